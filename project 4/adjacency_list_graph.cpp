@@ -1,142 +1,267 @@
 #include "adjacency_list_graph.hpp"
 
 #include <algorithm>
+#include <cstdint>
 #include <exception>
 #include <forward_list>
+#include <memory>
+#include <memory_resource>
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "bounds_check.hpp"
 #include "edge.hpp"
+#include "edge_index.hpp"
 
-AdjacencyListGraph::AdjacencyListGraph(const int vertex_count)
+template <class Bounds, class Weight>
+BasicAdjacencyListGraph<Bounds, Weight>::BasicAdjacencyListGraph(
+    const int vertex_count)
+    : BasicAdjacencyListGraph(vertex_count, EdgeAllocation::kHeap) {}
+
+template <class Bounds, class Weight>
+BasicAdjacencyListGraph<Bounds, Weight>::BasicAdjacencyListGraph(
+    const int vertex_count, const EdgeAllocation allocation)
+    : BasicAdjacencyListGraph(
+          vertex_count,
+          allocation == EdgeAllocation::kArena
+              ? std::make_shared<std::pmr::monotonic_buffer_resource>()
+              : nullptr,
+          std::pmr::get_default_resource()) {}
+
+template <class Bounds, class Weight>
+BasicAdjacencyListGraph<Bounds, Weight>::BasicAdjacencyListGraph(
+    const int vertex_count, std::pmr::memory_resource* resource)
+    : BasicAdjacencyListGraph(vertex_count, nullptr, resource) {}
+
+template <class Bounds, class Weight>
+BasicAdjacencyListGraph<Bounds, Weight>::BasicAdjacencyListGraph(
+    const BasicAdjacencyListGraph& other)
+    : vertex_count_(other.vertex_count_),
+      edge_count_(other.edge_count_),
+      arena_(other.arena_ == nullptr
+                 ? nullptr
+                 : std::make_shared<std::pmr::monotonic_buffer_resource>()),
+      resource_(arena_ == nullptr ? other.resource_ : arena_.get()),
+      chunks_(other.chunks_) {}
+
+template <class Bounds, class Weight>
+BasicAdjacencyListGraph<Bounds, Weight>::BasicAdjacencyListGraph(
+    const int vertex_count,
+    std::shared_ptr<std::pmr::monotonic_buffer_resource> arena,
+    std::pmr::memory_resource* resource)
     : vertex_count_(vertex_count),
       edge_count_(0),
-      edge_weights_(vertex_count, std::forward_list<Edge>()) {}
+      arena_(std::move(arena)),
+      resource_(arena_ == nullptr ? resource : arena_.get()) {
+  if (resource_ == nullptr) {
+    throw std::invalid_argument("memory resource cannot be null");
+  }
+  for (int begin = 0; begin < vertex_count; begin += kChunkSize) {
+    const int size = std::min(kChunkSize, vertex_count - begin);
+    std::shared_ptr<Chunk> chunk = std::make_shared<Chunk>();
+    chunk->arena = arena_;
+    // Each list is constructed with the resource, as copying a prototype
+    // list would give the copies the default resource instead.
+    chunk->lists.reserve(size);
+    for (int k = 0; k < size; ++k) {
+      chunk->lists.emplace_back(resource_);
+    }
+    chunk->indexes.resize(size);
+    chunks_.push_back(std::move(chunk));
+  }
+}
 
 //
 // Accessors
 //
 
-int AdjacencyListGraph::vertex_count() const noexcept {
-  return edge_weights_.size();
+template <class Bounds, class Weight>
+int BasicAdjacencyListGraph<Bounds, Weight>::vertex_count() const noexcept {
+  return vertex_count_;
 }
 
-int AdjacencyListGraph::edge_count() const noexcept {
+template <class Bounds, class Weight>
+int BasicAdjacencyListGraph<Bounds, Weight>::edge_count() const noexcept {
   return edge_count_;
 }
 
-bool AdjacencyListGraph::has_edge(const int i, const int j) const {
-  if (i < 0 || i >= vertex_count_) {
-    throw std::range_error("invalid i: " + std::to_string(i));
-  }
-  if (j < 0 || j >= vertex_count_) {
-    throw std::range_error("invalid j: " + std::to_string(j));
-  }
-  for (const Edge& edge : edge_weights_[i]) {
-    if (j == edge.j()) {
-      return true;
-    }
-  }
-  return false;
+template <class Bounds, class Weight>
+bool BasicAdjacencyListGraph<Bounds, Weight>::has_edge(
+    const int i, const int j) const {
+  check_vertex<Bounds>(i, vertex_count_, "i");
+  check_vertex<Bounds>(j, vertex_count_, "j");
+  return has_edge_unchecked(i, j);
 }
 
-int AdjacencyListGraph::edge_weight(const int i, const int j) const {
-  if (i < 0 || i >= vertex_count_) {
-    throw std::range_error("invalid i: " + std::to_string(i));
-  }
-  if (j < 0 || j >= vertex_count_) {
-    throw std::range_error("invalid j: " + std::to_string(j));
-  }
-  for (const Edge& edge : edge_weights_[i]) {
-    if (j == edge.j()) {
-      return edge.weight();
-    }
-  }
-  throw std::invalid_argument("no edge from i to j");
+template <class Bounds, class Weight>
+Weight BasicAdjacencyListGraph<Bounds, Weight>::edge_weight(
+    const int i, const int j) const {
+  check_vertex<Bounds>(i, vertex_count_, "i");
+  check_vertex<Bounds>(j, vertex_count_, "j");
+  return edge_weight_unchecked(i, j);
+}
+
+template <class Bounds, class Weight>
+std::vector<int> BasicAdjacencyListGraph<Bounds, Weight>::out_edges(
+    const int i) const {
+  check_vertex<Bounds>(i, vertex_count_, "i");
+  return out_edges_unchecked(i);
 }
 
-std::vector<int> AdjacencyListGraph::out_edges(const int i) const {
-  if (i < 0 || i >= vertex_count_) {
-    throw std::range_error("invalid i: " + std::to_string(i));
+template <class Bounds, class Weight>
+bool BasicAdjacencyListGraph<Bounds, Weight>::has_edge_unchecked(
+    const int i, const int j) const {
+  return index(i).contains(j);
+}
+
+template <class Bounds, class Weight>
+Weight BasicAdjacencyListGraph<Bounds, Weight>::edge_weight_unchecked(
+    const int i, const int j) const {
+  const Weight* weight = index(i).find(j);
+  if (weight == nullptr) {
+    throw std::invalid_argument("no edge from i to j");
   }
+  return *weight;
+}
+
+template <class Bounds, class Weight>
+std::vector<int> BasicAdjacencyListGraph<Bounds, Weight>::out_edges_unchecked(
+    const int i) const {
   std::vector<int> outs;
-  for (const Edge& edge : edge_weights_[i]) {
+  for (const BasicEdge<Weight>& edge : list(i)) {
     outs.push_back(edge.j());
   }
   return outs;
 }
 
-std::vector<int> AdjacencyListGraph::in_edges(const int j) const {
-  if (j < 0 || j >= vertex_count_) {
-    throw std::range_error("invalid j: " + std::to_string(j));
-  }
+template <class Bounds, class Weight>
+std::vector<int> BasicAdjacencyListGraph<Bounds, Weight>::in_edges(
+    const int j) const {
+  check_vertex<Bounds>(j, vertex_count_, "j");
   std::vector<int> ins;
-  for (const std::forward_list<Edge>& list : edge_weights_) {
-    for (const Edge& edge : list) {
-      if (j == edge.j()) {
-        ins.push_back(edge.i());
+  for (const std::shared_ptr<Chunk>& chunk : chunks_) {
+    for (const EdgeList& list : chunk->lists) {
+      for (const BasicEdge<Weight>& edge : list) {
+        if (j == edge.j()) {
+          ins.push_back(edge.i());
+        }
       }
     }
   }
   return ins;
 }
 
-std::vector<Edge> AdjacencyListGraph::edges() const noexcept {
-  std::vector<Edge> edges;
-  for (const std::forward_list<Edge>& list : edge_weights_) {
-    for (const Edge& edge : list) {
-      edges.push_back(edge);
+template <class Bounds, class Weight>
+std::vector<BasicEdge<Weight>>
+BasicAdjacencyListGraph<Bounds, Weight>::edges() const noexcept {
+  std::vector<BasicEdge<Weight>> edges;
+  for (const std::shared_ptr<Chunk>& chunk : chunks_) {
+    for (const EdgeList& list : chunk->lists) {
+      for (const BasicEdge<Weight>& edge : list) {
+        edges.push_back(edge);
+      }
     }
   }
   return edges;
 }
 
+template <class Bounds, class Weight>
+std::pmr::memory_resource*
+BasicAdjacencyListGraph<Bounds, Weight>::memory_resource() const noexcept {
+  return resource_;
+}
+
 //
 // Modifiers
 //
 
-void AdjacencyListGraph::add_edge(
-    const int i, const int j, const int edge_weight) {
-  if (i < 0 || i >= vertex_count_) {
-    throw std::range_error("invalid i: " + std::to_string(i));
-  }
-  if (j < 0 || j >= vertex_count_) {
-    throw std::range_error("invalid j: " + std::to_string(j));
-  }
+template <class Bounds, class Weight>
+void BasicAdjacencyListGraph<Bounds, Weight>::add_edge(
+    const int i, const int j, const Weight edge_weight) {
+  check_vertex<Bounds>(i, vertex_count_, "i");
+  check_vertex<Bounds>(j, vertex_count_, "j");
   if (edge_weight == 0) {
     throw std::invalid_argument("edge weight cannot be zero");
   }
-  for (Edge& edge : edge_weights_[i]) {
-    if (j == edge.j()) {
-      edge.set_weight(edge_weight);
-      return;
+  Chunk& chunk = unshared_chunk(i);
+  EdgeList& list = chunk.lists[i % kChunkSize];
+  if (!chunk.indexes[i % kChunkSize].insert_or_assign(j, edge_weight)) {
+    // The edge already exists, so only its weight in the adjacency list needs
+    // to be updated.
+    for (BasicEdge<Weight>& edge : list) {
+      if (j == edge.j()) {
+        edge.set_weight(edge_weight);
+        return;
+      }
     }
   }
   edge_count_++;
-  edge_weights_[i].push_front(Edge(i, j, edge_weight));
+  list.push_front(BasicEdge<Weight>(i, j, edge_weight));
 }
 
-  // Removes the edge from vertex i to vertex j.
-  //
-  // Throws if 0 <= i, j < vertex_count() is violated of if there is no edge
-  // from vertex i to vertex j.
-void AdjacencyListGraph::remove_edge(const int i, const int j) {
-  if (i < 0 || i >= vertex_count_) {
-    throw std::range_error("invalid i: " + std::to_string(i));
-  }
-  if (j < 0 || j >= vertex_count_) {
-    throw std::range_error("invalid j: " + std::to_string(j));
+template <class Bounds, class Weight>
+void BasicAdjacencyListGraph<Bounds, Weight>::remove_edge(
+    const int i, const int j) {
+  check_vertex<Bounds>(i, vertex_count_, "i");
+  check_vertex<Bounds>(j, vertex_count_, "j");
+  if (!index(i).contains(j)) {
+    throw std::invalid_argument("no edge from i to j");
   }
-  for (std::forward_list<Edge>::iterator iter = edge_weights_[i].before_begin();
-       std::next(iter) != edge_weights_[i].end(); ++iter) {
-    const std::forward_list<Edge>::iterator next_iter = std::next(iter);
-    if (next_iter->i() == i && next_iter->j() == j) {
-      edge_weights_[i].erase_after(iter);
-      edge_count_--;
+  Chunk& chunk = unshared_chunk(i);
+  EdgeList& list = chunk.lists[i % kChunkSize];
+  for (typename EdgeList::iterator iter = list.before_begin();
+       std::next(iter) != list.end(); ++iter) {
+    if (std::next(iter)->j() == j) {
+      list.erase_after(iter);
       break;
     }
   }
-  throw std::invalid_argument("no edge from i to j");
-}
\ No newline at end of file
+  chunk.indexes[i % kChunkSize].erase(j);
+  edge_count_--;
+}
+
+//
+// Helpers
+//
+
+template <class Bounds, class Weight>
+const typename BasicAdjacencyListGraph<Bounds, Weight>::EdgeList&
+BasicAdjacencyListGraph<Bounds, Weight>::list(const int i) const noexcept {
+  return chunks_[i / kChunkSize]->lists[i % kChunkSize];
+}
+
+template <class Bounds, class Weight>
+const BasicEdgeIndex<Weight>& BasicAdjacencyListGraph<Bounds, Weight>::index(
+    const int i) const noexcept {
+  return chunks_[i / kChunkSize]->indexes[i % kChunkSize];
+}
+
+template <class Bounds, class Weight>
+typename BasicAdjacencyListGraph<Bounds, Weight>::Chunk&
+BasicAdjacencyListGraph<Bounds, Weight>::unshared_chunk(const int i) {
+  std::shared_ptr<Chunk>& chunk = chunks_[i / kChunkSize];
+  // A chunk allocated from another graph's arena is copied even if this graph
+  // holds the last reference to it, as that graph (or another copy) may still
+  // allocate from the arena, which is not thread-safe.
+  if (chunk.use_count() > 1 || chunk->arena != arena_) {
+    std::shared_ptr<Chunk> copy = std::make_shared<Chunk>();
+    copy->arena = arena_;
+    copy->lists.reserve(chunk->lists.size());
+    for (const EdgeList& list : chunk->lists) {
+      copy->lists.emplace_back(list, resource_);
+    }
+    copy->indexes = chunk->indexes;
+    chunk = std::move(copy);
+  }
+  return *chunk;
+}
+
+template class BasicAdjacencyListGraph<Checked>;
+template class BasicAdjacencyListGraph<Unchecked>;
+template class BasicAdjacencyListGraph<DebugOnly>;
+template class BasicAdjacencyListGraph<Checked, std::uint16_t>;
+template class BasicAdjacencyListGraph<Checked, std::int64_t>;
+template class BasicAdjacencyListGraph<Checked, float>;
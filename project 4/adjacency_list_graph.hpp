@@ -2,39 +2,99 @@
 #define _adjacency_list_graph_hpp_
 
 #include <forward_list>
+#include <memory>
+#include <memory_resource>
 #include <set>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "bounds_check.hpp"
 #include "edge.hpp"
+#include "edge_index.hpp"
+
+// How an AdjacencyListGraph allocates the nodes of its adjacency lists.
+enum class EdgeAllocation {
+  // Each node is allocated from the default memory resource (normally the
+  // heap) and freed when its edge is removed.
+  kHeap,
+  // The nodes are allocated from an arena owned by the graph, which hands
+  // them out by bumping a pointer and frees them all at once when the graph
+  // is destroyed. This suits graphs that are built once and then mostly
+  // read, such as the airport network; the memory of a removed edge is only
+  // reclaimed with the graph.
+  kArena,
+};
 
-// The AdjacencyListGraph class implements the Graph ADT using the adjacency
-// list representation.
-class AdjacencyListGraph {
+// The BasicAdjacencyListGraph class template implements the Graph ADT using
+// the adjacency list representation.
+//
+// The adjacency lists are allocator-aware (std::pmr): their nodes come from
+// the default memory resource, from an arena owned by the graph (see
+// EdgeAllocation), or from a memory resource supplied by the caller.
+//
+// The vertices are stored in chunks of kChunkSize consecutive vertices, each
+// with their adjacency lists and edge indexes, which are shared between a
+// graph and its copies until one of them modifies the chunk. Copying a graph
+// therefore only copies pointers, and a modifier copies the chunk it changes
+// (if it is shared), so that a copy followed by a few edits (as in
+// VersionedAirportNetwork::update) costs time in proportion to the edits
+// rather than to the size of the graph.
+//
+// The template parameter Bounds is the bounds-check policy (see
+// bounds_check.hpp): whether the methods below that throw if
+// 0 <= i, j < vertex_count() is violated actually check it. The other errors
+// (such as a zero edge weight or a missing edge) are always reported.
+//
+// The template parameter Weight is the type of the edge weights, as for
+// BasicEdge. Every bounds-check policy is instantiated with int weights, and
+// Checked also with std::uint16_t, std::int64_t and float weights.
+template <class Bounds = Checked, class Weight = int>
+class BasicAdjacencyListGraph {
  public:
+  // The type of the edge weights.
+  using WeightType = Weight;
+
   //
   // Constructors and Destructors
   // 
 
   // The default constructor. Creates a graph with vertex_count-many vertices
   // and no edges.
-  AdjacencyListGraph(const int vertex_count);
+  BasicAdjacencyListGraph(const int vertex_count);
+
+  // The constructor. Creates a graph with vertex_count-many vertices and no
+  // edges, whose adjacency list nodes are allocated as `allocation` says.
+  BasicAdjacencyListGraph(
+      const int vertex_count, const EdgeAllocation allocation);
+
+  // The constructor. Creates a graph with vertex_count-many vertices and no
+  // edges, whose adjacency list nodes are allocated from `resource`.
+  //
+  // Throws a std::invalid_argument exception if resource is null.
+  //
+  // ASSUMES: resource outlives the graph (and any graph moved from it).
+  BasicAdjacencyListGraph(
+      const int vertex_count, std::pmr::memory_resource* resource);
 
-  // The copy constructor.
-  AdjacencyListGraph(const AdjacencyListGraph& other) = default;
+  // The copy constructor. The copy shares the adjacency lists of `other`
+  // (see below) and allocates the nodes of the lists it changes the same way
+  // as `other`: from the default memory resource, from an arena of its own,
+  // or from the same caller-supplied resource.
+  BasicAdjacencyListGraph(const BasicAdjacencyListGraph& other);
 
   // The copy assignment constructor.
-  AdjacencyListGraph& operator=(const AdjacencyListGraph& other) = default;
+  BasicAdjacencyListGraph& operator=(
+      const BasicAdjacencyListGraph& other) = default;
 
   // The move constructor.
-  AdjacencyListGraph(AdjacencyListGraph&& other) = default;
+  BasicAdjacencyListGraph(BasicAdjacencyListGraph&& other) = default;
 
   // The move assignment constructor.
-  AdjacencyListGraph& operator=(AdjacencyListGraph&& other) = default;
+  BasicAdjacencyListGraph& operator=(BasicAdjacencyListGraph&& other) = default;
 
   // The destructor.
-  ~AdjacencyListGraph() = default;
+  ~BasicAdjacencyListGraph() = default;
 
   //
   // Accessors
@@ -54,20 +114,40 @@ class AdjacencyListGraph {
   // Returns the weight of the edge from vertex i to vertex j.
   //
   // Throws if 0 <= i, j < vertex_count() is violated or if !has_edge(i, j).
-  int edge_weight(const int i, const int j) const;
+  Weight edge_weight(const int i, const int j) const;
 
   // Returns the vertices j with an edge from vertex i to vertex j.
   //
   // Throws if 0 <= i < vertex_count() is violated.
   std::vector<int> out_edges(const int i) const;
 
+  // The same as has_edge, except that i and j are never checked,
+  // whatever Bounds says (see UncheckedView in bounds_check.hpp).
+  //
+  // ASSUMES: 0 <= i, j < vertex_count().
+  bool has_edge_unchecked(const int i, const int j) const;
+
+  // The same as edge_weight, except that i and j are never checked (a missing
+  // edge is still reported).
+  //
+  // ASSUMES: 0 <= i, j < vertex_count().
+  Weight edge_weight_unchecked(const int i, const int j) const;
+
+  // The same as out_edges, except that i is never checked.
+  //
+  // ASSUMES: 0 <= i < vertex_count().
+  std::vector<int> out_edges_unchecked(const int i) const;
+
   // Returns the vertices i with an edge from vertex i to vertex j.
   //
   // Throws if 0 <= j < vertex_count() is violated.
   std::vector<int> in_edges(const int j) const;
 
   // Returns the edges in the graph, as a vector of Edges.
-  std::vector<Edge> edges() const noexcept;
+  std::vector<BasicEdge<Weight>> edges() const noexcept;
+
+  // Returns the memory resource the adjacency list nodes are allocated from.
+  std::pmr::memory_resource* memory_resource() const noexcept;
 
   //
   // Modifiers
@@ -79,7 +159,7 @@ class AdjacencyListGraph {
   // edge weight of the existing edge to `edge_weight`.
   //
   // Throws if 0 <= i, j < vertex_count() is violated or if edge_weight is zero.
-  void add_edge(const int i, const int j, const int edge_weight = 1);
+  void add_edge(const int i, const int j, const Weight edge_weight = 1);
 
   // Removes the edge from vertex i to vertex j.
   //
@@ -88,20 +168,81 @@ class AdjacencyListGraph {
   void remove_edge(const int i, const int j);
 
  private:
+  // The number of consecutive vertices stored in each chunk.
+  static constexpr int kChunkSize = 64;
+
+  // The adjacency list of a vertex.
+  using EdgeList = std::pmr::forward_list<BasicEdge<Weight>>;
+
+  // A chunk of the vertices, holding the adjacency lists and the edge indexes
+  // of vertices kChunkSize * c, ..., kChunkSize * (c + 1) - 1 for the c^th
+  // chunk (the last chunk may hold fewer).
+  struct Chunk {
+    // The arena the nodes of the lists were allocated from, if any, which
+    // the chunk keeps alive for as long as a graph shares it.
+    //
+    // This is declared before lists, so that the lists are destroyed before
+    // the memory they live in.
+    std::shared_ptr<std::pmr::monotonic_buffer_resource> arena;
+
+    // The adjacency lists of the vertices in the chunk.
+    //
+    // An Edge(i, j, edge_weight) (with edge_weight != 0) is in the list of
+    // vertex i if there is an edge from vertex i to vertex j.
+    std::vector<EdgeList> lists;
+
+    // The edge indexes of the vertices in the chunk, used to answer has_edge
+    // and edge_weight without walking the adjacency lists.
+    //
+    // The index of vertex i maps j to edge_weight exactly when
+    // Edge(i, j, edge_weight) is in the list of vertex i.
+    std::vector<BasicEdgeIndex<Weight>> indexes;
+  };
+
+  // The constructor delegated to by the public ones: creates a graph with
+  // vertex_count-many vertices and no edges, whose adjacency list nodes are
+  // allocated from `arena` if it is not null and from `resource` otherwise.
+  //
+  // Throws a std::invalid_argument exception if both are null.
+  BasicAdjacencyListGraph(
+      const int vertex_count,
+      std::shared_ptr<std::pmr::monotonic_buffer_resource> arena,
+      std::pmr::memory_resource* resource);
+
+  // Returns the adjacency list of vertex i.
+  const EdgeList& list(const int i) const noexcept;
+
+  // Returns the edge index of vertex i.
+  const BasicEdgeIndex<Weight>& index(const int i) const noexcept;
+
+  // Returns the chunk holding vertex i, first replacing it with a copy of its
+  // own if it is shared with another graph or if its nodes were allocated
+  // from an arena other than this graph's.
+  Chunk& unshared_chunk(const int i);
+
   // The number of vertices in the graph.
   const int vertex_count_;
 
   // The number of edges in the graph.
   //
-  // This is always equal to the number of non-zero entries in the matrix
-  // edge_weights_.
+  // This is always equal to the total length of the adjacency lists.
   int edge_count_;
 
-  // The adjacency lists storing the edges in the graph.
+  // The arena the adjacency list nodes are allocated from, if the graph
+  // allocates them as EdgeAllocation::kArena, or null otherwise.
   //
-  // An Edge(j, edge_weight) will exist in i^th element of edge_weights_ 
-  // (with edge_weight != 0) if there is an edge from vertex i to vertex j. 
-  std::vector<std::forward_list<Edge>> edge_weights_;
+  // The chunks allocated from the arena share its ownership, so it lives as
+  // long as the graph or any copy still sharing one of those chunks.
+  std::shared_ptr<std::pmr::monotonic_buffer_resource> arena_;
+
+  // The memory resource the adjacency list nodes are allocated from.
+  std::pmr::memory_resource* resource_;
+
+  // The chunks of the vertices, in order.
+  std::vector<std::shared_ptr<Chunk>> chunks_;
 };
 
+// The adjacency list graph that checks every vertex it is given.
+using AdjacencyListGraph = BasicAdjacencyListGraph<Checked>;
+
 #endif
\ No newline at end of file
@@ -4,9 +4,182 @@
 // Unit tests for the AdjacencyListGraph class.
 #include "adjacency_list_graph.hpp"
 
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <vector>
+
 #include "doctest.hpp"
+#include "edge.hpp"
 #include "graph_adt_test.hpp"
+#include "test_random.hpp"
+#include "undirected_graph.hpp"
 
 TEST_CASE_TEMPLATE_INVOKE(test_id, AdjacencyListGraph);
 
+// DebugOnly graphs behave as Checked ones unless NDEBUG is defined.
+#ifndef NDEBUG
+TEST_CASE_TEMPLATE_INVOKE(test_id, BasicAdjacencyListGraph<DebugOnly>);
+#endif
+
+// A memory resource that counts the allocations it passes on to the heap.
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  // Returns the number of allocations not yet deallocated.
+  int live() const noexcept {
+    return live_;
+  }
+
+ private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    ++live_;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(
+      void* p, std::size_t bytes, std::size_t alignment) override {
+    --live_;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+  int live_ = 0;
+};
+
+TEST_CASE("AdjacencyListGraphAllocation") {
+  SUBCASE("ArenaGraphMatchesHeapGraph") {
+    const int n = 50;
+    AdjacencyListGraph heap(n);
+    AdjacencyListGraph arena(n, EdgeAllocation::kArena);
+    CHECK_EQ(heap.memory_resource(), std::pmr::get_default_resource());
+    CHECK_NE(arena.memory_resource(), std::pmr::get_default_resource());
+    TestRandom random(46);
+    for (int step = 0; step < 2000; ++step) {
+      const int i = random.next(n);
+      const int j = random.next(n);
+      if (step % 3 == 2 && heap.has_edge(i, j)) {
+        heap.remove_edge(i, j);
+        arena.remove_edge(i, j);
+      } else {
+        heap.add_edge(i, j, 1 + step % 7);
+        arena.add_edge(i, j, 1 + step % 7);
+      }
+    }
+    CHECK_EQ(arena.edge_count(), heap.edge_count());
+    int mismatches = 0;
+    for (int i = 0; i < n; ++i) {
+      if (arena.out_edges(i) != heap.out_edges(i)) {
+        ++mismatches;
+      }
+      for (int j = 0; j < n; ++j) {
+        if (heap.has_edge(i, j) &&
+            arena.edge_weight(i, j) != heap.edge_weight(i, j)) {
+          ++mismatches;
+        }
+      }
+    }
+    CHECK_EQ(mismatches, 0);
+  }
+
+  SUBCASE("CopyOfArenaGraphHasItsOwnArena") {
+    std::unique_ptr<AdjacencyListGraph> original =
+        std::make_unique<AdjacencyListGraph>(4, EdgeAllocation::kArena);
+    original->add_edge(0, 1, 5);
+    original->add_edge(2, 3, 7);
+    const AdjacencyListGraph copy(*original);
+    CHECK_NE(copy.memory_resource(), original->memory_resource());
+    original.reset();
+    CHECK_EQ(copy.edge_count(), 2);
+    CHECK_EQ(copy.edge_weight(0, 1), 5);
+    CHECK_EQ(copy.edge_weight(2, 3), 7);
+  }
+
+  SUBCASE("CopiesAreIndependent") {
+    // Enough vertices for several chunks, so that some are shared and some
+    // copied. Vertex 299 starts with no edges.
+    const int n = 300;
+    for (const EdgeAllocation allocation :
+         {EdgeAllocation::kHeap, EdgeAllocation::kArena}) {
+      auto original = std::make_unique<AdjacencyListGraph>(n, allocation);
+      for (const Edge& edge : random_edges(n - 1, 1000, 50, 77)) {
+        original->add_edge(edge.i(), edge.j(), edge.weight());
+      }
+      const std::vector<Edge> before = original->edges();
+      AdjacencyListGraph copy(*original);
+      copy.add_edge(0, 299, 60);
+      copy.remove_edge(before[0].i(), before[0].j());
+      original->add_edge(299, 0, 61);
+      CHECK_FALSE(original->has_edge(0, 299));
+      CHECK(original->has_edge(before[0].i(), before[0].j()));
+      CHECK_FALSE(copy.has_edge(299, 0));
+      CHECK_EQ(original->edge_count(), before.size() + 1);
+      CHECK_EQ(copy.edge_count(), before.size());
+
+      // The copy keeps the shared lists, and the arena they live in, after
+      // the original is destroyed, and can still change them.
+      original.reset();
+      copy.add_edge(before[1].i(), before[1].j(), 62);
+      CHECK_EQ(copy.edge_weight(before[1].i(), before[1].j()), 62);
+      int mismatches = 0;
+      for (const Edge& edge : before) {
+        if (edge.i() == before[0].i() && edge.j() == before[0].j()) {
+          mismatches += copy.has_edge(edge.i(), edge.j());
+        } else if (edge.i() != before[1].i() || edge.j() != before[1].j()) {
+          mismatches += copy.edge_weight(edge.i(), edge.j()) != edge.weight();
+        }
+      }
+      CHECK_EQ(mismatches, 0);
+      CHECK_EQ(copy.out_edges(0).front(), 299);
+    }
+  }
+
+  SUBCASE("MovedArenaGraphKeepsItsEdges") {
+    AdjacencyListGraph original(3, EdgeAllocation::kArena);
+    original.add_edge(1, 2, 4);
+    std::pmr::memory_resource* resource = original.memory_resource();
+    const AdjacencyListGraph moved(std::move(original));
+    CHECK_EQ(moved.memory_resource(), resource);
+    CHECK_EQ(moved.out_edges(1), std::vector<int>{2});
+  }
+
+  SUBCASE("SuppliedResource") {
+    CountingResource resource;
+    {
+      AdjacencyListGraph graph(3, &resource);
+      graph.add_edge(0, 1);
+      graph.add_edge(0, 2);
+      graph.add_edge(1, 2);
+      CHECK_EQ(resource.live(), 3);
+      graph.remove_edge(0, 1);
+      CHECK_EQ(resource.live(), 2);
+      AdjacencyListGraph copy(graph);
+      CHECK_EQ(copy.memory_resource(), &resource);
+      // The copy shares the lists until it changes them.
+      CHECK_EQ(resource.live(), 2);
+      copy.add_edge(2, 0);
+      CHECK_EQ(resource.live(), 5);
+    }
+    CHECK_EQ(resource.live(), 0);
+    CHECK_THROWS_AS(AdjacencyListGraph(3, nullptr), std::invalid_argument);
+  }
+
+  SUBCASE("UndirectedArenaGraph") {
+    UndirectedGraph<AdjacencyListGraph> graph(
+        AdjacencyListGraph(3, EdgeAllocation::kArena));
+    graph.add_edge(0, 2, 9);
+    CHECK_EQ(graph.edge_count(), 1);
+    CHECK_EQ(graph.edge_weight(2, 0), 9);
+    AdjacencyListGraph with_edge(3);
+    with_edge.add_edge(0, 1);
+    CHECK_THROWS_AS(
+        UndirectedGraph<AdjacencyListGraph>{with_edge},
+        std::invalid_argument);
+  }
+}
+
 #endif
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "adjacency_matrix_graph.hpp"
 
 #include <algorithm>
+#include <cstdint>
 #include <exception>
 #include <iterator>
 #include <set>
@@ -9,50 +10,71 @@
 #include <utility>
 #include <vector>
 
-AdjacencyMatrixGraph::AdjacencyMatrixGraph(const int vertex_count)
+#include "bounds_check.hpp"
+
+template <class Bounds, class Weight>
+BasicAdjacencyMatrixGraph<Bounds, Weight>::BasicAdjacencyMatrixGraph(
+    const int vertex_count)
     : vertex_count_(vertex_count),
       edge_count_(0),
-      edge_weights_(vertex_count, std::vector<int>(vertex_count, 0)) {}
+      edge_weights_(vertex_count, std::vector<Weight>(vertex_count, 0)) {}
 
 //
 // Accessors
 //
 
-int AdjacencyMatrixGraph::vertex_count() const noexcept {
+template <class Bounds, class Weight>
+int BasicAdjacencyMatrixGraph<Bounds, Weight>::vertex_count() const noexcept {
   return edge_weights_.size();
 }
 
-int AdjacencyMatrixGraph::edge_count() const noexcept {
+template <class Bounds, class Weight>
+int BasicAdjacencyMatrixGraph<Bounds, Weight>::edge_count() const noexcept {
   return edge_count_;
 }
 
-bool AdjacencyMatrixGraph::has_edge(const int i, const int j) const {
-  if (i < 0 || i >= vertex_count_) {
-    throw std::range_error("invalid i: " + std::to_string(i));
-  }
-  if (j < 0 || j >= vertex_count_) {
-    throw std::range_error("invalid j: " + std::to_string(j));
-  }
+template <class Bounds, class Weight>
+bool BasicAdjacencyMatrixGraph<Bounds, Weight>::has_edge(
+    const int i, const int j) const {
+  check_vertex<Bounds>(i, vertex_count_, "i");
+  check_vertex<Bounds>(j, vertex_count_, "j");
+  return has_edge_unchecked(i, j);
+}
+
+template <class Bounds, class Weight>
+Weight BasicAdjacencyMatrixGraph<Bounds, Weight>::edge_weight(
+    const int i, const int j) const {
+  check_vertex<Bounds>(i, vertex_count_, "i");
+  check_vertex<Bounds>(j, vertex_count_, "j");
+  return edge_weight_unchecked(i, j);
+}
+
+template <class Bounds, class Weight>
+std::vector<int> BasicAdjacencyMatrixGraph<Bounds, Weight>::out_edges(
+    const int i) const {
+  check_vertex<Bounds>(i, vertex_count_, "i");
+  return out_edges_unchecked(i);
+}
+
+template <class Bounds, class Weight>
+bool BasicAdjacencyMatrixGraph<Bounds, Weight>::has_edge_unchecked(
+    const int i, const int j) const {
   return edge_weights_[i][j] != 0;
 }
 
-int AdjacencyMatrixGraph::edge_weight(const int i, const int j) const {
-  if (i < 0 || i >= vertex_count_) {
-    throw std::range_error("invalid i: " + std::to_string(i));
-  }
-  if (j < 0 || j >= vertex_count_) {
-    throw std::range_error("invalid j: " + std::to_string(j));
-  }
-  if (!has_edge(i, j)) {
+template <class Bounds, class Weight>
+Weight BasicAdjacencyMatrixGraph<Bounds, Weight>::edge_weight_unchecked(
+    const int i, const int j) const {
+  if (!has_edge_unchecked(i, j)) {
     throw std::invalid_argument("no edge from i to j");
   }
   return edge_weights_[i][j];
 }
 
-std::vector<int> AdjacencyMatrixGraph::out_edges(const int i) const {
-  if (i < 0 || i >= vertex_count_) {
-    throw std::range_error("invalid i: " + std::to_string(i));
-  }
+template <class Bounds, class Weight>
+std::vector<int>
+BasicAdjacencyMatrixGraph<Bounds, Weight>::out_edges_unchecked(
+    const int i) const {
   std::vector<int> outs;
   for (int j = 0; j < vertex_count_; ++j) {
     if (edge_weights_[i][j] != 0) {
@@ -62,10 +84,10 @@ std::vector<int> AdjacencyMatrixGraph::out_edges(const int i) const {
   return outs;
 }
 
-std::vector<int> AdjacencyMatrixGraph::in_edges(const int j) const {
-  if (j < 0 || j >= vertex_count_) {
-    throw std::range_error("invalid j: " + std::to_string(j));
-  }
+template <class Bounds, class Weight>
+std::vector<int> BasicAdjacencyMatrixGraph<Bounds, Weight>::in_edges(
+    const int j) const {
+  check_vertex<Bounds>(j, vertex_count_, "j");
   std::vector<int> ins;
   for (int i = 0; i < vertex_count_; ++i) {
     if (edge_weights_[i][j] != 0) {
@@ -75,12 +97,14 @@ std::vector<int> AdjacencyMatrixGraph::in_edges(const int j) const {
   return ins;
 }
 
-std::vector<Edge> AdjacencyMatrixGraph::edges() const noexcept {
-  std::vector<Edge> edges;
+template <class Bounds, class Weight>
+std::vector<BasicEdge<Weight>>
+BasicAdjacencyMatrixGraph<Bounds, Weight>::edges() const noexcept {
+  std::vector<BasicEdge<Weight>> edges;
   for (int i = 0; i < vertex_count_; ++i) {
     for (int j = 0; j < vertex_count_; ++j) {
       if (edge_weights_[i][j] != 0) {
-        edges.push_back(Edge(i, j, edge_weights_[i][j]));
+        edges.push_back(BasicEdge<Weight>(i, j, edge_weights_[i][j]));
       }
     }
   }
@@ -91,14 +115,11 @@ std::vector<Edge> AdjacencyMatrixGraph::edges() const noexcept {
 // Modifiers
 //
 
-void AdjacencyMatrixGraph::add_edge(
-    const int i, const int j, const int edge_weight) {
-  if (i < 0 || i >= vertex_count_) {
-    throw std::range_error("invalid i: " + std::to_string(i));
-  }
-  if (j < 0 || j >= vertex_count_) {
-    throw std::range_error("invalid j: " + std::to_string(j));
-  }
+template <class Bounds, class Weight>
+void BasicAdjacencyMatrixGraph<Bounds, Weight>::add_edge(
+    const int i, const int j, const Weight edge_weight) {
+  check_vertex<Bounds>(i, vertex_count_, "i");
+  check_vertex<Bounds>(j, vertex_count_, "j");
   if (edge_weight == 0) {
     throw std::invalid_argument("edge weight cannot be zero");
   }
@@ -110,11 +131,21 @@ void AdjacencyMatrixGraph::add_edge(
   edge_weights_[i][j] = edge_weight;
 }
 
-void AdjacencyMatrixGraph::remove_edge(const int i, const int j) {
+template <class Bounds, class Weight>
+void BasicAdjacencyMatrixGraph<Bounds, Weight>::remove_edge(
+    const int i, const int j) {
   if (!has_edge(i, j)) {
     throw std::invalid_argument(
         "no edge from i to j to remove: " +
             std::to_string(i) + ", " + std::to_string(j));;
   }
   edge_weights_[i][j] = 0;
-}
\ No newline at end of file
+  edge_count_--;
+}
+
+template class BasicAdjacencyMatrixGraph<Checked>;
+template class BasicAdjacencyMatrixGraph<Unchecked>;
+template class BasicAdjacencyMatrixGraph<DebugOnly>;
+template class BasicAdjacencyMatrixGraph<Checked, std::uint16_t>;
+template class BasicAdjacencyMatrixGraph<Checked, std::int64_t>;
+template class BasicAdjacencyMatrixGraph<Checked, float>;
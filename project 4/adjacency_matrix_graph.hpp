@@ -6,34 +6,45 @@
 #include <utility>
 #include <vector>
 
+#include "bounds_check.hpp"
 #include "edge.hpp"
 
-// The AdjacencyMatrixGraph class implements the Graph ADT using the adjacency
-// matrix representation.
-class AdjacencyMatrixGraph {
+// The BasicAdjacencyMatrixGraph class template implements the Graph ADT using
+// the adjacency matrix representation.
+//
+// The template parameters Bounds (the bounds-check policy, see
+// bounds_check.hpp) and Weight (the type of the edge weights) are as for
+// BasicAdjacencyListGraph, and instantiated for the same combinations.
+template <class Bounds = Checked, class Weight = int>
+class BasicAdjacencyMatrixGraph {
  public:
+  // The type of the edge weights.
+  using WeightType = Weight;
+
   //
   // Constructors and Destructors
   // 
 
   // The default constructor. Creates a graph with vertex_count-many vertices
   // and no edges.
-  AdjacencyMatrixGraph(const int vertex_count);
+  BasicAdjacencyMatrixGraph(const int vertex_count);
 
   // The copy constructor.
-  AdjacencyMatrixGraph(const AdjacencyMatrixGraph& other) = default;
+  BasicAdjacencyMatrixGraph(const BasicAdjacencyMatrixGraph& other) = default;
 
   // The copy assignment constructor.
-  AdjacencyMatrixGraph& operator=(const AdjacencyMatrixGraph& other) = default;
+  BasicAdjacencyMatrixGraph& operator=(
+      const BasicAdjacencyMatrixGraph& other) = default;
 
   // The move constructor.
-  AdjacencyMatrixGraph(AdjacencyMatrixGraph&& other) = default;
+  BasicAdjacencyMatrixGraph(BasicAdjacencyMatrixGraph&& other) = default;
 
   // The move assignment constructor.
-  AdjacencyMatrixGraph& operator=(AdjacencyMatrixGraph&& other) = default;
+  BasicAdjacencyMatrixGraph& operator=(
+      BasicAdjacencyMatrixGraph&& other) = default;
 
   // The destructor.
-  ~AdjacencyMatrixGraph() = default;
+  ~BasicAdjacencyMatrixGraph() = default;
 
   //
   // Accessors
@@ -53,20 +64,37 @@ class AdjacencyMatrixGraph {
   // Returns the weight of the edge from vertex i to vertex j.
   //
   // Throws if 0 <= i, j < vertex_count() is violated or if !has_edge(i, j).
-  int edge_weight(const int i, const int j) const;
+  Weight edge_weight(const int i, const int j) const;
 
   // Returns the vertices j with an edge from vertex i to vertex j.
   //
   // Throws if 0 <= i < vertex_count() is violated.
   std::vector<int> out_edges(const int i) const;
 
+  // The same as has_edge, except that i and j are never checked,
+  // whatever Bounds says (see UncheckedView in bounds_check.hpp).
+  //
+  // ASSUMES: 0 <= i, j < vertex_count().
+  bool has_edge_unchecked(const int i, const int j) const;
+
+  // The same as edge_weight, except that i and j are never checked (a missing
+  // edge is still reported).
+  //
+  // ASSUMES: 0 <= i, j < vertex_count().
+  Weight edge_weight_unchecked(const int i, const int j) const;
+
+  // The same as out_edges, except that i is never checked.
+  //
+  // ASSUMES: 0 <= i < vertex_count().
+  std::vector<int> out_edges_unchecked(const int i) const;
+
   // Returns the vertices i with an edge from vertex i to vertex j.
   //
   // Throws if 0 <= j < vertex_count() is violated.
   std::vector<int> in_edges(const int j) const;
 
   // Returns the edges in the graph, as a vector of Edge's.
-  std::vector<Edge> edges() const noexcept;
+  std::vector<BasicEdge<Weight>> edges() const noexcept;
 
   //
   // Modifiers
@@ -78,7 +106,7 @@ class AdjacencyMatrixGraph {
   // edge weight of the existing edge to `edge_weight`.
   //
   // Throws if 0 <= i, j < vertex_count() is violated or if edge_weight is zero.
-  void add_edge(const int i, const int j, const int edge_weight = 1);
+  void add_edge(const int i, const int j, const Weight edge_weight = 1);
 
   // Removes the edge from vertex i to vertex j.
   //
@@ -101,7 +129,10 @@ class AdjacencyMatrixGraph {
   // The value of edge_weights_[i][j] represents the weight of the edge from
   // vertex i to vertex j. A value of 0 represents that no edge is present from
   // vertex i to vertex j.
-  std::vector<std::vector<int>> edge_weights_;
+  std::vector<std::vector<Weight>> edge_weights_;
 };
 
+// The adjacency matrix graph that checks every vertex it is given.
+using AdjacencyMatrixGraph = BasicAdjacencyMatrixGraph<Checked>;
+
 #endif
\ No newline at end of file
@@ -9,4 +9,9 @@
 
 TEST_CASE_TEMPLATE_INVOKE(test_id, AdjacencyMatrixGraph);
 
+// DebugOnly graphs behave as Checked ones unless NDEBUG is defined.
+#ifndef NDEBUG
+TEST_CASE_TEMPLATE_INVOKE(test_id, BasicAdjacencyMatrixGraph<DebugOnly>);
+#endif
+
 #endif
\ No newline at end of file
@@ -8,6 +8,7 @@
 
 #include "airport.hpp"
 #include "flight_route.hpp"
+#include "permutation.hpp"
 
 AirportDatabase::AirportDatabase(
     const std::string& airport_datafile,
@@ -77,4 +78,23 @@ std::vector<FlightRoute> AirportDatabase::routes()
 
 int AirportDatabase::size() const noexcept {
   return code_to_index_.size();
-}
\ No newline at end of file
+}
+
+AirportDatabase AirportDatabase::reordered(
+    const std::vector<int>& order) const {
+  if (order.size() != size()) {
+    throw std::invalid_argument(
+        "order has " + std::to_string(order.size()) + " entries, expected " +
+            std::to_string(size()));
+  }
+  // Throws if order is not a permutation.
+  inverse_order(order);
+
+  AirportDatabase reordered = *this;
+  for (int k = 0; k < order.size(); ++k) {
+    const std::string& code = index_to_code_.at(order[k]);
+    reordered.code_to_index_[code] = k;
+    reordered.index_to_code_[k] = code;
+  }
+  return reordered;
+}
@@ -61,6 +61,17 @@ class AirportDatabase {
 
   // Returns the number of airports in this database.
   int size() const noexcept;
+
+  //
+  // Relabeling
+  //
+
+  // Returns a copy of this database in which the airport with index order[k]
+  // has index k, e.g., for one of the orders in vertex_order.hpp.
+  //
+  // Throws a std::invalid_argument exception if order is not a permutation of
+  // 0, 1, ..., size() - 1.
+  AirportDatabase reordered(const std::vector<int>& order) const;
   
  private:
   // A map from (three letter) IATA airport code to Airport object.
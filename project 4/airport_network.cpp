@@ -1,6 +1,11 @@
 #include "airport_network.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -8,33 +13,127 @@
 #include "adjacency_list_graph.hpp"
 #include "adjacency_matrix_graph.hpp"
 #include "airport_database.hpp"
+#include "all_pairs_shortest_path.hpp"
+#include "cancellation_token.hpp"
+#include "csr_graph.hpp"
+#include "disjoint_sets.hpp"
+#include "distance_table.hpp"
 #include "graph_traversal.hpp"
+#include "landmark_labeling.hpp"
+#include "many_to_many.hpp"
+#include "min_plus.hpp"
+#include "shortest_path_tree.hpp"
+#include "spatial_index.hpp"
+#include "traversal_workspace.hpp"
 #include "undirected_graph.hpp"
+#include "vertex_order.hpp"
+#include "vertex_set.hpp"
 #include "flight_route.hpp"
 
-AirportNetwork::AirportNetwork(const AirportDatabase& airport_database):airport_database_(airport_database),airport_graph_(airport_database_.size())
-// Implement the AirportNetwork constructor.
+namespace {
+
+// Returns the (undirected, weighted) graph modeling the airports and flight
+// routes in airport_database, as described for AirportNetwork::airport_graph_.
 //
-// Like every constructor, this should properly set all of the private data
-// members of the class. You should do as much initialization as possible in the
-// initializer list, though some will need to be done in the method body.
+// The edges are allocated from an arena, as the graph is built in one go and
+// then changed only by the occasional route update.
+UndirectedGraph<BasicAdjacencyListGraph<DebugOnly>> build_airport_graph(
+    const AirportDatabase& airport_database) {
+  UndirectedGraph<BasicAdjacencyListGraph<DebugOnly>> airport_graph(
+      BasicAdjacencyListGraph<DebugOnly>(
+          airport_database.size(), EdgeAllocation::kArena));
+  for (const FlightRoute& route : airport_database.routes()) {
+    const Airport airport_one = airport_database.airport(route.code_one());
+    const Airport airport_two = airport_database.airport(route.code_two());
+    airport_graph.add_edge(
+        airport_database.index(route.code_one()),
+        airport_database.index(route.code_two()),
+        airport_one.distance_miles(airport_two));
+  }
+  return airport_graph;
+}
+
+// Sets latitudes[i] and longitudes[i] to the location of the airport with
+// index i in airport_database, for every airport.
+void airport_coordinates(
+    const AirportDatabase& airport_database, std::vector<double>& latitudes,
+    std::vector<double>& longitudes) {
+  latitudes.resize(airport_database.size());
+  longitudes.resize(airport_database.size());
+  for (int i = 0; i < airport_database.size(); ++i) {
+    const Airport airport = airport_database.airport(airport_database.code(i));
+    latitudes[i] = airport.latitude();
+    longitudes[i] = airport.longitude();
+  }
+}
+
+// Returns airport_database with its airports relabeled in the given order.
+AirportDatabase reorder_airports(
+    const AirportDatabase& airport_database, const VertexOrder order) {
+  if (order == VertexOrder::kInput) {
+    return airport_database;
+  }
+  if (order == VertexOrder::kHilbert) {
+    std::vector<double> latitudes;
+    std::vector<double> longitudes;
+    airport_coordinates(airport_database, latitudes, longitudes);
+    return airport_database.reordered(hilbert_order(latitudes, longitudes));
+  }
+  const CsrGraph graph(build_airport_graph(airport_database));
+  if (order == VertexOrder::kBreadthFirst) {
+    return airport_database.reordered(breadth_first_order(graph));
+  }
+  return airport_database.reordered(hub_first_order(graph));
+}
+
+// Returns the connected component of each vertex of `graph`, as described for
+// AirportNetwork::airport_component_.
+std::vector<int> label_components(const CsrGraph& graph) {
+  DisjointSets components(graph.vertex_count());
+  const std::vector<int>& targets = graph.targets();
+  for (int i = 0; i < graph.vertex_count(); ++i) {
+    for (int e = graph.offset(i); e < graph.offset(i + 1); ++e) {
+      components.unite(i, targets[e]);
+    }
+  }
+  return components.labels();
+}
 
-{
-  std::vector<FlightRoute> routes = airport_database_.routes();
-  for(int i = 0; i < routes.size();i++)
-  {
-    std::string code_one_ = routes[i].code_one();
-    std::string code_two_ = routes[i].code_two();
-    int airport_one = airport_database_.index(code_one_);
-    int airport_two = airport_database_.index(code_two_);
-    Airport airport_uno = airport_database_.airport(code_one_);
-    Airport airport_dos = airport_database_.airport(code_two_);
-    int distance = airport_uno.distance_miles(airport_dos);
-    airport_graph_.add_edge(airport_one,airport_two,distance);
+// Returns the number of distinct labels in `labels`, which are numbered
+// 0, 1, 2, ....
+int count_labels(const std::vector<int>& labels) {
+  if (labels.empty()) {
+    return 0;
   }
-  
+  return *std::max_element(labels.begin(), labels.end()) + 1;
+}
+
+// Returns the spatial index of the airports in airport_database, as described
+// for AirportNetwork::airport_locations_->
+SpatialIndex locate_airports(const AirportDatabase& airport_database) {
+  std::vector<double> latitudes;
+  std::vector<double> longitudes;
+  airport_coordinates(airport_database, latitudes, longitudes);
+  return SpatialIndex(latitudes, longitudes);
 }
 
+}  // namespace
+
+AirportNetwork::AirportNetwork(
+    const AirportDatabase& airport_database, const VertexOrder order)
+    : airport_database_(std::make_shared<const AirportDatabase>(
+          reorder_airports(airport_database, order))),
+      airport_graph_(build_airport_graph(*airport_database_)),
+      airport_csr_(airport_graph_),
+      airport_component_(label_components(airport_csr_)),
+      num_components_(count_labels(airport_component_)),
+      airport_locations_(std::make_shared<const SpatialIndex>(
+          locate_airports(*airport_database_))),
+      airport_distances_(std::make_shared<LazyDistances>()) {}
+
+const AirportDatabase& AirportNetwork::airport_database() const noexcept {
+  return *airport_database_;
+}
 
 int AirportNetwork::num_airports() const noexcept {
   return airport_graph_.vertex_count();
@@ -45,35 +144,365 @@ int AirportNetwork::num_flight_routes() const noexcept {
 }
 
 std::vector<std::string> AirportNetwork::at_most_one_layover(
-    const std::string& code) const {
+    const std::string& code, const CancellationToken& cancellation) const {
   // Implement the at_most_one_layover function.
   //
   // HINT: This will require a modicum of business logic. The graph theory
   // part of the problem should be delegated to a method call in
   // graph_traversal.
-  int airport_num = airport_database_.index(code);
-  std::vector<bool> result = distance_at_most_two(airport_graph_,airport_num);
+  int airport_num = airport_database_->index(code);
+  const WorkspacePool::Lease workspace = workspace_pool_.acquire();
+  const VertexSet result = distance_at_most_two(
+      airport_graph_, airport_num, *workspace, cancellation);
   std::vector<std::string> layovers;
-  for(int i = 0; i < result.size();++i)
-  {
-    if(result[i] == true)
-    {
-      std::string airport_name = airport_database_.code(i);
-      layovers.push_back(airport_name);
-    }
+  layovers.reserve(result.count());
+  for (const int i : result) {
+    layovers.push_back(airport_database_->code(i));
+  }
+  return layovers;
+}
+
+std::vector<std::string> AirportNetwork::common_at_most_one_layover(
+    const std::vector<std::string>& codes) const {
+  if (codes.empty()) {
+    throw std::invalid_argument("codes cannot be empty");
+  }
+  const WorkspacePool::Lease workspace = workspace_pool_.acquire();
+  VertexSet common = distance_at_most_two(
+      airport_graph_, airport_database_->index(codes[0]), *workspace);
+  for (int c = 1; c < codes.size() && !common.empty(); ++c) {
+    common &= distance_at_most_two(
+        airport_graph_, airport_database_->index(codes[c]), *workspace);
+  }
+  std::vector<std::string> layovers;
+  layovers.reserve(common.count());
+  for (const int i : common) {
+    layovers.push_back(airport_database_->code(i));
   }
-  return std::vector<std::string>(layovers);
+  return layovers;
 }
 
-std::vector<int> AirportNetwork::least_distance(const std::string& code) const {
+std::vector<std::pair<std::string, int>> AirportNetwork::reachable_within(
+    const std::string& code, const int miles,
+    const CancellationToken& cancellation) const {
+  const int airport_num = airport_database_->index(code);
+  if (miles < 0) {
+    throw std::invalid_argument("miles cannot be negative");
+  }
+  const WorkspacePool::Lease workspace = workspace_pool_.acquire();
+  std::vector<std::pair<std::string, int>> reachable;
+  for (const std::pair<int, int>& airport : shortest_paths_within(
+           airport_graph_, airport_num, miles, *workspace, cancellation)) {
+    reachable.emplace_back(
+        airport_database_->code(airport.first), airport.second);
+  }
+  return reachable;
+}
+
+std::vector<int> AirportNetwork::least_distance(
+    const std::string& code, const CancellationToken& cancellation) const {
   // Implement the least_distance function.
   //
   // HINT: This will require a small amount of business logic. The graph theory
   // part of the problem should be delegated to a method call in
   // graph_traversal.
-  int airport_num = airport_database_.index(code);
-  std::vector<int> distance_from_airport = shortest_path(airport_graph_,airport_num);
+  int airport_num = airport_database_->index(code);
+  return tree_cache_.distances(airport_csr_, airport_num, cancellation);
+}
+
+int AirportNetwork::least_distance(
+    const std::string& from_code, const std::string& to_code) const {
+  const int from = airport_database_->index(from_code);
+  const int to = airport_database_->index(to_code);
+  if (airport_component_[from] != airport_component_[to]) {
+    return std::numeric_limits<int>::max();
+  }
+  return airport_distances().distance(from, to);
+}
+
+std::vector<int> AirportNetwork::least_distances(
+    const std::string& from_code,
+    const std::vector<std::string>& to_codes) const {
+  const int from = airport_database_->index(from_code);
+  std::vector<int> to(to_codes.size());
+  for (int c = 0; c < to_codes.size(); ++c) {
+    to[c] = airport_database_->index(to_codes[c]);
+  }
+  std::vector<int> distances(to_codes.size(), std::numeric_limits<int>::max());
+  for (int c = 0; c < to.size(); ++c) {
+    if (airport_component_[to[c]] == airport_component_[from]) {
+      distances[c] = airport_distances().distance(from, to[c]);
+    }
+  }
+  return distances;
+}
+
+int AirportNetwork::num_components() const noexcept {
+  return num_components_;
+}
+
+int AirportNetwork::component(const std::string& code) const {
+  return airport_component_[airport_database_->index(code)];
+}
+
+bool AirportNetwork::same_component(
+    const std::string& from_code, const std::string& to_code) const {
+  return component(from_code) == component(to_code);
+}
+
+std::vector<std::string> AirportNetwork::nearest_airports(
+    const double latitude, const double longitude, const int count) const {
+  std::vector<std::string> codes;
+  for (const std::pair<int, int>& airport :
+       airport_locations_->nearest(latitude, longitude, count)) {
+    codes.push_back(airport_database_->code(airport.first));
+  }
+  return codes;
+}
+
+std::vector<std::string> AirportNetwork::airports_within(
+    const double latitude, const double longitude, const int miles) const {
+  std::vector<std::string> codes;
+  for (const std::pair<int, int>& airport :
+       airport_locations_->within(latitude, longitude, miles)) {
+    codes.push_back(airport_database_->code(airport.first));
+  }
+  return codes;
+}
+
+std::string AirportNetwork::nearest_airport_with_route_to(
+    const double latitude, const double longitude,
+    const std::string& code) const {
+  const int destination = airport_database_->index(code);
+  const std::vector<std::pair<int, int>> nearest = airport_locations_->nearest(
+      latitude, longitude, 1, [this, destination](const int i) {
+        return airport_graph_.has_edge(i, destination);
+      });
+  return nearest.empty() ? "" : airport_database_->code(nearest[0].first);
+}
 
-  
-  return std::vector<int>(distance_from_airport);
-}
\ No newline at end of file
+std::vector<int> AirportNetwork::least_distance_within_layovers(
+    const std::string& code, const int max_layovers,
+    const CancellationToken& cancellation) const {
+  if (max_layovers < 0) {
+    throw std::invalid_argument("max_layovers cannot be negative");
+  }
+  // An itinerary with k layovers takes k + 1 flights. The graph is undirected,
+  // so airport_csr_ is also the graph of in-edges.
+  const int index = airport_database_->index(code);
+  const WorkspacePool::Lease workspace = workspace_pool_.acquire();
+  return shortest_path_within_hops(
+      airport_csr_, index, max_layovers + 1, *workspace, cancellation);
+}
+
+DistanceTable AirportNetwork::layover_distance_table(
+    const std::vector<std::string>& codes, const int max_layovers) const {
+  if (max_layovers < 0) {
+    throw std::invalid_argument("max_layovers cannot be negative");
+  }
+  std::vector<int> targets;
+  for (const std::string& code : codes) {
+    targets.push_back(airport_database_->index(code));
+  }
+  return hop_distance_table(airport_csr_, targets, max_layovers + 1);
+}
+
+DistanceTable AirportNetwork::least_distance_table(
+    const std::vector<std::string>& from_codes,
+    const std::vector<std::string>& to_codes) const {
+  std::vector<int> sources;
+  for (const std::string& code : from_codes) {
+    sources.push_back(airport_database_->index(code));
+  }
+  std::vector<int> targets;
+  for (const std::string& code : to_codes) {
+    targets.push_back(airport_database_->index(code));
+  }
+  return many_to_many_distances(airport_csr_, sources, targets);
+}
+
+DistanceTable AirportNetwork::all_pairs_least_distance(
+    const std::vector<std::string>& codes) const {
+  std::vector<int> vertices;
+  for (const std::string& code : codes) {
+    vertices.push_back(airport_database_->index(code));
+  }
+
+  // Extract the subgraph induced by the airports as a table of edge weights.
+  DistanceTable table(
+      codes.size(), codes.size(), std::numeric_limits<int>::max());
+  for (int a = 0; a < vertices.size(); ++a) {
+    int* row = table.row(a);
+    for (int b = 0; b < vertices.size(); ++b) {
+      if (airport_graph_.has_edge(vertices[a], vertices[b])) {
+        row[b] = airport_graph_.edge_weight(vertices[a], vertices[b]);
+      }
+    }
+  }
+  floyd_warshall(table);
+  return table;
+}
+
+//
+// Route Updates
+//
+
+void AirportNetwork::add_route(
+    const std::string& code_one, const std::string& code_two) {
+  const int i = airport_database_->index(code_one);
+  const int j = airport_database_->index(code_two);
+  if (i == j) {
+    throw std::invalid_argument("a route cannot start and end at " + code_one);
+  }
+  if (airport_graph_.has_edge(i, j)) {
+    throw std::invalid_argument(
+        "there already is a route between " + code_one + " and " + code_two);
+  }
+  const int miles = airport_database_->airport(code_one).distance_miles(
+      airport_database_->airport(code_two));
+  airport_graph_.add_edge(i, j, miles);
+  route_shortened(i, j, miles);
+}
+
+void AirportNetwork::remove_route(
+    const std::string& code_one, const std::string& code_two) {
+  const int i = airport_database_->index(code_one);
+  const int j = airport_database_->index(code_two);
+  if (!airport_graph_.has_edge(i, j)) {
+    throw std::invalid_argument(
+        "there is no route between " + code_one + " and " + code_two);
+  }
+  const int old_miles = airport_graph_.edge_weight(i, j);
+  airport_graph_.remove_edge(i, j);
+  airport_csr_.remove_edge(i, j);
+  airport_csr_.remove_edge(j, i);
+  route_lengthened(i, j, old_miles);
+}
+
+void AirportNetwork::set_route_distance(
+    const std::string& code_one, const std::string& code_two,
+    const int miles) {
+  const int i = airport_database_->index(code_one);
+  const int j = airport_database_->index(code_two);
+  if (!airport_graph_.has_edge(i, j)) {
+    throw std::invalid_argument(
+        "there is no route between " + code_one + " and " + code_two);
+  }
+  if (miles <= 0) {
+    throw std::invalid_argument("miles must be positive");
+  }
+  const int old_miles = airport_graph_.edge_weight(i, j);
+  airport_graph_.add_edge(i, j, miles);
+  if (miles < old_miles) {
+    route_shortened(i, j, miles);
+  } else if (miles > old_miles) {
+    airport_csr_.set_edge(i, j, miles);
+    airport_csr_.set_edge(j, i, miles);
+    route_lengthened(i, j, old_miles);
+  }
+}
+
+void AirportNetwork::route_shortened(
+    const int i, const int j, const int miles) {
+  airport_csr_.set_edge(i, j, miles);
+  airport_csr_.set_edge(j, i, miles);
+
+  // A new route can only join two components into one.
+  if (airport_component_[i] != airport_component_[j]) {
+    const int joined = airport_component_[j];
+    for (int& component : airport_component_) {
+      if (component == joined) {
+        component = airport_component_[i];
+      }
+    }
+    renumber_components();
+  }
+
+  if (LandmarkLabeling* labeling = unshared_airport_distances()) {
+    labeling->edge_decreased(airport_csr_, i, j);
+  }
+  tree_cache_.edge_decreased(airport_csr_, i, j);
+}
+
+void AirportNetwork::route_lengthened(
+    const int i, const int j, const int old_miles) {
+  if (!airport_graph_.has_edge(i, j) && i != j) {
+    // The component may have split in two. Search from both airports at
+    // once, one airport at a time from each side: if the searches meet, the
+    // airports are still connected, and otherwise the side that runs out first
+    // is a new component. Either way the work is bounded by the smaller side.
+    const std::vector<int>& targets = airport_csr_.targets();
+    std::vector<char> side(num_airports(), 0);
+    std::vector<int> reached[2] = {{i}, {j}};
+    int next[2] = {0, 0};
+    side[i] = 1;
+    side[j] = 2;
+    int s = 0;
+    bool met = false;
+    while (!met && next[s] < reached[s].size()) {
+      const int current = reached[s][next[s]++];
+      for (int e = airport_csr_.offset(current);
+           e < airport_csr_.offset(current + 1); ++e) {
+        const int v = targets[e];
+        if (side[v] == 0) {
+          side[v] = s + 1;
+          reached[s].push_back(v);
+        } else if (side[v] != s + 1) {
+          met = true;
+        }
+      }
+      s = 1 - s;
+    }
+    if (!met) {
+      for (const int v : reached[s]) {
+        airport_component_[v] = num_components_;
+      }
+      num_components_++;
+      renumber_components();
+    }
+  }
+
+  if (LandmarkLabeling* labeling = unshared_airport_distances()) {
+    labeling->edge_increased(airport_csr_, i, j, old_miles);
+  }
+  tree_cache_.edge_increased(airport_csr_, i, j);
+}
+
+const LandmarkLabeling& AirportNetwork::airport_distances() const {
+  LazyDistances& distances = *airport_distances_;
+  std::call_once(distances.once, [&]() {
+    distances.labeling = std::make_unique<LandmarkLabeling>(airport_csr_);
+    distances.built.store(true, std::memory_order_release);
+  });
+  return *distances.labeling;
+}
+
+LandmarkLabeling* AirportNetwork::unshared_airport_distances() {
+  // A copy of the network sharing the oracle may be building it right now, in
+  // which case this network starts over with an unbuilt one.
+  const bool built = airport_distances_->built.load(std::memory_order_acquire);
+  if (airport_distances_.use_count() > 1) {
+    // Another copy of the network shares the labels, so change a copy of them.
+    std::shared_ptr<LazyDistances> unshared = std::make_shared<LazyDistances>();
+    if (built) {
+      unshared->labeling =
+          std::make_unique<LandmarkLabeling>(*airport_distances_->labeling);
+      std::call_once(unshared->once, []() {});
+      unshared->built.store(true, std::memory_order_relaxed);
+    }
+    airport_distances_ = std::move(unshared);
+  }
+  return built ? airport_distances_->labeling.get() : nullptr;
+}
+
+void AirportNetwork::renumber_components() {
+  std::vector<int> renumbered(num_components_, -1);
+  int count = 0;
+  for (int& component : airport_component_) {
+    if (renumbered[component] == -1) {
+      renumbered[component] = count++;
+    }
+    component = renumbered[component];
+  }
+  num_components_ = count;
+}
@@ -1,6 +1,9 @@
 #ifndef _airport_network_hpp_
 #define _airport_network_hpp_
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -8,15 +11,52 @@
 #include "adjacency_list_graph.hpp"
 #include "adjacency_matrix_graph.hpp"
 #include "airport_database.hpp"
+#include "cancellation_token.hpp"
+#include "csr_graph.hpp"
+#include "disjoint_sets.hpp"
+#include "distance_table.hpp"
+#include "landmark_labeling.hpp"
+#include "shortest_path_tree.hpp"
+#include "spatial_index.hpp"
+#include "traversal_workspace.hpp"
 #include "undirected_graph.hpp"
+#include "vertex_order.hpp"
 
 // The AirportNetwork class offers graph traversal algorithms over a database
 // of airports and flights.
+//
+// Thread safety: the queries (the const member functions) may be called
+// concurrently from any number of threads on one shared network. Their scratch
+// state is kept per thread (see WorkspacePool) and taken without locking;
+// the one cache they fill, of shortest path trees, is split into separately
+// locked shards (see ShortestPathTreeCache), the only lock a query takes.
+// The distance oracle of least_distance between two airports is built by the
+// first such query; queries that need it meanwhile wait for it.
+// The route updates change the network, and must not run concurrently with
+// any other call on it; to keep answering queries during updates, see
+// VersionedAirportNetwork.
+//
+// Cancellation: the queries that search the network take an optional
+// CancellationToken, checked periodically by the search, so that a query
+// whose caller has gone away stops early (with an OperationCancelled
+// exception) instead of running to completion. See async_airport_network.hpp
+// for awaitable versions of these queries.
 class AirportNetwork {
  public:
   // Constructs an AirportNetwork modeling the data in airport_database as a
   // weighted undirected graph.
-  AirportNetwork(const AirportDatabase& airport_database);
+  //
+  // The airports are relabeled in the given order (see vertex_order.hpp) to
+  // improve the memory locality of traversals. With any order other than
+  // VertexOrder::kInput, the results indexed by airport (such as those of
+  // least_distance) follow the indices of airport_database() rather than those
+  // of the database passed in.
+  AirportNetwork(
+      const AirportDatabase& airport_database,
+      const VertexOrder order = VertexOrder::kInput);
+
+  // Returns the database of airports, with the indices used by the network.
+  const AirportDatabase& airport_database() const noexcept;
 
   // Returns the number of airports in the network.
   int num_airports() const noexcept;
@@ -27,27 +67,247 @@ class AirportNetwork {
   // Returns the airport codes that are at most one layover away from `code`.
   //
   // Throws a std::invalid_argument exception if `code` is not an airport code
-  // in the database.
+  // in the database, and an OperationCancelled exception if `cancellation` is
+  // cancelled before the search finishes.
   //
   // NOTE: As an example, this will equal one if there is a direct flight from
   // `from_code` to `to_code`.
-  std::vector<std::string> at_most_one_layover(const std::string& code) const;
+  std::vector<std::string> at_most_one_layover(
+      const std::string& code,
+      const CancellationToken& cancellation = CancellationToken()) const;
+
+  // Returns the airport codes that are at most one layover away from every
+  // airport in `codes`, e.g., the candidate meeting points for travelers
+  // starting from each of them.
+  //
+  // Throws a std::invalid_argument exception if `codes` is empty or any code
+  // is not an airport code in the database.
+  std::vector<std::string> common_at_most_one_layover(
+      const std::vector<std::string>& codes) const;
+
+  // Returns the airports that can be reached from `code` flying at most
+  // `miles` miles in total, as (code, least distance in miles) pairs by
+  // increasing distance. The airport `code` itself is first, at distance zero.
+  //
+  // The search stops at the edge of the budget, so its cost depends on the
+  // number of airports returned rather than on the size of the network.
+  //
+  // Throws a std::invalid_argument exception if `code` is not an airport code
+  // in the database or if miles is negative, and an OperationCancelled
+  // exception if `cancellation` is cancelled before the search finishes.
+  std::vector<std::pair<std::string, int>> reachable_within(
+      const std::string& code, const int miles,
+      const CancellationToken& cancellation = CancellationToken()) const;
 
   // Returns the shortest path distance of travel (in miles) when flying from
   // `code` to each airport.
   //
+  // The shortest path trees of the most recent airports are cached (and kept
+  // up to date by the route updates), so repeated calls do not search.
+  //
   // Throws a std::invalid_argument exception if `code` is not an airport code
-  // in the database.
+  // in the database, and an OperationCancelled exception if `cancellation` is
+  // cancelled before the search finishes (a search cancelled this way is not
+  // cached).
   //
   // NOTE: If there is a direct flight from ` to `to_code`, this will
   // be the great-circle distance between the airports. If there is not a direct
   // flight, this will measure the amount one needs to deviate from the
   // great-circle route given the available flights.
-  std::vector<int> least_distance(const std::string& code) const;
+  std::vector<int> least_distance(
+      const std::string& code,
+      const CancellationToken& cancellation = CancellationToken()) const;
+
+  // Returns the shortest path distance of travel (in miles) when flying from
+  // `from_code` to `to_code`, or std::numeric_limits<int>::max() if there is
+  // no itinerary between them.
+  //
+  // Airports in different components are answered in O(1), and airports in
+  // the same component by merging their labels in the distance oracle (built
+  // by the first call), without a search.
+  //
+  // Throws a std::invalid_argument exception if either code is not an airport
+  // code in the database.
+  int least_distance(
+      const std::string& from_code, const std::string& to_code) const;
+
+  // Returns the shortest path distances of travel (in miles) when flying from
+  // `from_code` to each of the airports `to_codes`, in the same order, with
+  // std::numeric_limits<int>::max() for airports with no itinerary.
+  //
+  // Each distance is answered by airport_distances_, without a search.
+  //
+  // Throws a std::invalid_argument exception if any code is not an airport
+  // code in the database.
+  std::vector<int> least_distances(
+      const std::string& from_code,
+      const std::vector<std::string>& to_codes) const;
+
+  // Returns the number of connected components of the network, i.e., of
+  // maximal groups of airports with itineraries between any two of them.
+  int num_components() const noexcept;
+
+  // Returns the index (between 0 and num_components() - 1) of the connected
+  // component of the airport `code`. Airports are in the same component
+  // exactly when there is an itinerary between them.
+  //
+  // Throws a std::invalid_argument exception if `code` is not an airport code
+  // in the database.
+  int component(const std::string& code) const;
+
+  // Returns whether there is an itinerary between `from_code` and `to_code`.
+  //
+  // Throws a std::invalid_argument exception if either code is not an airport
+  // code in the database.
+  bool same_component(
+      const std::string& from_code, const std::string& to_code) const;
+
+  // Returns the codes of the (at most) `count` airports closest to (latitude,
+  // longitude), in degrees, by increasing great-circle distance.
+  //
+  // Throws a std::invalid_argument exception if count is negative.
+  std::vector<std::string> nearest_airports(
+      const double latitude, const double longitude, const int count) const;
+
+  // Returns the codes of the airports within `miles` great-circle miles of
+  // (latitude, longitude), in degrees, by increasing distance.
+  //
+  // Throws a std::invalid_argument exception if miles is negative.
+  std::vector<std::string> airports_within(
+      const double latitude, const double longitude, const int miles) const;
+
+  // Returns the code of the airport closest to (latitude, longitude), in
+  // degrees, with a direct flight route to `code`, or the empty string if no
+  // airport has a route to `code`.
+  //
+  // Throws a std::invalid_argument exception if `code` is not an airport code
+  // in the database.
+  std::string nearest_airport_with_route_to(
+      const double latitude, const double longitude,
+      const std::string& code) const;
+
+  // Returns the shortest path distance of travel (in miles) when flying from
+  // `code` to each airport with at most max_layovers layovers, i.e., on
+  // itineraries of at most max_layovers + 1 flights.
+  //
+  // An airport that cannot be reached with at most max_layovers layovers has
+  // distance std::numeric_limits<int>::max().
+  //
+  // Throws a std::invalid_argument exception if `code` is not an airport code
+  // in the database or if max_layovers is negative, and an OperationCancelled
+  // exception if `cancellation` is cancelled before the search finishes.
+  std::vector<int> least_distance_within_layovers(
+      const std::string& code, const int max_layovers,
+      const CancellationToken& cancellation = CancellationToken()) const;
+
+  // Returns the table of shortest path distances of travel (in miles) between
+  // every airport and each of the airports `codes`, with at most max_layovers
+  // layovers.
+  //
+  // The entry in row i and column c is the least distance between the airport
+  // with index i in the database and codes[c] (flight routes are
+  // bidirectional, so this is the same in either direction), and
+  // std::numeric_limits<int>::max() if it takes more than max_layovers
+  // layovers.
+  //
+  // Throws a std::invalid_argument exception if any code is not an airport
+  // code in the database or if max_layovers is negative.
+  DistanceTable layover_distance_table(
+      const std::vector<std::string>& codes, const int max_layovers) const;
+
+  // Returns the table of shortest path distances of travel (in miles) from
+  // each of the airports `from_codes` to each of the airports `to_codes`.
+  //
+  // The entry in row r and column c is the least distance from from_codes[r]
+  // to to_codes[c], and std::numeric_limits<int>::max() if there is no
+  // itinerary between them.
+  //
+  // This uses the many-to-many engine of many_to_many.hpp, so each search
+  // from an airport in `from_codes` stops once it has found the distances to
+  // all of `to_codes`, rather than running a full least_distance.
+  //
+  // Throws a std::invalid_argument exception if any code is not an airport
+  // code in the database.
+  DistanceTable least_distance_table(
+      const std::vector<std::string>& from_codes,
+      const std::vector<std::string>& to_codes) const;
+
+  // Returns the table of shortest path distances of travel (in miles) between
+  // every pair of the airports `codes`, flying only between those airports.
+  //
+  // The entry in row a and column b is the least distance from codes[a] to
+  // codes[b] using only the flight routes between airports in `codes`, and
+  // std::numeric_limits<int>::max() if there is no such itinerary.
+  //
+  // Throws a std::invalid_argument exception if any code is not an airport
+  // code in the database.
+  //
+  // NOTE: This is intended for hub analytics over the busiest one or two
+  // thousand airports; it takes O(codes.size()^3) time.
+  DistanceTable all_pairs_least_distance(
+      const std::vector<std::string>& codes) const;
+
+  //
+  // Route Updates
+  //
+  // Each update changes the network in place, and repairs the derived state
+  // (the CSR snapshot, the components, the distance oracle if it has been
+  // built, and the cached shortest path trees) around the changed route
+  // rather than rebuilding it. airport_database() is not changed.
+  //
+  // ASSUMES: No query runs concurrently with an update.
+
+  // Adds a flight route between `code_one` and `code_two`, whose distance is
+  // the great-circle distance between the airports.
+  //
+  // Throws a std::invalid_argument exception if either code is not an airport
+  // code in the database, if the codes are the same, or if there already is a
+  // route between the airports.
+  void add_route(const std::string& code_one, const std::string& code_two);
+
+  // Removes the flight route between `code_one` and `code_two`.
+  //
+  // Throws a std::invalid_argument exception if either code is not an airport
+  // code in the database or if there is no route between the airports.
+  void remove_route(const std::string& code_one, const std::string& code_two);
+
+  // Sets the distance (in miles) of the flight route between `code_one` and
+  // `code_two`, e.g., to model a detour around closed airspace.
+  //
+  // Throws a std::invalid_argument exception if either code is not an airport
+  // code in the database, if there is no route between the airports, or if
+  // miles is not positive.
+  void set_route_distance(
+      const std::string& code_one, const std::string& code_two,
+      const int miles);
 
  private:
-  // The database of airports.
-  const AirportDatabase airport_database_;
+  // Repairs the derived state after the route between airports i and j was
+  // added or made shorter (already in airport_graph_), with the given
+  // distance.
+  void route_shortened(const int i, const int j, const int miles);
+
+  // Repairs the derived state after the route between airports i and j,
+  // which had the given distance, was removed or made longer (already in
+  // airport_graph_ and airport_csr_).
+  void route_lengthened(const int i, const int j, const int old_miles);
+
+  // Relabels airport_component_ as described for it, and sets num_components_.
+  void renumber_components();
+
+  // Returns the distance oracle of airport_distances_, building it on the
+  // first call.
+  const LandmarkLabeling& airport_distances() const;
+
+  // Returns the distance oracle of airport_distances_ for a route update to
+  // repair, after giving the network its own copy if another copy of the
+  // network shares it, or null if it has not been built (it is then built
+  // from the updated routes when first needed).
+  LandmarkLabeling* unshared_airport_distances();
+
+  // The database of airports. It never changes, so copies of the network share
+  // it.
+  const std::shared_ptr<const AirportDatabase> airport_database_;
 
   // A (undirected, weighted) graph modeling the airports in airport_database_.
   // * The airport with a given (three letter) IATA code is represented by
@@ -73,8 +333,59 @@ class AirportNetwork {
 
 
 
-  UndirectedGraph<AdjacencyListGraph> airport_graph_;
+  // The vertices passed to the graph always come from airport_database_ (the
+  // public methods check the airport codes first), so the graph only checks
+  // them in debug builds (see bounds_check.hpp).
+  UndirectedGraph<BasicAdjacencyListGraph<DebugOnly>> airport_graph_;
   //UndirectedGraph<AdjacencyMatrixGraph> airport_graph_;
+
+  // A CSR snapshot of airport_graph_, for the engines that sweep over every
+  // flight route repeatedly (such as least_distance_within_layovers).
+  CsrGraph airport_csr_;
+
+  // The connected component of each airport (by index in airport_database_),
+  // labeled 0, 1, ..., num_components_ - 1 in order of their first airport.
+  std::vector<int> airport_component_;
+
+  // The number of connected components.
+  int num_components_;
+
+  // The locations of the airports (by index in airport_database_), shared by
+  // copies of the network.
+  const std::shared_ptr<const SpatialIndex> airport_locations_;
+
+  // An exact distance oracle, built at most once.
+  struct LazyDistances {
+    // Guards the building of labeling.
+    std::once_flag once;
+
+    // Whether labeling has been built.
+    std::atomic<bool> built{false};
+
+    // The oracle, once built.
+    std::unique_ptr<LandmarkLabeling> labeling;
+  };
+
+  // The exact distance oracle for airport_csr_, answering least_distance
+  // between two airports in a few hundred nanoseconds rather than a search.
+  //
+  // Building it takes about ten times as long as the rest of the constructor,
+  // so it is built by the first query that needs it (see airport_distances)
+  // rather than by every network, most of which never answer such a query.
+  //
+  // Copies of the network share the oracle until one of them changes a route,
+  // which then changes its own copy of it.
+  std::shared_ptr<LazyDistances> airport_distances_;
+
+  // The shortest path trees of the airports least_distance was most recently
+  // called for. Copies of the network share the trees in the same way.
+  mutable ShortestPathTreeCache tree_cache_;
+
+  // The scratch workspaces for traversals of airport_graph_. Each query leases
+  // one for its duration from a stack kept by its thread, so concurrent (and
+  // nested) queries each get their own without locking, and repeated queries
+  // do not reallocate or re-initialize per-airport state.
+  mutable WorkspacePool workspace_pool_;
 };
 
 #endif
\ No newline at end of file
@@ -3,13 +3,17 @@
 
 #include "airport_network.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <limits>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "airport_database.hpp"
+#include "cancellation_token.hpp"
 #include "doctest.hpp"
 
 TEST_CASE("Constructor") {
@@ -103,6 +107,46 @@ TEST_CASE("AtMostOneLayoverLargeDatabase") {
   }
 }
 
+TEST_CASE("CommonAtMostOneLayover") {
+  const AirportDatabase airport_database =
+      AirportDatabase("data_airports.txt", "data_flights.txt");
+  const AirportNetwork airport_network = AirportNetwork(airport_database);
+
+  SUBCASE("BadCodesThrowException") {
+    CHECK_THROWS_AS(
+        airport_network.common_at_most_one_layover({}),
+        std::invalid_argument);
+    CHECK_THROWS_AS(
+        airport_network.common_at_most_one_layover({"LAX", "ACO"}),
+        std::invalid_argument);
+  }
+
+  SUBCASE("SingleCodeMatchesAtMostOneLayover") {
+    CHECK_EQ(
+        airport_network.common_at_most_one_layover({"LAX"}),
+        airport_network.at_most_one_layover("LAX"));
+  }
+
+  SUBCASE("IsTheIntersection") {
+    const std::vector<std::string> lax =
+        airport_network.at_most_one_layover("LAX");
+    const std::vector<std::string> ord =
+        airport_network.at_most_one_layover("ORD");
+    const std::vector<std::string> common =
+        airport_network.common_at_most_one_layover({"LAX", "ORD"});
+    CHECK_LT(common.size(), std::min(lax.size(), ord.size()));
+    for (const std::string& code : common) {
+      CHECK_NE(std::find(lax.begin(), lax.end(), code), lax.end());
+      CHECK_NE(std::find(ord.begin(), ord.end(), code), ord.end());
+    }
+    int expected = 0;
+    for (const std::string& code : lax) {
+      expected += std::find(ord.begin(), ord.end(), code) != ord.end();
+    }
+    CHECK_EQ(common.size(), expected);
+  }
+}
+
 TEST_CASE("LeastDistanceSmallDatabase") {
   const AirportDatabase airport_database =
       AirportDatabase("small_data_airports.txt", "small_data_flights.txt");
@@ -162,4 +206,609 @@ TEST_CASE("LeastDistanceLargeDatabase") {
   }
 }
 
+TEST_CASE("ReachableWithin") {
+  SUBCASE("SmallDatabase") {
+    const AirportDatabase airport_database =
+        AirportDatabase("small_data_airports.txt", "small_data_flights.txt");
+    const AirportNetwork airport_network = AirportNetwork(airport_database);
+    CHECK_THROWS_AS(
+        airport_network.reachable_within("ACO", 100), std::invalid_argument);
+    CHECK_THROWS_AS(
+        airport_network.reachable_within("LAX", -1), std::invalid_argument);
+    using Reached = std::vector<std::pair<std::string, int>>;
+    CHECK_EQ(airport_network.reachable_within("LAX", 0), Reached({{"LAX", 0}}));
+    CHECK_EQ(
+        airport_network.reachable_within("LAX", 1894),
+        Reached({{"LAX", 0}, {"ORD", 1739}}));
+    CHECK_EQ(
+        airport_network.reachable_within("LAX", 1895),
+        Reached({{"LAX", 0}, {"ORD", 1739}, {"DEC", 1895}}));
+    CHECK_EQ(
+        airport_network.reachable_within("PGF", 100000),
+        Reached({{"PGF", 0}}));
+  }
+
+  SUBCASE("LargeDatabaseMatchesLeastDistance") {
+    const AirportDatabase airport_database =
+        AirportDatabase("data_airports.txt", "data_flights.txt");
+    const AirportNetwork airport_network = AirportNetwork(airport_database);
+    const std::vector<int> distances = airport_network.least_distance("LAX");
+    const std::vector<std::pair<std::string, int>> reachable =
+        airport_network.reachable_within("LAX", 3000);
+    int expected = 0;
+    for (const int distance : distances) {
+      expected += distance <= 3000;
+    }
+    CHECK_EQ(reachable.size(), expected);
+    int mismatches = 0;
+    for (int r = 0; r < reachable.size(); ++r) {
+      mismatches +=
+          distances[airport_database.index(reachable[r].first)] !=
+              reachable[r].second ||
+          (r > 0 && reachable[r - 1].second > reachable[r].second);
+    }
+    CHECK_EQ(mismatches, 0);
+  }
+}
+
+TEST_CASE("ComponentsSmallDatabase") {
+  const AirportDatabase airport_database =
+      AirportDatabase("small_data_airports.txt", "small_data_flights.txt");
+  const AirportNetwork airport_network = AirportNetwork(airport_database);
+
+  SUBCASE("BadCodeThrowsException") {
+    CHECK_THROWS_AS(airport_network.component("ACO"), std::invalid_argument);
+    CHECK_THROWS_AS(
+        airport_network.least_distance("LAX", "ACO"), std::invalid_argument);
+    CHECK_THROWS_AS(
+        airport_network.least_distances("ACO", {"LAX"}),
+        std::invalid_argument);
+  }
+
+  SUBCASE("IsolatedAirportIsItsOwnComponent") {
+    CHECK_GE(airport_network.num_components(), 2);
+    CHECK(airport_network.same_component("LAX", "DEC"));
+    CHECK_FALSE(airport_network.same_component("LAX", "PGF"));
+    CHECK_GE(airport_network.component("PGF"), 0);
+    CHECK_LT(
+        airport_network.component("PGF"), airport_network.num_components());
+  }
+
+  SUBCASE("PointToPointLeastDistance") {
+    CHECK_EQ(airport_network.least_distance("LAX", "LAX"), 0);
+    CHECK_EQ(airport_network.least_distance("LAX", "ORD"), 1739);
+    CHECK_EQ(airport_network.least_distance("LAX", "DEC"), 1895);
+    CHECK_EQ(
+        airport_network.least_distance("LAX", "PGF"),
+        std::numeric_limits<int>::max());
+  }
+
+  SUBCASE("BatchLeastDistances") {
+    CHECK_EQ(
+        airport_network.least_distances("LAX", {"DEC", "PGF", "ORD"}),
+        std::vector<int>({1895, std::numeric_limits<int>::max(), 1739}));
+    CHECK_EQ(
+        airport_network.least_distances("PGF", {"LAX"}),
+        std::vector<int>({std::numeric_limits<int>::max()}));
+  }
+}
+
+TEST_CASE("ComponentsLargeDatabase") {
+  const AirportDatabase airport_database =
+      AirportDatabase("data_airports.txt", "data_flights.txt");
+  const AirportNetwork airport_network = AirportNetwork(airport_database);
+  const std::vector<int> distances = airport_network.least_distance("LAX");
+
+  SUBCASE("ComponentsMatchReachability") {
+    int mismatches = 0;
+    for (int i = 0; i < airport_network.num_airports(); ++i) {
+      const bool reachable = distances[i] != std::numeric_limits<int>::max();
+      mismatches += reachable != airport_network.same_component(
+          "LAX", airport_database.code(i));
+    }
+    CHECK_EQ(mismatches, 0);
+  }
+
+  SUBCASE("PointToPointMatchesLeastDistance") {
+    CHECK_EQ(airport_network.least_distance("LAX", "DEC"), 1696);
+    int mismatches = 0;
+    for (int i = 0; i < airport_network.num_airports(); i += 37) {
+      mismatches += distances[i] != airport_network.least_distance(
+          "LAX", airport_database.code(i));
+    }
+    CHECK_EQ(mismatches, 0);
+  }
+}
+
+TEST_CASE("NearbyAirportsSmallDatabase") {
+  const AirportDatabase airport_database =
+      AirportDatabase("small_data_airports.txt", "small_data_flights.txt");
+  const AirportNetwork airport_network = AirportNetwork(airport_database);
+
+  SUBCASE("BadArgumentsThrowException") {
+    CHECK_THROWS_AS(
+        airport_network.nearest_airports(0.0, 0.0, -1), std::invalid_argument);
+    CHECK_THROWS_AS(
+        airport_network.airports_within(0.0, 0.0, -1), std::invalid_argument);
+    CHECK_THROWS_AS(
+        airport_network.nearest_airport_with_route_to(0.0, 0.0, "ACO"),
+        std::invalid_argument);
+  }
+
+  SUBCASE("NearestAirports") {
+    CHECK_EQ(
+        airport_network.nearest_airports(41.9, -88.0, 2),
+        std::vector<std::string>({"ORD", "DEC"}));
+    CHECK_EQ(airport_network.nearest_airports(41.9, -88.0, 100).size(), 9);
+  }
+
+  SUBCASE("AirportsWithin") {
+    CHECK_EQ(
+        airport_network.airports_within(41.9786, -87.9048, 100),
+        std::vector<std::string>({"ORD"}));
+    CHECK_EQ(
+        airport_network.airports_within(41.9786, -87.9048, 200),
+        std::vector<std::string>({"ORD", "DEC"}));
+  }
+
+  SUBCASE("NearestAirportWithRouteTo") {
+    CHECK_EQ(
+        airport_network.nearest_airport_with_route_to(39.8, -88.9, "ORD"),
+        "DEC");
+    CHECK_EQ(
+        airport_network.nearest_airport_with_route_to(42.7, 2.9, "KZN"),
+        "AER");
+    CHECK_EQ(
+        airport_network.nearest_airport_with_route_to(42.7, 2.9, "PGF"), "");
+  }
+}
+
+TEST_CASE("VertexOrdersPreserveAnswers") {
+  const AirportDatabase airport_database =
+      AirportDatabase("data_airports.txt", "data_flights.txt");
+  const AirportNetwork input_network = AirportNetwork(airport_database);
+  const std::vector<int> expected = input_network.least_distance("LAX");
+
+  SUBCASE("ReorderedRejectsNonPermutations") {
+    CHECK_THROWS_AS(airport_database.reordered({0}), std::invalid_argument);
+  }
+
+  for (const VertexOrder order :
+       {VertexOrder::kBreadthFirst, VertexOrder::kHubFirst,
+        VertexOrder::kHilbert}) {
+    const AirportNetwork airport_network =
+        AirportNetwork(airport_database, order);
+    const AirportDatabase& reordered = airport_network.airport_database();
+    CHECK_EQ(reordered.size(), airport_database.size());
+    CHECK_EQ(
+        airport_network.num_flight_routes(),
+        input_network.num_flight_routes());
+    CHECK_EQ(airport_network.least_distance("LAX", "DEC"), 1696);
+    CHECK_EQ(
+        airport_network.at_most_one_layover("LAX").size(),
+        input_network.at_most_one_layover("LAX").size());
+
+    const std::vector<int> distances = airport_network.least_distance("LAX");
+    int mismatches = 0;
+    for (int i = 0; i < airport_database.size(); ++i) {
+      mismatches +=
+          distances[reordered.index(airport_database.code(i))] != expected[i];
+    }
+    CHECK_EQ(mismatches, 0);
+  }
+}
+
+TEST_CASE("LeastDistanceWithinLayoversSmallDatabase") {
+  const AirportDatabase airport_database =
+      AirportDatabase("small_data_airports.txt", "small_data_flights.txt");
+  const AirportNetwork airport_network = AirportNetwork(airport_database);
+
+  SUBCASE("BadArgumentsThrowException") {
+    CHECK_THROWS_AS(
+        airport_network.least_distance_within_layovers("ACO", 1),
+        std::invalid_argument);
+    CHECK_THROWS_AS(
+        airport_network.least_distance_within_layovers("LAX", -1),
+        std::invalid_argument);
+  }
+
+  SUBCASE("DirectFlightsOnly") {
+    const std::vector<int> distances =
+        airport_network.least_distance_within_layovers("LAX", 0);
+    CHECK_EQ(distances[airport_database.index("LAX")], 0);
+    CHECK_EQ(distances[airport_database.index("ORD")], 1739);
+    CHECK_EQ(
+        distances[airport_database.index("DEC")],
+        std::numeric_limits<int>::max());
+  }
+
+  SUBCASE("OneLayover") {
+    const std::vector<int> distances =
+        airport_network.least_distance_within_layovers("LAX", 1);
+    CHECK_EQ(distances[airport_database.index("DEC")], 1895);
+  }
+
+  SUBCASE("ManyLayoversMatchesLeastDistance") {
+    CHECK_EQ(
+        airport_network.least_distance_within_layovers("LAX", 8),
+        airport_network.least_distance("LAX"));
+  }
+}
+
+TEST_CASE("LeastDistanceWithinLayoversLargeDatabase") {
+  const AirportDatabase airport_database =
+      AirportDatabase("data_airports.txt", "data_flights.txt");
+  const AirportNetwork airport_network = AirportNetwork(airport_database);
+
+  const std::vector<int> one_layover =
+      airport_network.least_distance_within_layovers("LAX", 1);
+  const std::vector<int> two_layovers =
+      airport_network.least_distance_within_layovers("LAX", 2);
+  const std::vector<int> unlimited = airport_network.least_distance("LAX");
+  for (int i = 0; i < unlimited.size(); ++i) {
+    CHECK_LE(unlimited[i], two_layovers[i]);
+    CHECK_LE(two_layovers[i], one_layover[i]);
+  }
+  CHECK_EQ(one_layover[airport_database.index("ORD")], 1739);
+  CHECK_EQ(two_layovers[airport_database.index("DEC")], 1696);
+}
+
+TEST_CASE("LayoverDistanceTableLargeDatabase") {
+  const AirportDatabase airport_database =
+      AirportDatabase("data_airports.txt", "data_flights.txt");
+  const AirportNetwork airport_network = AirportNetwork(airport_database);
+
+  SUBCASE("BadArgumentsThrowException") {
+    CHECK_THROWS_AS(
+        airport_network.layover_distance_table({"LAX", "ACO"}, 1),
+        std::invalid_argument);
+    CHECK_THROWS_AS(
+        airport_network.layover_distance_table({"LAX"}, -1),
+        std::invalid_argument);
+  }
+
+  SUBCASE("ColumnsMatchLeastDistanceWithinLayovers") {
+    const std::vector<std::string> codes = {"LAX", "ORD", "DEC"};
+    const DistanceTable table =
+        airport_network.layover_distance_table(codes, 2);
+    CHECK_EQ(table.rows(), airport_network.num_airports());
+    for (int c = 0; c < codes.size(); ++c) {
+      CHECK_EQ(
+          table.row_vector(airport_database.index(codes[c]))[c], 0);
+      const std::vector<int> expected =
+          airport_network.least_distance_within_layovers(codes[c], 2);
+      for (int i = 0; i < table.rows(); i += 13) {
+        CHECK_EQ(table.at(i, c), expected[i]);
+      }
+    }
+    CHECK_EQ(table.at(airport_database.index("LAX"), 2), 1696);
+  }
+}
+
+TEST_CASE("LeastDistanceTable") {
+  SUBCASE("SmallDatabase") {
+    const AirportDatabase airport_database =
+        AirportDatabase("small_data_airports.txt", "small_data_flights.txt");
+    const AirportNetwork airport_network = AirportNetwork(airport_database);
+    CHECK_THROWS_AS(
+        airport_network.least_distance_table({"LAX"}, {"ACO"}),
+        std::invalid_argument);
+    const DistanceTable table = airport_network.least_distance_table(
+        {"LAX", "PGF"}, {"DEC", "ORD", "PGF"});
+    CHECK_EQ(table.at(0, 0), 1895);
+    CHECK_EQ(table.at(0, 1), 1739);
+    CHECK_EQ(table.at(0, 2), std::numeric_limits<int>::max());
+    CHECK_EQ(table.at(1, 0), std::numeric_limits<int>::max());
+    CHECK_EQ(table.at(1, 2), 0);
+  }
+
+  SUBCASE("LargeDatabaseMatchesLeastDistance") {
+    const AirportDatabase airport_database =
+        AirportDatabase("data_airports.txt", "data_flights.txt");
+    const AirportNetwork airport_network = AirportNetwork(airport_database);
+    std::vector<std::string> from_codes({"LAX", "JFK", "PGF", "SYD"});
+    std::vector<std::string> to_codes({"DEC", "LHR", "LAX", "PGF"});
+    for (int i = 0; i < airport_database.size(); i += 211) {
+      from_codes.push_back(airport_database.code(i));
+      to_codes.push_back(
+          airport_database.code(airport_database.size() - 1 - i));
+    }
+    const DistanceTable table =
+        airport_network.least_distance_table(from_codes, to_codes);
+    CHECK_EQ(table.at(0, 0), 1696);
+    int mismatches = 0;
+    for (int r = 0; r < from_codes.size(); ++r) {
+      const std::vector<int> distances =
+          airport_network.least_distance(from_codes[r]);
+      for (int c = 0; c < to_codes.size(); ++c) {
+        mismatches +=
+            table.at(r, c) != distances[airport_database.index(to_codes[c])];
+      }
+    }
+    CHECK_EQ(mismatches, 0);
+  }
+}
+
+TEST_CASE("AllPairsLeastDistanceSmallDatabase") {
+  const AirportDatabase airport_database =
+      AirportDatabase("small_data_airports.txt", "small_data_flights.txt");
+  const AirportNetwork airport_network = AirportNetwork(airport_database);
+
+  SUBCASE("BadCodeThrowsException") {
+    CHECK_THROWS_AS(
+        airport_network.all_pairs_least_distance({"LAX", "ACO"}),
+        std::invalid_argument);
+  }
+
+  SUBCASE("MatchesLeastDistance") {
+    const std::vector<std::string> codes = airport_database.codes();
+    const DistanceTable table =
+        airport_network.all_pairs_least_distance(codes);
+    for (int a = 0; a < codes.size(); ++a) {
+      const std::vector<int> distances =
+          airport_network.least_distance(codes[a]);
+      for (int b = 0; b < codes.size(); ++b) {
+        CHECK_EQ(table.at(a, b), distances[airport_database.index(codes[b])]);
+      }
+    }
+  }
+
+  SUBCASE("OnlyUsesRoutesBetweenTheAirports") {
+    const DistanceTable table =
+        airport_network.all_pairs_least_distance({"LAX", "ORD", "DEC"});
+    CHECK_EQ(table.at(0, 2), 1895);
+    const DistanceTable without_ord =
+        airport_network.all_pairs_least_distance({"LAX", "DEC"});
+    CHECK_EQ(without_ord.at(0, 1), std::numeric_limits<int>::max());
+  }
+}
+
+TEST_CASE("RouteUpdatesSmallDatabase") {
+  const AirportDatabase airport_database =
+      AirportDatabase("small_data_airports.txt", "small_data_flights.txt");
+  AirportNetwork airport_network = AirportNetwork(airport_database);
+  const std::vector<std::string> codes = airport_database.codes();
+  constexpr int kNoPath = std::numeric_limits<int>::max();
+
+  // Counts the pairs of airports on which the repaired answers disagree with
+  // all_pairs_least_distance (which searches the updated routes afresh) or
+  // with the components.
+  const auto count_mismatches = [&]() {
+    const DistanceTable table =
+        airport_network.all_pairs_least_distance(codes);
+    int mismatches = 0;
+    for (int a = 0; a < codes.size(); ++a) {
+      const std::vector<int> distances =
+          airport_network.least_distance(codes[a]);
+      for (int b = 0; b < codes.size(); ++b) {
+        const int expected = table.at(a, b);
+        mismatches +=
+            distances[airport_database.index(codes[b])] != expected;
+        mismatches +=
+            airport_network.least_distance(codes[a], codes[b]) != expected;
+        mismatches += airport_network.same_component(codes[a], codes[b]) !=
+                      (expected != kNoPath);
+      }
+    }
+    return mismatches;
+  };
+
+  SUBCASE("BadUpdatesThrowException") {
+    CHECK_THROWS_AS(
+        airport_network.add_route("LAX", "ACO"), std::invalid_argument);
+    CHECK_THROWS_AS(
+        airport_network.add_route("LAX", "LAX"), std::invalid_argument);
+    CHECK_THROWS_AS(
+        airport_network.add_route("LAX", "ORD"), std::invalid_argument);
+    CHECK_THROWS_AS(
+        airport_network.remove_route("LAX", "DEC"), std::invalid_argument);
+    CHECK_THROWS_AS(
+        airport_network.set_route_distance("LAX", "DEC", 100),
+        std::invalid_argument);
+    CHECK_THROWS_AS(
+        airport_network.set_route_distance("LAX", "ORD", 0),
+        std::invalid_argument);
+    CHECK_EQ(airport_network.num_flight_routes(), 7);
+  }
+
+  SUBCASE("RemoveRouteSplitsComponent") {
+    // Fill the cache of shortest path trees first, so that they are repaired.
+    CHECK_EQ(count_mismatches(), 0);
+    airport_network.remove_route("ORD", "LAX");
+    CHECK_EQ(airport_network.num_flight_routes(), 6);
+    CHECK_EQ(airport_network.num_components(), 3);
+    CHECK_FALSE(airport_network.same_component("LAX", "DEC"));
+    CHECK(airport_network.same_component("ORD", "DEC"));
+    CHECK_EQ(airport_network.least_distance("LAX", "DEC"), kNoPath);
+    CHECK_EQ(count_mismatches(), 0);
+  }
+
+  SUBCASE("AddRouteJoinsComponents") {
+    CHECK_EQ(count_mismatches(), 0);
+    airport_network.add_route("PGF", "DEC");
+    CHECK_EQ(airport_network.num_flight_routes(), 8);
+    CHECK_EQ(airport_network.num_components(), 1);
+    CHECK_EQ(
+        airport_network.least_distance("LAX", "PGF"),
+        1895 + airport_database.airport("PGF").distance_miles(
+                   airport_database.airport("DEC")));
+    CHECK_EQ(count_mismatches(), 0);
+  }
+
+  SUBCASE("SetRouteDistance") {
+    CHECK_EQ(count_mismatches(), 0);
+    airport_network.set_route_distance("LAX", "ORD", 100);
+    CHECK_EQ(airport_network.least_distance("LAX", "DEC"), 256);
+    CHECK_EQ(count_mismatches(), 0);
+    airport_network.set_route_distance("LAX", "ORD", 5000);
+    CHECK_EQ(airport_network.least_distance("LAX", "DEC"), 5156);
+    CHECK_EQ(count_mismatches(), 0);
+  }
+
+  SUBCASE("UpdatesBeforeTheOracleIsBuilt") {
+    // No query has needed the distance oracle yet, so the updates leave it
+    // unbuilt, and it is built from the updated routes. The copy shares the
+    // unbuilt oracle until the update, and then builds its own.
+    airport_network.set_route_distance("LAX", "ORD", 100);
+    const AirportNetwork copy = airport_network;
+    airport_network.add_route("PGF", "DEC");
+    CHECK_EQ(copy.least_distance("LAX", "DEC"), 256);
+    CHECK_EQ(copy.least_distance("LAX", "PGF"), kNoPath);
+    CHECK_EQ(count_mismatches(), 0);
+  }
+
+  SUBCASE("CopiesRepairTheirOwnOracle") {
+    CHECK_EQ(count_mismatches(), 0);
+    AirportNetwork copy = airport_network;
+    copy.remove_route("ORD", "LAX");
+    CHECK_EQ(copy.least_distance("LAX", "DEC"), kNoPath);
+    CHECK_EQ(airport_network.least_distance("LAX", "DEC"), 1895);
+  }
+
+  SUBCASE("ManyUpdates") {
+    CHECK_EQ(count_mismatches(), 0);
+    airport_network.add_route("KZN", "ORD");
+    airport_network.add_route("MRV", "AER");
+    airport_network.remove_route("KZN", "LAX");
+    airport_network.set_route_distance("MRV", "AER", 50);
+    airport_network.remove_route("ASF", "KZN");
+    airport_network.add_route("PGF", "CEK");
+    airport_network.remove_route("KZN", "ORD");
+    CHECK_EQ(airport_network.num_flight_routes(), 7);
+    CHECK_EQ(count_mismatches(), 0);
+  }
+}
+
+TEST_CASE("RouteUpdatesLargeDatabase") {
+  const AirportDatabase airport_database =
+      AirportDatabase("data_airports.txt", "data_flights.txt");
+  AirportNetwork airport_network = AirportNetwork(airport_database);
+  const std::vector<std::string> codes = airport_database.codes();
+
+  // The repaired shortest path tree from LAX must agree with the distance
+  // oracle and the components after every update.
+  airport_network.least_distance("LAX");
+  const auto count_mismatches = [&]() {
+    const std::vector<int> distances = airport_network.least_distance("LAX");
+    const std::vector<int> expected =
+        airport_network.least_distances("LAX", codes);
+    int mismatches = 0;
+    for (int c = 0; c < codes.size(); ++c) {
+      mismatches += distances[airport_database.index(codes[c])] != expected[c];
+      mismatches += airport_network.same_component("LAX", codes[c]) !=
+                    (expected[c] != std::numeric_limits<int>::max());
+    }
+    return mismatches;
+  };
+
+  const int components = airport_network.num_components();
+  airport_network.remove_route("LAX", "ORD");
+  CHECK_EQ(count_mismatches(), 0);
+  airport_network.set_route_distance("LAX", "JFK", 100);
+  CHECK_EQ(count_mismatches(), 0);
+  airport_network.add_route("LAX", "AAA");
+  CHECK_EQ(airport_network.num_components(), components - 1);
+  CHECK_EQ(count_mismatches(), 0);
+  airport_network.remove_route("LAX", "AAA");
+  CHECK_EQ(airport_network.num_components(), components);
+  CHECK_EQ(count_mismatches(), 0);
+}
+
+TEST_CASE("ConcurrentQueries") {
+  const AirportDatabase airport_database =
+      AirportDatabase("data_airports.txt", "data_flights.txt");
+  const AirportNetwork airport_network = AirportNetwork(airport_database);
+
+  // More airports than the tree cache holds (64 trees), so that the threads
+  // also evict each other's trees.
+  std::vector<std::string> codes;
+  for (int i = 0; i < airport_database.size(); i += 97) {
+    codes.push_back(airport_database.code(i));
+  }
+  REQUIRE_GT(codes.size(), 64);
+
+  // The answers of a separate network queried from this thread alone.
+  const AirportNetwork oracle = AirportNetwork(airport_database);
+  std::vector<std::vector<int>> distances;
+  std::vector<std::vector<std::string>> layovers;
+  for (const std::string& code : codes) {
+    distances.push_back(oracle.least_distance(code));
+    layovers.push_back(oracle.at_most_one_layover(code));
+  }
+
+  const int kThreads = 4;
+  std::atomic<int> mismatches(0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      // Each thread visits the airports twice, in its own order.
+      for (int k = 0; k < 2 * codes.size(); ++k) {
+        const int c = (k * (2 * t + 1) + 11 * t) % codes.size();
+        mismatches += airport_network.least_distance(codes[c]) != distances[c];
+        // The first of these builds the distance oracle, while the other
+        // threads wait for it.
+        mismatches += airport_network.least_distance(codes[0], codes[c]) !=
+                      distances[0][airport_database.index(codes[c])];
+        mismatches +=
+            airport_network.at_most_one_layover(codes[c]) != layovers[c];
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  CHECK_EQ(mismatches.load(), 0);
+}
+
+TEST_CASE("CancelledQueries") {
+  const AirportDatabase airport_database =
+      AirportDatabase("data_airports.txt", "data_flights.txt");
+  const AirportNetwork airport_network = AirportNetwork(airport_database);
+  CancellationSource source;
+  const CancellationToken live = source.token();
+  source.cancel();
+  const CancellationToken cancelled = source.token();
+
+  SUBCASE("SearchesStopWithException") {
+    CHECK_THROWS_AS(
+        airport_network.least_distance("LAX", cancelled), OperationCancelled);
+    CHECK_THROWS_AS(
+        airport_network.at_most_one_layover("LAX", cancelled),
+        OperationCancelled);
+    CHECK_THROWS_AS(
+        airport_network.reachable_within("LAX", 100000, cancelled),
+        OperationCancelled);
+    CHECK_THROWS_AS(
+        airport_network.least_distance_within_layovers("LAX", 2, cancelled),
+        OperationCancelled);
+    // Tokens handed out before the cancellation are cancelled too.
+    CHECK_THROWS_AS(
+        airport_network.least_distance("ORD", live), OperationCancelled);
+  }
+
+  SUBCASE("BadArgumentsStillThrowInvalidArgument") {
+    CHECK_THROWS_AS(
+        airport_network.least_distance("ACO", cancelled),
+        std::invalid_argument);
+    CHECK_THROWS_AS(
+        airport_network.least_distance_within_layovers("LAX", -1, cancelled),
+        std::invalid_argument);
+  }
+
+  SUBCASE("CancelledSearchesLeaveNoTrace") {
+    CHECK_THROWS_AS(
+        airport_network.least_distance("LAX", cancelled), OperationCancelled);
+    CHECK_THROWS_AS(
+        airport_network.reachable_within("LAX", 100000, cancelled),
+        OperationCancelled);
+    // The unfinished tree was not cached, and the workspace is reusable.
+    const AirportNetwork oracle = AirportNetwork(airport_database);
+    CHECK_EQ(
+        airport_network.least_distance("LAX"), oracle.least_distance("LAX"));
+    CHECK_EQ(
+        airport_network.reachable_within("LAX", 1000),
+        oracle.reachable_within("LAX", 1000));
+  }
+}
+
 #endif
\ No newline at end of file
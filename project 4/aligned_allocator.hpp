@@ -0,0 +1,54 @@
+#ifndef _aligned_allocator_hpp_
+#define _aligned_allocator_hpp_
+
+#include <cstddef>
+#include <new>
+
+// The AlignedAllocator class is an allocator whose allocations start on an
+// `Alignment`-byte boundary, for use with containers whose data is processed
+// with (aligned) SIMD loads.
+//
+// The default alignment of 64 bytes is a cache line, which is also the width
+// of an AVX-512 register.
+template <class T, std::size_t Alignment = 64>
+class AlignedAllocator {
+ public:
+  using value_type = T;
+
+  // Allows containers to rebind the allocator to their node types.
+  template <class U>
+  struct rebind {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  // The default constructor.
+  AlignedAllocator() noexcept = default;
+
+  // The converting constructor, used when the allocator is rebound.
+  template <class U>
+  AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+  // Allocates uninitialized storage for count-many objects of type T.
+  T* allocate(const std::size_t count) {
+    return static_cast<T*>(::operator new(
+        count * sizeof(T), std::align_val_t(Alignment)));
+  }
+
+  // Deallocates storage obtained from allocate.
+  void deallocate(T* pointer, const std::size_t) noexcept {
+    ::operator delete(pointer, std::align_val_t(Alignment));
+  }
+
+  // All AlignedAllocators with the same alignment are interchangeable.
+  template <class U>
+  bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept {
+    return true;
+  }
+
+  template <class U>
+  bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept {
+    return false;
+  }
+};
+
+#endif
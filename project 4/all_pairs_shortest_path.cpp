@@ -0,0 +1,182 @@
+#include "all_pairs_shortest_path.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "aligned_allocator.hpp"
+#include "bounds_check.hpp"
+#include "distance_table.hpp"
+#include "parallel_for.hpp"
+
+namespace {
+
+// The side length of the square tiles the matrix is processed in.
+constexpr int kTile = 64;
+
+// The internal representation of "no path". Any two path lengths below it can
+// be added without overflowing an int.
+constexpr int kInfinity = std::numeric_limits<int>::max() / 2;
+
+// Performs c[j] = min(c[j], a + b[j]) for 0 <= j < kTile.
+//
+// ASSUMES: c and b are 64-byte aligned and a < kInfinity.
+inline void relax_tile_row(int* c, const int a, const int* b) {
+#if defined(__AVX512F__)
+  const __m512i broadcast = _mm512_set1_epi32(a);
+  for (int j = 0; j < kTile; j += 16) {
+    const __m512i through =
+        _mm512_add_epi32(broadcast, _mm512_load_si512(b + j));
+    _mm512_store_si512(
+        c + j, _mm512_min_epi32(_mm512_load_si512(c + j), through));
+  }
+#elif defined(__AVX2__)
+  const __m256i broadcast = _mm256_set1_epi32(a);
+  for (int j = 0; j < kTile; j += 8) {
+    __m256i* target = reinterpret_cast<__m256i*>(c + j);
+    const __m256i through = _mm256_add_epi32(
+        broadcast, _mm256_load_si256(reinterpret_cast<const __m256i*>(b + j)));
+    _mm256_store_si256(
+        target, _mm256_min_epi32(_mm256_load_si256(target), through));
+  }
+#else
+  for (int j = 0; j < kTile; ++j) {
+    c[j] = std::min(c[j], a + b[j]);
+  }
+#endif
+}
+
+// Relaxes the tile c through the tiles a and b: for every k, i and j of the
+// tile, c[i][j] = min(c[i][j], a[i][k] + b[k][j]). The tiles are rows of a
+// matrix with `stride` ints between rows, and may alias each other (as they
+// do in the first two phases), which is safe because the Floyd-Warshall
+// update never changes row k or column k during iteration k.
+void relax_tile(int* c, const int* a, const int* b, const int stride) {
+  for (int k = 0; k < kTile; ++k) {
+    const int* b_row = b + static_cast<long>(k) * stride;
+    for (int i = 0; i < kTile; ++i) {
+      const int a_ik = a[static_cast<long>(i) * stride + k];
+      if (a_ik < kInfinity) {
+        relax_tile_row(c + static_cast<long>(i) * stride, a_ik, b_row);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+void floyd_warshall(DistanceTable& table) {
+  if (table.rows() != table.cols()) {
+    throw std::invalid_argument("table is not square");
+  }
+  const int n = table.rows();
+  const int tiles = (n + kTile - 1) / kTile;
+  const int stride = tiles * kTile;
+
+  // Copy the table into a matrix padded to whole tiles. The padding vertices
+  // have no edges, so they do not change any path lengths.
+  std::vector<int, AlignedAllocator<int>> matrix(
+      static_cast<long>(stride) * stride, kInfinity);
+  const auto entry = [&](const int i, const int j) -> int& {
+    return matrix[static_cast<long>(i) * stride + j];
+  };
+  const auto tile = [&](const int ti, const int tj) {
+    return &entry(ti * kTile, tj * kTile);
+  };
+  for (int i = 0; i < n; ++i) {
+    const int* row = table.row(i);
+    for (int j = 0; j < n; ++j) {
+      entry(i, j) = row[j] < kInfinity ? row[j] : kInfinity;
+    }
+    entry(i, i) = 0;
+  }
+
+  for (int tk = 0; tk < tiles; ++tk) {
+    int* diagonal = tile(tk, tk);
+
+    // Phase one: the diagonal tile depends only on itself.
+    relax_tile(diagonal, diagonal, diagonal, stride);
+
+    // Phase two: the tiles in row tk and column tk depend on themselves and
+    // the diagonal tile. Tile t < tiles is (tk, t) and tile t >= tiles is
+    // (t - tiles, tk).
+    parallel_for(2 * tiles, [&](const int begin, const int end) {
+      for (int t = begin; t < end; ++t) {
+        if (t < tiles && t != tk) {
+          int* c = tile(tk, t);
+          relax_tile(c, diagonal, c, stride);
+        } else if (t >= tiles && t - tiles != tk) {
+          int* c = tile(t - tiles, tk);
+          relax_tile(c, c, diagonal, stride);
+        }
+      }
+    });
+
+    // Phase three: every other tile depends on the tiles in its row and column
+    // computed in phase two. Each thread owns whole rows of tiles.
+    parallel_for(tiles, [&](const int begin, const int end) {
+      for (int ti = begin; ti < end; ++ti) {
+        if (ti == tk) {
+          continue;
+        }
+        for (int tj = 0; tj < tiles; ++tj) {
+          if (tj != tk) {
+            relax_tile(tile(ti, tj), tile(ti, tk), tile(tk, tj), stride);
+          }
+        }
+      }
+    });
+  }
+
+  for (int i = 0; i < n; ++i) {
+    int* row = table.row(i);
+    for (int j = 0; j < n; ++j) {
+      row[j] = entry(i, j) < kInfinity ? entry(i, j)
+                                       : std::numeric_limits<int>::max();
+    }
+  }
+}
+
+template <class Graph>
+DistanceTable all_pairs_shortest_path(const Graph& graph) {
+  const int n = graph.vertex_count();
+  DistanceTable table(n, n, std::numeric_limits<int>::max());
+  // Use out_edges rather than edges, as edges reports each edge of an
+  // undirected graph only once. Every vertex passed is valid, so the graph is
+  // read through its unchecked accessors.
+  const UncheckedView<Graph> view(graph);
+  for (int i = 0; i < n; ++i) {
+    int* row = table.row(i);
+    for (const int j : view.out_edges(i)) {
+      row[j] = view.edge_weight(i, j);
+    }
+  }
+  floyd_warshall(table);
+  return table;
+}
+
+// Since the implementation of all_pairs_shortest_path is in the cpp file, we
+// need to tell the compiler which template instantiations to make.
+//
+// For more information, see
+// https://isocpp.org/wiki/faq/templates#templates-defn-vs-decl.
+template DistanceTable all_pairs_shortest_path<AdjacencyListGraph>(
+    const AdjacencyListGraph& graph);
+template DistanceTable all_pairs_shortest_path<AdjacencyMatrixGraph>(
+    const AdjacencyMatrixGraph& graph);
+template DistanceTable all_pairs_shortest_path<BitMatrixGraph>(
+    const BitMatrixGraph& graph);
+template DistanceTable
+all_pairs_shortest_path<UndirectedGraph<AdjacencyListGraph>>(
+    const UndirectedGraph<AdjacencyListGraph>& graph);
+template DistanceTable
+all_pairs_shortest_path<UndirectedGraph<AdjacencyMatrixGraph>>(
+    const UndirectedGraph<AdjacencyMatrixGraph>& graph);
+template DistanceTable
+all_pairs_shortest_path<UndirectedGraph<BitMatrixGraph>>(
+    const UndirectedGraph<BitMatrixGraph>& graph);
@@ -0,0 +1,46 @@
+#ifndef _all_pairs_shortest_path_hpp_
+#define _all_pairs_shortest_path_hpp_
+
+#include "adjacency_list_graph.hpp"
+#include "adjacency_matrix_graph.hpp"
+#include "bit_matrix_graph.hpp"
+#include "distance_table.hpp"
+#include "undirected_graph.hpp"
+
+// Replaces the n by n table of edge weights `table` with the table of shortest
+// path lengths, using the Floyd-Warshall algorithm.
+//
+// On input, table.at(i, j) is the weight of the edge from vertex i to vertex j
+// (std::numeric_limits<int>::max() if there is no edge). On output,
+// table.at(i, j) is the length of the shortest path from vertex i to vertex j
+// (std::numeric_limits<int>::max() if no path exists). The diagonal is set to
+// zero.
+//
+// The matrix is processed in 64 by 64 tiles (16 KB each, so that the three
+// tiles used by an update stay in the L1/L2 cache) in the three phases of the
+// blocked algorithm: the diagonal tile, then the tiles in its row and column,
+// then all remaining tiles. The tiles of the last two phases are updated in
+// parallel, and the min-plus kernel is vectorized with AVX-512 or AVX2 when
+// compiled for them.
+//
+// Throws a std::invalid_argument exception if the table is not square.
+//
+// ASSUMES: The edge weights are non-negative and every shortest path length is
+// less than std::numeric_limits<int>::max() / 2.
+void floyd_warshall(DistanceTable& table);
+
+// Returns the table of shortest path lengths between every pair of vertices in
+// the graph, computed with floyd_warshall.
+//
+// The entry in row i and column j is the length of the shortest path from
+// vertex i to vertex j (if a path exists) and std::numeric_limits<int>::max()
+// otherwise (if no path exists).
+//
+// This takes O(n^2) memory and O(n^3) time, so it is intended for graphs of at
+// most a few thousand vertices.
+//
+// ASSUMES: The same as floyd_warshall.
+template <class Graph>
+DistanceTable all_pairs_shortest_path(const Graph& graph);
+
+#endif
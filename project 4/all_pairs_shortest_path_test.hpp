@@ -0,0 +1,60 @@
+#ifndef _all_pairs_shortest_path_test_hpp_
+#define _all_pairs_shortest_path_test_hpp_
+
+#include "all_pairs_shortest_path.hpp"
+
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "adjacency_list_graph.hpp"
+#include "adjacency_matrix_graph.hpp"
+#include "bit_matrix_graph.hpp"
+#include "distance_table.hpp"
+#include "doctest.hpp"
+#include "graph_traversal.hpp"
+#include "test_random.hpp"
+#include "undirected_graph.hpp"
+
+TEST_CASE("FloydWarshall") {
+  SUBCASE("NonSquareTableThrowsException") {
+    DistanceTable table(2, 3, std::numeric_limits<int>::max());
+    CHECK_THROWS_AS(floyd_warshall(table), std::invalid_argument);
+  }
+
+  SUBCASE("EmptyTable") {
+    DistanceTable table(0, 0, 0);
+    floyd_warshall(table);
+    CHECK_EQ(table.rows(), 0);
+  }
+
+  SUBCASE("StraightPath") {
+    constexpr int kMax = std::numeric_limits<int>::max();
+    DistanceTable table(3, 3, kMax);
+    table.set(0, 1, 5);
+    table.set(1, 2, 7);
+    floyd_warshall(table);
+    CHECK_EQ(table.row_vector(0), std::vector<int>({0, 5, 12}));
+    CHECK_EQ(table.row_vector(1), std::vector<int>({kMax, 0, 7}));
+    CHECK_EQ(table.row_vector(2), std::vector<int>({kMax, kMax, 0}));
+  }
+}
+
+TEST_CASE_TEMPLATE(
+    "AllPairsShortestPathMatchesShortestPath", GraphT, AdjacencyListGraph,
+    BitMatrixGraph, UndirectedGraph<AdjacencyListGraph>,
+    UndirectedGraph<AdjacencyMatrixGraph>) {
+  // Spans several 64 by 64 tiles, with a partial last tile and a few
+  // unreachable vertices.
+  constexpr int kVertexCount = 150;
+  const GraphT graph = random_graph<GraphT>(kVertexCount, 500, 1000, 2022, 3);
+
+  const DistanceTable table = all_pairs_shortest_path(graph);
+  REQUIRE_EQ(table.rows(), kVertexCount);
+  REQUIRE_EQ(table.cols(), kVertexCount);
+  for (int start = 0; start < kVertexCount; ++start) {
+    CHECK_EQ(table.row_vector(start), shortest_path(graph, start));
+  }
+}
+
+#endif
@@ -0,0 +1,63 @@
+#include "async_airport_network.hpp"
+
+#if defined(__cpp_impl_coroutine)
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "airport_network.hpp"
+#include "cancellation_token.hpp"
+#include "compute_executor.hpp"
+
+AsyncAirportNetwork::AsyncAirportNetwork(
+    const AirportNetwork& network, ComputeExecutor& executor, Resumer resume)
+    : network_(network), executor_(executor), resume_(std::move(resume)) {}
+
+AsyncQuery<std::vector<std::string>> AsyncAirportNetwork::at_most_one_layover(
+    std::string code, CancellationToken cancellation) const {
+  return AsyncQuery<std::vector<std::string>>(
+      executor_, resume_,
+      [this, code = std::move(code), cancellation = std::move(cancellation)]() {
+        cancellation.throw_if_cancelled();
+        return network_.at_most_one_layover(code, cancellation);
+      });
+}
+
+AsyncQuery<std::vector<std::pair<std::string, int>>>
+AsyncAirportNetwork::reachable_within(
+    std::string code, const int miles, CancellationToken cancellation) const {
+  return AsyncQuery<std::vector<std::pair<std::string, int>>>(
+      executor_, resume_,
+      [this, code = std::move(code), miles,
+       cancellation = std::move(cancellation)]() {
+        cancellation.throw_if_cancelled();
+        return network_.reachable_within(code, miles, cancellation);
+      });
+}
+
+AsyncQuery<std::vector<int>> AsyncAirportNetwork::least_distance(
+    std::string code, CancellationToken cancellation) const {
+  return AsyncQuery<std::vector<int>>(
+      executor_, resume_,
+      [this, code = std::move(code), cancellation = std::move(cancellation)]() {
+        cancellation.throw_if_cancelled();
+        return network_.least_distance(code, cancellation);
+      });
+}
+
+AsyncQuery<std::vector<int>>
+AsyncAirportNetwork::least_distance_within_layovers(
+    std::string code, const int max_layovers,
+    CancellationToken cancellation) const {
+  return AsyncQuery<std::vector<int>>(
+      executor_, resume_,
+      [this, code = std::move(code), max_layovers,
+       cancellation = std::move(cancellation)]() {
+        cancellation.throw_if_cancelled();
+        return network_.least_distance_within_layovers(
+            code, max_layovers, cancellation);
+      });
+}
+
+#endif
@@ -0,0 +1,196 @@
+#ifndef _async_airport_network_hpp_
+#define _async_airport_network_hpp_
+
+// The awaitable queries need C++20 coroutines; compiled as an earlier
+// standard, this header declares nothing.
+#if defined(__cpp_impl_coroutine)
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "airport_network.hpp"
+#include "cancellation_token.hpp"
+#include "compute_executor.hpp"
+
+// The AsyncQuery class template is an awaitable computation of a T. Awaiting
+// it (with co_await) runs the computation on a ComputeExecutor, suspending the
+// awaiting coroutine until it is done, and then evaluates to the result, or
+// throws the exception the computation threw.
+//
+// The computation starts when the query is awaited rather than when it is
+// created, so a query that is never awaited costs nothing.
+template <class T>
+class AsyncQuery {
+ public:
+  // Resumes a coroutine whose computation is done (see AsyncAirportNetwork).
+  using Resumer = std::function<void(std::coroutine_handle<>)>;
+
+  //
+  // Constructors and Destructors
+  //
+
+  // The constructor. Runs `compute` on `executor` when awaited, then resumes
+  // the awaiting coroutine with `resume`, or, if resume is empty, directly on
+  // the thread of the executor that ran the computation.
+  //
+  // ASSUMES: executor and resume outlive the query.
+  AsyncQuery(
+      ComputeExecutor& executor, const Resumer& resume,
+      std::function<T()> compute)
+      : executor_(executor), resume_(resume), compute_(std::move(compute)) {}
+
+  // Queries cannot be copied, and can only be moved before they are awaited,
+  // as the executor refers to them while they are awaited.
+  AsyncQuery(const AsyncQuery& other) = delete;
+  AsyncQuery& operator=(const AsyncQuery& other) = delete;
+
+  // The move constructor.
+  //
+  // ASSUMES: `other` has not been awaited.
+  AsyncQuery(AsyncQuery&& other) = default;
+
+  // The destructor.
+  ~AsyncQuery() = default;
+
+  //
+  // Awaiting
+  //
+  // These are called by co_await, and not meant to be called directly.
+
+  // Returns false, as the computation has not run yet.
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  // Posts the computation, to resume `caller` once it is done.
+  //
+  // ASSUMES: caller is not destroyed while it is suspended (to abandon a
+  // query, cancel it instead).
+  void await_suspend(std::coroutine_handle<> caller) {
+    executor_.post([this, caller]() {
+      try {
+        result_.emplace(compute_());
+      } catch (...) {
+        error_ = std::current_exception();
+      }
+      // Once resumed, the coroutine may destroy the query at any time, so the
+      // query is not touched past this point.
+      const Resumer& resume = resume_;
+      if (resume) {
+        resume(caller);
+      } else {
+        caller.resume();
+      }
+    });
+  }
+
+  // Returns the result of the computation, or rethrows its exception.
+  T await_resume() {
+    if (error_ != nullptr) {
+      std::rethrow_exception(error_);
+    }
+    return std::move(*result_);
+  }
+
+ private:
+  // The executor running the computation.
+  ComputeExecutor& executor_;
+
+  // Resumes the awaiting coroutine, if not empty.
+  const Resumer& resume_;
+
+  // The computation.
+  std::function<T()> compute_;
+
+  // The result of the computation, once it has returned.
+  std::optional<T> result_;
+
+  // The exception thrown by the computation, if any.
+  std::exception_ptr error_;
+};
+
+// The AsyncAirportNetwork class offers awaitable versions of the queries of an
+// AirportNetwork that search the network, for services built on C++20
+// coroutines. Each query runs on a ComputeExecutor, so the thread of the
+// awaiting coroutine (say, an event loop) is not held up for the milliseconds
+// a search can take, and the coroutine is resumed once the answer is ready.
+//
+// Each query takes an optional CancellationToken. Cancelling it stops the
+// search at its next check (see cancellation_token.hpp), and a query
+// cancelled before its turn on the executor does not search at all; either
+// way the co_await throws an OperationCancelled exception, so abandoned
+// requests stop consuming CPU.
+//
+// The arguments of each query are copied into it, as the search runs after
+// the call returns. As the queries of an AirportNetwork are thread safe, any
+// number of them may run at once.
+class AsyncAirportNetwork {
+ public:
+  // Resumes a coroutine whose query is done, e.g., by posting it to the event
+  // loop it was suspended on.
+  using Resumer = std::function<void(std::coroutine_handle<>)>;
+
+  //
+  // Constructors and Destructors
+  //
+
+  // The constructor. Runs the queries on `network` with `executor`, and
+  // resumes the awaiting coroutines with `resume`, or, if resume is empty,
+  // directly on the threads of the executor.
+  //
+  // ASSUMES: network and executor outlive the AsyncAirportNetwork, and the
+  // network is not changed meanwhile.
+  AsyncAirportNetwork(
+      const AirportNetwork& network, ComputeExecutor& executor,
+      Resumer resume = Resumer());
+
+  // Copies are not allowed, as pending queries refer to the Resumer.
+  AsyncAirportNetwork(const AsyncAirportNetwork& other) = delete;
+  AsyncAirportNetwork& operator=(const AsyncAirportNetwork& other) = delete;
+
+  // The destructor.
+  //
+  // ASSUMES: No query is pending.
+  ~AsyncAirportNetwork() = default;
+
+  //
+  // Queries
+  //
+  // Each query evaluates to what the AirportNetwork method of the same name
+  // returns, and throws what it throws, when awaited.
+
+  AsyncQuery<std::vector<std::string>> at_most_one_layover(
+      std::string code,
+      CancellationToken cancellation = CancellationToken()) const;
+
+  AsyncQuery<std::vector<std::pair<std::string, int>>> reachable_within(
+      std::string code, const int miles,
+      CancellationToken cancellation = CancellationToken()) const;
+
+  AsyncQuery<std::vector<int>> least_distance(
+      std::string code,
+      CancellationToken cancellation = CancellationToken()) const;
+
+  AsyncQuery<std::vector<int>> least_distance_within_layovers(
+      std::string code, const int max_layovers,
+      CancellationToken cancellation = CancellationToken()) const;
+
+ private:
+  // The network queried.
+  const AirportNetwork& network_;
+
+  // The executor running the queries.
+  ComputeExecutor& executor_;
+
+  // Resumes the awaiting coroutines, if not empty.
+  const Resumer resume_;
+};
+
+#endif
+
+#endif
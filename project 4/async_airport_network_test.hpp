@@ -0,0 +1,196 @@
+#ifndef _async_airport_network_test_hpp_
+#define _async_airport_network_test_hpp_
+
+// Unit tests for the AsyncAirportNetwork class, which needs C++20 coroutines.
+#include "async_airport_network.hpp"
+
+#if defined(__cpp_impl_coroutine)
+
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "airport_database.hpp"
+#include "airport_network.hpp"
+#include "cancellation_token.hpp"
+#include "compute_executor.hpp"
+#include "doctest.hpp"
+
+// A coroutine that starts at once and is not awaited, so that a plain
+// function can start one and wait for its result through a std::future.
+struct StartedCoroutine {
+  struct promise_type {
+    StartedCoroutine get_return_object() noexcept {
+      return {};
+    }
+    std::suspend_never initial_suspend() noexcept {
+      return {};
+    }
+    std::suspend_never final_suspend() noexcept {
+      return {};
+    }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept {
+      std::terminate();
+    }
+  };
+};
+
+// Awaits `query` and fulfills `result` with its value or exception. If
+// resumed_on is not null, it receives the thread the coroutine was resumed on.
+template <class T>
+StartedCoroutine await_into(
+    AsyncQuery<T> query, std::promise<T>& result,
+    std::thread::id* resumed_on = nullptr) {
+  try {
+    T value = co_await query;
+    if (resumed_on != nullptr) {
+      *resumed_on = std::this_thread::get_id();
+    }
+    result.set_value(std::move(value));
+  } catch (...) {
+    result.set_exception(std::current_exception());
+  }
+}
+
+// Returns the value of `query`, awaited in a coroutine.
+template <class T>
+T await_query(AsyncQuery<T> query) {
+  std::promise<T> result;
+  std::future<T> future = result.get_future();
+  await_into(std::move(query), result);
+  return future.get();
+}
+
+TEST_CASE("AsyncAirportNetwork") {
+  const AirportDatabase airport_database =
+      AirportDatabase("data_airports.txt", "data_flights.txt");
+  const AirportNetwork airport_network = AirportNetwork(airport_database);
+  const AirportNetwork oracle = AirportNetwork(airport_database);
+  ComputeExecutor executor(2);
+
+  SUBCASE("QueriesMatchAirportNetwork") {
+    const AsyncAirportNetwork network(airport_network, executor);
+    CHECK_EQ(
+        await_query(network.least_distance("LAX")),
+        oracle.least_distance("LAX"));
+    CHECK_EQ(
+        await_query(network.at_most_one_layover("DEC")),
+        oracle.at_most_one_layover("DEC"));
+    CHECK_EQ(
+        await_query(network.reachable_within("ORD", 500)),
+        oracle.reachable_within("ORD", 500));
+    CHECK_EQ(
+        await_query(network.least_distance_within_layovers("LAX", 2)),
+        oracle.least_distance_within_layovers("LAX", 2));
+  }
+
+  SUBCASE("ExceptionsReachTheCaller") {
+    const AsyncAirportNetwork network(airport_network, executor);
+    CHECK_THROWS_AS(
+        await_query(network.least_distance("ACO")),
+        std::invalid_argument);
+    CHECK_THROWS_AS(
+        await_query(network.least_distance_within_layovers("LAX", -1)),
+        std::invalid_argument);
+  }
+
+  SUBCASE("CancelledQueriesThrowException") {
+    const AsyncAirportNetwork network(airport_network, executor);
+    CancellationSource source;
+    source.cancel();
+    CHECK_THROWS_AS(
+        await_query(network.least_distance("LAX", source.token())),
+        OperationCancelled);
+    CHECK_THROWS_AS(
+        await_query(
+            network.least_distance_within_layovers("LAX", 3, source.token())),
+        OperationCancelled);
+  }
+
+  SUBCASE("QueriesCancelledWhileQueuedDoNotRun") {
+    // One thread, kept busy until the queries are queued and cancelled.
+    ComputeExecutor busy_executor(1);
+    const AsyncAirportNetwork network(airport_network, busy_executor);
+    std::mutex mutex;
+    std::condition_variable released;
+    bool release = false;
+    busy_executor.post([&]() {
+      std::unique_lock<std::mutex> lock(mutex);
+      released.wait(lock, [&]() { return release; });
+    });
+
+    CancellationSource source;
+    std::vector<std::promise<std::vector<int>>> results(8);
+    std::vector<std::future<std::vector<int>>> futures;
+    for (std::promise<std::vector<int>>& result : results) {
+      futures.push_back(result.get_future());
+      await_into(network.least_distance("LAX", source.token()), result);
+    }
+    source.cancel();
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      release = true;
+    }
+    released.notify_all();
+    for (std::future<std::vector<int>>& future : futures) {
+      CHECK_THROWS_AS(future.get(), OperationCancelled);
+    }
+    // Later queries are answered as usual.
+    CHECK_EQ(
+        await_query(network.least_distance("LAX")),
+        oracle.least_distance("LAX"));
+  }
+
+  SUBCASE("CallersResumeThroughTheResumer") {
+    // A single-threaded event loop: the resumer queues the coroutines, and
+    // this thread resumes them.
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<std::coroutine_handle<>> loop;
+    const AsyncAirportNetwork network(
+        airport_network, executor, [&](std::coroutine_handle<> caller) {
+          std::lock_guard<std::mutex> lock(mutex);
+          loop.push_back(caller);
+          ready.notify_one();
+        });
+
+    const std::vector<std::string> codes = {"LAX", "ORD", "DEC", "JFK"};
+    std::vector<std::promise<std::vector<int>>> results(codes.size());
+    std::vector<std::future<std::vector<int>>> futures;
+    std::vector<std::thread::id> resumed_on(codes.size());
+    for (int c = 0; c < codes.size(); ++c) {
+      futures.push_back(results[c].get_future());
+      await_into(
+          network.least_distance_within_layovers(codes[c], 1), results[c],
+          &resumed_on[c]);
+    }
+    for (int resumed = 0; resumed < codes.size(); ++resumed) {
+      std::unique_lock<std::mutex> lock(mutex);
+      ready.wait(lock, [&]() { return !loop.empty(); });
+      const std::coroutine_handle<> caller = loop.front();
+      loop.pop_front();
+      lock.unlock();
+      caller.resume();
+    }
+    for (int c = 0; c < codes.size(); ++c) {
+      CHECK_EQ(
+          futures[c].get(),
+          oracle.least_distance_within_layovers(codes[c], 1));
+      CHECK_EQ(resumed_on[c], std::this_thread::get_id());
+    }
+  }
+}
+
+#endif
+
+#endif
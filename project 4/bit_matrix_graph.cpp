@@ -0,0 +1,319 @@
+#include "bit_matrix_graph.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "edge.hpp"
+
+namespace {
+
+// The number of 64-bit words in a 64-byte cache line.
+constexpr int kWordsPerLine = 8;
+
+// The smallest number of weight slots reserved for a row that has any.
+constexpr int kMinRowCapacity = 4;
+
+// Returns the number of words per bitmap row for a graph with vertex_count
+// vertices, rounded up to a whole number of cache lines.
+int words_per_row_for(const int vertex_count) {
+  const int words = (vertex_count + 63) / 64;
+  return (words + kWordsPerLine - 1) / kWordsPerLine * kWordsPerLine;
+}
+
+// Appends base + b to `out` for every set bit b of the words of a bitmap row,
+// where base is 64 times the index of the word.
+void append_set_bits(
+    const std::uint64_t* words, const int word_count, std::vector<int>& out) {
+  int w = 0;
+#ifdef __AVX2__
+  // Skip over runs of empty words four at a time; rows of sparse graphs are
+  // mostly zero.
+  for (; w + 4 <= word_count; w += 4) {
+    const __m256i block =
+        _mm256_load_si256(reinterpret_cast<const __m256i*>(words + w));
+    if (_mm256_testz_si256(block, block)) {
+      continue;
+    }
+    for (int k = w; k < w + 4; ++k) {
+      std::uint64_t bits = words[k];
+      while (bits != 0) {
+        out.push_back(64 * k + __builtin_ctzll(bits));
+        bits &= bits - 1;
+      }
+    }
+  }
+#endif
+  for (; w < word_count; ++w) {
+    std::uint64_t bits = words[w];
+    while (bits != 0) {
+      out.push_back(64 * w + __builtin_ctzll(bits));
+      bits &= bits - 1;
+    }
+  }
+}
+
+// Appends every i in [0, row_count) to `out` for which bit `bit` of
+// words[i * stride] is set, i.e., scans one column of a bitmap with `stride`
+// words per row.
+void append_set_rows(
+    const std::uint64_t* words, const long stride, const int row_count,
+    const int bit, std::vector<int>& out) {
+  const std::uint64_t mask = std::uint64_t(1) << bit;
+  int i = 0;
+#if defined(__AVX512F__)
+  // Gather the column word of eight rows at once, and test all eight bits.
+  const __m512i masks = _mm512_set1_epi64(mask);
+  const __m512i step = _mm512_set1_epi64(8 * stride);
+  __m512i indexes = _mm512_set_epi64(
+      7 * stride, 6 * stride, 5 * stride, 4 * stride, 3 * stride, 2 * stride,
+      stride, 0);
+  for (; i + 8 <= row_count; i += 8) {
+    const __m512i block = _mm512_mask_i64gather_epi64(
+        _mm512_setzero_si512(), 0xff, indexes, words, 8);
+    unsigned int hits = _mm512_test_epi64_mask(block, masks);
+    while (hits != 0) {
+      out.push_back(i + __builtin_ctz(hits));
+      hits &= hits - 1;
+    }
+    indexes = _mm512_add_epi64(indexes, step);
+  }
+#elif defined(__AVX2__)
+  // Gather the column word of four rows at once, and test all four bits.
+  const __m256i masks = _mm256_set1_epi64x(mask);
+  const __m256i step = _mm256_set1_epi64x(4 * stride);
+  __m256i indexes = _mm256_set_epi64x(3 * stride, 2 * stride, stride, 0);
+  for (; i + 4 <= row_count; i += 4) {
+    const __m256i block = _mm256_i64gather_epi64(
+        reinterpret_cast<const long long*>(words), indexes, 8);
+    const __m256i clear = _mm256_cmpeq_epi64(
+        _mm256_and_si256(block, masks), _mm256_setzero_si256());
+    unsigned int hits =
+        ~_mm256_movemask_pd(_mm256_castsi256_pd(clear)) & 0xf;
+    while (hits != 0) {
+      out.push_back(i + __builtin_ctz(hits));
+      hits &= hits - 1;
+    }
+    indexes = _mm256_add_epi64(indexes, step);
+  }
+#endif
+  for (; i < row_count; ++i) {
+    if (words[i * stride] & mask) {
+      out.push_back(i);
+    }
+  }
+}
+
+}  // namespace
+
+BitMatrixGraph::BitMatrixGraph(const int vertex_count)
+    : vertex_count_(vertex_count),
+      edge_count_(0),
+      words_per_row_(words_per_row_for(vertex_count)),
+      presence_(static_cast<long>(vertex_count) * words_per_row_, 0),
+      lines_per_row_(words_per_row_ / kWordsPerLine),
+      line_ranks_(static_cast<long>(vertex_count) * lines_per_row_, 0),
+      rows_(vertex_count, RowSpan{0, 0, 0}),
+      unused_slots_(0) {}
+
+//
+// Accessors
+//
+
+int BitMatrixGraph::vertex_count() const noexcept {
+  return vertex_count_;
+}
+
+int BitMatrixGraph::edge_count() const noexcept {
+  return edge_count_;
+}
+
+bool BitMatrixGraph::has_edge(const int i, const int j) const {
+  if (i < 0 || i >= vertex_count_) {
+    throw std::range_error("invalid i: " + std::to_string(i));
+  }
+  if (j < 0 || j >= vertex_count_) {
+    throw std::range_error("invalid j: " + std::to_string(j));
+  }
+  return has_edge_unchecked(i, j);
+}
+
+int BitMatrixGraph::edge_weight(const int i, const int j) const {
+  if (!has_edge(i, j)) {
+    throw std::invalid_argument("no edge from i to j");
+  }
+  return weights_[rows_[i].offset + rank(i, j)];
+}
+
+std::vector<int> BitMatrixGraph::out_edges(const int i) const {
+  if (i < 0 || i >= vertex_count_) {
+    throw std::range_error("invalid i: " + std::to_string(i));
+  }
+  return out_edges_unchecked(i);
+}
+
+bool BitMatrixGraph::has_edge_unchecked(const int i, const int j) const {
+  return (row(i)[j / 64] >> (j % 64)) & 1;
+}
+
+int BitMatrixGraph::edge_weight_unchecked(const int i, const int j) const {
+  if (!has_edge_unchecked(i, j)) {
+    throw std::invalid_argument("no edge from i to j");
+  }
+  return weights_[rows_[i].offset + rank(i, j)];
+}
+
+std::vector<int> BitMatrixGraph::out_edges_unchecked(const int i) const {
+  std::vector<int> outs;
+  outs.reserve(rows_[i].size);
+  append_set_bits(row(i), words_per_row_, outs);
+  return outs;
+}
+
+std::vector<int> BitMatrixGraph::in_edges(const int j) const {
+  if (j < 0 || j >= vertex_count_) {
+    throw std::range_error("invalid j: " + std::to_string(j));
+  }
+  std::vector<int> ins;
+  append_set_rows(
+      presence_.data() + j / 64, words_per_row_, vertex_count_, j % 64, ins);
+  return ins;
+}
+
+std::vector<Edge> BitMatrixGraph::edges() const noexcept {
+  std::vector<Edge> edges;
+  edges.reserve(edge_count_);
+  std::vector<int> outs;
+  for (int i = 0; i < vertex_count_; ++i) {
+    outs.clear();
+    append_set_bits(row(i), words_per_row_, outs);
+    for (int k = 0; k < outs.size(); ++k) {
+      edges.push_back(Edge(i, outs[k], weights_[rows_[i].offset + k]));
+    }
+  }
+  return edges;
+}
+
+long BitMatrixGraph::memory_bytes() const noexcept {
+  return presence_.capacity() * sizeof(std::uint64_t) +
+      line_ranks_.capacity() * sizeof(int) +
+      weights_.capacity() * sizeof(int) +
+      rows_.capacity() * sizeof(RowSpan);
+}
+
+//
+// Modifiers
+//
+
+void BitMatrixGraph::add_edge(const int i, const int j, const int edge_weight) {
+  if (edge_weight == 0) {
+    throw std::invalid_argument("edge weight cannot be zero");
+  }
+  const bool present = has_edge(i, j);
+  const int position = rank(i, j);
+  if (present) {
+    weights_[rows_[i].offset + position] = edge_weight;
+    return;
+  }
+  if (rows_[i].size == rows_[i].capacity) {
+    grow_row(i);
+  }
+  RowSpan& span = rows_[i];
+  const auto first = weights_.begin() + span.offset;
+  std::copy_backward(
+      first + position, first + span.size, first + span.size + 1);
+  first[position] = edge_weight;
+  span.size++;
+  presence_[static_cast<long>(i) * words_per_row_ + j / 64] |=
+      std::uint64_t(1) << (j % 64);
+  adjust_ranks(i, j, 1);
+  edge_count_++;
+}
+
+void BitMatrixGraph::remove_edge(const int i, const int j) {
+  if (!has_edge(i, j)) {
+    throw std::invalid_argument(
+        "no edge from i to j to remove: " +
+            std::to_string(i) + ", " + std::to_string(j));
+  }
+  RowSpan& span = rows_[i];
+  const auto first = weights_.begin() + span.offset;
+  std::copy(first + rank(i, j) + 1, first + span.size, first + rank(i, j));
+  span.size--;
+  presence_[static_cast<long>(i) * words_per_row_ + j / 64] &=
+      ~(std::uint64_t(1) << (j % 64));
+  adjust_ranks(i, j, -1);
+  edge_count_--;
+}
+
+//
+// Helpers
+//
+
+const std::uint64_t* BitMatrixGraph::row(const int i) const noexcept {
+  return presence_.data() + static_cast<long>(i) * words_per_row_;
+}
+
+int BitMatrixGraph::rank(const int i, const int j) const noexcept {
+  // Only the words of the cache line holding column j need counting.
+  const int line = j / 64 / kWordsPerLine;
+  const std::uint64_t* words = row(i);
+  int count = line_ranks_[static_cast<long>(i) * lines_per_row_ + line];
+  for (int w = line * kWordsPerLine; w < j / 64; ++w) {
+    count += __builtin_popcountll(words[w]);
+  }
+  const std::uint64_t below = (std::uint64_t(1) << (j % 64)) - 1;
+  return count + __builtin_popcountll(words[j / 64] & below);
+}
+
+void BitMatrixGraph::adjust_ranks(
+    const int i, const int j, const int delta) noexcept {
+  int* ranks = line_ranks_.data() + static_cast<long>(i) * lines_per_row_;
+  for (int line = j / 64 / kWordsPerLine + 1; line < lines_per_row_; ++line) {
+    ranks[line] += delta;
+  }
+}
+
+void BitMatrixGraph::grow_row(const int i) {
+  RowSpan& span = rows_[i];
+  const int capacity = std::max(kMinRowCapacity, 2 * span.capacity);
+  if (span.offset + span.capacity == static_cast<int>(weights_.size())) {
+    // The row is the last in weights_, so it can grow in place. This is the
+    // usual case when the edges are added one row at a time.
+    weights_.resize(span.offset + capacity);
+    span.capacity = capacity;
+    return;
+  }
+  if (2 * (unused_slots_ + span.capacity) > static_cast<int>(weights_.size())) {
+    compact_weights();
+  }
+  const int offset = static_cast<int>(weights_.size());
+  weights_.resize(offset + capacity);
+  std::copy(
+      weights_.begin() + span.offset,
+      weights_.begin() + span.offset + span.size, weights_.begin() + offset);
+  unused_slots_ += span.capacity;
+  span.offset = offset;
+  span.capacity = capacity;
+}
+
+void BitMatrixGraph::compact_weights() {
+  std::vector<int, AlignedAllocator<int>> packed;
+  packed.reserve(edge_count_);
+  for (RowSpan& span : rows_) {
+    const int offset = static_cast<int>(packed.size());
+    packed.insert(
+        packed.end(), weights_.begin() + span.offset,
+        weights_.begin() + span.offset + span.size);
+    span.offset = offset;
+    span.capacity = span.size;
+  }
+  weights_.swap(packed);
+  unused_slots_ = 0;
+}
@@ -0,0 +1,201 @@
+#ifndef _bit_matrix_graph_hpp_
+#define _bit_matrix_graph_hpp_
+
+#include <cstdint>
+#include <vector>
+
+#include "aligned_allocator.hpp"
+#include "edge.hpp"
+
+// The BitMatrixGraph class implements the Graph ADT using a bit-packed
+// adjacency matrix.
+//
+// Compared to AdjacencyMatrixGraph, which stores a vector of int per row, the
+// presence of each edge is stored as a single bit in one contiguous, 64-byte
+// aligned bitmap, and the weights are stored separately, in a second
+// contiguous, 64-byte aligned buffer holding the weights of each row together
+// (in column order). For the full airport network this is about 10 MB of
+// bitmap instead of about 330 MB of ints, and out_edges scans a row 64
+// vertices at a time.
+//
+// The position of a weight within its row is the rank of its bit in the row,
+// i.e., the number of set bits before it. A rank directory holding the number
+// of set bits before each cache line of the row bounds the work of a rank to
+// the popcount of a single line, so edge_weight and add_edge take O(1) time
+// (plus, for add_edge and remove_edge, O(deg(i) + vertex_count() / 512) to
+// shift the rest of the row).
+class BitMatrixGraph {
+ public:
+  // The type of the edge weights.
+  using WeightType = int;
+
+  //
+  // Constructors and Destructors
+  //
+
+  // The default constructor. Creates a graph with vertex_count-many vertices
+  // and no edges.
+  BitMatrixGraph(const int vertex_count);
+
+  // The copy constructor.
+  BitMatrixGraph(const BitMatrixGraph& other) = default;
+
+  // The copy assignment constructor.
+  BitMatrixGraph& operator=(const BitMatrixGraph& other) = default;
+
+  // The move constructor.
+  BitMatrixGraph(BitMatrixGraph&& other) = default;
+
+  // The move assignment constructor.
+  BitMatrixGraph& operator=(BitMatrixGraph&& other) = default;
+
+  // The destructor.
+  ~BitMatrixGraph() = default;
+
+  //
+  // Accessors
+  //
+
+  // Returns the number of vertices in the graph.
+  int vertex_count() const noexcept;
+
+  // Returns the number of edges in the graph.
+  int edge_count() const noexcept;
+
+  // Returns whether there is an edge from vertex i to vertex j.
+  //
+  // Throws if 0 <= i, j < vertex_count() is violated.
+  bool has_edge(const int i, const int j) const;
+
+  // Returns the weight of the edge from vertex i to vertex j.
+  //
+  // Throws if 0 <= i, j < vertex_count() is violated or if !has_edge(i, j).
+  int edge_weight(const int i, const int j) const;
+
+  // Returns the vertices j with an edge from vertex i to vertex j, in
+  // increasing order.
+  //
+  // Throws if 0 <= i < vertex_count() is violated.
+  std::vector<int> out_edges(const int i) const;
+
+  // The same as has_edge, except that i and j are never checked (see
+  // UncheckedView in bounds_check.hpp).
+  //
+  // ASSUMES: 0 <= i, j < vertex_count().
+  bool has_edge_unchecked(const int i, const int j) const;
+
+  // The same as edge_weight, except that i and j are never checked (a missing
+  // edge is still reported).
+  //
+  // ASSUMES: 0 <= i, j < vertex_count().
+  int edge_weight_unchecked(const int i, const int j) const;
+
+  // The same as out_edges, except that i is never checked.
+  //
+  // ASSUMES: 0 <= i < vertex_count().
+  std::vector<int> out_edges_unchecked(const int i) const;
+
+  // Returns the vertices i with an edge from vertex i to vertex j, in
+  // increasing order.
+  //
+  // Throws if 0 <= j < vertex_count() is violated.
+  std::vector<int> in_edges(const int j) const;
+
+  // Returns the edges in the graph, as a vector of Edge's.
+  std::vector<Edge> edges() const noexcept;
+
+  // Returns the number of bytes of heap memory used by the graph.
+  long memory_bytes() const noexcept;
+
+  //
+  // Modifiers
+  //
+
+  // Adds a new edge from vertex i to vertex j with the specified edge weight.
+  //
+  // If there is already an edge from vertex i to vertex j, this updates the
+  // edge weight of the existing edge to `edge_weight`.
+  //
+  // Throws if 0 <= i, j < vertex_count() is violated or if edge_weight is zero.
+  void add_edge(const int i, const int j, const int edge_weight = 1);
+
+  // Removes the edge from vertex i to vertex j.
+  //
+  // Throws if 0 <= i, j < vertex_count() is violated of if there is no edge
+  // from vertex i to vertex j.
+  void remove_edge(const int i, const int j);
+
+ private:
+  // Returns a pointer to the first word of row i of the bitmap.
+  const std::uint64_t* row(const int i) const noexcept;
+
+  // Returns the number of edges from vertex i to vertices less than j, i.e.,
+  // the position of the weight of the edge from vertex i to vertex j among the
+  // weights of row i.
+  int rank(const int i, const int j) const noexcept;
+
+  // Adds `delta` to the rank directory entries of the cache lines of row i
+  // after the one holding column j.
+  void adjust_ranks(const int i, const int j, const int delta) noexcept;
+
+  // Moves the weights of row i to the end of weights_, with room for at least
+  // one more, compacting weights_ first if too much of it is unused.
+  void grow_row(const int i);
+
+  // Packs the weights of every row next to each other, dropping the unused
+  // slots of weights_.
+  void compact_weights();
+
+  // The location of the weights of a row in weights_.
+  struct RowSpan {
+    // The index of the weight of the first edge of the row.
+    int offset;
+
+    // The number of edges in the row.
+    int size;
+
+    // The number of slots of weights_ reserved for the row, starting at
+    // offset.
+    int capacity;
+  };
+
+  // The number of vertices in the graph.
+  const int vertex_count_;
+
+  // The number of edges in the graph.
+  //
+  // This is always equal to the number of set bits in presence_.
+  int edge_count_;
+
+  // The number of 64-bit words in each row of presence_. Rows are padded to a
+  // multiple of 512 bits so that every row starts on a 64-byte boundary.
+  const int words_per_row_;
+
+  // The adjacency matrix as a bitmap, stored row after row.
+  //
+  // Bit (j % 64) of word (i * words_per_row_ + j / 64) is set exactly when
+  // there is an edge from vertex i to vertex j.
+  std::vector<std::uint64_t, AlignedAllocator<std::uint64_t>> presence_;
+
+  // The number of 64-byte cache lines in each row of presence_.
+  const int lines_per_row_;
+
+  // The rank directory. Element (i * lines_per_row_ + l) is the number of set
+  // bits in row i of presence_ before cache line l of the row.
+  std::vector<int> line_ranks_;
+
+  // The weights of the edges in the graph, row after row.
+  //
+  // Element (rows_[i].offset + k) is the weight of the edge from vertex i to
+  // the vertex j of the k^th set bit in row i of presence_. Rows that outgrow
+  // their capacity move to the end, leaving unused slots behind.
+  std::vector<int, AlignedAllocator<int>> weights_;
+
+  // Where the weights of each row are in weights_.
+  std::vector<RowSpan> rows_;
+
+  // The number of slots of weights_ left behind by rows that moved.
+  int unused_slots_;
+};
+
+#endif
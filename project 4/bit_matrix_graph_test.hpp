@@ -0,0 +1,102 @@
+#ifndef _bit_matrix_graph_test_hpp_
+#define _bit_matrix_graph_test_hpp_
+
+// Unit tests for the BitMatrixGraph class.
+#include "bit_matrix_graph.hpp"
+
+#include <vector>
+
+#include "adjacency_matrix_graph.hpp"
+#include "doctest.hpp"
+#include "edge.hpp"
+#include "graph_adt_test.hpp"
+#include "test_random.hpp"
+
+TEST_CASE_TEMPLATE_INVOKE(test_id, BitMatrixGraph);
+
+TEST_CASE("BitMatrixGraph") {
+  // Enough vertices that rows span several 64-bit words and cache lines.
+  constexpr int kVertexCount = 1100;
+
+  SUBCASE("EdgesAcrossWordBoundaries") {
+    BitMatrixGraph graph(kVertexCount);
+    const std::vector<int> targets = {0, 63, 64, 127, 511, 512, 700, 1099};
+    for (const int j : targets) {
+      graph.add_edge(5, j, j + 1);
+    }
+    CHECK_EQ(graph.edge_count(), targets.size());
+    CHECK_EQ(graph.out_edges(5), targets);
+    for (const int j : targets) {
+      CHECK(graph.has_edge(5, j));
+      CHECK_EQ(graph.edge_weight(5, j), j + 1);
+      CHECK_EQ(graph.in_edges(j), std::vector<int>({5}));
+    }
+    CHECK_FALSE(graph.has_edge(5, 65));
+    CHECK_FALSE(graph.has_edge(4, 64));
+  }
+
+  SUBCASE("WeightsStayWithTheirEdges") {
+    BitMatrixGraph graph(kVertexCount);
+    graph.add_edge(1, 900, 9);
+    graph.add_edge(1, 2, 2);
+    graph.add_edge(1, 300, 3);
+    graph.add_edge(1, 300, 30);
+    CHECK_EQ(graph.edge_count(), 3);
+    CHECK_EQ(graph.edge_weight(1, 2), 2);
+    CHECK_EQ(graph.edge_weight(1, 300), 30);
+    CHECK_EQ(graph.edge_weight(1, 900), 9);
+    CHECK_EQ(
+        graph.edges(),
+        std::vector<Edge>({Edge(1, 2, 2), Edge(1, 300, 30), Edge(1, 900, 9)}));
+  }
+
+  SUBCASE("RemoveEdge") {
+    BitMatrixGraph graph(kVertexCount);
+    graph.add_edge(3, 4, 4);
+    graph.add_edge(3, 800, 8);
+    graph.remove_edge(3, 4);
+    CHECK_EQ(graph.edge_count(), 1);
+    CHECK_FALSE(graph.has_edge(3, 4));
+    CHECK_EQ(graph.edge_weight(3, 800), 8);
+    CHECK_THROWS_AS(graph.remove_edge(3, 4), std::invalid_argument);
+  }
+
+  SUBCASE("InterleavedRowsMatchAdjacencyMatrixGraph") {
+    // Adding edges to rows in no particular order moves rows around the
+    // weight buffer and compacts it; every weight must follow its edge.
+    constexpr int kCount = 300;
+    BitMatrixGraph graph(kCount);
+    AdjacencyMatrixGraph reference(kCount);
+    TestRandom random(777);
+    for (int step = 0; step < 6000; ++step) {
+      const int i = random.next(kCount);
+      const int j = random.next(kCount);
+      if (step % 5 == 4 && reference.has_edge(i, j)) {
+        graph.remove_edge(i, j);
+        reference.remove_edge(i, j);
+      } else {
+        const int weight = 1 + random.next(100);
+        graph.add_edge(i, j, weight);
+        reference.add_edge(i, j, weight);
+      }
+    }
+    CHECK_EQ(graph.edge_count(), reference.edge_count());
+    CHECK_EQ(graph.edges(), reference.edges());
+    int mismatches = 0;
+    for (int v = 0; v < kCount; ++v) {
+      mismatches += graph.out_edges(v) != reference.out_edges(v);
+      mismatches += graph.in_edges(v) != reference.in_edges(v);
+    }
+    CHECK_EQ(mismatches, 0);
+  }
+
+  SUBCASE("OutOfRangeThrows") {
+    BitMatrixGraph graph(kVertexCount);
+    CHECK_THROWS_AS(graph.has_edge(-1, 0), std::range_error);
+    CHECK_THROWS_AS(graph.has_edge(0, kVertexCount), std::range_error);
+    CHECK_THROWS_AS(graph.out_edges(kVertexCount), std::range_error);
+    CHECK_THROWS_AS(graph.add_edge(0, 1, 0), std::invalid_argument);
+  }
+}
+
+#endif
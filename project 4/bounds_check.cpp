@@ -0,0 +1,9 @@
+#include "bounds_check.hpp"
+
+#include <stdexcept>
+#include <string>
+
+void throw_invalid_vertex(const char* name, const int vertex) {
+  throw std::range_error(
+      std::string("invalid ") + name + ": " + std::to_string(vertex));
+}
@@ -0,0 +1,124 @@
+#ifndef _bounds_check_hpp_
+#define _bounds_check_hpp_
+
+#include <type_traits>
+#include <utility>
+
+// The bounds-check policies of the graph classes (see adjacency_list_graph.hpp
+// and adjacency_matrix_graph.hpp), which say whether their accessors and
+// modifiers check that the vertices they are given are valid:
+//
+// * Checked graphs always check, throwing a std::range_error exception for an
+//   invalid vertex. This is the default, for graphs built from outside input.
+// * Unchecked graphs never check, so an invalid vertex is undefined behavior.
+// * DebugOnly graphs check (as Checked graphs do) unless NDEBUG is defined,
+//   for graphs whose owner only ever passes vertices it has already validated,
+//   such as the graph inside an AirportNetwork.
+//
+// Whatever their policy, the graphs also have unchecked accessors
+// (has_edge_unchecked, edge_weight_unchecked and out_edges_unchecked), which
+// traversals read them through, by way of an UncheckedView, once they have
+// validated the vertex they start from.
+struct Checked {};
+struct Unchecked {};
+struct DebugOnly {};
+
+// Whether graphs with the bounds-check policy Bounds check their vertices.
+template <class Bounds>
+inline constexpr bool kChecksBounds = false;
+
+template <>
+inline constexpr bool kChecksBounds<Checked> = true;
+
+#ifndef NDEBUG
+template <>
+inline constexpr bool kChecksBounds<DebugOnly> = true;
+#endif
+
+// Throws a std::range_error exception reporting that `vertex` (named `name`)
+// is not a valid vertex.
+//
+// This is kept out of line, so that building the message does not weigh on
+// the code of the callers.
+[[noreturn]] void throw_invalid_vertex(const char* name, const int vertex);
+
+// Throws a std::range_error exception naming `name` if
+// 0 <= vertex < vertex_count is violated, provided kChecksBounds<Bounds>.
+template <class Bounds>
+inline void check_vertex(
+    const int vertex, const int vertex_count, const char* name) {
+  if constexpr (kChecksBounds<Bounds>) {
+    if (vertex < 0 || vertex >= vertex_count) {
+      throw_invalid_vertex(name, vertex);
+    }
+  }
+}
+
+// Whether Graph has the unchecked accessors described above.
+template <class Graph, class = void>
+inline constexpr bool kHasUncheckedAccessors = false;
+
+template <class Graph>
+inline constexpr bool kHasUncheckedAccessors<
+    Graph, std::void_t<decltype(std::declval<const Graph&>()
+                                    .out_edges_unchecked(0))>> = true;
+
+// The UncheckedView class template is a read-only view of a graph through its
+// unchecked accessors, for a traversal that has validated the vertex it starts
+// from and so only ever passes the graph vertices it got from it. A graph
+// without unchecked accessors (such as a CsrGraph) is read through its
+// ordinary ones.
+//
+// The view holds a reference to the graph, so it must not outlive it.
+template <class Graph>
+class UncheckedView {
+ public:
+  // The constructor.
+  explicit UncheckedView(const Graph& graph) noexcept : graph_(graph) {}
+
+  // Returns the number of vertices in the graph.
+  int vertex_count() const noexcept {
+    return graph_.vertex_count();
+  }
+
+  // Returns whether there is an edge from vertex i to vertex j.
+  //
+  // ASSUMES: 0 <= i, j < vertex_count().
+  bool has_edge(const int i, const int j) const {
+    if constexpr (kHasUncheckedAccessors<Graph>) {
+      return graph_.has_edge_unchecked(i, j);
+    } else {
+      return graph_.has_edge(i, j);
+    }
+  }
+
+  // Returns the weight of the edge from vertex i to vertex j.
+  //
+  // Throws if !has_edge(i, j).
+  //
+  // ASSUMES: 0 <= i, j < vertex_count().
+  decltype(auto) edge_weight(const int i, const int j) const {
+    if constexpr (kHasUncheckedAccessors<Graph>) {
+      return graph_.edge_weight_unchecked(i, j);
+    } else {
+      return graph_.edge_weight(i, j);
+    }
+  }
+
+  // Returns the vertices j with an edge from vertex i to vertex j.
+  //
+  // ASSUMES: 0 <= i < vertex_count().
+  decltype(auto) out_edges(const int i) const {
+    if constexpr (kHasUncheckedAccessors<Graph>) {
+      return graph_.out_edges_unchecked(i);
+    } else {
+      return graph_.out_edges(i);
+    }
+  }
+
+ private:
+  // The graph viewed.
+  const Graph& graph_;
+};
+
+#endif
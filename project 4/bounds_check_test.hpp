@@ -0,0 +1,100 @@
+#ifndef _bounds_check_test_hpp_
+#define _bounds_check_test_hpp_
+
+// Unit tests for the bounds-check policies.
+#include "bounds_check.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+#include "adjacency_list_graph.hpp"
+#include "adjacency_matrix_graph.hpp"
+#include "bit_matrix_graph.hpp"
+#include "csr_graph.hpp"
+#include "doctest.hpp"
+#include "undirected_graph.hpp"
+
+TEST_CASE("BoundsCheck") {
+  SUBCASE("CheckedAlwaysChecks") {
+    CHECK_NOTHROW(check_vertex<Checked>(0, 3, "i"));
+    CHECK_NOTHROW(check_vertex<Checked>(2, 3, "i"));
+    CHECK_THROWS_AS(check_vertex<Checked>(-1, 3, "i"), std::range_error);
+    CHECK_THROWS_WITH_AS(
+        check_vertex<Checked>(3, 3, "j"), "invalid j: 3", std::range_error);
+  }
+
+  SUBCASE("UncheckedNeverChecks") {
+    CHECK_FALSE(kChecksBounds<Unchecked>);
+    CHECK_NOTHROW(check_vertex<Unchecked>(3, 3, "i"));
+  }
+
+  SUBCASE("DebugOnlyChecksUnlessNDEBUG") {
+#ifdef NDEBUG
+    CHECK_FALSE(kChecksBounds<DebugOnly>);
+#else
+    CHECK(kChecksBounds<DebugOnly>);
+    CHECK_THROWS_AS(check_vertex<DebugOnly>(3, 3, "i"), std::range_error);
+#endif
+  }
+
+  SUBCASE("UncheckedGraphsKeepOtherErrors") {
+    BasicAdjacencyListGraph<Unchecked> list(3);
+    BasicAdjacencyMatrixGraph<Unchecked> matrix(3);
+    UndirectedGraph<BasicAdjacencyListGraph<Unchecked>> undirected(3);
+    UndirectedGraph<BasicSymmetricEdges<Unchecked>> symmetric(3);
+    list.add_edge(0, 2, 5);
+    matrix.add_edge(0, 2, 5);
+    undirected.add_edge(0, 2, 5);
+    symmetric.add_edge(0, 2, 5);
+    CHECK_EQ(list.out_edges(0), std::vector<int>{2});
+    CHECK_EQ(matrix.edge_weight(0, 2), 5);
+    CHECK_EQ(undirected.edge_weight(2, 0), 5);
+    CHECK_EQ(symmetric.out_edges(2), std::vector<int>{0});
+    CHECK_THROWS_AS(symmetric.edge_weight(1, 2), std::invalid_argument);
+    CHECK_THROWS_AS(list.add_edge(0, 1, 0), std::invalid_argument);
+    CHECK_THROWS_AS(list.edge_weight(1, 2), std::invalid_argument);
+    CHECK_THROWS_AS(matrix.remove_edge(1, 0), std::invalid_argument);
+  }
+
+  SUBCASE("CheckedGraphsHaveUncheckedAccessors") {
+    // The public graph types stay Checked, with unchecked accessors beside the
+    // checked ones for the traversals.
+    AdjacencyListGraph list(3);
+    AdjacencyMatrixGraph matrix(3);
+    UndirectedGraph<SymmetricEdges> symmetric(3);
+    list.add_edge(0, 2, 5);
+    matrix.add_edge(0, 2, 5);
+    symmetric.add_edge(2, 0, 5);
+    CHECK_THROWS_AS(list.out_edges(3), std::range_error);
+    CHECK_THROWS_WITH_AS(
+        symmetric.out_edges(-1), "invalid i: -1", std::range_error);
+    CHECK_EQ(list.out_edges_unchecked(0), std::vector<int>{2});
+    CHECK(matrix.has_edge_unchecked(0, 2));
+    CHECK_FALSE(matrix.has_edge_unchecked(2, 0));
+    CHECK_EQ(symmetric.edge_weight_unchecked(0, 2), 5);
+    CHECK_EQ(symmetric.out_edges_unchecked(2), std::vector<int>{0});
+    CHECK_THROWS_AS(list.edge_weight_unchecked(2, 0), std::invalid_argument);
+  }
+
+  SUBCASE("UncheckedViewReadsTheUncheckedAccessors") {
+    UndirectedGraph<AdjacencyListGraph> graph(3);
+    graph.add_edge(0, 1, 4);
+    const UncheckedView<UndirectedGraph<AdjacencyListGraph>> view(graph);
+    CHECK(kHasUncheckedAccessors<UndirectedGraph<AdjacencyListGraph>>);
+    CHECK(kHasUncheckedAccessors<UndirectedGraph<BitMatrixGraph>>);
+    CHECK(kHasUncheckedAccessors<UndirectedGraph<SymmetricEdges>>);
+    CHECK_FALSE(kHasUncheckedAccessors<CsrGraph>);
+    CHECK_EQ(view.vertex_count(), 3);
+    CHECK(view.has_edge(1, 0));
+    CHECK_EQ(view.edge_weight(1, 0), 4);
+    CHECK_EQ(view.out_edges(0), graph.out_edges(0));
+
+    // A graph without unchecked accessors is read through its ordinary ones.
+    const CsrGraph csr(graph);
+    const UncheckedView<CsrGraph> csr_view(csr);
+    CHECK_EQ(csr_view.edge_weight(0, 1), 4);
+    CHECK_THROWS_AS(csr_view.edge_weight(0, 2), std::invalid_argument);
+  }
+}
+
+#endif
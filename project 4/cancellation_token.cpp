@@ -0,0 +1,101 @@
+#include "cancellation_token.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+//
+// OperationCancelled
+//
+
+OperationCancelled::OperationCancelled()
+    : OperationCancelled("operation cancelled") {}
+
+OperationCancelled::OperationCancelled(const std::string& what)
+    : std::runtime_error(what) {}
+
+//
+// DeadlineExceeded
+//
+
+DeadlineExceeded::DeadlineExceeded()
+    : OperationCancelled("deadline exceeded") {}
+
+void throw_if_stopped(const SearchStatus status) {
+  switch (status) {
+    case SearchStatus::kCancelled:
+      throw OperationCancelled();
+    case SearchStatus::kDeadlineExceeded:
+      throw DeadlineExceeded();
+    default:
+      break;
+  }
+}
+
+//
+// CancellationToken
+//
+
+CancellationToken::CancellationToken(
+    std::shared_ptr<const std::atomic<bool>> flag)
+    : flag_(std::move(flag)) {}
+
+CancellationToken::Clock::time_point CancellationToken::deadline()
+    const noexcept {
+  return deadline_;
+}
+
+SearchStatus CancellationToken::status() const noexcept {
+  // The flag only ever goes from false to true and guards no other data, so
+  // a relaxed load suffices; a check that just misses the change is made up
+  // for at the next one.
+  if (flag_ != nullptr && flag_->load(std::memory_order_relaxed)) {
+    return SearchStatus::kCancelled;
+  }
+  if (deadline_ != Clock::time_point::max() && Clock::now() >= deadline_) {
+    return SearchStatus::kDeadlineExceeded;
+  }
+  return SearchStatus::kComplete;
+}
+
+bool CancellationToken::cancelled() const noexcept {
+  return status() != SearchStatus::kComplete;
+}
+
+void CancellationToken::throw_if_cancelled() const {
+  throw_if_stopped(status());
+}
+
+CancellationToken CancellationToken::with_deadline(
+    const Clock::time_point deadline) const {
+  CancellationToken token = *this;
+  token.deadline_ = std::min(deadline_, deadline);
+  return token;
+}
+
+CancellationToken CancellationToken::with_timeout(
+    const Clock::duration timeout) const {
+  return with_deadline(Clock::now() + timeout);
+}
+
+//
+// CancellationSource
+//
+
+CancellationSource::CancellationSource()
+    : flag_(std::make_shared<std::atomic<bool>>(false)) {}
+
+CancellationToken CancellationSource::token() const {
+  return CancellationToken(flag_);
+}
+
+bool CancellationSource::cancelled() const noexcept {
+  return flag_->load(std::memory_order_relaxed);
+}
+
+void CancellationSource::cancel() noexcept {
+  flag_->store(true, std::memory_order_relaxed);
+}
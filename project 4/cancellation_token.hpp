@@ -0,0 +1,174 @@
+#ifndef _cancellation_token_hpp_
+#define _cancellation_token_hpp_
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+// The outcome of a search that stops early when its CancellationToken is
+// cancelled or its deadline passes.
+enum class SearchStatus {
+  // The search ran to completion.
+  kComplete,
+  // The search stopped because its token was cancelled.
+  kCancelled,
+  // The search stopped because the deadline of its token passed.
+  kDeadlineExceeded,
+};
+
+// The OperationCancelled exception is thrown by a computation that stopped
+// early because its CancellationToken was cancelled.
+class OperationCancelled : public std::runtime_error {
+ public:
+  // The constructor.
+  OperationCancelled();
+
+ protected:
+  // Creates an exception with the message `what`, for subclasses.
+  explicit OperationCancelled(const std::string& what);
+};
+
+// The DeadlineExceeded exception is thrown by a computation that stopped early
+// because the deadline of its CancellationToken passed.
+class DeadlineExceeded : public OperationCancelled {
+ public:
+  // The constructor.
+  DeadlineExceeded();
+};
+
+// Throws an OperationCancelled exception if status is kCancelled and a
+// DeadlineExceeded exception if status is kDeadlineExceeded.
+void throw_if_stopped(const SearchStatus status);
+
+// The CancellationToken class lets a long computation check whether its result
+// is still wanted, so that the work of an abandoned request can be stopped.
+//
+// Cancellation is cooperative: a token is cancelled through the
+// CancellationSource it came from, or when its deadline (if it has one)
+// passes, and the computation holding it checks it periodically (once every
+// kCheckInterval steps of its loops) and then either throws an
+// OperationCancelled exception or returns what it has so far with the
+// SearchStatus of the token. A default-constructed token is never cancelled,
+// and checking it costs a null pointer test and a comparison; only a token
+// with a deadline reads the clock.
+class CancellationToken {
+ public:
+  // The clock of the deadlines.
+  using Clock = std::chrono::steady_clock;
+
+  // The number of steps (e.g., vertices settled) between checks in the loops
+  // of the traversals that take a token.
+  static constexpr int kCheckInterval = 256;
+
+  //
+  // Constructors and Destructors
+  //
+
+  // The default constructor. Creates a token that is never cancelled.
+  CancellationToken() = default;
+
+  // The copy constructor. The copy is cancelled along with `other`.
+  CancellationToken(const CancellationToken& other) = default;
+
+  // The copy assignment constructor.
+  CancellationToken& operator=(const CancellationToken& other) = default;
+
+  // The move constructor.
+  CancellationToken(CancellationToken&& other) = default;
+
+  // The move assignment constructor.
+  CancellationToken& operator=(CancellationToken&& other) = default;
+
+  // The destructor.
+  ~CancellationToken() = default;
+
+  //
+  // Accessors
+  //
+
+  // Returns the deadline of the token, or Clock::time_point::max() if it has
+  // none.
+  Clock::time_point deadline() const noexcept;
+
+  // Returns kCancelled if the token has been cancelled, kDeadlineExceeded if
+  // its deadline has passed, and kComplete (i.e., the computation may go on)
+  // otherwise.
+  SearchStatus status() const noexcept;
+
+  // Returns whether the token has been cancelled or its deadline has passed.
+  bool cancelled() const noexcept;
+
+  // Throws an OperationCancelled exception if the token has been cancelled,
+  // and a DeadlineExceeded exception if its deadline has passed.
+  void throw_if_cancelled() const;
+
+  // Returns a copy of the token that is also cancelled once `deadline`
+  // passes (or, if the token has an earlier deadline, once that passes).
+  CancellationToken with_deadline(const Clock::time_point deadline) const;
+
+  // Returns a copy of the token that is also cancelled once `timeout` has
+  // elapsed from now.
+  CancellationToken with_timeout(const Clock::duration timeout) const;
+
+ private:
+  friend class CancellationSource;
+
+  // Creates a token that is cancelled once `flag` is set.
+  explicit CancellationToken(std::shared_ptr<const std::atomic<bool>> flag);
+
+  // The flag set by the source, or null if the token is never cancelled.
+  std::shared_ptr<const std::atomic<bool>> flag_;
+
+  // The deadline, or Clock::time_point::max() if there is none.
+  Clock::time_point deadline_ = Clock::time_point::max();
+};
+
+// The CancellationSource class hands out CancellationTokens and cancels them.
+//
+// Copies of a source share its state, so cancelling any of them cancels every
+// token handed out by any of them. The state lives as long as any source or
+// token refers to it, so tokens may outlive their sources.
+class CancellationSource {
+ public:
+  //
+  // Constructors and Destructors
+  //
+
+  // The default constructor. Creates a source that has not been cancelled.
+  CancellationSource();
+
+  // The copy constructor. The copy shares the state of `other`.
+  CancellationSource(const CancellationSource& other) = default;
+
+  // The copy assignment constructor.
+  CancellationSource& operator=(const CancellationSource& other) = default;
+
+  // The destructor.
+  ~CancellationSource() = default;
+
+  //
+  // Accessors
+  //
+
+  // Returns a token that is cancelled when the source is.
+  CancellationToken token() const;
+
+  // Returns whether the source has been cancelled.
+  bool cancelled() const noexcept;
+
+  //
+  // Mutators
+  //
+
+  // Cancels the source, and with it every token it handed out. Cancelling a
+  // source twice does nothing more.
+  void cancel() noexcept;
+
+ private:
+  // The flag shared with the tokens.
+  std::shared_ptr<std::atomic<bool>> flag_;
+};
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef _cancellation_token_test_hpp_
+#define _cancellation_token_test_hpp_
+
+// Unit tests for the CancellationToken and CancellationSource classes.
+#include "cancellation_token.hpp"
+
+#include <chrono>
+#include <stdexcept>
+
+#include "doctest.hpp"
+
+TEST_CASE("CancellationToken") {
+  SUBCASE("DefaultTokenIsNeverCancelled") {
+    const CancellationToken token;
+    CHECK_FALSE(token.cancelled());
+    CHECK_NOTHROW(token.throw_if_cancelled());
+  }
+
+  SUBCASE("CancelReachesEveryToken") {
+    CancellationSource source;
+    const CancellationToken before = source.token();
+    const CancellationToken copy = before;
+    CHECK_FALSE(source.cancelled());
+    CHECK_FALSE(before.cancelled());
+    source.cancel();
+    CHECK(source.cancelled());
+    CHECK(before.cancelled());
+    CHECK(copy.cancelled());
+    CHECK(source.token().cancelled());
+    CHECK_THROWS_AS(before.throw_if_cancelled(), OperationCancelled);
+    // OperationCancelled is a std::runtime_error.
+    CHECK_THROWS_AS(before.throw_if_cancelled(), std::runtime_error);
+    source.cancel();
+    CHECK(source.cancelled());
+  }
+
+  SUBCASE("CopiedSourcesShareState") {
+    CancellationSource source;
+    const CancellationSource copy = source;
+    const CancellationToken token = copy.token();
+    source.cancel();
+    CHECK(copy.cancelled());
+    CHECK(token.cancelled());
+  }
+
+  SUBCASE("TokensOutliveTheirSource") {
+    CancellationToken token;
+    {
+      CancellationSource source;
+      token = source.token();
+      source.cancel();
+    }
+    CHECK(token.cancelled());
+  }
+
+  SUBCASE("Deadlines") {
+    const CancellationToken::Clock::time_point now =
+        CancellationToken::Clock::now();
+    const CancellationToken none;
+    CHECK_EQ(none.deadline(), CancellationToken::Clock::time_point::max());
+    CHECK_EQ(none.status(), SearchStatus::kComplete);
+
+    const CancellationToken expired =
+        none.with_deadline(now - std::chrono::milliseconds(1));
+    CHECK_EQ(expired.status(), SearchStatus::kDeadlineExceeded);
+    CHECK(expired.cancelled());
+    CHECK_THROWS_AS(expired.throw_if_cancelled(), DeadlineExceeded);
+    // DeadlineExceeded is an OperationCancelled.
+    CHECK_THROWS_AS(expired.throw_if_cancelled(), OperationCancelled);
+
+    const CancellationToken later = none.with_timeout(std::chrono::hours(1));
+    CHECK_EQ(later.status(), SearchStatus::kComplete);
+    CHECK_GT(later.deadline(), now);
+    // The earlier of two deadlines holds.
+    CHECK_EQ(later.with_deadline(now).deadline(), now);
+    CHECK_EQ(
+        expired.with_timeout(std::chrono::hours(1)).deadline(),
+        expired.deadline());
+
+    // Cancellation takes precedence over the deadline.
+    CancellationSource source;
+    const CancellationToken both =
+        source.token().with_deadline(now - std::chrono::milliseconds(1));
+    CHECK_EQ(both.status(), SearchStatus::kDeadlineExceeded);
+    source.cancel();
+    CHECK_EQ(both.status(), SearchStatus::kCancelled);
+  }
+
+  SUBCASE("ThrowIfStopped") {
+    CHECK_NOTHROW(throw_if_stopped(SearchStatus::kComplete));
+    CHECK_THROWS_AS(
+        throw_if_stopped(SearchStatus::kCancelled), OperationCancelled);
+    CHECK_THROWS_AS(
+        throw_if_stopped(SearchStatus::kDeadlineExceeded), DeadlineExceeded);
+  }
+
+  SUBCASE("SourcesAreIndependent") {
+    CancellationSource first;
+    CancellationSource second;
+    first.cancel();
+    CHECK_FALSE(second.token().cancelled());
+  }
+}
+
+#endif
@@ -0,0 +1,60 @@
+#include "compute_executor.hpp"
+
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+ComputeExecutor::ComputeExecutor(const int thread_count) {
+  if (thread_count <= 0) {
+    throw std::invalid_argument(
+        "thread_count must be positive: " + std::to_string(thread_count));
+  }
+  threads_.reserve(thread_count);
+  for (int t = 0; t < thread_count; ++t) {
+    threads_.emplace_back(&ComputeExecutor::work, this);
+  }
+}
+
+ComputeExecutor::~ComputeExecutor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  ready_.notify_all();
+  for (std::thread& thread : threads_) {
+    thread.join();
+  }
+}
+
+int ComputeExecutor::thread_count() const noexcept {
+  return threads_.size();
+}
+
+void ComputeExecutor::post(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+  }
+  ready_.notify_one();
+}
+
+void ComputeExecutor::work() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    ready_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+    if (tasks_.empty()) {
+      // Stopping, with nothing left to run.
+      return;
+    }
+    std::function<void()> task = std::move(tasks_.front());
+    tasks_.pop_front();
+    lock.unlock();
+    task();
+    // Destroy the task (and whatever it holds) before taking the lock again.
+    task = nullptr;
+    lock.lock();
+  }
+}
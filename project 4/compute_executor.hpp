@@ -0,0 +1,75 @@
+#ifndef _compute_executor_hpp_
+#define _compute_executor_hpp_
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// The ComputeExecutor class runs tasks on a fixed pool of threads of its own,
+// in the order they were posted, so that long computations (such as the
+// searches of AirportNetwork) can be moved off threads that must stay
+// responsive, like the event loop of a server.
+class ComputeExecutor {
+ public:
+  //
+  // Constructors and Destructors
+  //
+
+  // The constructor. Starts thread_count threads (by default, one for each
+  // hardware thread).
+  //
+  // Throws a std::invalid_argument exception if thread_count is not positive.
+  explicit ComputeExecutor(
+      const int thread_count = std::max(
+          1, static_cast<int>(std::thread::hardware_concurrency())));
+
+  // Executors cannot be copied, as they own their threads.
+  ComputeExecutor(const ComputeExecutor& other) = delete;
+  ComputeExecutor& operator=(const ComputeExecutor& other) = delete;
+
+  // The destructor. Runs the tasks already posted, then stops the threads.
+  ~ComputeExecutor();
+
+  //
+  // Accessors
+  //
+
+  // Returns the number of threads of the executor.
+  int thread_count() const noexcept;
+
+  //
+  // Mutators
+  //
+
+  // Queues `task` to be run on one of the threads of the executor.
+  //
+  // ASSUMES: task does not throw (an exception escaping a task terminates the
+  // program), and the executor is not being destroyed.
+  void post(std::function<void()> task);
+
+ private:
+  // The loop of each thread: runs tasks until the executor stops and the
+  // queue is empty.
+  void work();
+
+  // Guards tasks_ and stopping_.
+  std::mutex mutex_;
+
+  // Signaled when a task is queued or the executor stops.
+  std::condition_variable ready_;
+
+  // The tasks not yet started, in order of posting.
+  std::deque<std::function<void()>> tasks_;
+
+  // Whether the destructor has been called.
+  bool stopping_ = false;
+
+  // The threads of the executor.
+  std::vector<std::thread> threads_;
+};
+
+#endif
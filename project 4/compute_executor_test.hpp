@@ -0,0 +1,85 @@
+#ifndef _compute_executor_test_hpp_
+#define _compute_executor_test_hpp_
+
+// Unit tests for the ComputeExecutor class.
+#include "compute_executor.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "doctest.hpp"
+
+TEST_CASE("ComputeExecutor") {
+  SUBCASE("BadThreadCountThrowsException") {
+    CHECK_THROWS_AS(ComputeExecutor(0), std::invalid_argument);
+  }
+
+  SUBCASE("RunsEveryTaskBeforeStopping") {
+    std::atomic<int> runs(0);
+    {
+      ComputeExecutor executor(3);
+      CHECK_EQ(executor.thread_count(), 3);
+      for (int k = 0; k < 1000; ++k) {
+        executor.post([&runs]() { ++runs; });
+      }
+    }
+    CHECK_EQ(runs.load(), 1000);
+  }
+
+  SUBCASE("OneThreadRunsTasksInOrder") {
+    std::vector<int> order;
+    {
+      ComputeExecutor executor(1);
+      for (int k = 0; k < 100; ++k) {
+        executor.post([&order, k]() { order.push_back(k); });
+      }
+    }
+    CHECK_EQ(order.size(), 100);
+    CHECK(std::is_sorted(order.begin(), order.end()));
+  }
+
+  SUBCASE("RunsTasksOnItsOwnThreads") {
+    std::mutex mutex;
+    std::set<std::thread::id> ids;
+    {
+      ComputeExecutor executor(2);
+      for (int k = 0; k < 100; ++k) {
+        executor.post([&]() {
+          std::lock_guard<std::mutex> lock(mutex);
+          ids.insert(std::this_thread::get_id());
+        });
+      }
+    }
+    CHECK_GE(ids.size(), 1);
+    CHECK_LE(ids.size(), 2);
+    CHECK_EQ(ids.count(std::this_thread::get_id()), 0);
+  }
+
+  SUBCASE("TasksRunConcurrently") {
+    // Each of two tasks waits for the other to start, which only finishes if
+    // they run on different threads at once.
+    std::mutex mutex;
+    std::condition_variable started;
+    int count = 0;
+    {
+      ComputeExecutor executor(2);
+      for (int k = 0; k < 2; ++k) {
+        executor.post([&]() {
+          std::unique_lock<std::mutex> lock(mutex);
+          ++count;
+          started.notify_all();
+          started.wait(lock, [&]() { return count == 2; });
+        });
+      }
+    }
+    CHECK_EQ(count, 2);
+  }
+}
+
+#endif
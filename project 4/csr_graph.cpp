@@ -0,0 +1,242 @@
+#include "csr_graph.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "adjacency_list_graph.hpp"
+#include "adjacency_matrix_graph.hpp"
+#include "bit_matrix_graph.hpp"
+#include "bounds_check.hpp"
+#include "undirected_graph.hpp"
+
+namespace {
+
+// Returns `weight` as a Weight.
+//
+// Throws a std::range_error exception if weight cannot be represented as a
+// Weight.
+template <class Weight>
+Weight narrow_weight(const int weight) {
+  if constexpr (std::is_integral_v<Weight>) {
+    if (weight < std::numeric_limits<Weight>::min() ||
+        weight > std::numeric_limits<Weight>::max()) {
+      throw std::range_error(
+          "edge weight out of range: " + std::to_string(weight));
+    }
+  }
+  return static_cast<Weight>(weight);
+}
+
+}  // namespace
+
+template <class Weight>
+template <class Graph>
+BasicCsrGraph<Weight>::BasicCsrGraph(const Graph& graph)
+    : offsets_(1, 0) {
+  const int vertex_count = graph.vertex_count();
+  const UncheckedView<Graph> view(graph);
+  offsets_.reserve(vertex_count + 1);
+  for (int i = 0; i < vertex_count; ++i) {
+    for (const int j : view.out_edges(i)) {
+      targets_.push_back(j);
+      weights_.push_back(narrow_weight<Weight>(view.edge_weight(i, j)));
+    }
+    offsets_.push_back(targets_.size());
+  }
+}
+
+template <class Weight>
+BasicCsrGraph<Weight>::BasicCsrGraph(const int vertex_count)
+    : offsets_(vertex_count + 1, 0) {}
+
+//
+// Accessors
+//
+
+template <class Weight>
+int BasicCsrGraph<Weight>::vertex_count() const noexcept {
+  return offsets_.size() - 1;
+}
+
+template <class Weight>
+int BasicCsrGraph<Weight>::edge_count() const noexcept {
+  return targets_.size();
+}
+
+template <class Weight>
+int BasicCsrGraph<Weight>::offset(const int i) const noexcept {
+  return offsets_[i];
+}
+
+template <class Weight>
+const std::vector<int>& BasicCsrGraph<Weight>::targets() const noexcept {
+  return targets_;
+}
+
+template <class Weight>
+const std::vector<Weight>& BasicCsrGraph<Weight>::weights()
+    const noexcept {
+  return weights_;
+}
+
+template <class Weight>
+Weight BasicCsrGraph<Weight>::edge_weight(const int i, const int j) const {
+  const int position = find_edge(i, j);
+  if (position < 0) {
+    throw std::invalid_argument(
+        "no edge from i to j: " + std::to_string(i) + ", " +
+            std::to_string(j));
+  }
+  return weights_[position];
+}
+
+template <class Weight>
+BasicCsrGraph<Weight> BasicCsrGraph<Weight>::transpose() const {
+  const int count = vertex_count();
+  BasicCsrGraph transposed(count);
+
+  // Count the in-edges of every vertex, then turn the counts into offsets.
+  for (const int j : targets_) {
+    transposed.offsets_[j + 1]++;
+  }
+  for (int j = 0; j < count; ++j) {
+    transposed.offsets_[j + 1] += transposed.offsets_[j];
+  }
+
+  // Place every edge, keeping the in-edges of each vertex ordered by source.
+  transposed.targets_.resize(targets_.size());
+  transposed.weights_.resize(weights_.size());
+  std::vector<int> next(
+      transposed.offsets_.begin(), transposed.offsets_.end() - 1);
+  for (int i = 0; i < count; ++i) {
+    for (int e = offsets_[i]; e < offsets_[i + 1]; ++e) {
+      const int position = next[targets_[e]]++;
+      transposed.targets_[position] = i;
+      transposed.weights_[position] = weights_[e];
+    }
+  }
+  return transposed;
+}
+
+//
+// Modifiers
+//
+
+template <class Weight>
+void BasicCsrGraph<Weight>::set_edge(
+    const int i, const int j, const Weight weight) {
+  const int position = find_edge(i, j);
+  if (position >= 0) {
+    weights_[position] = weight;
+    return;
+  }
+  targets_.insert(targets_.begin() + offsets_[i + 1], j);
+  weights_.insert(weights_.begin() + offsets_[i + 1], weight);
+  for (int k = i + 1; k < offsets_.size(); ++k) {
+    offsets_[k]++;
+  }
+}
+
+template <class Weight>
+void BasicCsrGraph<Weight>::remove_edge(const int i, const int j) {
+  const int position = find_edge(i, j);
+  if (position < 0) {
+    throw std::invalid_argument(
+        "no edge from i to j to remove: " + std::to_string(i) + ", " +
+            std::to_string(j));
+  }
+  targets_.erase(targets_.begin() + position);
+  weights_.erase(weights_.begin() + position);
+  for (int k = i + 1; k < offsets_.size(); ++k) {
+    offsets_[k]--;
+  }
+}
+
+template <class Weight>
+int BasicCsrGraph<Weight>::find_edge(const int i, const int j) const {
+  if (i < 0 || i >= vertex_count()) {
+    throw std::range_error("invalid i: " + std::to_string(i));
+  }
+  if (j < 0 || j >= vertex_count()) {
+    throw std::range_error("invalid j: " + std::to_string(j));
+  }
+  for (int e = offsets_[i]; e < offsets_[i + 1]; ++e) {
+    if (targets_[e] == j) {
+      return e;
+    }
+  }
+  return -1;
+}
+
+// Since the implementation of BasicCsrGraph is in the cpp file, we need to
+// tell the compiler which template instantiations to make.
+//
+// For more information, see
+// https://isocpp.org/wiki/faq/templates#templates-defn-vs-decl.
+template BasicCsrGraph<int>::BasicCsrGraph(
+    const UndirectedGraph<BasicAdjacencyListGraph<DebugOnly>>& graph);
+
+template class BasicCsrGraph<std::uint16_t>;
+template BasicCsrGraph<std::uint16_t>::BasicCsrGraph(
+    const AdjacencyListGraph& graph);
+template BasicCsrGraph<std::uint16_t>::BasicCsrGraph(
+    const AdjacencyMatrixGraph& graph);
+template BasicCsrGraph<std::uint16_t>::BasicCsrGraph(
+    const BitMatrixGraph& graph);
+template BasicCsrGraph<std::uint16_t>::BasicCsrGraph(
+    const UndirectedGraph<AdjacencyListGraph>& graph);
+template BasicCsrGraph<std::uint16_t>::BasicCsrGraph(
+    const UndirectedGraph<AdjacencyMatrixGraph>& graph);
+template BasicCsrGraph<std::uint16_t>::BasicCsrGraph(
+    const UndirectedGraph<BitMatrixGraph>& graph);
+template BasicCsrGraph<std::uint16_t>::BasicCsrGraph(
+    const UndirectedGraph<SymmetricEdges>& graph);
+
+template class BasicCsrGraph<std::int32_t>;
+template BasicCsrGraph<std::int32_t>::BasicCsrGraph(
+    const AdjacencyListGraph& graph);
+template BasicCsrGraph<std::int32_t>::BasicCsrGraph(
+    const AdjacencyMatrixGraph& graph);
+template BasicCsrGraph<std::int32_t>::BasicCsrGraph(
+    const BitMatrixGraph& graph);
+template BasicCsrGraph<std::int32_t>::BasicCsrGraph(
+    const UndirectedGraph<AdjacencyListGraph>& graph);
+template BasicCsrGraph<std::int32_t>::BasicCsrGraph(
+    const UndirectedGraph<AdjacencyMatrixGraph>& graph);
+template BasicCsrGraph<std::int32_t>::BasicCsrGraph(
+    const UndirectedGraph<BitMatrixGraph>& graph);
+template BasicCsrGraph<std::int32_t>::BasicCsrGraph(
+    const UndirectedGraph<SymmetricEdges>& graph);
+
+template class BasicCsrGraph<std::int64_t>;
+template BasicCsrGraph<std::int64_t>::BasicCsrGraph(
+    const AdjacencyListGraph& graph);
+template BasicCsrGraph<std::int64_t>::BasicCsrGraph(
+    const AdjacencyMatrixGraph& graph);
+template BasicCsrGraph<std::int64_t>::BasicCsrGraph(
+    const BitMatrixGraph& graph);
+template BasicCsrGraph<std::int64_t>::BasicCsrGraph(
+    const UndirectedGraph<AdjacencyListGraph>& graph);
+template BasicCsrGraph<std::int64_t>::BasicCsrGraph(
+    const UndirectedGraph<AdjacencyMatrixGraph>& graph);
+template BasicCsrGraph<std::int64_t>::BasicCsrGraph(
+    const UndirectedGraph<BitMatrixGraph>& graph);
+template BasicCsrGraph<std::int64_t>::BasicCsrGraph(
+    const UndirectedGraph<SymmetricEdges>& graph);
+
+template class BasicCsrGraph<float>;
+template BasicCsrGraph<float>::BasicCsrGraph(const AdjacencyListGraph& graph);
+template BasicCsrGraph<float>::BasicCsrGraph(const AdjacencyMatrixGraph& graph);
+template BasicCsrGraph<float>::BasicCsrGraph(const BitMatrixGraph& graph);
+template BasicCsrGraph<float>::BasicCsrGraph(
+    const UndirectedGraph<AdjacencyListGraph>& graph);
+template BasicCsrGraph<float>::BasicCsrGraph(
+    const UndirectedGraph<AdjacencyMatrixGraph>& graph);
+template BasicCsrGraph<float>::BasicCsrGraph(
+    const UndirectedGraph<BitMatrixGraph>& graph);
+template BasicCsrGraph<float>::BasicCsrGraph(
+    const UndirectedGraph<SymmetricEdges>& graph);
@@ -0,0 +1,134 @@
+#ifndef _csr_graph_hpp_
+#define _csr_graph_hpp_
+
+#include <cstdint>
+#include <vector>
+
+#include "path_length.hpp"
+
+// The BasicCsrGraph class template is a snapshot of the edges of a graph in
+// compressed sparse row (CSR) form: the out-edges of every vertex are stored
+// contiguously, vertex after vertex, in two flat arrays of targets and
+// weights.
+//
+// Algorithms that sweep over every edge many times (such as rounds of
+// Bellman-Ford relaxation or sparse matrix products) use a CsrGraph instead of
+// calling out_edges and edge_weight on a Graph, which allocates a vector per
+// call and looks up every weight separately.
+//
+// A snapshot can be kept in step with its graph edge by edge (set_edge and
+// remove_edge). Each update shifts the edges after it along the flat arrays,
+// which is a single memmove and far cheaper than taking a new snapshot.
+//
+// The template parameter Weight is the type the weights are stored as; it is
+// instantiated for std::uint16_t, std::int32_t, std::int64_t and float. The
+// snapshots used throughout keep int weights (see CsrGraph below); a narrower
+// type halves the weight array of, e.g., the airport network.
+template <class Weight>
+class BasicCsrGraph {
+ public:
+  //
+  // Constructors and Destructors
+  //
+
+  // Creates a snapshot of the edges of `graph`. For an undirected graph, every
+  // edge appears as an out-edge of both of its vertices.
+  //
+  // Throws a std::range_error exception if the weight of an edge cannot be
+  // represented as a Weight (e.g., is negative or above 65535 for
+  // std::uint16_t).
+  template <class Graph>
+  explicit BasicCsrGraph(const Graph& graph);
+
+  // The copy constructor.
+  BasicCsrGraph(const BasicCsrGraph& other) = default;
+
+  // The copy assignment constructor.
+  BasicCsrGraph& operator=(const BasicCsrGraph& other) = default;
+
+  // The move constructor.
+  BasicCsrGraph(BasicCsrGraph&& other) = default;
+
+  // The move assignment constructor.
+  BasicCsrGraph& operator=(BasicCsrGraph&& other) = default;
+
+  // The destructor.
+  ~BasicCsrGraph() = default;
+
+  //
+  // Accessors
+  //
+
+  // Returns the number of vertices in the graph.
+  int vertex_count() const noexcept;
+
+  // Returns the number of (directed) edges stored.
+  int edge_count() const noexcept;
+
+  // Returns the position in targets() and weights() of the first out-edge of
+  // vertex i. The out-edges of vertex i are at positions offset(i) up to (but
+  // not including) offset(i + 1).
+  //
+  // ASSUMES: 0 <= i <= vertex_count().
+  int offset(const int i) const noexcept;
+
+  // Returns the targets of the edges, grouped by source vertex.
+  const std::vector<int>& targets() const noexcept;
+
+  // Returns the weights of the edges, in the same order as targets().
+  const std::vector<Weight>& weights() const noexcept;
+
+  // Returns the weight of the edge from vertex i to vertex j.
+  //
+  // Throws a std::range_error exception if 0 <= i, j < vertex_count() is
+  // violated, or a std::invalid_argument exception if there is no such edge.
+  Weight edge_weight(const int i, const int j) const;
+
+  // Returns the graph with every edge reversed, i.e., the graph whose out-edges
+  // are the in-edges of this graph.
+  BasicCsrGraph transpose() const;
+
+  //
+  // Modifiers
+  //
+
+  // Sets the weight of the edge from vertex i to vertex j, adding the edge
+  // (after the other out-edges of i) if there is none.
+  //
+  // Throws a std::range_error exception if 0 <= i, j < vertex_count() is
+  // violated.
+  void set_edge(const int i, const int j, const Weight weight);
+
+  // Removes the edge from vertex i to vertex j.
+  //
+  // Throws a std::range_error exception if 0 <= i, j < vertex_count() is
+  // violated, or a std::invalid_argument exception if there is no such edge.
+  void remove_edge(const int i, const int j);
+
+ private:
+  // Creates an empty snapshot with vertex_count-many vertices.
+  explicit BasicCsrGraph(const int vertex_count);
+
+  // Returns the position in targets_ of the edge from vertex i to vertex j, or
+  // -1 if there is no such edge.
+  //
+  // Throws a std::range_error exception if 0 <= i, j < vertex_count() is
+  // violated.
+  int find_edge(const int i, const int j) const;
+
+  // The positions of the first out-edge of each vertex, followed by the total
+  // number of edges. Has vertex_count() + 1 elements.
+  std::vector<int> offsets_;
+
+  // The targets of the edges, grouped by source vertex.
+  std::vector<int> targets_;
+
+  // The weights of the edges, in the same order as targets_.
+  std::vector<Weight> weights_;
+};
+
+// The snapshot with int weights, used by the traversals and indexes of the
+// airport network.
+using CsrGraph = BasicCsrGraph<int>;
+
+#endif
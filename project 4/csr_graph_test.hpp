@@ -0,0 +1,104 @@
+#ifndef _csr_graph_test_hpp_
+#define _csr_graph_test_hpp_
+
+// Unit tests for the CsrGraph class.
+#include "csr_graph.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "adjacency_list_graph.hpp"
+#include "adjacency_matrix_graph.hpp"
+#include "doctest.hpp"
+#include "undirected_graph.hpp"
+
+TEST_CASE("CsrGraph") {
+  SUBCASE("EmptyGraph") {
+    const CsrGraph csr(AdjacencyListGraph(0));
+    CHECK_EQ(csr.vertex_count(), 0);
+    CHECK_EQ(csr.edge_count(), 0);
+    CHECK_EQ(csr.transpose().vertex_count(), 0);
+  }
+
+  SUBCASE("DirectedGraph") {
+    AdjacencyMatrixGraph graph(4);
+    graph.add_edge(0, 1, 5);
+    graph.add_edge(0, 3, 6);
+    graph.add_edge(2, 0, 7);
+    const CsrGraph csr(graph);
+    CHECK_EQ(csr.vertex_count(), 4);
+    CHECK_EQ(csr.edge_count(), 3);
+    CHECK_EQ(csr.offset(0), 0);
+    CHECK_EQ(csr.offset(1), 2);
+    CHECK_EQ(csr.offset(2), 2);
+    CHECK_EQ(csr.offset(3), 3);
+    CHECK_EQ(csr.offset(4), 3);
+    CHECK_EQ(csr.targets(), std::vector<int>({1, 3, 0}));
+    CHECK_EQ(csr.weights(), std::vector<int>({5, 6, 7}));
+
+    const CsrGraph transposed = csr.transpose();
+    CHECK_EQ(transposed.edge_count(), 3);
+    CHECK_EQ(transposed.offset(1), 1);
+    CHECK_EQ(transposed.offset(2), 2);
+    CHECK_EQ(transposed.targets(), std::vector<int>({2, 0, 0}));
+    CHECK_EQ(transposed.weights(), std::vector<int>({7, 5, 6}));
+  }
+
+  SUBCASE("UndirectedGraphIsSymmetric") {
+    UndirectedGraph<AdjacencyMatrixGraph> graph(3);
+    graph.add_edge(0, 1, 2);
+    graph.add_edge(1, 2, 3);
+    const CsrGraph csr(graph);
+    CHECK_EQ(csr.edge_count(), 4);
+    const CsrGraph transposed = csr.transpose();
+    CHECK_EQ(transposed.targets(), csr.targets());
+    CHECK_EQ(transposed.weights(), csr.weights());
+  }
+
+  SUBCASE("SetAndRemoveEdges") {
+    AdjacencyMatrixGraph graph(4);
+    graph.add_edge(0, 1, 5);
+    graph.add_edge(0, 3, 6);
+    graph.add_edge(2, 0, 7);
+    CsrGraph csr(graph);
+    CHECK_EQ(csr.edge_weight(0, 3), 6);
+    CHECK_THROWS_AS(csr.edge_weight(1, 0), std::invalid_argument);
+    CHECK_THROWS_AS(csr.edge_weight(0, 4), std::range_error);
+
+    csr.set_edge(0, 3, 8);
+    csr.set_edge(1, 2, 9);
+    CHECK_EQ(csr.edge_count(), 4);
+    CHECK_EQ(csr.offset(2), 3);
+    CHECK_EQ(csr.offset(4), 4);
+    CHECK_EQ(csr.targets(), std::vector<int>({1, 3, 2, 0}));
+    CHECK_EQ(csr.weights(), std::vector<int>({5, 8, 9, 7}));
+
+    csr.remove_edge(0, 1);
+    CHECK_EQ(csr.edge_count(), 3);
+    CHECK_EQ(csr.offset(1), 1);
+    CHECK_EQ(csr.targets(), std::vector<int>({3, 2, 0}));
+    CHECK_EQ(csr.weights(), std::vector<int>({8, 9, 7}));
+    CHECK_THROWS_AS(csr.remove_edge(0, 1), std::invalid_argument);
+    CHECK_THROWS_AS(csr.set_edge(-1, 1, 1), std::range_error);
+  }
+
+  SUBCASE("NarrowWeights") {
+    AdjacencyListGraph graph(3);
+    graph.add_edge(0, 1, 65535);
+    graph.add_edge(1, 2, 3);
+    const BasicCsrGraph<std::uint16_t> narrow(graph);
+    CHECK_EQ(narrow.weights(), std::vector<std::uint16_t>({65535, 3}));
+    CHECK_EQ(narrow.transpose().edge_weight(1, 0), 65535);
+    const BasicCsrGraph<float> real(graph);
+    CHECK_EQ(real.edge_weight(1, 2), 3.0f);
+
+    graph.add_edge(2, 0, 65536);
+    CHECK_THROWS_AS(BasicCsrGraph<std::uint16_t>{graph}, std::range_error);
+    graph.add_edge(2, 0, -1);
+    CHECK_THROWS_AS(BasicCsrGraph<std::uint16_t>{graph}, std::range_error);
+    CHECK_EQ(BasicCsrGraph<std::int64_t>(graph).edge_weight(2, 0), -1);
+  }
+}
+
+#endif
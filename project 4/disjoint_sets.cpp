@@ -0,0 +1,82 @@
+#include "disjoint_sets.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+DisjointSets::DisjointSets(const int size) : count_(size) {
+  if (size < 0) {
+    throw std::invalid_argument("invalid size: " + std::to_string(size));
+  }
+  parent_.resize(size);
+  for (int v = 0; v < size; ++v) {
+    parent_[v] = v;
+  }
+  set_size_.assign(size, 1);
+}
+
+//
+// Accessors
+//
+
+int DisjointSets::size() const noexcept {
+  return parent_.size();
+}
+
+int DisjointSets::count() const noexcept {
+  return count_;
+}
+
+//
+// Modifiers
+//
+
+int DisjointSets::find(const int v) {
+  if (v < 0 || v >= parent_.size()) {
+    throw std::range_error("invalid v: " + std::to_string(v));
+  }
+  int root = v;
+  while (parent_[root] != root) {
+    root = parent_[root];
+  }
+  // Compress the path, so that later finds from any of these elements take a
+  // single step.
+  int current = v;
+  while (parent_[current] != root) {
+    const int next = parent_[current];
+    parent_[current] = root;
+    current = next;
+  }
+  return root;
+}
+
+bool DisjointSets::unite(const int a, const int b) {
+  int root_a = find(a);
+  int root_b = find(b);
+  if (root_a == root_b) {
+    return false;
+  }
+  // Hang the smaller tree under the larger one, keeping the trees shallow.
+  if (set_size_[root_a] < set_size_[root_b]) {
+    std::swap(root_a, root_b);
+  }
+  parent_[root_b] = root_a;
+  set_size_[root_a] += set_size_[root_b];
+  count_--;
+  return true;
+}
+
+std::vector<int> DisjointSets::labels() {
+  std::vector<int> label_of_root(parent_.size(), -1);
+  std::vector<int> labels(parent_.size());
+  int next_label = 0;
+  for (int v = 0; v < parent_.size(); ++v) {
+    const int root = find(v);
+    if (label_of_root[root] == -1) {
+      label_of_root[root] = next_label++;
+    }
+    labels[v] = label_of_root[root];
+  }
+  return labels;
+}
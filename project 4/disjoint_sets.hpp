@@ -0,0 +1,84 @@
+#ifndef _disjoint_sets_hpp_
+#define _disjoint_sets_hpp_
+
+#include <vector>
+
+// The DisjointSets class encapsulates a partition of the elements
+// 0, 1, ..., size() - 1 into disjoint sets, supporting merging two sets and
+// finding the set of an element (the union-find data structure).
+//
+// Sets are merged by size, and find compresses the path it walks so that every
+// element on it points directly at the representative, so any sequence of
+// operations takes nearly linear time in total.
+//
+// For more information, see
+// https://en.wikipedia.org/wiki/Disjoint-set_data_structure.
+class DisjointSets {
+ public:
+  //
+  // Constructors and Destructors
+  //
+
+  // The constructor. Creates size-many singleton sets.
+  //
+  // Throws a std::invalid_argument exception if size is negative.
+  explicit DisjointSets(const int size);
+
+  // The copy constructor.
+  DisjointSets(const DisjointSets& other) = default;
+
+  // The copy assignment constructor.
+  DisjointSets& operator=(const DisjointSets& other) = default;
+
+  // The move constructor.
+  DisjointSets(DisjointSets&& other) = default;
+
+  // The move assignment constructor.
+  DisjointSets& operator=(DisjointSets&& other) = default;
+
+  // The destructor.
+  ~DisjointSets() = default;
+
+  //
+  // Accessors
+  //
+
+  // Returns the number of elements.
+  int size() const noexcept;
+
+  // Returns the number of (disjoint) sets.
+  int count() const noexcept;
+
+  //
+  // Modifiers
+  //
+
+  // Returns the representative of the set containing element v. Two elements
+  // are in the same set exactly when they have the same representative.
+  //
+  // Throws a std::range_error exception if 0 <= v < size() is violated.
+  int find(const int v);
+
+  // Merges the sets containing elements a and b. Returns whether they were in
+  // different sets.
+  //
+  // Throws a std::range_error exception if 0 <= a, b < size() is violated.
+  bool unite(const int a, const int b);
+
+  // Returns for each element the index of its set, where the sets are numbered
+  // 0, 1, ..., count() - 1 in order of their smallest elements.
+  std::vector<int> labels();
+
+ private:
+  // The parent of each element in its set's tree. Representatives are their
+  // own parents.
+  std::vector<int> parent_;
+
+  // The number of elements of each set, meaningful only for representatives.
+  std::vector<int> set_size_;
+
+  // The number of sets.
+  int count_;
+};
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef _disjoint_sets_test_hpp_
+#define _disjoint_sets_test_hpp_
+
+// Unit tests for the DisjointSets class.
+#include "disjoint_sets.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+#include "doctest.hpp"
+
+TEST_CASE("DisjointSets") {
+  SUBCASE("NegativeSizeThrowsException") {
+    CHECK_THROWS_AS(DisjointSets(-1), std::invalid_argument);
+  }
+
+  SUBCASE("StartsWithSingletons") {
+    DisjointSets sets(4);
+    CHECK_EQ(sets.size(), 4);
+    CHECK_EQ(sets.count(), 4);
+    for (int v = 0; v < 4; ++v) {
+      CHECK_EQ(sets.find(v), v);
+    }
+    CHECK_EQ(sets.labels(), std::vector<int>({0, 1, 2, 3}));
+  }
+
+  SUBCASE("BadElementThrowsException") {
+    DisjointSets sets(4);
+    CHECK_THROWS_AS(sets.find(-1), std::range_error);
+    CHECK_THROWS_AS(sets.find(4), std::range_error);
+    CHECK_THROWS_AS(sets.unite(0, 4), std::range_error);
+  }
+
+  SUBCASE("UniteMergesSets") {
+    DisjointSets sets(6);
+    CHECK(sets.unite(4, 1));
+    CHECK(sets.unite(2, 5));
+    CHECK(sets.unite(1, 5));
+    CHECK_FALSE(sets.unite(4, 2));
+    CHECK_EQ(sets.count(), 3);
+    CHECK_EQ(sets.find(4), sets.find(2));
+    CHECK_NE(sets.find(0), sets.find(1));
+    CHECK_EQ(sets.labels(), std::vector<int>({0, 1, 1, 2, 1, 1}));
+  }
+
+  SUBCASE("LongChainIsCompressed") {
+    const int size = 100000;
+    DisjointSets sets(size);
+    for (int v = 1; v < size; ++v) {
+      sets.unite(v - 1, v);
+    }
+    CHECK_EQ(sets.count(), 1);
+    int separated = 0;
+    for (int v = 0; v < size; ++v) {
+      separated += sets.find(v) != sets.find(0);
+    }
+    CHECK_EQ(separated, 0);
+  }
+}
+
+#endif
@@ -0,0 +1,99 @@
+#include "distance_table.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+DistanceTable::DistanceTable(const int rows, const int cols, const int value)
+    : rows_(rows), cols_(cols), stride_((cols + 15) / 16 * 16) {
+  if (rows < 0 || cols < 0) {
+    throw std::invalid_argument(
+        "invalid table shape: " + std::to_string(rows) + " x " +
+            std::to_string(cols));
+  }
+  entries_.assign(
+      static_cast<long>(rows_) * stride_, std::numeric_limits<int>::max());
+  for (int i = 0; i < rows_; ++i) {
+    std::fill(row(i), row(i) + cols_, value);
+  }
+}
+
+//
+// Accessors
+//
+
+int DistanceTable::rows() const noexcept {
+  return rows_;
+}
+
+int DistanceTable::cols() const noexcept {
+  return cols_;
+}
+
+int DistanceTable::stride() const noexcept {
+  return stride_;
+}
+
+int DistanceTable::at(const int i, const int j) const {
+  if (i < 0 || i >= rows_) {
+    throw std::range_error("invalid i: " + std::to_string(i));
+  }
+  if (j < 0 || j >= cols_) {
+    throw std::range_error("invalid j: " + std::to_string(j));
+  }
+  return row(i)[j];
+}
+
+const int* DistanceTable::row(const int i) const noexcept {
+  return entries_.data() + static_cast<long>(i) * stride_;
+}
+
+std::vector<int> DistanceTable::row_vector(const int i) const {
+  if (i < 0 || i >= rows_) {
+    throw std::range_error("invalid i: " + std::to_string(i));
+  }
+  return std::vector<int>(row(i), row(i) + cols_);
+}
+
+//
+// Modifiers
+//
+
+void DistanceTable::set(const int i, const int j, const int value) {
+  if (i < 0 || i >= rows_) {
+    throw std::range_error("invalid i: " + std::to_string(i));
+  }
+  if (j < 0 || j >= cols_) {
+    throw std::range_error("invalid j: " + std::to_string(j));
+  }
+  row(i)[j] = value;
+}
+
+int* DistanceTable::row(const int i) noexcept {
+  return entries_.data() + static_cast<long>(i) * stride_;
+}
+
+//
+// Relational Operators
+//
+
+bool DistanceTable::operator==(const DistanceTable& rhs) const noexcept {
+  return rows_ == rhs.rows_ && cols_ == rhs.cols_ && entries_ == rhs.entries_;
+}
+
+bool DistanceTable::operator!=(const DistanceTable& rhs) const noexcept {
+  return !(*this == rhs);
+}
+
+std::ostream& operator<<(std::ostream& stream, const DistanceTable& table) {
+  for (int i = 0; i < table.rows(); ++i) {
+    for (int j = 0; j < table.cols(); ++j) {
+      stream << (j == 0 ? "" : " ") << table.at(i, j);
+    }
+    stream << std::endl;
+  }
+  return stream;
+}
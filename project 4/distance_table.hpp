@@ -0,0 +1,117 @@
+#ifndef _distance_table_hpp_
+#define _distance_table_hpp_
+
+#include <iostream>
+#include <vector>
+
+#include "aligned_allocator.hpp"
+
+// The DistanceTable class encapsulates a dense rows() by cols() table of
+// shortest path lengths, such as an all-pairs distance matrix or a table of
+// distances from a set of source vertices to a set of target vertices.
+//
+// An entry of std::numeric_limits<int>::max() means that no path exists.
+//
+// The entries are stored row after row in one 64-byte aligned allocation, and
+// every row is padded to a multiple of 16 ints (one AVX-512 register), so that
+// rows can be processed with aligned SIMD loads. The padding entries are
+// always std::numeric_limits<int>::max().
+class DistanceTable {
+ public:
+  //
+  // Constructors and Destructors
+  //
+
+  // The constructor. Creates a table with the given number of rows and
+  // columns, with every entry equal to `value`.
+  //
+  // Throws a std::invalid_argument exception if rows or cols is negative.
+  DistanceTable(const int rows, const int cols, const int value);
+
+  // The copy constructor.
+  DistanceTable(const DistanceTable& other) = default;
+
+  // The copy assignment constructor.
+  DistanceTable& operator=(const DistanceTable& other) = default;
+
+  // The move constructor.
+  DistanceTable(DistanceTable&& other) = default;
+
+  // The move assignment constructor.
+  DistanceTable& operator=(DistanceTable&& other) = default;
+
+  // The destructor.
+  ~DistanceTable() = default;
+
+  //
+  // Accessors
+  //
+
+  // Returns the number of rows in the table.
+  int rows() const noexcept;
+
+  // Returns the number of columns in the table.
+  int cols() const noexcept;
+
+  // Returns the number of ints between the starts of consecutive rows.
+  int stride() const noexcept;
+
+  // Returns the entry in row i and column j.
+  //
+  // Throws a std::range_error exception if 0 <= i < rows() or
+  // 0 <= j < cols() is violated.
+  int at(const int i, const int j) const;
+
+  // Returns a pointer to the (64-byte aligned) first entry of row i.
+  //
+  // ASSUMES: 0 <= i < rows().
+  const int* row(const int i) const noexcept;
+
+  // Returns row i of the table as a vector.
+  //
+  // Throws a std::range_error exception if 0 <= i < rows() is violated.
+  std::vector<int> row_vector(const int i) const;
+
+  //
+  // Modifiers
+  //
+
+  // Sets the entry in row i and column j to `value`.
+  //
+  // Throws a std::range_error exception if 0 <= i < rows() or
+  // 0 <= j < cols() is violated.
+  void set(const int i, const int j, const int value);
+
+  // Returns a pointer to the (64-byte aligned) first entry of row i.
+  //
+  // ASSUMES: 0 <= i < rows(). Entries past cols() must not be modified.
+  int* row(const int i) noexcept;
+
+  //
+  // Relational Operators
+  //
+
+  // Returns whether two tables have the same shape and entries.
+  bool operator==(const DistanceTable& rhs) const noexcept;
+
+  // Returns whether two tables differ in shape or in any entry.
+  bool operator!=(const DistanceTable& rhs) const noexcept;
+
+ private:
+  // The number of rows in the table.
+  int rows_;
+
+  // The number of columns in the table.
+  int cols_;
+
+  // The number of ints between the starts of consecutive rows.
+  int stride_;
+
+  // The entries of the table, with entry (i, j) at index i * stride_ + j.
+  std::vector<int, AlignedAllocator<int>> entries_;
+};
+
+// Writes the table to `stream`, one row per line.
+std::ostream& operator<<(std::ostream& stream, const DistanceTable& table);
+
+#endif
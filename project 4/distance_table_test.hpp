@@ -0,0 +1,52 @@
+#ifndef _distance_table_test_hpp_
+#define _distance_table_test_hpp_
+
+// Unit tests for the DistanceTable class.
+#include "distance_table.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "doctest.hpp"
+
+TEST_CASE("DistanceTable") {
+  SUBCASE("NegativeShapeThrowsException") {
+    CHECK_THROWS_AS(DistanceTable(-1, 2, 0), std::invalid_argument);
+    CHECK_THROWS_AS(DistanceTable(2, -1, 0), std::invalid_argument);
+  }
+
+  SUBCASE("ConstructorFillsEntries") {
+    const DistanceTable table(3, 20, 7);
+    CHECK_EQ(table.rows(), 3);
+    CHECK_EQ(table.cols(), 20);
+    CHECK_EQ(table.stride() % 16, 0);
+    CHECK_EQ(table.row_vector(2), std::vector<int>(20, 7));
+  }
+
+  SUBCASE("RowsAreAligned") {
+    const DistanceTable table(4, 5, 0);
+    for (int i = 0; i < table.rows(); ++i) {
+      CHECK_EQ(reinterpret_cast<std::uintptr_t>(table.row(i)) % 64, 0);
+    }
+  }
+
+  SUBCASE("SetAndAt") {
+    DistanceTable table(2, 2, 0);
+    table.set(1, 0, 42);
+    CHECK_EQ(table.at(1, 0), 42);
+    CHECK_EQ(table.at(0, 1), 0);
+    CHECK_THROWS_AS(table.at(2, 0), std::range_error);
+    CHECK_THROWS_AS(table.set(0, -1, 1), std::range_error);
+  }
+
+  SUBCASE("Equality") {
+    DistanceTable table(2, 3, 1);
+    CHECK_EQ(table, DistanceTable(2, 3, 1));
+    table.set(0, 0, 2);
+    CHECK_NE(table, DistanceTable(2, 3, 1));
+    CHECK_NE(DistanceTable(3, 2, 1), DistanceTable(2, 3, 1));
+  }
+}
+
+#endif
@@ -1,33 +1,45 @@
 #include "edge.hpp"
 
+#include <cstdint>
 #include <stdexcept>
 
-Edge::Edge(const int i, const int j, const int weight)
+template <class Weight>
+BasicEdge<Weight>::BasicEdge(const int i, const int j, const Weight weight)
     : i_(i), j_(j), weight_(weight) {
   if (weight == 0) {
     throw std::invalid_argument("weight must be non-zero");
   }
 }
 
-int Edge::i() const noexcept {
+template <class Weight>
+int BasicEdge<Weight>::i() const noexcept {
   return i_;
 }
 
-int Edge::j() const noexcept {
+template <class Weight>
+int BasicEdge<Weight>::j() const noexcept {
   return j_;
 }
 
-int Edge::weight() const noexcept {
+template <class Weight>
+Weight BasicEdge<Weight>::weight() const noexcept {
   return weight_;
 }
 
-void Edge::set_weight(const int weight) {
+template <class Weight>
+void BasicEdge<Weight>::set_weight(const Weight weight) {
   if (weight == 0) {
     throw std::invalid_argument("weight must be non-zero");
   }
   weight_ = weight;
 }
 
-bool Edge::operator==(const Edge& rhs) const noexcept {
+template <class Weight>
+bool BasicEdge<Weight>::operator==(const BasicEdge& rhs) const noexcept {
   return i() == rhs.i() && j() == rhs.j() && weight() == rhs.weight();
-}
\ No newline at end of file
+}
+
+template class BasicEdge<std::uint16_t>;
+template class BasicEdge<std::int32_t>;
+template class BasicEdge<std::int64_t>;
+template class BasicEdge<float>;
\ No newline at end of file
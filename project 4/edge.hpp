@@ -1,12 +1,20 @@
 #ifndef _edge_hpp_
 #define _edge_hpp_
 
-// The Edge class encapsulates a non-zero weighted edge from an outbound
-// (source) vertex i to an inbound (desination) vertex j.
+// The BasicEdge class template encapsulates a non-zero weighted edge from an
+// outbound (source) vertex i to an inbound (desination) vertex j.
 //
 // The edge can be a loop, i.e., the case i == j is allowed.
-class Edge {
+//
+// The template parameter Weight is the type of the weight; it is instantiated
+// for std::uint16_t, std::int32_t, std::int64_t and float, as are the graphs
+// storing BasicEdges (see path_length.hpp for the matching PathLength types).
+template <class Weight = int>
+class BasicEdge {
  public:
+  // The type of the weight.
+  using WeightType = Weight;
+
   //
   // Constructors and Destructors
   //
@@ -14,16 +22,16 @@ class Edge {
   // The constructor.
   //
   // Throws an std::invalid_argument exception if weight is zero.
-  Edge(const int i, const int j, const int weight = 1);
+  BasicEdge(const int i, const int j, const Weight weight = 1);
 
   // The copy constructor is the default.
-  Edge(const Edge& other) = default;
+  BasicEdge(const BasicEdge& other) = default;
 
   // The copy assignment constructor is the default.
-  Edge& operator=(const Edge& rhs) = default;
+  BasicEdge& operator=(const BasicEdge& rhs) = default;
 
   // The destructor is the default.
-  ~Edge() = default;
+  ~BasicEdge() = default;
 
   //
   // Accessors
@@ -36,7 +44,7 @@ class Edge {
   int j() const noexcept;
 
   // Returns the weight of the edge.
-  int weight() const noexcept;
+  Weight weight() const noexcept;
 
   //
   // Modifiers
@@ -45,14 +53,14 @@ class Edge {
   // Updates the weight of the edge.
   //
   // Throws an std::invalid_argument exception if weight is zero.
-  void set_weight(const int weight);
+  void set_weight(const Weight weight);
 
   //
   // Relational Operators
   //
 
   // Returns whether two edges are equal (i.e., the vertices and weights are the same).
-  bool operator==(const Edge& rhs) const noexcept;
+  bool operator==(const BasicEdge& rhs) const noexcept;
 
  private:
   // The index of the outbound (source) vertex.
@@ -62,7 +70,10 @@ class Edge {
   int j_;
 
   // The (non-zero) weight of the edge.
-  int weight_; 
+  Weight weight_;
 };
 
+// The edge with int weights, used by the graphs unless told otherwise.
+using Edge = BasicEdge<int>;
+
 #endif
\ No newline at end of file
@@ -0,0 +1,231 @@
+#include "edge_index.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+//
+// Accessors
+//
+
+template <class Weight>
+int BasicEdgeIndex<Weight>::size() const noexcept {
+  return size_;
+}
+
+template <class Weight>
+bool BasicEdgeIndex<Weight>::hashed() const noexcept {
+  return hashed_;
+}
+
+template <class Weight>
+bool BasicEdgeIndex<Weight>::contains(const int j) const noexcept {
+  return find(j) != nullptr;
+}
+
+template <class Weight>
+const Weight* BasicEdgeIndex<Weight>::find(const int j) const noexcept {
+  const int position = hashed_ ? find_slot(j) : find_flat(j);
+  if (position < 0) {
+    return nullptr;
+  }
+  return &weights_[position];
+}
+
+//
+// Modifiers
+//
+
+template <class Weight>
+bool BasicEdgeIndex<Weight>::insert_or_assign(
+    const int j, const Weight weight) {
+  if (!hashed_) {
+    const std::vector<int>::iterator iter =
+        std::lower_bound(keys_.begin(), keys_.end(), j);
+    const int position = iter - keys_.begin();
+    if (iter != keys_.end() && *iter == j) {
+      weights_[position] = weight;
+      return false;
+    }
+    keys_.insert(iter, j);
+    weights_.insert(weights_.begin() + position, weight);
+    size_++;
+    if (size_ > kHashThreshold) {
+      rehash(4 * kHashThreshold);
+    }
+    return true;
+  }
+
+  const int existing = find_slot(j);
+  if (existing >= 0) {
+    weights_[existing] = weight;
+    return false;
+  }
+  // Keep the load factor (counting erased slots, which still lengthen probe
+  // sequences) at most one half.
+  const int capacity = keys_.size();
+  if (2 * (size_ + erased_ + 1) > capacity) {
+    rehash(2 * (size_ + 1) > capacity / 2 ? 2 * capacity : capacity);
+  }
+  const int mask = keys_.size() - 1;
+  int slot = home_slot(j, keys_.size());
+  while (keys_[slot] >= 0) {
+    slot = (slot + 1) & mask;
+  }
+  if (keys_[slot] == kErasedSlot) {
+    erased_--;
+  }
+  keys_[slot] = j;
+  weights_[slot] = weight;
+  size_++;
+  return true;
+}
+
+template <class Weight>
+bool BasicEdgeIndex<Weight>::erase(const int j) {
+  if (!hashed_) {
+    const int position = find_flat(j);
+    if (position < 0) {
+      return false;
+    }
+    keys_.erase(keys_.begin() + position);
+    weights_.erase(weights_.begin() + position);
+    size_--;
+    return true;
+  }
+
+  const int slot = find_slot(j);
+  if (slot < 0) {
+    return false;
+  }
+  keys_[slot] = kErasedSlot;
+  erased_++;
+  size_--;
+  // Switching back at a quarter of the threshold (rather than at the
+  // threshold) avoids thrashing between representations when edges are
+  // repeatedly added and removed around the threshold.
+  if (size_ <= kHashThreshold / 4) {
+    flatten();
+  }
+  return true;
+}
+
+//
+// Helpers
+//
+
+template <class Weight>
+int BasicEdgeIndex<Weight>::find_flat(const int j) const noexcept {
+  const int count = keys_.size();
+  if (count <= kLinearScanLimit) {
+    int position = 0;
+#ifdef __SSE2__
+    // Compare four destinations at a time against j.
+    const __m128i needle = _mm_set1_epi32(j);
+    for (; position + 4 <= count; position += 4) {
+      const __m128i block = _mm_loadu_si128(
+          reinterpret_cast<const __m128i*>(keys_.data() + position));
+      const int mask = _mm_movemask_ps(
+          _mm_castsi128_ps(_mm_cmpeq_epi32(block, needle)));
+      if (mask != 0) {
+        return position + __builtin_ctz(mask);
+      }
+    }
+#endif
+    for (; position < count; ++position) {
+      if (keys_[position] == j) {
+        return position;
+      }
+    }
+    return -1;
+  }
+  const std::vector<int>::const_iterator iter =
+      std::lower_bound(keys_.begin(), keys_.end(), j);
+  if (iter == keys_.end() || *iter != j) {
+    return -1;
+  }
+  return iter - keys_.begin();
+}
+
+template <class Weight>
+int BasicEdgeIndex<Weight>::find_slot(const int j) const noexcept {
+  if (j < 0) {
+    return -1;
+  }
+  const int mask = keys_.size() - 1;
+  int slot = home_slot(j, keys_.size());
+  // The table always has an empty slot, so the probe sequence terminates.
+  while (keys_[slot] != kEmptySlot) {
+    if (keys_[slot] == j) {
+      return slot;
+    }
+    slot = (slot + 1) & mask;
+  }
+  return -1;
+}
+
+template <class Weight>
+int BasicEdgeIndex<Weight>::home_slot(
+    const int j, const int capacity) noexcept {
+  // Fibonacci hashing: vertex ids are dense and often consecutive, so the
+  // multiplication spreads them across the table before masking.
+  const std::uint64_t hash =
+      static_cast<std::uint64_t>(j) * UINT64_C(11400714819323198485);
+  return (hash >> 32) & (capacity - 1);
+}
+
+template <class Weight>
+void BasicEdgeIndex<Weight>::rehash(const int capacity) {
+  std::vector<int> old_keys(capacity, kEmptySlot);
+  std::vector<Weight> old_weights(capacity, 0);
+  old_keys.swap(keys_);
+  old_weights.swap(weights_);
+
+  for (int position = 0; position < old_keys.size(); ++position) {
+    const int j = old_keys[position];
+    if (j < 0) {
+      continue;
+    }
+    int slot = home_slot(j, capacity);
+    while (keys_[slot] != kEmptySlot) {
+      slot = (slot + 1) & (capacity - 1);
+    }
+    keys_[slot] = j;
+    weights_[slot] = old_weights[position];
+  }
+  erased_ = 0;
+  hashed_ = true;
+}
+
+template <class Weight>
+void BasicEdgeIndex<Weight>::flatten() {
+  std::vector<std::pair<int, Weight>> entries;
+  entries.reserve(size_);
+  for (int slot = 0; slot < keys_.size(); ++slot) {
+    if (keys_[slot] >= 0) {
+      entries.emplace_back(keys_[slot], weights_[slot]);
+    }
+  }
+  std::sort(entries.begin(), entries.end());
+
+  keys_.clear();
+  weights_.clear();
+  for (const std::pair<int, Weight>& entry : entries) {
+    keys_.push_back(entry.first);
+    weights_.push_back(entry.second);
+  }
+  keys_.shrink_to_fit();
+  weights_.shrink_to_fit();
+  erased_ = 0;
+  hashed_ = false;
+}
+
+template class BasicEdgeIndex<std::uint16_t>;
+template class BasicEdgeIndex<std::int32_t>;
+template class BasicEdgeIndex<std::int64_t>;
+template class BasicEdgeIndex<float>;
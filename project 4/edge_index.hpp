@@ -0,0 +1,133 @@
+#ifndef _edge_index_hpp_
+#define _edge_index_hpp_
+
+#include <vector>
+
+// The BasicEdgeIndex class template maps the destination vertices j of the
+// edges leaving a single vertex i to the weights of those edges, stored as
+// Weight (instantiated for the weight types of BasicEdge).
+//
+// The index adapts its representation to the degree of the vertex:
+//
+// * While the vertex has at most kHashThreshold edges, the destinations are
+//   kept in a flat array sorted in increasing order, with the weights in a
+//   parallel array. Lookups use a (SIMD) linear scan when the array is very
+//   small and binary search otherwise.
+// * Once the vertex has more than kHashThreshold edges, the index switches to
+//   an open-addressing hash table with linear probing, so that lookups on
+//   high-degree vertices (hub airports) take expected constant time.
+template <class Weight = int>
+class BasicEdgeIndex {
+ public:
+  //
+  // Constructors and Destructors
+  //
+
+  // The default constructor. Creates an empty index.
+  BasicEdgeIndex() = default;
+
+  // The copy constructor.
+  BasicEdgeIndex(const BasicEdgeIndex& other) = default;
+
+  // The copy assignment constructor.
+  BasicEdgeIndex& operator=(const BasicEdgeIndex& other) = default;
+
+  // The move constructor.
+  BasicEdgeIndex(BasicEdgeIndex&& other) = default;
+
+  // The move assignment constructor.
+  BasicEdgeIndex& operator=(BasicEdgeIndex&& other) = default;
+
+  // The destructor.
+  ~BasicEdgeIndex() = default;
+
+  //
+  // Accessors
+  //
+
+  // Returns the number of destinations in the index.
+  int size() const noexcept;
+
+  // Returns whether the index uses the hash table representation.
+  bool hashed() const noexcept;
+
+  // Returns whether j is a destination in the index.
+  bool contains(const int j) const noexcept;
+
+  // Returns a pointer to the weight stored for destination j, or nullptr if j
+  // is not a destination in the index.
+  //
+  // The pointer is invalidated by any call to a modifier.
+  const Weight* find(const int j) const noexcept;
+
+  //
+  // Modifiers
+  //
+
+  // Stores `weight` as the weight for destination j, adding j to the index if
+  // it is not already present.
+  //
+  // Returns whether j was added (as opposed to having its weight updated).
+  //
+  // ASSUMES: j is non-negative.
+  bool insert_or_assign(const int j, const Weight weight);
+
+  // Removes destination j from the index.
+  //
+  // Returns whether j was present in the index.
+  bool erase(const int j);
+
+ private:
+  // The largest flat array that is searched with a linear scan rather than
+  // with binary search.
+  static constexpr int kLinearScanLimit = 16;
+
+  // The largest number of destinations kept in the flat representation.
+  static constexpr int kHashThreshold = 64;
+
+  // The marker for a hash table slot that has never held a destination.
+  static constexpr int kEmptySlot = -1;
+
+  // The marker for a hash table slot whose destination has been erased.
+  static constexpr int kErasedSlot = -2;
+
+  // Returns the position of j in the flat representation, or -1 if j is not
+  // present.
+  int find_flat(const int j) const noexcept;
+
+  // Returns the hash table slot holding j, or -1 if j is not present.
+  int find_slot(const int j) const noexcept;
+
+  // Returns the home slot of j in a hash table with `capacity` slots.
+  static int home_slot(const int j, const int capacity) noexcept;
+
+  // Rebuilds the hash table with `capacity` slots (a power of two), dropping
+  // erased slots.
+  void rehash(const int capacity);
+
+  // Converts the hash table back to the (sorted) flat representation.
+  void flatten();
+
+  // The number of destinations in the index.
+  int size_ = 0;
+
+  // The number of hash table slots marked kErasedSlot.
+  int erased_ = 0;
+
+  // Whether keys_ and weights_ hold a hash table rather than a flat array.
+  bool hashed_ = false;
+
+  // The destinations in the index. In the flat representation this holds
+  // exactly size_ destinations in increasing order; in the hash table
+  // representation this holds the slots of the table.
+  std::vector<int> keys_;
+
+  // The weight of the edge to the destination at the same position in keys_.
+  std::vector<Weight> weights_;
+};
+
+// The index with int weights (or, as UndirectedGraph<SymmetricEdges> uses
+// it, positions).
+using EdgeIndex = BasicEdgeIndex<int>;
+
+#endif
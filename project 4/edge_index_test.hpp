@@ -0,0 +1,81 @@
+#ifndef _edge_index_test_hpp_
+#define _edge_index_test_hpp_
+
+// Unit tests for the EdgeIndex class.
+#include "edge_index.hpp"
+
+#include "doctest.hpp"
+
+TEST_CASE("EdgeIndex") {
+  SUBCASE("EmptyIndex") {
+    EdgeIndex index;
+    CHECK_EQ(index.size(), 0);
+    CHECK_FALSE(index.hashed());
+    CHECK_FALSE(index.contains(0));
+    CHECK_EQ(index.find(3), nullptr);
+    CHECK_FALSE(index.erase(3));
+  }
+
+  SUBCASE("SmallIndexStaysFlat") {
+    EdgeIndex index;
+    for (int j = 10; j >= 0; --j) {
+      CHECK(index.insert_or_assign(j, j + 100));
+    }
+    CHECK_EQ(index.size(), 11);
+    CHECK_FALSE(index.hashed());
+    for (int j = 0; j <= 10; ++j) {
+      REQUIRE(index.find(j) != nullptr);
+      CHECK_EQ(*index.find(j), j + 100);
+    }
+    CHECK_FALSE(index.contains(11));
+  }
+
+  SUBCASE("InsertOrAssignUpdatesWeight") {
+    EdgeIndex index;
+    CHECK(index.insert_or_assign(4, 1));
+    CHECK_FALSE(index.insert_or_assign(4, 7));
+    CHECK_EQ(index.size(), 1);
+    CHECK_EQ(*index.find(4), 7);
+  }
+
+  SUBCASE("LargeIndexIsHashed") {
+    EdgeIndex index;
+    for (int j = 0; j < 1000; ++j) {
+      index.insert_or_assign(3 * j, j + 1);
+    }
+    CHECK(index.hashed());
+    CHECK_EQ(index.size(), 1000);
+    for (int j = 0; j < 1000; ++j) {
+      REQUIRE(index.find(3 * j) != nullptr);
+      CHECK_EQ(*index.find(3 * j), j + 1);
+      CHECK_FALSE(index.contains(3 * j + 1));
+    }
+    CHECK_FALSE(index.insert_or_assign(0, 5));
+    CHECK_EQ(*index.find(0), 5);
+  }
+
+  SUBCASE("EraseShrinksBackToFlat") {
+    EdgeIndex index;
+    for (int j = 0; j < 200; ++j) {
+      index.insert_or_assign(j, j + 1);
+    }
+    for (int j = 0; j < 200; j += 2) {
+      CHECK(index.erase(j));
+      CHECK_FALSE(index.erase(j));
+    }
+    CHECK_EQ(index.size(), 100);
+    for (int j = 0; j < 200; ++j) {
+      CHECK_EQ(index.contains(j), j % 2 == 1);
+    }
+    for (int j = 1; j < 190; j += 2) {
+      index.erase(j);
+    }
+    CHECK_FALSE(index.hashed());
+    CHECK_EQ(index.size(), 5);
+    for (int j = 191; j < 200; j += 2) {
+      CHECK_EQ(*index.find(j), j + 1);
+    }
+  }
+}
+
+#endif
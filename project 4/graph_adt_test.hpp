@@ -127,6 +127,22 @@ TEST_CASE_TEMPLATE_DEFINE("GraphAbstractDataType", GraphT, test_id) {
         CHECK_EQ(actual_out_edges_set, expected_out_edges_set);
       }
     }
+
+    SUBCASE("RemoveEdge") {
+      graph.remove_edge(1, 3);
+      graph.remove_edge(4, 4);
+      CHECK_EQ(graph.edge_count(), kNumVertices * kNumVertices - 2);
+      CHECK_FALSE(graph.has_edge(1, 3));
+      CHECK_FALSE(graph.has_edge(4, 4));
+      CHECK(graph.has_edge(3, 1));
+      CHECK_EQ(graph.edges().size(), kNumVertices * kNumVertices - 2);
+      CHECK_THROWS_AS(graph.remove_edge(1, 3), std::invalid_argument);
+      CHECK_THROWS_AS(graph.edge_weight(1, 3), std::invalid_argument);
+
+      graph.add_edge(1, 3, kEdgeWeight);
+      CHECK_EQ(graph.edge_count(), kNumVertices * kNumVertices - 1);
+      CHECK_EQ(graph.edge_weight(1, 3), kEdgeWeight);
+    }
   }
 }
 
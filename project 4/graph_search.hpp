@@ -0,0 +1,312 @@
+#ifndef _graph_search_hpp_
+#define _graph_search_hpp_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__cpp_concepts)
+#include <concepts>
+#endif
+
+#include "bounds_check.hpp"
+#include "path_length.hpp"
+#include "traversal_workspace.hpp"
+
+// Header-only breadth first search, depth first search and Djikstra's
+// algorithm over any graph implementing the Graph ADT, driven by a visitor.
+//
+// Being templates defined in this header, the searches are instantiated (and
+// the callbacks of the visitor inlined into them) wherever they are used, so
+// a new graph type needs no explicit instantiation. The same holds for the
+// functions of graph_traversal.hpp built on these searches.
+//
+// A visitor is any type with the callbacks below (see SearchVisitor for one
+// that ignores every event, to derive from):
+//
+// * on_discover(v, distance) is called when vertex v is first reached, with
+//   its distance from vertex start (in edges, or for Djikstra's algorithm
+//   its first tentative distance).
+// * on_relax(u, v, distance) is called by Djikstra's algorithm when the edge
+//   from vertex u to vertex v gives v a shorter tentative distance, before v
+//   is updated. It returns whether to take the new distance; returning false
+//   (e.g., for a distance beyond some bound) leaves v as it was.
+// * on_settle(v, distance) is called when vertex v is expanded: when it leaves
+//   the queue of a breadth first search, once all of its out-edges have been
+//   explored by a depth first search (with its depth), and when Djikstra's
+//   algorithm settles it at its final distance.
+// * should_stop() is called after every on_settle (and, for a depth first
+//   search, after every on_discover). Once it returns true, the search
+//   returns right away.
+//
+// Each search takes its scratch state from a BasicTraversalWorkspace, which is
+// left holding the distances of the vertices reached (see the searches below),
+// and returns whether it ran to completion (false if should_stop stopped it).
+//
+// Once a search has checked vertex start, it reads the graph through an
+// UncheckedView (see bounds_check.hpp): every other vertex it passes the
+// graph came from out_edges, so checking it again would only cost time.
+// The distances passed to the visitor have the Distance type of the
+// workspace; for Djikstra's algorithm, PathLengthWorkspace<Graph> gives the
+// distances the PathLength of the edge weights (see path_length.hpp).
+//
+// Compiled as C++20, the graph and visitor types are checked against the
+// concepts below; compiled as an earlier standard, they are unconstrained.
+
+#if defined(__cpp_concepts)
+
+// A graph with vertex_count() and out_edges(i) (a random access range of
+// vertices) as in the Graph ADT, as needed by the unweighted searches.
+template <class Graph>
+concept GraphAdt = requires(const Graph& graph, const int i) {
+  { graph.vertex_count() } -> std::convertible_to<int>;
+  { graph.out_edges(i)[0] } -> std::convertible_to<int>;
+  { std::size(graph.out_edges(i)) } -> std::convertible_to<std::size_t>;
+};
+
+// A GraphAdt that also has edge_weight(i, j), of an arithmetic type, as needed
+// by Djikstra's algorithm.
+template <class Graph>
+concept WeightedGraphAdt =
+    GraphAdt<Graph> && requires(const Graph& graph, const int i) {
+      requires std::is_arithmetic_v<decltype(graph.edge_weight(i, i))>;
+    };
+
+// A visitor for the searches, as described above, given distances of type
+// Distance.
+template <class Visitor, class Distance>
+concept GraphVisitor =
+    requires(Visitor& visitor, const int v, const Distance distance) {
+      visitor.on_discover(v, distance);
+      { visitor.on_relax(v, v, distance) } -> std::convertible_to<bool>;
+      visitor.on_settle(v, distance);
+      { visitor.should_stop() } -> std::convertible_to<bool>;
+    };
+
+#define GRAPH_SEARCH_GRAPH GraphAdt
+#define GRAPH_SEARCH_WEIGHTED_GRAPH WeightedGraphAdt
+#define GRAPH_SEARCH_VISITOR GraphVisitor<Distance>
+
+#else
+
+#define GRAPH_SEARCH_GRAPH class
+#define GRAPH_SEARCH_WEIGHTED_GRAPH class
+#define GRAPH_SEARCH_VISITOR class
+
+#endif
+
+// The type of the edge weights of Graph.
+template <class Graph>
+using GraphWeight = decltype(std::declval<const Graph&>().edge_weight(0, 0));
+
+// The workspace whose distances are the PathLength of the edge weights of
+// Graph (see path_length.hpp), wide enough that the paths found by
+// djikstra_search do not overflow in practice.
+template <class Graph>
+using PathLengthWorkspace =
+    BasicTraversalWorkspace<typename PathLength<GraphWeight<Graph>>::type>;
+
+// The SearchVisitor struct is a visitor that ignores every event and never
+// stops a search. Visitors derive from it and hide the callbacks they need.
+struct SearchVisitor {
+  template <class Distance>
+  void on_discover(const int, const Distance) {}
+
+  template <class Distance>
+  bool on_relax(const int, const int, const Distance) {
+    return true;
+  }
+
+  template <class Distance>
+  void on_settle(const int, const Distance) {}
+
+  bool should_stop() {
+    return false;
+  }
+};
+
+// Runs a breadth first search of `graph` from vertex start.
+//
+// Afterwards the vertices reached are in workspace.touched(), in breadth
+// first order, with their distances (in edges) in workspace.distance.
+//
+// Throws a std::range_error exception if start is not a valid vertex.
+template <
+    GRAPH_SEARCH_GRAPH Graph, class Distance, GRAPH_SEARCH_VISITOR Visitor>
+bool breadth_first_search(
+    const Graph& graph, const int start,
+    BasicTraversalWorkspace<Distance>& workspace, Visitor& visitor) {
+  if (start < 0 || start >= graph.vertex_count()) {
+    throw std::range_error("Not a valid index");
+  }
+  const UncheckedView<Graph> view(graph);
+  workspace.reset(graph.vertex_count());
+  workspace.set_distance(start, 0);
+  visitor.on_discover(start, Distance{0});
+
+  // The touched vertices are in breadth first order, so they double as the
+  // queue of the search. The list grows while it is walked, so it is indexed
+  // rather than iterated.
+  for (std::size_t k = 0; k < workspace.touched().size(); ++k) {
+    const int current = workspace.touched()[k];
+    const Distance edges = workspace.distance(current);
+    visitor.on_settle(current, edges);
+    if (visitor.should_stop()) {
+      return false;
+    }
+    for (const int v : view.out_edges(current)) {
+      if (!workspace.seen(v)) {
+        const Distance distance = edges + 1;
+        workspace.set_distance(v, distance);
+        visitor.on_discover(v, distance);
+      }
+    }
+  }
+  return true;
+}
+
+// Runs a depth first search of `graph` from vertex start.
+//
+// Afterwards the vertices reached are in workspace.touched(), in the order in
+// which they were discovered, with their depths in the search tree in
+// workspace.distance.
+//
+// Throws a std::range_error exception if start is not a valid vertex.
+template <
+    GRAPH_SEARCH_GRAPH Graph, class Distance, GRAPH_SEARCH_VISITOR Visitor>
+bool depth_first_search(
+    const Graph& graph, const int start,
+    BasicTraversalWorkspace<Distance>& workspace, Visitor& visitor) {
+  if (start < 0 || start >= graph.vertex_count()) {
+    throw std::range_error("Not a valid index");
+  }
+  const UncheckedView<Graph> view(graph);
+  using Neighbors = decltype(view.out_edges(start));
+
+  // The path from vertex start to the vertex being explored, each vertex with
+  // its out-edges and the position of the next one to follow.
+  struct Frame {
+    int vertex;
+    Neighbors neighbors;
+    std::size_t next;
+  };
+  std::vector<Frame> path;
+
+  workspace.reset(graph.vertex_count());
+  workspace.set_distance(start, 0);
+  visitor.on_discover(start, Distance{0});
+  if (visitor.should_stop()) {
+    return false;
+  }
+  path.push_back(Frame{start, view.out_edges(start), 0});
+  while (!path.empty()) {
+    Frame& top = path.back();
+    if (top.next == std::size(top.neighbors)) {
+      const int finished = top.vertex;
+      path.pop_back();
+      visitor.on_settle(finished, workspace.distance(finished));
+      if (visitor.should_stop()) {
+        return false;
+      }
+      continue;
+    }
+    const int v = top.neighbors[top.next++];
+    if (workspace.seen(v)) {
+      continue;
+    }
+    const Distance depth = static_cast<Distance>(path.size());
+    workspace.set_distance(v, depth);
+    visitor.on_discover(v, depth);
+    if (visitor.should_stop()) {
+      return false;
+    }
+    path.push_back(Frame{v, view.out_edges(v), 0});
+  }
+  return true;
+}
+
+// Runs Djikstra's algorithm on `graph` from vertex start, with a binary heap
+// (stored in workspace.queue()).
+//
+// Afterwards the vertices reached are in workspace.touched(); those settled
+// (all of them, unless the search was stopped) have their final distances in
+// workspace.distance, and the others their tentative ones.
+//
+// Throws a std::range_error exception if start is not a valid vertex.
+//
+// ASSUMES: The edge weights in graph are non-negative.
+template <
+    GRAPH_SEARCH_WEIGHTED_GRAPH Graph, class Distance,
+    GRAPH_SEARCH_VISITOR Visitor>
+bool djikstra_search(
+    const Graph& graph, const int start,
+    BasicTraversalWorkspace<Distance>& workspace, Visitor& visitor) {
+  if (start < 0 || start >= graph.vertex_count()) {
+    throw std::range_error("Not a valid index");
+  }
+  const UncheckedView<Graph> view(graph);
+  constexpr Distance kUnreachable = std::numeric_limits<Distance>::max();
+  workspace.reset(graph.vertex_count());
+  workspace.set_distance(start, 0);
+  visitor.on_discover(start, Distance{0});
+
+  // A min-heap of (tentative distance, vertex) pairs. A vertex may be in the
+  // heap more than once; only its first (smallest) entry is processed.
+  std::vector<std::pair<Distance, int>>& queue = workspace.queue();
+  const std::greater<std::pair<Distance, int>> later;
+  queue.emplace_back(0, start);
+  while (!queue.empty()) {
+    std::pop_heap(queue.begin(), queue.end(), later);
+    const int current = queue.back().second;
+    queue.pop_back();
+    if (workspace.settled(current)) {
+      continue;
+    }
+    workspace.settle(current);
+    const Distance current_distance = workspace.distance(current);
+    visitor.on_settle(current, current_distance);
+    if (visitor.should_stop()) {
+      return false;
+    }
+    for (const int v : view.out_edges(current)) {
+      if (workspace.settled(v)) {
+        continue;
+      }
+      // A path longer than the largest Distance is dropped rather than
+      // overflowing, leaving v unreached if it has no shorter path.
+      using Sum = std::common_type_t<Distance, GraphWeight<Graph>>;
+      const Sum weight = view.edge_weight(current, v);
+      if (weight >= static_cast<Sum>(kUnreachable - current_distance)) {
+        continue;
+      }
+      const Distance candidate =
+          static_cast<Distance>(current_distance + weight);
+      if (candidate >= workspace.distance(v)) {
+        continue;
+      }
+      const bool discovered = !workspace.seen(v);
+      if (!visitor.on_relax(current, v, candidate)) {
+        continue;
+      }
+      workspace.set_distance(v, candidate);
+      if (discovered) {
+        visitor.on_discover(v, candidate);
+      }
+      queue.emplace_back(candidate, v);
+      std::push_heap(queue.begin(), queue.end(), later);
+    }
+  }
+  return true;
+}
+
+#undef GRAPH_SEARCH_GRAPH
+#undef GRAPH_SEARCH_WEIGHTED_GRAPH
+#undef GRAPH_SEARCH_VISITOR
+
+#endif
@@ -0,0 +1,206 @@
+#ifndef _graph_search_test_hpp_
+#define _graph_search_test_hpp_
+
+#include "graph_search.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "adjacency_list_graph.hpp"
+#include "adjacency_matrix_graph.hpp"
+#include "graph_traversal.hpp"
+#include "test_random.hpp"
+#include "traversal_workspace.hpp"
+#include "undirected_graph.hpp"
+#include "doctest.hpp"
+
+// A visitor that records every event, and stops the search once `stop_after`
+// vertices have been settled (if not -1).
+struct RecordingVisitor {
+  std::vector<std::pair<int, int>> discovered;
+  std::vector<std::pair<int, int>> relaxed;
+  std::vector<std::pair<int, int>> settled;
+  int stop_after = -1;
+  int max_distance = std::numeric_limits<int>::max();
+
+  void on_discover(const int v, const int distance) {
+    discovered.emplace_back(v, distance);
+  }
+
+  bool on_relax(const int u, const int v, const int distance) {
+    relaxed.emplace_back(u, v);
+    return distance <= max_distance;
+  }
+
+  void on_settle(const int v, const int distance) {
+    settled.emplace_back(v, distance);
+  }
+
+  bool should_stop() {
+    return settled.size() == stop_after;
+  }
+};
+
+TEST_CASE("BreadthFirstSearch") {
+  // 0 -> 1 -> 3 -> 4, 0 -> 2 -> 3, and 5 unreachable.
+  AdjacencyMatrixGraph graph(6);
+  graph.add_edge(0, 1);
+  graph.add_edge(0, 2);
+  graph.add_edge(1, 3);
+  graph.add_edge(2, 3);
+  graph.add_edge(3, 4);
+  TraversalWorkspace workspace;
+
+  SUBCASE("InvalidStartThrowsException") {
+    SearchVisitor visitor;
+    CHECK_THROWS_AS(
+        breadth_first_search(graph, -1, workspace, visitor),
+        std::range_error);
+    CHECK_THROWS_AS(
+        breadth_first_search(graph, 6, workspace, visitor),
+        std::range_error);
+  }
+
+  SUBCASE("VisitsInBreadthFirstOrder") {
+    RecordingVisitor visitor;
+    CHECK(breadth_first_search(graph, 0, workspace, visitor));
+    const std::vector<std::pair<int, int>> expected = {
+        {0, 0}, {1, 1}, {2, 1}, {3, 2}, {4, 3}};
+    CHECK_EQ(visitor.discovered, expected);
+    CHECK_EQ(visitor.settled, expected);
+    CHECK(visitor.relaxed.empty());
+    CHECK_EQ(workspace.touched(), std::vector<int>({0, 1, 2, 3, 4}));
+    CHECK_FALSE(workspace.seen(5));
+  }
+
+  SUBCASE("StopsWhenAsked") {
+    RecordingVisitor visitor;
+    visitor.stop_after = 2;
+    CHECK_FALSE(breadth_first_search(graph, 0, workspace, visitor));
+    CHECK_EQ(
+        visitor.settled, std::vector<std::pair<int, int>>({{0, 0}, {1, 1}}));
+    // The search stopped before expanding vertex 1.
+    CHECK_EQ(visitor.discovered.back(), std::make_pair(2, 1));
+    CHECK_FALSE(workspace.seen(3));
+  }
+}
+
+TEST_CASE("DepthFirstSearch") {
+  // 0 -> 1 -> 2, 0 -> 3, 3 -> 2.
+  AdjacencyMatrixGraph graph(4);
+  graph.add_edge(0, 1);
+  graph.add_edge(0, 3);
+  graph.add_edge(1, 2);
+  graph.add_edge(3, 2);
+  TraversalWorkspace workspace;
+
+  SUBCASE("InvalidStartThrowsException") {
+    SearchVisitor visitor;
+    CHECK_THROWS_AS(
+        depth_first_search(graph, 4, workspace, visitor), std::range_error);
+  }
+
+  SUBCASE("DiscoversInPreorderAndSettlesInPostorder") {
+    RecordingVisitor visitor;
+    CHECK(depth_first_search(graph, 0, workspace, visitor));
+    CHECK_EQ(
+        visitor.discovered,
+        std::vector<std::pair<int, int>>({{0, 0}, {1, 1}, {2, 2}, {3, 1}}));
+    CHECK_EQ(
+        visitor.settled,
+        std::vector<std::pair<int, int>>({{2, 2}, {1, 1}, {3, 1}, {0, 0}}));
+  }
+
+  SUBCASE("StopsWhenAsked") {
+    RecordingVisitor visitor;
+    visitor.stop_after = 1;
+    CHECK_FALSE(depth_first_search(graph, 0, workspace, visitor));
+    CHECK_EQ(visitor.settled, std::vector<std::pair<int, int>>({{2, 2}}));
+    CHECK_EQ(visitor.discovered.size(), 3);
+  }
+}
+
+TEST_CASE("DjikstraSearch") {
+  // 0 -> 1 (weight 5), 0 -> 2 (1), 2 -> 1 (2), 1 -> 3 (1).
+  AdjacencyListGraph graph(4);
+  graph.add_edge(0, 1, 5);
+  graph.add_edge(0, 2, 1);
+  graph.add_edge(2, 1, 2);
+  graph.add_edge(1, 3, 1);
+  TraversalWorkspace workspace;
+
+  SUBCASE("InvalidStartThrowsException") {
+    SearchVisitor visitor;
+    CHECK_THROWS_AS(
+        djikstra_search(graph, -1, workspace, visitor), std::range_error);
+  }
+
+  SUBCASE("SettlesByDistance") {
+    RecordingVisitor visitor;
+    CHECK(djikstra_search(graph, 0, workspace, visitor));
+    CHECK_EQ(
+        visitor.settled,
+        std::vector<std::pair<int, int>>({{0, 0}, {2, 1}, {1, 3}, {3, 4}}));
+    // Vertex 1 is discovered once, at its first tentative distance, and
+    // relaxed again through vertex 2.
+    CHECK_EQ(visitor.discovered.size(), 4);
+    CHECK_NE(
+        std::find(
+            visitor.discovered.begin(), visitor.discovered.end(),
+            std::make_pair(1, 5)),
+        visitor.discovered.end());
+    CHECK_EQ(visitor.relaxed.size(), 4);
+  }
+
+  SUBCASE("RejectedRelaxationsAreDropped") {
+    RecordingVisitor visitor;
+    visitor.max_distance = 3;
+    CHECK(djikstra_search(graph, 0, workspace, visitor));
+    CHECK_EQ(
+        visitor.settled,
+        std::vector<std::pair<int, int>>({{0, 0}, {2, 1}, {1, 3}}));
+    CHECK_FALSE(workspace.seen(3));
+  }
+
+  SUBCASE("StopsWhenAsked") {
+    RecordingVisitor visitor;
+    visitor.stop_after = 2;
+    CHECK_FALSE(djikstra_search(graph, 0, workspace, visitor));
+    // The search stopped before relaxing the out-edges of vertex 2, so vertex
+    // 1 keeps its tentative distance.
+    CHECK_EQ(workspace.distance(1), 5);
+    CHECK_FALSE(workspace.settled(1));
+  }
+}
+
+TEST_CASE("DjikstraSearchMatchesDenseShortestPath") {
+  // The searches, and the traversals of graph_traversal.hpp built on them,
+  // need no instantiation per graph type, so they also run on the symmetric
+  // undirected graph, which no source file instantiates them for.
+  constexpr int kVertexCount = 120;
+  const auto reference = random_graph<UndirectedGraph<AdjacencyMatrixGraph>>(
+      kVertexCount, 400, 100, 12345, 5);
+  const auto graph = random_graph<UndirectedGraph<SymmetricEdges>>(
+      kVertexCount, 400, 100, 12345, 5);
+
+  TraversalWorkspace workspace;
+  int mismatches = 0;
+  for (int start = 0; start < kVertexCount; start += 5) {
+    SearchVisitor visitor;
+    djikstra_search(graph, start, workspace, visitor);
+    const std::vector<int> expected = dense_shortest_path(reference, start);
+    for (int v = 0; v < kVertexCount; ++v) {
+      const int distance = workspace.seen(v)
+                               ? workspace.distance(v)
+                               : std::numeric_limits<int>::max();
+      mismatches += distance != expected[v];
+    }
+    mismatches += shortest_path(graph, start, workspace) != expected;
+  }
+  CHECK_EQ(mismatches, 0);
+}
+
+#endif
@@ -1,195 +1,404 @@
 #include "graph_traversal.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstdint>
+#include <functional>
 #include <iostream>
 #include <limits>
+#include <utility>
 #include <vector>
 
-// A helper method for shortest_path that returns the index of the vertex that
-// should be the next current node, given which nodes have already been visited
-// and the tentative distances to nodes.
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "aligned_allocator.hpp"
+#include "bounds_check.hpp"
+#include "cancellation_token.hpp"
+#include "csr_graph.hpp"
+#include "parallel_for.hpp"
+#include "traversal_workspace.hpp"
+
+// A helper method for dense_shortest_path that returns the index of the vertex
+// that should be the next current node, given the tentative distances
+// `frontier` of the count-many vertices, where visited vertices have a
+// tentative distance of std::numeric_limits<int>::max().
 //
 // The return value indicates whether the algorithm should continue running. If
-// true, the next current index is returned through the reference parameter
-// next_current.
-bool next_current_for_shortest_path(
-    const std::vector<bool>& visited, const std::vector<int>& distance,
-    int& next_current) {
-  // Assert the visited and distance vectors are the same size. If they are not,
-  // a programming mistake has been made.
-  assert(visited.size() == distance.size());
-
-  // Initialize next_current_distance to be the (tentative) distance to some
-  // (reachable) vertex that has not yet been visited.
-  int next_current_distance = std::numeric_limits<int>::max();
-  for (int v = 0; v < visited.size(); ++v) {
-    if (!visited[v] && distance[v] < std::numeric_limits<int>::max()) {
-      next_current = v;
-      next_current_distance = distance[v];
-      break;
-    }
+// true, the next current index (the first index holding the smallest tentative
+// distance) is returned through the reference parameter next_current.
+//
+// ASSUMES: frontier is 64-byte aligned and padded with
+// std::numeric_limits<int>::max() to a multiple of 16 elements.
+bool next_current_for_dense_shortest_path(
+    const int* frontier, const int count, int& next_current) {
+  constexpr int kIntMax = std::numeric_limits<int>::max();
+  const int padded_count = (count + 15) / 16 * 16;
+
+  // First pass: reduce the array to its minimum value.
+  int minimum = kIntMax;
+#if defined(__AVX512F__)
+  __m512i minimums = _mm512_set1_epi32(kIntMax);
+  for (int v = 0; v < padded_count; v += 16) {
+    minimums = _mm512_min_epi32(minimums, _mm512_load_si512(frontier + v));
+  }
+  minimum = _mm512_reduce_min_epi32(minimums);
+#elif defined(__AVX2__)
+  __m256i minimums = _mm256_set1_epi32(kIntMax);
+  for (int v = 0; v < padded_count; v += 8) {
+    minimums = _mm256_min_epi32(
+        minimums,
+        _mm256_load_si256(reinterpret_cast<const __m256i*>(frontier + v)));
   }
+  alignas(32) int lanes[8];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), minimums);
+  for (const int lane : lanes) {
+    minimum = std::min(minimum, lane);
+  }
+#else
+  for (int v = 0; v < padded_count; ++v) {
+    minimum = std::min(minimum, frontier[v]);
+  }
+#endif
 
-  // Return false if next_current_distance wasn't set to something smaller than
-  // std::numeric_limits<int>::max(). For Djikstra's algorithm, this happens
-  // when we have visited every node reachable from the start vertex.
-  if (next_current_distance == std::numeric_limits<int>::max()) {
+  // Return false if every vertex is either visited or unreachable.
+  if (minimum == kIntMax) {
     return false;
   }
 
-  // Iterate through all the vertices, looking for the unvisited node with the
-  // smallest (tentative) distance. As we find better candidates, update
-  // next_current and next_current_distance.
-  for (int v = 0; v < visited.size(); ++v) {
-    if (!visited[v] && distance[v] < next_current_distance) {
+  // Second pass: recover the first index holding the minimum. This usually
+  // stops long before the end of the array.
+#if defined(__AVX512F__)
+  const __m512i needle = _mm512_set1_epi32(minimum);
+  for (int v = 0; v < padded_count; v += 16) {
+    const __mmask16 mask =
+        _mm512_cmpeq_epi32_mask(_mm512_load_si512(frontier + v), needle);
+    if (mask != 0) {
+      next_current = v + __builtin_ctz(mask);
+      return true;
+    }
+  }
+#elif defined(__AVX2__)
+  const __m256i needle = _mm256_set1_epi32(minimum);
+  for (int v = 0; v < padded_count; v += 8) {
+    const __m256i block =
+        _mm256_load_si256(reinterpret_cast<const __m256i*>(frontier + v));
+    const int mask = _mm256_movemask_ps(
+        _mm256_castsi256_ps(_mm256_cmpeq_epi32(block, needle)));
+    if (mask != 0) {
+      next_current = v + __builtin_ctz(mask);
+      return true;
+    }
+  }
+#else
+  for (int v = 0; v < padded_count; ++v) {
+    if (frontier[v] == minimum) {
       next_current = v;
-      next_current_distance = distance[v];
+      return true;
     }
   }
+#endif
 
-  // Return true, as we have set next_current to an appropriate index.
-  return true;
+  // The minimum was found in the first pass, so it is always found again.
+  assert(false);
+  return false;
 }
 
 template <class Graph>
-std::vector<bool> distance_at_most_two(const Graph& graph, const int start) {
-  
-  // Implement the distance_at_most_two method.
-  //
-  // There are many different valid and good strategies to implement this
-  // method.
-  //
-  // * It is possible to modify breadth first search, keeping track of how many
-  //   edges have been traversed.
-  // * It is possible to compute the vertices adjacent to the start vertex and
-  //   the vertices adjacent to those vertices.
-  // * It is possible to use shortest_path on a different graph.
-if (start < 0 || start > graph.vertex_count())
-{
-  throw std::range_error("Not a valid index");
+std::vector<int> dense_shortest_path(const Graph& graph, const int start) {
+  TraversalWorkspace workspace;
+  return dense_shortest_path(graph, start, workspace);
 }
 
- std::vector<bool> seen = std::vector<bool>
- (graph.vertex_count(), false);
-
- seen[start] = true;
-
- std::queue<int> todo = std::queue<int>({start});
- std::vector<int> edge_count(graph.vertex_count(),std::numeric_limits<int>::max());
- std::vector<bool> edge_distance(graph.vertex_count(),false);
- edge_count[start] = 0;
- while (!todo.empty()) {
-  int next = todo.front();
-  todo.pop();
-  for (const int v : graph.out_edges(next)) {
-     if (!seen[v]) {
-       seen[v] = true;
-       todo.push(v);
-       edge_count[v] = edge_count[next] + 1;
-     }
-   }
-  }
- for(int i = 0; i < edge_count.size();i++)
-{
-  if(edge_count[i] <= 2)
-    {
-      edge_distance[i] = true;
+template <class Graph>
+std::vector<int> dense_shortest_path(
+    const Graph& graph, const int start, TraversalWorkspace& workspace) {
+  if (start < 0 || start >= graph.vertex_count()) {
+    throw std::range_error("Not a valid index");
+  }
+  constexpr int kIntMax = std::numeric_limits<int>::max();
+  const int count = graph.vertex_count();
+  const UncheckedView<Graph> view(graph);
+
+  // The final (and, for unvisited vertices, tentative) shortest distances.
+  std::vector<int> distance(count, kIntMax);
+
+  // The tentative distances of the unvisited vertices, with visited vertices
+  // masked to kIntMax. Padded to a multiple of 16 ints (one AVX-512 register)
+  // so the argmin never needs a scalar tail.
+  TraversalWorkspace::ScratchArray& frontier = workspace.scratch(0);
+  frontier.assign((count + 15) / 16 * 16, kIntMax);
+
+  distance[start] = 0;
+  frontier[start] = 0;
+  int current = start;
+  while (next_current_for_dense_shortest_path(
+             frontier.data(), count, current)) {
+    // Mark the current vertex as visited. Its distance is final, and since
+    // the edge weights are non-negative no relaxation below can improve it.
+    frontier[current] = kIntMax;
+    for (const int v : view.out_edges(current)) {
+      const int candidate = distance[current] + view.edge_weight(current, v);
+      if (candidate < distance[v]) {
+        distance[v] = candidate;
+        frontier[v] = candidate;
+      }
     }
+  }
+  return distance;
 }
- return std::vector<bool>(edge_distance);
+
+std::vector<int> shortest_path_within_hops(
+    const CsrGraph& in_edges, const int start, const int max_edges,
+    const CancellationToken& cancellation) {
+  TraversalWorkspace workspace;
+  return shortest_path_within_hops(
+      in_edges, start, max_edges, workspace, cancellation);
 }
 
-template <class Graph>
-std::vector<int> shortest_path(const Graph& graph, const int start) {
-  
-  // Implement Djikstra's algorithm for finding the shortest paths from a given
-  // vertex. For more information and as a reference, see
-  // https://en.wikipedia.org/wiki/Dijkstra%27s_algorithm.
-  // 
-  // START(Djikstra's Algorithm)
-  //
-  // PROCEDURE shortest_path(const Graph& graph, const int start)
-  //
-  //   Throw a std::invalid_argument exception if start is not a valid vertex.
-  //
-  //   Create a vector to track whether each node has been visited. Initialize
-  //   it by setting all nodes as not visited.
-  //
-  //   Create a vector to track the shortest distance to each vertex from the
-  //   start vertex. Initialize it by setting the start node as distance 0 and
-  //   other nodes as distance infinity, which we represent by
-  //   std::numeric_limits<int>::max().
-  //
-  //   Create a variable to track the current node being processed. Initialize
-  //   it by setting it to be the start vertex.
-  //
-  //   WHILE (next_current_for_shortest_path)
-  //
-  //     For every out-edge of the current vertex, determine whether the path
-  //     through the current vertex is shorter than the best path seen so far.
-  //     If it is better, update its shortest distance.
-  //
-  //     Mark the current vertex as visited.
-  //
-  //  END WHILE
-  //
-  //  Return the vector of shortest distances.
-  //
-  // END PROCEDURE
-  //
-  // STOP
-if (start < 0 || start >= graph.vertex_count())
-{
-  throw std::range_error("Not a valid index");
+std::vector<int> shortest_path_within_hops(
+    const CsrGraph& in_edges, const int start, const int max_edges,
+    TraversalWorkspace& workspace, const CancellationToken& cancellation) {
+  SearchResult<std::vector<int>> result = partial_shortest_path_within_hops(
+      in_edges, start, max_edges, workspace, cancellation);
+  throw_if_stopped(result.status);
+  return std::move(result.value);
 }
 
-std::vector<bool> seen = std::vector<bool>
- (graph.vertex_count(), false);
+SearchResult<std::vector<int>> partial_shortest_path_within_hops(
+    const CsrGraph& in_edges, const int start, const int max_edges,
+    const CancellationToken& cancellation) {
+  TraversalWorkspace workspace;
+  return partial_shortest_path_within_hops(
+      in_edges, start, max_edges, workspace, cancellation);
+}
 
-std::vector<int> distance = std::vector<int>(graph.vertex_count(), std::numeric_limits<int>::max());
+SearchResult<std::vector<int>> partial_shortest_path_within_hops(
+    const CsrGraph& in_edges, const int start, const int max_edges,
+    TraversalWorkspace& workspace, const CancellationToken& cancellation) {
+  if (start < 0 || start >= in_edges.vertex_count()) {
+    throw std::range_error("Not a valid index");
+  }
+  if (max_edges < 0) {
+    throw std::invalid_argument("max_edges cannot be negative");
+  }
+  constexpr int kIntMax = std::numeric_limits<int>::max();
+  const int count = in_edges.vertex_count();
+  const std::vector<int>& sources = in_edges.targets();
+  const std::vector<int>& weights = in_edges.weights();
 
-distance[start] = 0;
-int current = start;
-while(next_current_for_shortest_path(seen,distance,current)){
-for(const int v : graph.out_edges(current)){
-   if(distance[current] + graph.edge_weight(current,v) < distance[v])
-   {
-     distance[v] = distance[current] + graph.edge_weight(current,v);
-   }
+  // previous holds the lengths of the shortest paths with at most `round`
+  // edges; next receives those with at most `round + 1` edges. Both live in
+  // the workspace, and only the final round is copied out.
+  TraversalWorkspace::ScratchArray& previous = workspace.scratch(0);
+  TraversalWorkspace::ScratchArray& next = workspace.scratch(1);
+  previous.assign(count, kIntMax);
+  next.assign(count, kIntMax);
+  previous[start] = 0;
+  const auto result = [&previous](const SearchStatus status) {
+    return SearchResult<std::vector<int>>{
+        status, std::vector<int>(previous.begin(), previous.end())};
+  };
+
+  // Whether any chunk changed a distance in the current round, and why (if
+  // at all) a chunk stopped the round.
+  std::atomic<bool> changed(false);
+  std::atomic<SearchStatus> stopped(SearchStatus::kComplete);
+  for (int round = 0; round < max_edges; ++round) {
+    SearchStatus status = cancellation.status();
+    if (status != SearchStatus::kComplete) {
+      return result(status);
+    }
+    // Chunks write only their own vertices of `next`, so no locking is
+    // needed. Each chunk sets `changed` at most once, after its loop. A chunk
+    // that finds the search stopped records why and gives up on the round.
+    changed.store(false, std::memory_order_relaxed);
+    parallel_for(count, [&](const int begin, const int end) {
+      bool chunk_changed = false;
+      for (int v = begin; v < end; ++v) {
+        if ((v - begin + 1) % CancellationToken::kCheckInterval == 0) {
+          const SearchStatus chunk_status = cancellation.status();
+          if (chunk_status != SearchStatus::kComplete) {
+            stopped.store(chunk_status, std::memory_order_relaxed);
+            return;
+          }
+        }
+        int best = previous[v];
+        for (int e = in_edges.offset(v); e < in_edges.offset(v + 1); ++e) {
+          // Clamping the source's distance to kIntMax - weight first means
+          // the sum never overflows, and is kIntMax if the source is
+          // unreachable (the same clamp as extend in min_plus.cpp).
+          const int weight = weights[e];
+          best = std::min(
+              best, std::min(previous[sources[e]], kIntMax - weight) + weight);
+        }
+        next[v] = best;
+        chunk_changed |= best != previous[v];
+      }
+      if (chunk_changed) {
+        changed.store(true, std::memory_order_relaxed);
+      }
+    }, 1024);
+    status = stopped.load(std::memory_order_relaxed);
+    if (status != SearchStatus::kComplete) {
+      // The round is unfinished, so the previous one is the result.
+      return result(status);
+    }
+    previous.swap(next);
+    if (!changed.load(std::memory_order_relaxed)) {
+      break;
+    }
   }
-seen[current] = true;
+  return result(SearchStatus::kComplete);
 }
-return std::vector<int> (distance);
+
+template <class Weight, class Distance>
+std::vector<Distance> weighted_shortest_path(
+    const BasicCsrGraph<Weight>& graph, const int start) {
+  if (start < 0 || start >= graph.vertex_count()) {
+    throw std::range_error("Not a valid index");
+  }
+  constexpr Distance kUnreachable = std::numeric_limits<Distance>::max();
+  const std::vector<int>& targets = graph.targets();
+  const std::vector<Weight>& weights = graph.weights();
+  std::vector<Distance> distance(graph.vertex_count(), kUnreachable);
+
+  // A min-heap of (tentative distance, vertex) pairs. A vertex may be queued
+  // several times; only the entry matching its current distance is expanded.
+  using Entry = std::pair<Distance, int>;
+  std::vector<Entry> queue;
+  distance[start] = 0;
+  queue.emplace_back(0, start);
+  while (!queue.empty()) {
+    std::pop_heap(queue.begin(), queue.end(), std::greater<Entry>());
+    const Entry entry = queue.back();
+    queue.pop_back();
+    const int current = entry.second;
+    if (entry.first != distance[current]) {
+      continue;
+    }
+    for (int e = graph.offset(current); e < graph.offset(current + 1); ++e) {
+      const Distance weight = weights[e];
+      // Saturate rather than overflow (a no-op for float weights).
+      const Distance candidate = entry.first > kUnreachable - weight
+                                     ? kUnreachable
+                                     : entry.first + weight;
+      if (candidate < distance[targets[e]]) {
+        distance[targets[e]] = candidate;
+        queue.emplace_back(candidate, targets[e]);
+        std::push_heap(queue.begin(), queue.end(), std::greater<Entry>());
+      }
+    }
+  }
+  return distance;
 }
 
-// Since the implementation of distance_at_most_two is in the cpp file, we need
-// to tell the compiler which template instantiations to make.
+template <class Graph>
+std::vector<int> shortest_path_within_hops(
+    const Graph& graph, const int start, const int max_edges) {
+  if (start < 0 || start >= graph.vertex_count()) {
+    throw std::range_error("Not a valid index");
+  }
+  TraversalWorkspace workspace;
+  return shortest_path_within_hops(graph, start, max_edges, workspace);
+}
+
+template <class Graph>
+std::vector<int> shortest_path_within_hops(
+    const Graph& graph, const int start, const int max_edges,
+    TraversalWorkspace& workspace) {
+  if (start < 0 || start >= graph.vertex_count()) {
+    throw std::range_error("Not a valid index");
+  }
+  return shortest_path_within_hops(
+      CsrGraph(graph).transpose(), start, max_edges, workspace);
+}
+
+// The dense form of Djikstra's algorithm is only instantiated for the
+// (matrix-backed) graphs it is a good fit for.
+template std::vector<int> dense_shortest_path<AdjacencyMatrixGraph>(
+    const AdjacencyMatrixGraph& graph, const int start);
+template std::vector<int> dense_shortest_path<BitMatrixGraph>(
+    const BitMatrixGraph& graph, const int start);
+template std::vector<int>
+dense_shortest_path<UndirectedGraph<AdjacencyMatrixGraph>>(
+    const UndirectedGraph<AdjacencyMatrixGraph>& graph, const int start);
+template std::vector<int>
+dense_shortest_path<UndirectedGraph<BitMatrixGraph>>(
+    const UndirectedGraph<BitMatrixGraph>& graph, const int start);
+
+// Since the implementation of shortest_path_within_hops is in the cpp file, we
+// need to tell the compiler which template instantiations to make.
 //
 // For more information, see
 // https://isocpp.org/wiki/faq/templates#templates-defn-vs-decl.
-template std::vector<bool> distance_at_most_two<AdjacencyListGraph>(
-    const AdjacencyListGraph& graph, const int start);
-template std::vector<bool> distance_at_most_two<AdjacencyMatrixGraph>(
-    const AdjacencyMatrixGraph& graph, const int start);
-template std::vector<bool>
-distance_at_most_two<UndirectedGraph<AdjacencyListGraph>>(
-    const UndirectedGraph<AdjacencyListGraph>& graph, const int start);
-template std::vector<bool>
-distance_at_most_two<UndirectedGraph<AdjacencyMatrixGraph>>(
-    const UndirectedGraph<AdjacencyMatrixGraph>& graph, const int start);
+template std::vector<int> shortest_path_within_hops<AdjacencyListGraph>(
+    const AdjacencyListGraph& graph, const int start, const int max_edges);
+template std::vector<int> shortest_path_within_hops<AdjacencyMatrixGraph>(
+    const AdjacencyMatrixGraph& graph, const int start, const int max_edges);
+template std::vector<int> shortest_path_within_hops<BitMatrixGraph>(
+    const BitMatrixGraph& graph, const int start, const int max_edges);
+template std::vector<int>
+shortest_path_within_hops<UndirectedGraph<AdjacencyListGraph>>(
+    const UndirectedGraph<AdjacencyListGraph>& graph, const int start,
+    const int max_edges);
+template std::vector<int>
+shortest_path_within_hops<UndirectedGraph<AdjacencyMatrixGraph>>(
+    const UndirectedGraph<AdjacencyMatrixGraph>& graph, const int start,
+    const int max_edges);
+template std::vector<int>
+shortest_path_within_hops<UndirectedGraph<BitMatrixGraph>>(
+    const UndirectedGraph<BitMatrixGraph>& graph, const int start,
+    const int max_edges);
 
-// Since the implementation of shortest_path is in the cpp file, we need to tell
-// the compiler which template instantiations to make.
+// Since the implementations of the TraversalWorkspace overloads are in the cpp
+// file, we need to tell the compiler which template instantiations to make.
 //
 // For more information, see
 // https://isocpp.org/wiki/faq/templates#templates-defn-vs-decl.
-template std::vector<int> shortest_path<AdjacencyListGraph>(
-    const AdjacencyListGraph& graph, const int start);
-template std::vector<int> shortest_path<AdjacencyMatrixGraph>(
-    const AdjacencyMatrixGraph& graph, const int start);
+template std::vector<int> dense_shortest_path<AdjacencyMatrixGraph>(
+    const AdjacencyMatrixGraph& graph, const int start,
+    TraversalWorkspace& workspace);
+template std::vector<int> dense_shortest_path<BitMatrixGraph>(
+    const BitMatrixGraph& graph, const int start,
+    TraversalWorkspace& workspace);
+template std::vector<int>
+dense_shortest_path<UndirectedGraph<AdjacencyMatrixGraph>>(
+    const UndirectedGraph<AdjacencyMatrixGraph>& graph, const int start,
+    TraversalWorkspace& workspace);
 template std::vector<int>
-shortest_path<UndirectedGraph<AdjacencyListGraph>>(
-    const UndirectedGraph<AdjacencyListGraph>& graph, const int start);
+dense_shortest_path<UndirectedGraph<BitMatrixGraph>>(
+    const UndirectedGraph<BitMatrixGraph>& graph, const int start,
+    TraversalWorkspace& workspace);
+template std::vector<int> shortest_path_within_hops<AdjacencyListGraph>(
+    const AdjacencyListGraph& graph, const int start, const int max_edges,
+    TraversalWorkspace& workspace);
+template std::vector<int> shortest_path_within_hops<AdjacencyMatrixGraph>(
+    const AdjacencyMatrixGraph& graph, const int start, const int max_edges,
+    TraversalWorkspace& workspace);
+template std::vector<int> shortest_path_within_hops<BitMatrixGraph>(
+    const BitMatrixGraph& graph, const int start, const int max_edges,
+    TraversalWorkspace& workspace);
 template std::vector<int>
-shortest_path<UndirectedGraph<AdjacencyMatrixGraph>>(
-    const UndirectedGraph<AdjacencyMatrixGraph>& graph, const int start);
\ No newline at end of file
+shortest_path_within_hops<UndirectedGraph<AdjacencyListGraph>>(
+    const UndirectedGraph<AdjacencyListGraph>& graph, const int start,
+    const int max_edges, TraversalWorkspace& workspace);
+template std::vector<int>
+shortest_path_within_hops<UndirectedGraph<AdjacencyMatrixGraph>>(
+    const UndirectedGraph<AdjacencyMatrixGraph>& graph, const int start,
+    const int max_edges, TraversalWorkspace& workspace);
+template std::vector<int>
+shortest_path_within_hops<UndirectedGraph<BitMatrixGraph>>(
+    const UndirectedGraph<BitMatrixGraph>& graph, const int start,
+    const int max_edges, TraversalWorkspace& workspace);
+
+template std::vector<std::uint32_t> weighted_shortest_path(
+    const BasicCsrGraph<std::uint16_t>& graph, const int start);
+template std::vector<std::int64_t> weighted_shortest_path(
+    const BasicCsrGraph<std::int32_t>& graph, const int start);
+template std::vector<std::int64_t> weighted_shortest_path(
+    const BasicCsrGraph<std::int64_t>& graph, const int start);
+template std::vector<double> weighted_shortest_path(
+    const BasicCsrGraph<float>& graph, const int start);
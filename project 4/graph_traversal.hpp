@@ -1,6 +1,8 @@
 #ifndef _graph_traversal_hpp_
 #define _graph_traversal_hpp_
 
+#include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <queue>
 #include <stdexcept>
@@ -9,10 +11,26 @@
 
 #include "adjacency_list_graph.hpp"
 #include "adjacency_matrix_graph.hpp"
+#include "bit_matrix_graph.hpp"
+#include "cancellation_token.hpp"
+#include "csr_graph.hpp"
+#include "graph_search.hpp"
+#include "traversal_workspace.hpp"
 #include "undirected_graph.hpp"
+#include "vertex_set.hpp"
 
-// Returns whether each vertex in the graph is at most distance two from vertex
-// start.
+// The result of a search that may have been stopped early by its
+// CancellationToken (see cancellation_token.hpp). If status is not
+// SearchStatus::kComplete, value holds what the search had found when it
+// stopped.
+template <class T>
+struct SearchResult {
+  SearchStatus status;
+  T value;
+};
+
+// Returns the set of vertices in the graph that are at most distance two from
+// vertex start.
 //
 // A vertex i is at most distance two from vertex start if any of the following
 // is true:
@@ -29,7 +47,22 @@
 //
 // ASSUMES: The edge weights in graph are non-negative.
 template <class Graph>
-std::vector<bool> distance_at_most_two(const Graph& graph, const int start);
+VertexSet distance_at_most_two(const Graph& graph, const int start);
+
+// The same as distance_at_most_two above, using `workspace` for the scratch
+// state of the search.
+//
+// The breadth first search stops expanding at distance two and only touches
+// the workspace slots of the vertices it reaches, which are left in
+// workspace.touched() (with their distances, in edges, in workspace.distance).
+//
+// The search checks `cancellation` once for each vertex it expands, and
+// throws an OperationCancelled exception if it has been cancelled.
+template <class Graph, class Distance>
+VertexSet distance_at_most_two(
+    const Graph& graph, const int start,
+    BasicTraversalWorkspace<Distance>& workspace,
+    const CancellationToken& cancellation = CancellationToken());
 
 // Returns for each vertex in the graph the length of the shortest path from
 // vertex start to the vertex.
@@ -44,4 +77,446 @@ std::vector<bool> distance_at_most_two(const Graph& graph, const int start);
 template <class Graph>
 std::vector<int> shortest_path(const Graph& graph, const int start);
 
+// The same as shortest_path above, using `workspace` for the scratch state of
+// the search.
+//
+// This runs Djikstra's algorithm with a binary heap (stored in
+// workspace.queue()), so only the vertices reachable from vertex start are
+// touched; they are left in workspace.touched() with their distances in
+// workspace.distance.
+//
+// The search checks `cancellation` once every
+// CancellationToken::kCheckInterval vertices it settles, and throws an
+// OperationCancelled exception if it has been cancelled (a DeadlineExceeded
+// exception if its deadline has passed). The same holds for shortest_path_to
+// and shortest_paths_within.
+//
+// The lengths are summed, stored and returned as the Distance of the
+// workspace, with std::numeric_limits<Distance>::max() for the vertices with
+// no path. A path longer than that is dropped rather than overflowing, so with
+// a TraversalWorkspace the paths longer than std::numeric_limits<int>::max()
+// are lost; a PathLengthWorkspace<Graph> (see graph_search.hpp) sums them in
+// the PathLength of the edge weights instead.
+template <class Graph, class Distance>
+std::vector<Distance> shortest_path(
+    const Graph& graph, const int start,
+    BasicTraversalWorkspace<Distance>& workspace,
+    const CancellationToken& cancellation = CancellationToken());
+
+// The same as the workspace overload of shortest_path above, except
+// that when `cancellation` stops the search it returns the distances found so
+// far with the SearchStatus of the token, instead of throwing.
+//
+// The vertices are settled by increasing distance, so a partial result holds
+// the exact lengths of the shortest paths to the vertices closest to vertex
+// start (every vertex settled before the search stopped), and
+// std::numeric_limits<Distance>::max() for the others.
+template <class Graph, class Distance>
+SearchResult<std::vector<Distance>> partial_shortest_path(
+    const Graph& graph, const int start,
+    BasicTraversalWorkspace<Distance>& workspace,
+    const CancellationToken& cancellation);
+
+// Returns the length of the shortest path from vertex start to vertex target,
+// or std::numeric_limits<Distance>::max() if there is no such path.
+//
+// This runs the same search as the workspace overload of
+// shortest_path, stopping as soon as vertex target is settled, so it only
+// touches the vertices closer to vertex start than vertex target (and their
+// neighbors).
+//
+// Throws a std::range_error exception if start or target is not a valid
+// vertex.
+//
+// ASSUMES: The edge weights in graph are non-negative.
+template <class Graph, class Distance>
+Distance shortest_path_to(
+    const Graph& graph, const int start, const int target,
+    BasicTraversalWorkspace<Distance>& workspace,
+    const CancellationToken& cancellation = CancellationToken());
+
+// Returns the vertices at most max_distance from vertex start, as (vertex,
+// length of the shortest path from vertex start) pairs by increasing length
+// (and then by vertex).
+//
+// This runs the same search as the workspace overload of
+// shortest_path, never touching a vertex further than max_distance, so (as
+// resetting the workspace is O(1)) its cost depends only on the vertices
+// returned and their edges, not on the size of the graph.
+//
+// Throws a std::range_error exception if start is not a valid vertex and a
+// std::invalid_argument exception if max_distance is negative.
+//
+// ASSUMES: The edge weights in graph are non-negative.
+template <class Graph, class Distance>
+std::vector<std::pair<int, Distance>> shortest_paths_within(
+    const Graph& graph, const int start,
+    const typename BasicTraversalWorkspace<Distance>::DistanceType max_distance,
+    BasicTraversalWorkspace<Distance>& workspace,
+    const CancellationToken& cancellation = CancellationToken());
+
+// The same as shortest_paths_within above, except that when `cancellation`
+// stops the search it returns the vertices settled so far (which are the
+// closest to vertex start, with exact lengths) with the SearchStatus of the
+// token, instead of throwing.
+template <class Graph, class Distance>
+SearchResult<std::vector<std::pair<int, Distance>>>
+partial_shortest_paths_within(
+    const Graph& graph, const int start,
+    const typename BasicTraversalWorkspace<Distance>::DistanceType max_distance,
+    BasicTraversalWorkspace<Distance>& workspace,
+    const CancellationToken& cancellation);
+
+// Returns the same shortest path lengths as shortest_path, computed with the
+// "dense" O(n^2) form of Djikstra's algorithm.
+//
+// The tentative distances of the unvisited vertices are kept in a 64-byte
+// aligned array in which visited vertices are masked to
+// std::numeric_limits<int>::max(), so that choosing the next vertex is a
+// single vectorized (AVX-512 or AVX2, when compiled for them) min-reduction.
+// This is the better choice for dense graphs, such as the adjacency matrix
+// graphs it is instantiated for, where out_edges is O(n) anyway.
+//
+// Throws a std::range_error exception if start is not a valid vertex.
+//
+// ASSUMES: The edge weights in graph are non-negative.
+template <class Graph>
+std::vector<int> dense_shortest_path(const Graph& graph, const int start);
+
+// The same as dense_shortest_path above, except that the padded frontier is
+// kept in workspace.scratch(0) rather than allocated for the call.
+template <class Graph>
+std::vector<int> dense_shortest_path(
+    const Graph& graph, const int start, TraversalWorkspace& workspace);
+
+// Returns for each vertex in the graph the length of the shortest path from
+// vertex start to the vertex that uses at most max_edges edges.
+//
+// The i^th value in the return vector is the length of the shortest such path
+// from vertex start to vertex i (if one exists) and
+// std::numeric_limits<int>::max() otherwise.
+//
+// This runs max_edges rounds of Bellman-Ford relaxation (stopping early once a
+// round changes nothing) over a CsrGraph of the in-edges of every vertex. Each
+// round reads the distances of the previous round and writes a second buffer,
+// so the vertices of a round are relaxed in parallel without synchronization.
+//
+// Throws a std::range_error exception if start is not a valid vertex and a
+// std::invalid_argument exception if max_edges is negative.
+//
+// ASSUMES: The edge weights in graph are non-negative.
+template <class Graph>
+std::vector<int> shortest_path_within_hops(
+    const Graph& graph, const int start, const int max_edges);
+
+// The same as shortest_path_within_hops above, except that the distances of
+// the rounds are kept in workspace.scratch(0) and workspace.scratch(1) rather
+// than allocated for the call.
+template <class Graph>
+std::vector<int> shortest_path_within_hops(
+    const Graph& graph, const int start, const int max_edges,
+    TraversalWorkspace& workspace);
+
+// The same as shortest_path_within_hops above, given the in-edges of the graph
+// as a CsrGraph, i.e., CsrGraph(graph).transpose().
+//
+// For an undirected graph, CsrGraph(graph) is its own transpose.
+//
+// Each round checks `cancellation` before it starts and once every
+// CancellationToken::kCheckInterval vertices of each chunk, and throws an
+// OperationCancelled exception if it has been cancelled (a DeadlineExceeded
+// exception if its deadline has passed).
+std::vector<int> shortest_path_within_hops(
+    const CsrGraph& in_edges, const int start, const int max_edges,
+    const CancellationToken& cancellation = CancellationToken());
+std::vector<int> shortest_path_within_hops(
+    const CsrGraph& in_edges, const int start, const int max_edges,
+    TraversalWorkspace& workspace,
+    const CancellationToken& cancellation = CancellationToken());
+
+// The same as shortest_path_within_hops above, except that when
+// `cancellation` stops the search it returns the distances of the last
+// finished round with the SearchStatus of the token, instead of throwing.
+//
+// After r rounds, the distances are the lengths of the shortest paths with at
+// most r edges, so a partial result is exact for fewer edges and an upper
+// bound for max_edges.
+SearchResult<std::vector<int>> partial_shortest_path_within_hops(
+    const CsrGraph& in_edges, const int start, const int max_edges,
+    const CancellationToken& cancellation);
+SearchResult<std::vector<int>> partial_shortest_path_within_hops(
+    const CsrGraph& in_edges, const int start, const int max_edges,
+    TraversalWorkspace& workspace, const CancellationToken& cancellation);
+
+// Returns for each vertex in the graph the length of the shortest path from
+// vertex start to the vertex, for weights of any of the types BasicCsrGraph
+// is instantiated for.
+//
+// The lengths are summed, stored and queued as Distance, which defaults to
+// the PathLength of the weights (see path_length.hpp): wide enough that the
+// sums cannot overflow in practice. The i^th value in the return vector is
+// the length of the shortest path from vertex start to vertex i (if a path
+// exists) and std::numeric_limits<Distance>::max() otherwise; lengths beyond
+// that saturate at it.
+//
+// This runs Djikstra's algorithm with a binary heap of (distance, vertex)
+// pairs, so a narrow Distance also makes the queue entries narrower.
+//
+// Throws a std::range_error exception if start is not a valid vertex.
+//
+// ASSUMES: The edge weights in graph are non-negative.
+template <class Weight, class Distance = typename PathLength<Weight>::type>
+std::vector<Distance> weighted_shortest_path(
+    const BasicCsrGraph<Weight>& graph, const int start);
+
+// The same as weighted_shortest_path above, for any other graph (such as an
+// UndirectedGraph<BasicAdjacencyListGraph<Checked, Weight>>), by running the
+// workspace overload of shortest_path with a BasicTraversalWorkspace of
+// Distance, which defaults to the PathLength of its edge weights.
+template <
+    class Graph,
+    class Distance = typename PathLength<GraphWeight<Graph>>::type>
+std::vector<Distance> weighted_shortest_path(
+    const Graph& graph, const int start);
+
+//
+// Definitions
+//
+
+// The traversals built on the searches of graph_search.hpp (and their
+// visitors) are defined here, in the header, so that, like the searches, they
+// are instantiated for whatever graph type they are called with, and the
+// callbacks of their visitors are inlined into the search. The other
+// traversals are defined in graph_traversal.cpp, which instantiates them for
+// the graph types of this project.
+
+template <class Graph>
+VertexSet distance_at_most_two(const Graph& graph, const int start) {
+  TraversalWorkspace workspace;
+  return distance_at_most_two(graph, start, workspace);
+}
+
+// The visitor of distance_at_most_two, which stops the breadth first search at
+// the first vertex two edges from vertex start (by then every vertex at most
+// two edges away has been discovered), and checks `cancellation` at each
+// vertex expanded before that.
+class DistanceAtMostTwoVisitor : public SearchVisitor {
+ public:
+  explicit DistanceAtMostTwoVisitor(const CancellationToken& cancellation)
+      : cancellation_(cancellation) {}
+
+  template <class Distance>
+  void on_settle(const int, const Distance distance) {
+    if (distance == 2) {
+      done_ = true;
+    } else {
+      cancellation_.throw_if_cancelled();
+    }
+  }
+
+  bool should_stop() {
+    return done_;
+  }
+
+ private:
+  const CancellationToken& cancellation_;
+  bool done_ = false;
+};
+
+template <class Graph, class Distance>
+VertexSet distance_at_most_two(
+    const Graph& graph, const int start,
+    BasicTraversalWorkspace<Distance>& workspace,
+    const CancellationToken& cancellation) {
+  DistanceAtMostTwoVisitor visitor(cancellation);
+  breadth_first_search(graph, start, workspace, visitor);
+
+  VertexSet result(graph.vertex_count());
+  for (const int v : workspace.touched()) {
+    result.insert(v);
+  }
+  return result;
+}
+
+template <class Graph>
+std::vector<int> shortest_path(const Graph& graph, const int start) {
+  TraversalWorkspace workspace;
+  return shortest_path(graph, start, workspace);
+}
+
+// The visitor of run_shortest_path, which drops the paths longer than
+// max_distance, checks `cancellation` once every
+// CancellationToken::kCheckInterval settled vertices, and stops the search
+// once vertex target (if not -1) is settled.
+template <class Distance>
+class ShortestPathVisitor : public SearchVisitor {
+ public:
+  ShortestPathVisitor(
+      const int target, const Distance max_distance,
+      const CancellationToken& cancellation)
+      : target_(target),
+        max_distance_(max_distance),
+        cancellation_(cancellation) {}
+
+  bool on_relax(const int, const int, const Distance distance) {
+    return distance <= max_distance_;
+  }
+
+  void on_settle(const int v, const Distance) {
+    if (++settled_ % CancellationToken::kCheckInterval == 0) {
+      status_ = cancellation_.status();
+    }
+    // Every vertex left in the queue is at least as far as the target.
+    stop_ = status_ != SearchStatus::kComplete || v == target_;
+  }
+
+  bool should_stop() {
+    return stop_;
+  }
+
+  // Returns the status of the token when the search stopped, and
+  // SearchStatus::kComplete if it was not stopped by the token.
+  SearchStatus status() const {
+    return status_;
+  }
+
+ private:
+  const int target_;
+  const Distance max_distance_;
+  const CancellationToken& cancellation_;
+  int settled_ = 0;
+  SearchStatus status_ = SearchStatus::kComplete;
+  bool stop_ = false;
+};
+
+// A helper method for the workspace overload of shortest_path,
+// shortest_path_to and shortest_paths_within that runs Djikstra's algorithm
+// from vertex start, using `workspace` for its state, until every reachable
+// vertex is settled or (if target is not -1) until vertex target is settled.
+//
+// Vertices further than max_distance from vertex start are never touched, so
+// afterwards the touched vertices are exactly those at most max_distance away,
+// all of them settled (unless the search stopped at vertex target).
+//
+// The search stops early if `cancellation` is found cancelled (it is checked
+// once every CancellationToken::kCheckInterval settled vertices). The return
+// value is the status of the token then, and SearchStatus::kComplete if the
+// search finished.
+//
+// ASSUMES: start and target (unless it is -1) are valid vertices, and
+// max_distance is not negative.
+template <class Graph, class Distance>
+SearchStatus run_shortest_path(
+    const Graph& graph, const int start, const int target,
+    const Distance max_distance, BasicTraversalWorkspace<Distance>& workspace,
+    const CancellationToken& cancellation) {
+  ShortestPathVisitor<Distance> visitor(target, max_distance, cancellation);
+  djikstra_search(graph, start, workspace, visitor);
+  return visitor.status();
+}
+
+template <class Graph, class Distance>
+std::vector<Distance> shortest_path(
+    const Graph& graph, const int start,
+    BasicTraversalWorkspace<Distance>& workspace,
+    const CancellationToken& cancellation) {
+  SearchResult<std::vector<Distance>> result =
+      partial_shortest_path(graph, start, workspace, cancellation);
+  throw_if_stopped(result.status);
+  return std::move(result.value);
+}
+
+template <class Graph, class Distance>
+SearchResult<std::vector<Distance>> partial_shortest_path(
+    const Graph& graph, const int start,
+    BasicTraversalWorkspace<Distance>& workspace,
+    const CancellationToken& cancellation) {
+  if (start < 0 || start >= graph.vertex_count()) {
+    throw std::range_error("Not a valid index");
+  }
+  const SearchStatus status = run_shortest_path(
+      graph, start, -1, std::numeric_limits<Distance>::max(), workspace,
+      cancellation);
+
+  // Unless the search stopped early, every touched vertex is settled.
+  std::vector<Distance> distance(
+      graph.vertex_count(), std::numeric_limits<Distance>::max());
+  for (const int v : workspace.touched()) {
+    if (workspace.settled(v)) {
+      distance[v] = workspace.distance(v);
+    }
+  }
+  return {status, std::move(distance)};
+}
+
+template <class Graph, class Distance>
+Distance shortest_path_to(
+    const Graph& graph, const int start, const int target,
+    BasicTraversalWorkspace<Distance>& workspace,
+    const CancellationToken& cancellation) {
+  if (start < 0 || start >= graph.vertex_count()) {
+    throw std::range_error("Not a valid index");
+  }
+  if (target < 0 || target >= graph.vertex_count()) {
+    throw std::range_error("Not a valid index");
+  }
+  throw_if_stopped(run_shortest_path(
+      graph, start, target, std::numeric_limits<Distance>::max(), workspace,
+      cancellation));
+  return workspace.distance(target);
+}
+
+template <class Graph, class Distance>
+std::vector<std::pair<int, Distance>> shortest_paths_within(
+    const Graph& graph, const int start,
+    const typename BasicTraversalWorkspace<Distance>::DistanceType max_distance,
+    BasicTraversalWorkspace<Distance>& workspace,
+    const CancellationToken& cancellation) {
+  SearchResult<std::vector<std::pair<int, Distance>>> result =
+      partial_shortest_paths_within(
+          graph, start, max_distance, workspace, cancellation);
+  throw_if_stopped(result.status);
+  return std::move(result.value);
+}
+
+template <class Graph, class Distance>
+SearchResult<std::vector<std::pair<int, Distance>>>
+partial_shortest_paths_within(
+    const Graph& graph, const int start,
+    const typename BasicTraversalWorkspace<Distance>::DistanceType max_distance,
+    BasicTraversalWorkspace<Distance>& workspace,
+    const CancellationToken& cancellation) {
+  if (start < 0 || start >= graph.vertex_count()) {
+    throw std::range_error("Not a valid index");
+  }
+  if (max_distance < 0) {
+    throw std::invalid_argument("max_distance cannot be negative");
+  }
+  const SearchStatus status = run_shortest_path(
+      graph, start, -1, max_distance, workspace, cancellation);
+
+  // Unless the search stopped early, every touched vertex is settled.
+  std::vector<std::pair<int, Distance>> reached;
+  reached.reserve(workspace.touched().size());
+  for (const int v : workspace.touched()) {
+    if (workspace.settled(v)) {
+      reached.emplace_back(v, workspace.distance(v));
+    }
+  }
+  std::sort(
+      reached.begin(), reached.end(),
+      [](const std::pair<int, Distance>& a, const std::pair<int, Distance>& b) {
+        return a.second < b.second ||
+               (a.second == b.second && a.first < b.first);
+      });
+  return {status, std::move(reached)};
+}
+
+template <class Graph, class Distance>
+std::vector<Distance> weighted_shortest_path(
+    const Graph& graph, const int start) {
+  BasicTraversalWorkspace<Distance> workspace;
+  return shortest_path(graph, start, workspace);
+}
+
 #endif
\ No newline at end of file
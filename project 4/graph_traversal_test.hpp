@@ -3,12 +3,21 @@
 
 #include "graph_traversal.hpp"
 
+#include <chrono>
+#include <cstdint>
 #include <limits>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 #include "adjacency_list_graph.hpp"
 #include "adjacency_matrix_graph.hpp"
+#include "bit_matrix_graph.hpp"
+#include "cancellation_token.hpp"
+#include "csr_graph.hpp"
+#include "test_random.hpp"
 #include "undirected_graph.hpp"
+#include "vertex_set.hpp"
 #include "doctest.hpp"
 
 constexpr int kIntMax = std::numeric_limits<int>::max();
@@ -30,16 +39,16 @@ TEST_CASE("DistanceAtMostTwoInDirectedGraph") {
 
     CHECK_EQ(
         distance_at_most_two(graph, 0),
-        std::vector<bool>({true, false, false, false}));
+        VertexSet(std::vector<bool>({true, false, false, false})));
     CHECK_EQ(
         distance_at_most_two(graph, 1),
-        std::vector<bool>({false, true, false, false}));
+        VertexSet(std::vector<bool>({false, true, false, false})));
     CHECK_EQ(
         distance_at_most_two(graph, 2),
-        std::vector<bool>({false, false, true, false}));
+        VertexSet(std::vector<bool>({false, false, true, false})));
     CHECK_EQ(
         distance_at_most_two(graph, 3),
-        std::vector<bool>({false, false, false, true}));
+        VertexSet(std::vector<bool>({false, false, false, true})));
   }
 
   SUBCASE("StraightPath") {
@@ -50,16 +59,16 @@ TEST_CASE("DistanceAtMostTwoInDirectedGraph") {
 
     CHECK_EQ(
         distance_at_most_two(graph, 0),
-        std::vector<bool>({true, true, true, false}));
+        VertexSet(std::vector<bool>({true, true, true, false})));
     CHECK_EQ(
         distance_at_most_two(graph, 1),
-        std::vector<bool>({false, true, true, true}));
+        VertexSet(std::vector<bool>({false, true, true, true})));
     CHECK_EQ(
         distance_at_most_two(graph, 2),
-        std::vector<bool>({false, false, true, true}));
+        VertexSet(std::vector<bool>({false, false, true, true})));
     CHECK_EQ(
         distance_at_most_two(graph, 3),
-        std::vector<bool>({false, false, false, true}));
+        VertexSet(std::vector<bool>({false, false, false, true})));
   }
 
   SUBCASE("CompleteGraph") {
@@ -72,16 +81,16 @@ TEST_CASE("DistanceAtMostTwoInDirectedGraph") {
 
     CHECK_EQ(
         distance_at_most_two(graph, 0),
-        std::vector<bool>({true, true, true, true}));
+        VertexSet(std::vector<bool>({true, true, true, true})));
     CHECK_EQ(
         distance_at_most_two(graph, 1),
-        std::vector<bool>({true, true, true, true}));
+        VertexSet(std::vector<bool>({true, true, true, true})));
     CHECK_EQ(
         distance_at_most_two(graph, 2),
-        std::vector<bool>({true, true, true, true}));
+        VertexSet(std::vector<bool>({true, true, true, true})));
     CHECK_EQ(
         distance_at_most_two(graph, 3),
-        std::vector<bool>({true, true, true, true}));
+        VertexSet(std::vector<bool>({true, true, true, true})));
   }
 }
 
@@ -102,16 +111,16 @@ TEST_CASE("DistanceAtMostTwoInUndirectedGraph") {
 
     CHECK_EQ(
         distance_at_most_two(graph, 0),
-        std::vector<bool>({true, false, false, false}));
+        VertexSet(std::vector<bool>({true, false, false, false})));
     CHECK_EQ(
         distance_at_most_two(graph, 1),
-        std::vector<bool>({false, true, false, false}));
+        VertexSet(std::vector<bool>({false, true, false, false})));
     CHECK_EQ(
         distance_at_most_two(graph, 2),
-        std::vector<bool>({false, false, true, false}));
+        VertexSet(std::vector<bool>({false, false, true, false})));
     CHECK_EQ(
         distance_at_most_two(graph, 3),
-        std::vector<bool>({false, false, false, true}));
+        VertexSet(std::vector<bool>({false, false, false, true})));
   }
 
   SUBCASE("StraightPath") {
@@ -122,16 +131,16 @@ TEST_CASE("DistanceAtMostTwoInUndirectedGraph") {
 
     CHECK_EQ(
         distance_at_most_two(graph, 0),
-        std::vector<bool>({true, true, true, false}));
+        VertexSet(std::vector<bool>({true, true, true, false})));
     CHECK_EQ(
         distance_at_most_two(graph, 1),
-        std::vector<bool>({true, true, true, true}));
+        VertexSet(std::vector<bool>({true, true, true, true})));
     CHECK_EQ(
         distance_at_most_two(graph, 2),
-        std::vector<bool>({true, true, true, true}));
+        VertexSet(std::vector<bool>({true, true, true, true})));
     CHECK_EQ(
         distance_at_most_two(graph, 3),
-        std::vector<bool>({false, true, true, true}));
+        VertexSet(std::vector<bool>({false, true, true, true})));
   }
 
   SUBCASE("CompleteGraph") {
@@ -144,16 +153,16 @@ TEST_CASE("DistanceAtMostTwoInUndirectedGraph") {
 
     CHECK_EQ(
         distance_at_most_two(graph, 0),
-        std::vector<bool>({true, true, true, true}));
+        VertexSet(std::vector<bool>({true, true, true, true})));
     CHECK_EQ(
         distance_at_most_two(graph, 1),
-        std::vector<bool>({true, true, true, true}));
+        VertexSet(std::vector<bool>({true, true, true, true})));
     CHECK_EQ(
         distance_at_most_two(graph, 2),
-        std::vector<bool>({true, true, true, true}));
+        VertexSet(std::vector<bool>({true, true, true, true})));
     CHECK_EQ(
         distance_at_most_two(graph, 3),
-        std::vector<bool>({true, true, true, true}));
+        VertexSet(std::vector<bool>({true, true, true, true})));
   }
 }
 
@@ -277,4 +286,339 @@ TEST_CASE("ShortestPathInUndirectedGraph") {
   }
 }
 
+TEST_CASE_TEMPLATE(
+    "DenseShortestPathMatchesShortestPath", GraphT, AdjacencyMatrixGraph,
+    BitMatrixGraph, UndirectedGraph<AdjacencyMatrixGraph>,
+    UndirectedGraph<BitMatrixGraph>) {
+  SUBCASE("InvalidStartThrowsException") {
+    GraphT graph(4);
+    CHECK_THROWS_AS(dense_shortest_path(graph, -1), std::range_error);
+    CHECK_THROWS_AS(dense_shortest_path(graph, 4), std::range_error);
+  }
+
+  SUBCASE("StraightPath") {
+    GraphT graph(4);
+    graph.add_edge(0, 1);
+    graph.add_edge(1, 2);
+    graph.add_edge(2, 3);
+    for (int start = 0; start < 4; ++start) {
+      CHECK_EQ(dense_shortest_path(graph, start), shortest_path(graph, start));
+    }
+  }
+
+  SUBCASE("PseudoRandomGraph") {
+    // A vertex count that is not a multiple of the SIMD width, with the last
+    // few vertices left unreachable.
+    constexpr int kVertexCount = 150;
+    const GraphT graph =
+        random_graph<GraphT>(kVertexCount, 600, 100, 12345, 5);
+    for (int start = 0; start < kVertexCount; start += 7) {
+      CHECK_EQ(dense_shortest_path(graph, start), shortest_path(graph, start));
+    }
+  }
+
+  SUBCASE("WorkspaceMatchesFreshState") {
+    // One workspace is reused across graphs of different sizes.
+    TraversalWorkspace workspace;
+    CHECK_THROWS_AS(
+        dense_shortest_path(GraphT(4), 4, workspace), std::range_error);
+    for (const int vertex_count : {70, 150, 20}) {
+      const GraphT graph =
+          random_graph<GraphT>(vertex_count, 4 * vertex_count, 100, 3);
+      for (int start = 0; start < vertex_count; start += 9) {
+        CHECK_EQ(
+            dense_shortest_path(graph, start, workspace),
+            dense_shortest_path(graph, start));
+      }
+    }
+  }
+}
+
+TEST_CASE_TEMPLATE(
+    "WeightedShortestPathMatchesShortestPath", WeightT, std::uint16_t,
+    std::int32_t, std::int64_t, float) {
+  using Distance = typename PathLength<WeightT>::type;
+  constexpr int kVertexCount = 150;
+  const auto graph = random_graph<UndirectedGraph<AdjacencyListGraph>>(
+      kVertexCount, 500, 1000, 48, 5);
+  const BasicCsrGraph<WeightT> csr(graph);
+  int mismatches = 0;
+  for (int start = 0; start < kVertexCount; start += 7) {
+    const std::vector<int> expected = shortest_path(graph, start);
+    const std::vector<Distance> actual = weighted_shortest_path(csr, start);
+    for (int v = 0; v < kVertexCount; ++v) {
+      const bool unreachable = expected[v] == std::numeric_limits<int>::max();
+      if (unreachable ? actual[v] != std::numeric_limits<Distance>::max()
+                      : actual[v] != static_cast<Distance>(expected[v])) {
+        ++mismatches;
+      }
+    }
+  }
+  CHECK_EQ(mismatches, 0);
+  CHECK_THROWS_AS(weighted_shortest_path(csr, -1), std::range_error);
+  CHECK_THROWS_AS(weighted_shortest_path(csr, kVertexCount), std::range_error);
+}
+
+TEST_CASE_TEMPLATE(
+    "WeightedShortestPathOverWeightedGraphs", WeightT, std::uint16_t,
+    std::int32_t, std::int64_t, float) {
+  // The list, matrix and symmetric undirected graphs with WeightT weights
+  // find the same lengths as the BasicCsrGraph<WeightT> of the same edges.
+  using Distance = typename PathLength<WeightT>::type;
+  constexpr int kVertexCount = 90;
+  const auto list =
+      random_graph<UndirectedGraph<BasicAdjacencyListGraph<Checked, WeightT>>>(
+          kVertexCount, 300, 1000, 49, 4);
+  const auto matrix = random_graph<
+      UndirectedGraph<BasicAdjacencyMatrixGraph<Checked, WeightT>>>(
+      kVertexCount, 300, 1000, 49, 4);
+  const auto symmetric =
+      random_graph<UndirectedGraph<BasicSymmetricEdges<Checked, WeightT>>>(
+          kVertexCount, 300, 1000, 49, 4);
+  const BasicCsrGraph<WeightT> csr(
+      random_graph<UndirectedGraph<AdjacencyListGraph>>(
+          kVertexCount, 300, 1000, 49, 4));
+  int mismatches = 0;
+  for (int start = 0; start < kVertexCount; start += 6) {
+    const std::vector<Distance> expected = weighted_shortest_path(csr, start);
+    mismatches += weighted_shortest_path(list, start) != expected;
+    mismatches += weighted_shortest_path(matrix, start) != expected;
+    mismatches += weighted_shortest_path(symmetric, start) != expected;
+  }
+  CHECK_EQ(mismatches, 0);
+}
+
+TEST_CASE("WeightedShortestPathDoesNotOverflow") {
+  // Three edges of weight 2^30 make a path longer than the largest int.
+  constexpr int kHeavy = 1 << 30;
+  AdjacencyListGraph graph(4);
+  graph.add_edge(0, 1, kHeavy);
+  graph.add_edge(1, 2, kHeavy);
+  graph.add_edge(2, 3, kHeavy);
+  const std::vector<std::int64_t> distance =
+      weighted_shortest_path(BasicCsrGraph<std::int32_t>(graph), 0);
+  CHECK_EQ(distance[3], std::int64_t{3} * kHeavy);
+
+  // The same holds for the searches over the graph itself, in its
+  // PathLengthWorkspace, while with int distances the path is dropped rather
+  // than overflowing.
+  CHECK_EQ(weighted_shortest_path(graph, 0), distance);
+  CHECK_EQ(
+      shortest_path(graph, 0), std::vector<int>({0, kHeavy, kIntMax, kIntMax}));
+
+  // Near the top of std::int64_t, the lengths saturate.
+  BasicCsrGraph<std::int64_t> wide(graph);
+  wide.set_edge(1, 2, std::numeric_limits<std::int64_t>::max() - 5);
+  const std::vector<std::int64_t> saturated = weighted_shortest_path(wide, 0);
+  CHECK_EQ(saturated[1], kHeavy);
+  CHECK_EQ(saturated[2], std::numeric_limits<std::int64_t>::max());
+  CHECK_EQ(saturated[3], std::numeric_limits<std::int64_t>::max());
+}
+
+TEST_CASE("ShortestPathWithinHops") {
+  SUBCASE("InvalidArgumentsThrowException") {
+    AdjacencyMatrixGraph graph(4);
+    CHECK_THROWS_AS(shortest_path_within_hops(graph, -1, 2), std::range_error);
+    CHECK_THROWS_AS(shortest_path_within_hops(graph, 4, 2), std::range_error);
+    CHECK_THROWS_AS(
+        shortest_path_within_hops(graph, 0, -1), std::invalid_argument);
+  }
+
+  SUBCASE("CheaperPathWithMoreEdges") {
+    // The direct edge from 0 to 3 is long; the path through 1 and 2 is short.
+    AdjacencyListGraph graph(4);
+    graph.add_edge(0, 3, 100);
+    graph.add_edge(0, 1, 1);
+    graph.add_edge(1, 2, 1);
+    graph.add_edge(2, 3, 1);
+
+    CHECK_EQ(
+        shortest_path_within_hops(graph, 0, 0),
+        std::vector<int>({0, kIntMax, kIntMax, kIntMax}));
+    CHECK_EQ(
+        shortest_path_within_hops(graph, 0, 1),
+        std::vector<int>({0, 1, kIntMax, 100}));
+    CHECK_EQ(
+        shortest_path_within_hops(graph, 0, 2),
+        std::vector<int>({0, 1, 2, 100}));
+    CHECK_EQ(
+        shortest_path_within_hops(graph, 0, 3),
+        std::vector<int>({0, 1, 2, 3}));
+    CHECK_EQ(
+        shortest_path_within_hops(graph, 3, 3),
+        std::vector<int>({kIntMax, kIntMax, kIntMax, 0}));
+  }
+
+  SUBCASE("HeavyPathsAreDroppedRatherThanOverflowing") {
+    constexpr int kHeavy = 1 << 30;
+    AdjacencyListGraph graph(4);
+    graph.add_edge(0, 1, kHeavy);
+    graph.add_edge(1, 2, kHeavy);
+    graph.add_edge(2, 3, kHeavy);
+    CHECK_EQ(
+        shortest_path_within_hops(graph, 0, 3),
+        std::vector<int>({0, kHeavy, kIntMax, kIntMax}));
+  }
+
+  SUBCASE("EnoughHopsMatchesShortestPath") {
+    constexpr int kVertexCount = 60;
+    const auto graph = random_graph<UndirectedGraph<AdjacencyListGraph>>(
+        kVertexCount, 150, 50, 7);
+    for (int start = 0; start < kVertexCount; start += 5) {
+      CHECK_EQ(
+          shortest_path_within_hops(graph, start, kVertexCount - 1),
+          shortest_path(graph, start));
+    }
+  }
+}
+
+TEST_CASE_TEMPLATE(
+    "WorkspaceTraversalsMatchTraversals", GraphT, AdjacencyListGraph,
+    AdjacencyMatrixGraph, UndirectedGraph<AdjacencyListGraph>,
+    UndirectedGraph<BitMatrixGraph>) {
+  // One workspace is reused across every call, including for graphs of
+  // different sizes.
+  TraversalWorkspace workspace;
+
+  SUBCASE("InvalidStartThrowsException") {
+    GraphT graph(4);
+    CHECK_THROWS_AS(
+        distance_at_most_two(graph, -1, workspace), std::range_error);
+    CHECK_THROWS_AS(
+        distance_at_most_two(graph, 4, workspace), std::range_error);
+    CHECK_THROWS_AS(shortest_path(graph, -1, workspace), std::range_error);
+    CHECK_THROWS_AS(shortest_path(graph, 4, workspace), std::range_error);
+    CHECK_THROWS_AS(shortest_path_to(graph, 4, 0, workspace), std::range_error);
+    CHECK_THROWS_AS(
+        shortest_path_to(graph, 0, -1, workspace), std::range_error);
+    CHECK_THROWS_AS(
+        shortest_paths_within(graph, 4, 10, workspace), std::range_error);
+    CHECK_THROWS_AS(
+        shortest_paths_within(graph, 0, -1, workspace), std::invalid_argument);
+    CHECK_THROWS_AS(
+        shortest_path_within_hops(graph, 4, 2, workspace), std::range_error);
+    CHECK_THROWS_AS(
+        shortest_path_within_hops(graph, 0, -1, workspace),
+        std::invalid_argument);
+  }
+
+  SUBCASE("PseudoRandomGraphs") {
+    for (const int vertex_count : {40, 90, 15}) {
+      const GraphT graph =
+          random_graph<GraphT>(vertex_count, 2 * vertex_count, 100, 1);
+      for (int start = 0; start < vertex_count; start += 3) {
+        CHECK_EQ(
+            distance_at_most_two(graph, start, workspace),
+            distance_at_most_two(graph, start));
+        const std::vector<int> expected = shortest_path(graph, start);
+        CHECK_EQ(shortest_path(graph, start, workspace), expected);
+        for (int target = 0; target < vertex_count; target += 5) {
+          CHECK_EQ(
+              shortest_path_to(graph, start, target, workspace),
+              expected[target]);
+        }
+        const int budget = 150;
+        std::vector<int> within(vertex_count, kIntMax);
+        for (const std::pair<int, int>& reached :
+             shortest_paths_within(graph, start, budget, workspace)) {
+          within[reached.first] = reached.second;
+        }
+        for (int v = 0; v < vertex_count; ++v) {
+          CHECK_EQ(within[v], expected[v] <= budget ? expected[v] : kIntMax);
+        }
+        CHECK_EQ(
+            shortest_path_within_hops(graph, start, 3, workspace),
+            shortest_path_within_hops(graph, start, 3));
+      }
+    }
+  }
+}
+
+TEST_CASE("StoppedTraversals") {
+  // A path 0 - 1 - ... - 999 of unit edges, so that the searches from vertex
+  // 0 settle the vertices in order.
+  constexpr int kVertexCount = 1000;
+  UndirectedGraph<AdjacencyListGraph> graph(kVertexCount);
+  for (int v = 0; v + 1 < kVertexCount; ++v) {
+    graph.add_edge(v, v + 1);
+  }
+  const CsrGraph in_edges(graph);
+  TraversalWorkspace workspace;
+  CancellationSource source;
+  source.cancel();
+  const CancellationToken cancelled = source.token();
+  const CancellationToken expired = CancellationToken().with_deadline(
+      CancellationToken::Clock::now() - std::chrono::seconds(1));
+  const CancellationToken live =
+      CancellationSource().token().with_timeout(std::chrono::hours(1));
+
+  SUBCASE("CompleteSearchesMatchUnstoppedSearches") {
+    const SearchResult<std::vector<int>> full =
+        partial_shortest_path(graph, 0, workspace, live);
+    CHECK_EQ(full.status, SearchStatus::kComplete);
+    CHECK_EQ(full.value, shortest_path(graph, 0));
+    const SearchResult<std::vector<std::pair<int, int>>> within =
+        partial_shortest_paths_within(graph, 0, 500, workspace, live);
+    CHECK_EQ(within.status, SearchStatus::kComplete);
+    CHECK_EQ(within.value, shortest_paths_within(graph, 0, 500, workspace));
+    const SearchResult<std::vector<int>> hops =
+        partial_shortest_path_within_hops(in_edges, 0, 20, live);
+    CHECK_EQ(hops.status, SearchStatus::kComplete);
+    CHECK_EQ(hops.value, shortest_path_within_hops(graph, 0, 20));
+    const SearchResult<std::vector<int>> reused =
+        partial_shortest_path_within_hops(in_edges, 0, 20, workspace, live);
+    CHECK_EQ(reused.status, SearchStatus::kComplete);
+    CHECK_EQ(reused.value, hops.value);
+  }
+
+  SUBCASE("StoppedSearchesThrowException") {
+    CHECK_THROWS_AS(
+        shortest_path(graph, 0, workspace, cancelled), OperationCancelled);
+    CHECK_THROWS_AS(
+        shortest_path(graph, 0, workspace, expired), DeadlineExceeded);
+    CHECK_THROWS_AS(
+        shortest_path_to(graph, 0, kVertexCount - 1, workspace, expired),
+        DeadlineExceeded);
+    CHECK_THROWS_AS(
+        shortest_paths_within(graph, 0, kVertexCount, workspace, cancelled),
+        OperationCancelled);
+    CHECK_THROWS_AS(
+        shortest_path_within_hops(in_edges, 0, 5, expired), DeadlineExceeded);
+    // A search that finishes before its first check is not stopped.
+    CHECK_EQ(shortest_path_to(graph, 0, 10, workspace, cancelled), 10);
+  }
+
+  SUBCASE("StoppedShortestPathKeepsSettledVertices") {
+    const SearchResult<std::vector<int>> partial =
+        partial_shortest_path(graph, 0, workspace, expired);
+    CHECK_EQ(partial.status, SearchStatus::kDeadlineExceeded);
+    // The search stops at its first check, with kCheckInterval vertices
+    // settled.
+    int mismatches = 0;
+    for (int v = 0; v < kVertexCount; ++v) {
+      const int expected = v < CancellationToken::kCheckInterval ? v : kIntMax;
+      mismatches += partial.value[v] != expected;
+    }
+    CHECK_EQ(mismatches, 0);
+
+    const SearchResult<std::vector<std::pair<int, int>>> within =
+        partial_shortest_paths_within(
+            graph, 0, kVertexCount, workspace, cancelled);
+    CHECK_EQ(within.status, SearchStatus::kCancelled);
+    REQUIRE_EQ(within.value.size(), CancellationToken::kCheckInterval);
+    const int last = CancellationToken::kCheckInterval - 1;
+    CHECK_EQ(within.value.back(), std::make_pair(last, last));
+  }
+
+  SUBCASE("StoppedHopSearchKeepsFinishedRounds") {
+    const SearchResult<std::vector<int>> partial =
+        partial_shortest_path_within_hops(in_edges, 3, 5, cancelled);
+    CHECK_EQ(partial.status, SearchStatus::kCancelled);
+    // Stopped before the first round: only the start is reached.
+    std::vector<int> expected(kVertexCount, kIntMax);
+    expected[3] = 0;
+    CHECK_EQ(partial.value, expected);
+  }
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,532 @@
+#include "landmark_labeling.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "aligned_allocator.hpp"
+#include "csr_graph.hpp"
+#include "permutation.hpp"
+#include "traversal_workspace.hpp"
+#include "vertex_order.hpp"
+
+namespace {
+
+constexpr int kIntMax = std::numeric_limits<int>::max();
+
+// The number of entries every label is padded to a multiple of (one AVX-512
+// register of ints).
+constexpr int kBlock = 16;
+
+// The hub rank of padding entries, which sorts after every real hub.
+constexpr int kPadHub = kIntMax;
+
+// The distance of padding entries. Two padding entries may match each other,
+// but their sum (or the sum with any real distance) is at least
+// kPadDistance, which is more than any real sum of two distances.
+constexpr int kPadDistance = kIntMax / 2;
+
+// The first bytes of a file written by LandmarkLabeling::save.
+constexpr char kMagic[8] = {'P', 'L', 'L', 'A', 'B', 'E', 'L', '2'};
+
+// Returns the least a_distances[i] + b_distances[j] over the entries i and j
+// of two labels with the same hub (a_hubs[i] == b_hubs[j]). This is at least
+// kPadDistance if the labels share no real hub.
+//
+// ASSUMES: The labels are 64-byte aligned, sorted by hub, and padded to a
+// multiple of kBlock entries.
+int merge_labels(
+    const int* a_hubs, const int* a_distances, const long a_count,
+    const int* b_hubs, const int* b_distances, const long b_count) {
+  long i = 0;
+  long j = 0;
+#if defined(__AVX512F__)
+  // Compare a block of 16 hubs of each label against each other, rotating
+  // the second block one lane at a time, and advance past whichever block
+  // ends with the smaller hub.
+  const __m512i rotate = _mm512_set_epi32(
+      0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+  __m512i best = _mm512_set1_epi32(kIntMax);
+  while (i < a_count && j < b_count) {
+    const __m512i a_hub = _mm512_load_si512(a_hubs + i);
+    const __m512i a_distance = _mm512_load_si512(a_distances + i);
+    __m512i b_hub = _mm512_load_si512(b_hubs + j);
+    __m512i b_distance = _mm512_load_si512(b_distances + j);
+    for (int r = 0; r < 16; ++r) {
+      const __mmask16 same = _mm512_cmpeq_epi32_mask(a_hub, b_hub);
+      best = _mm512_mask_min_epi32(
+          best, same, best, _mm512_add_epi32(a_distance, b_distance));
+      b_hub = _mm512_permutexvar_epi32(rotate, b_hub);
+      b_distance = _mm512_permutexvar_epi32(rotate, b_distance);
+    }
+    const int a_last = a_hubs[i + 15];
+    const int b_last = b_hubs[j + 15];
+    i += a_last <= b_last ? 16 : 0;
+    j += b_last <= a_last ? 16 : 0;
+  }
+  return _mm512_reduce_min_epi32(best);
+#elif defined(__AVX2__)
+  const __m256i rotate = _mm256_set_epi32(0, 7, 6, 5, 4, 3, 2, 1);
+  const __m256i none = _mm256_set1_epi32(kIntMax);
+  __m256i best = none;
+  while (i < a_count && j < b_count) {
+    const __m256i a_hub =
+        _mm256_load_si256(reinterpret_cast<const __m256i*>(a_hubs + i));
+    const __m256i a_distance =
+        _mm256_load_si256(reinterpret_cast<const __m256i*>(a_distances + i));
+    __m256i b_hub =
+        _mm256_load_si256(reinterpret_cast<const __m256i*>(b_hubs + j));
+    __m256i b_distance =
+        _mm256_load_si256(reinterpret_cast<const __m256i*>(b_distances + j));
+    for (int r = 0; r < 8; ++r) {
+      const __m256i same = _mm256_cmpeq_epi32(a_hub, b_hub);
+      const __m256i sum = _mm256_add_epi32(a_distance, b_distance);
+      best = _mm256_min_epi32(best, _mm256_blendv_epi8(none, sum, same));
+      b_hub = _mm256_permutevar8x32_epi32(b_hub, rotate);
+      b_distance = _mm256_permutevar8x32_epi32(b_distance, rotate);
+    }
+    const int a_last = a_hubs[i + 7];
+    const int b_last = b_hubs[j + 7];
+    i += a_last <= b_last ? 8 : 0;
+    j += b_last <= a_last ? 8 : 0;
+  }
+  alignas(32) int lanes[8];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), best);
+  return *std::min_element(lanes, lanes + 8);
+#else
+  int best = kIntMax;
+  while (i < a_count && j < b_count) {
+    if (a_hubs[i] < b_hubs[j]) {
+      i++;
+    } else if (a_hubs[i] > b_hubs[j]) {
+      j++;
+    } else {
+      best = std::min(best, a_distances[i] + b_distances[j]);
+      i++;
+      j++;
+    }
+  }
+  return best;
+#endif
+}
+
+// Returns count rounded up to a whole number of blocks.
+long padded_size(const long count) {
+  return (count + kBlock - 1) / kBlock * kBlock;
+}
+
+// Writes `count` values starting at `values` to `stream`.
+template <class T>
+void write_values(std::ofstream& stream, const T* values, const long count) {
+  stream.write(reinterpret_cast<const char*>(values), count * sizeof(T));
+}
+
+// Reads `count` values from `stream` to `values`.
+template <class T>
+void read_values(std::ifstream& stream, T* values, const long count) {
+  stream.read(reinterpret_cast<char*>(values), count * sizeof(T));
+}
+
+}  // namespace
+
+LandmarkLabeling::LandmarkLabeling(const CsrGraph& graph)
+    : order_(hub_first_order(graph)) {
+  const auto start_time = std::chrono::steady_clock::now();
+  const int n = graph.vertex_count();
+  begins_.assign(n, 0);
+  counts_.assign(n, 0);
+  capacities_.assign(n, 0);
+  // Labels grow by moving to the end of the arena, so leave room for a few
+  // slots per vertex rather than reallocating the arena as it grows.
+  hubs_.reserve(4L * kBlock * n);
+  distances_.reserve(4L * kBlock * n);
+
+  // The searches run in rank order, so every label grows at its end, and is
+  // sorted by rank.
+  TraversalWorkspace workspace;
+  std::vector<int> root_distance(n, kIntMax);
+  for (int rank = 0; rank < n; ++rank) {
+    resume_search(graph, rank, order_[rank], 0, workspace, root_distance);
+  }
+  compact();
+
+  build_seconds_ = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start_time).count();
+}
+
+//
+// Accessors
+//
+
+int LandmarkLabeling::vertex_count() const noexcept {
+  return counts_.size();
+}
+
+long LandmarkLabeling::label_entries() const noexcept {
+  return label_entries_;
+}
+
+long LandmarkLabeling::memory_bytes() const noexcept {
+  return order_.size() * sizeof(int) + begins_.size() * sizeof(long) +
+         (counts_.size() + capacities_.size()) * sizeof(int) +
+         hubs_.size() * (sizeof(int) + sizeof(int));
+}
+
+double LandmarkLabeling::build_seconds() const noexcept {
+  return build_seconds_;
+}
+
+//
+// Queries
+//
+
+int LandmarkLabeling::distance(const int u, const int v) const {
+  if (u < 0 || u >= vertex_count()) {
+    throw std::range_error("invalid u: " + std::to_string(u));
+  }
+  if (v < 0 || v >= vertex_count()) {
+    throw std::range_error("invalid v: " + std::to_string(v));
+  }
+  const int best = merge_labels(
+      hubs_.data() + begins_[u], distances_.data() + begins_[u],
+      padded_size(counts_[u]), hubs_.data() + begins_[v],
+      distances_.data() + begins_[v], padded_size(counts_[v]));
+  return best < kPadDistance ? best : kIntMax;
+}
+
+//
+// Modifiers
+//
+
+void LandmarkLabeling::edge_decreased(
+    const CsrGraph& graph, const int a, const int b) {
+  const int weight = graph.edge_weight(a, b);
+
+  // The new paths through the edge start at a hub of one of its vertices, so
+  // resume the searches of those hubs, in rank order, from the other vertex.
+  // The labels are copied first, as the searches add to them.
+  const std::vector<int> a_hubs(
+      hubs_.begin() + begins_[a], hubs_.begin() + begins_[a] + counts_[a]);
+  const std::vector<int> a_distances(
+      distances_.begin() + begins_[a],
+      distances_.begin() + begins_[a] + counts_[a]);
+  const std::vector<int> b_hubs(
+      hubs_.begin() + begins_[b], hubs_.begin() + begins_[b] + counts_[b]);
+  const std::vector<int> b_distances(
+      distances_.begin() + begins_[b],
+      distances_.begin() + begins_[b] + counts_[b]);
+
+  TraversalWorkspace workspace;
+  std::vector<int> root_distance(vertex_count(), kIntMax);
+  int i = 0;
+  int j = 0;
+  while (i < a_hubs.size() || j < b_hubs.size()) {
+    const int a_rank = i < a_hubs.size() ? a_hubs[i] : kIntMax;
+    const int b_rank = j < b_hubs.size() ? b_hubs[j] : kIntMax;
+    if (a_rank <= b_rank) {
+      resume_search(
+          graph, a_rank, b, a_distances[i] + weight, workspace, root_distance);
+      i++;
+    }
+    if (b_rank <= a_rank) {
+      resume_search(
+          graph, b_rank, a, b_distances[j] + weight, workspace, root_distance);
+      j++;
+    }
+  }
+}
+
+void LandmarkLabeling::edge_increased(
+    const CsrGraph& graph, const int a, const int b, const int old_weight) {
+  if (a < 0 || a >= vertex_count()) {
+    throw std::range_error("invalid a: " + std::to_string(a));
+  }
+  if (b < 0 || b >= vertex_count()) {
+    throw std::range_error("invalid b: " + std::to_string(b));
+  }
+
+  // Only the hubs the edge was tight for, i.e., with a shortest path to one of
+  // its vertices through the other, can have a shortest path through it. The
+  // labels still answer the distances from before the change, so they find
+  // those hubs without a search. The shortest paths from every other hub, and
+  // with them its entries, are unchanged.
+  std::vector<char> affected(vertex_count(), 0);
+  bool any = false;
+  for (int rank = 0; rank < vertex_count(); ++rank) {
+    const int to_a = distance(order_[rank], a);
+    const int to_b = distance(order_[rank], b);
+    if (to_a != kIntMax && to_b != kIntMax &&
+        (to_a + old_weight == to_b || to_b + old_weight == to_a)) {
+      affected[rank] = 1;
+      any = true;
+    }
+  }
+  if (!any) {
+    return;
+  }
+
+  // Drop the entries of the affected hubs, which may now be too short, and
+  // rerun their searches in rank order, pruned by the labels of the hubs
+  // ranked above them as in the constructor.
+  remove_entries(affected);
+  TraversalWorkspace workspace;
+  std::vector<int> root_distance(vertex_count(), kIntMax);
+  for (int rank = 0; rank < vertex_count(); ++rank) {
+    if (affected[rank]) {
+      resume_search(graph, rank, order_[rank], 0, workspace, root_distance);
+    }
+  }
+}
+
+void LandmarkLabeling::compact() {
+  std::vector<int, AlignedAllocator<int>> hubs;
+  std::vector<int, AlignedAllocator<int>> distances;
+  long size = 0;
+  for (int v = 0; v < vertex_count(); ++v) {
+    size += padded_size(counts_[v]);
+  }
+  hubs.assign(size, kPadHub);
+  distances.assign(size, kPadDistance);
+
+  long position = 0;
+  for (int v = 0; v < vertex_count(); ++v) {
+    std::copy_n(
+        hubs_.begin() + begins_[v], counts_[v], hubs.begin() + position);
+    std::copy_n(
+        distances_.begin() + begins_[v], counts_[v],
+        distances.begin() + position);
+    begins_[v] = position;
+    capacities_[v] = padded_size(counts_[v]);
+    position += capacities_[v];
+  }
+  hubs_ = std::move(hubs);
+  distances_ = std::move(distances);
+}
+
+void LandmarkLabeling::resume_search(
+    const CsrGraph& graph, const int rank, const int start,
+    const int start_distance, TraversalWorkspace& workspace,
+    std::vector<int>& root_distance) {
+  const int root = order_[rank];
+  for (int k = 0; k < counts_[root] && hubs_[begins_[root] + k] <= rank; ++k) {
+    root_distance[hubs_[begins_[root] + k]] = distances_[begins_[root] + k];
+  }
+
+  const std::vector<int>& targets = graph.targets();
+  const std::vector<int>& weights = graph.weights();
+  const std::greater<std::pair<int, int>> later;
+  workspace.reset(vertex_count());
+  workspace.set_distance(start, start_distance);
+  std::vector<std::pair<int, int>>& queue = workspace.queue();
+  queue.emplace_back(start_distance, start);
+  while (!queue.empty()) {
+    std::pop_heap(queue.begin(), queue.end(), later);
+    const int current_distance = queue.back().first;
+    const int current = queue.back().second;
+    queue.pop_back();
+    if (workspace.settled(current)) {
+      continue;
+    }
+    workspace.settle(current);
+
+    // Prune the search at vertices whose distance from the root is already
+    // answered by the labels.
+    bool covered = false;
+    for (long k = begins_[current]; k < begins_[current] + counts_[current];
+         ++k) {
+      if (root_distance[hubs_[k]] != kIntMax &&
+          root_distance[hubs_[k]] + distances_[k] <= current_distance) {
+        covered = true;
+        break;
+      }
+    }
+    if (covered) {
+      continue;
+    }
+    insert_entry(current, rank, current_distance);
+
+    for (int e = graph.offset(current); e < graph.offset(current + 1); ++e) {
+      const int v = targets[e];
+      const int candidate = current_distance + weights[e];
+      if (!workspace.settled(v) && candidate < workspace.distance(v)) {
+        workspace.set_distance(v, candidate);
+        queue.emplace_back(candidate, v);
+        std::push_heap(queue.begin(), queue.end(), later);
+      }
+    }
+  }
+
+  for (int k = 0; k < counts_[root]; ++k) {
+    root_distance[hubs_[begins_[root] + k]] = kIntMax;
+  }
+}
+
+void LandmarkLabeling::insert_entry(
+    const int v, const int rank, const int distance) {
+  const long begin = begins_[v];
+  const long end = begin + counts_[v];
+  const long position =
+      std::lower_bound(hubs_.begin() + begin, hubs_.begin() + end, rank) -
+      hubs_.begin();
+  if (position < end && hubs_[position] == rank) {
+    distances_[position] = std::min(distances_[position], distance);
+    return;
+  }
+
+  if (counts_[v] == capacities_[v]) {
+    // The slot is full, so move the label to a slot twice the size at the end
+    // of the arena.
+    const long moved = hubs_.size();
+    capacities_[v] = std::max<long>(kBlock, 2 * capacities_[v]);
+    hubs_.resize(moved + capacities_[v], kPadHub);
+    distances_.resize(moved + capacities_[v], kPadDistance);
+    std::copy_n(hubs_.begin() + begin, counts_[v], hubs_.begin() + moved);
+    std::copy_n(
+        distances_.begin() + begin, counts_[v], distances_.begin() + moved);
+    begins_[v] = moved;
+    insert_entry(v, rank, distance);
+    return;
+  }
+
+  std::copy_backward(
+      hubs_.begin() + position, hubs_.begin() + end, hubs_.begin() + end + 1);
+  std::copy_backward(
+      distances_.begin() + position, distances_.begin() + end,
+      distances_.begin() + end + 1);
+  hubs_[position] = rank;
+  distances_[position] = distance;
+  counts_[v]++;
+  label_entries_++;
+}
+
+void LandmarkLabeling::remove_entries(const std::vector<char>& removed) {
+  for (int v = 0; v < vertex_count(); ++v) {
+    const long begin = begins_[v];
+    const long end = begin + counts_[v];
+    long kept = begin;
+    for (long k = begin; k < end; ++k) {
+      if (!removed[hubs_[k]]) {
+        hubs_[kept] = hubs_[k];
+        distances_[kept] = distances_[k];
+        kept++;
+      }
+    }
+    // The merge reads whole blocks, so the freed entries become padding.
+    std::fill(hubs_.begin() + kept, hubs_.begin() + end, kPadHub);
+    std::fill(
+        distances_.begin() + kept, distances_.begin() + end, kPadDistance);
+    label_entries_ -= end - kept;
+    counts_[v] = kept - begin;
+  }
+}
+
+//
+// Persistence
+//
+
+void LandmarkLabeling::save(const std::string& path) const {
+  std::ofstream stream(path, std::ios::binary);
+  const std::int64_t header[2] = {vertex_count(), label_entries_};
+  stream.write(kMagic, sizeof(kMagic));
+  write_values(stream, header, 2);
+  write_values(stream, order_.data(), order_.size());
+  write_values(stream, counts_.data(), counts_.size());
+  for (int v = 0; v < vertex_count(); ++v) {
+    write_values(stream, hubs_.data() + begins_[v], counts_[v]);
+  }
+  for (int v = 0; v < vertex_count(); ++v) {
+    write_values(stream, distances_.data() + begins_[v], counts_[v]);
+  }
+  if (!stream) {
+    throw std::runtime_error("cannot write labels to " + path);
+  }
+}
+
+LandmarkLabeling LandmarkLabeling::load(const std::string& path) {
+  std::ifstream stream(path, std::ios::binary);
+  char magic[sizeof(kMagic)] = {};
+  std::int64_t header[2] = {-1, -1};
+  stream.read(magic, sizeof(magic));
+  read_values(stream, header, 2);
+  if (!stream || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+      header[0] < 0 || header[0] > kIntMax || header[1] < 0) {
+    throw std::runtime_error("not a landmark labeling file: " + path);
+  }
+
+  // Check the sizes in the header against the rest of the file before
+  // allocating anything for them, so that a corrupt count is reported as such
+  // rather than as a failed allocation.
+  const std::streampos data_begin = stream.tellg();
+  stream.seekg(0, std::ios::end);
+  const std::int64_t data_bytes = stream.tellg() - data_begin;
+  stream.seekg(data_begin);
+  const std::int64_t vertex_bytes = header[0] * 2 * sizeof(int);
+  if (!stream || vertex_bytes > data_bytes ||
+      header[1] > (data_bytes - vertex_bytes) / (2 * sizeof(int))) {
+    throw std::runtime_error("truncated landmark labeling file: " + path);
+  }
+
+  // Read the labels back to back, then spread them out into padded slots.
+  const int n = header[0];
+  LandmarkLabeling labeling;
+  labeling.order_.resize(n);
+  labeling.begins_.resize(n);
+  labeling.counts_.resize(n);
+  labeling.capacities_.resize(n);
+  labeling.label_entries_ = header[1];
+  read_values(stream, labeling.order_.data(), n);
+  read_values(stream, labeling.counts_.data(), n);
+  long entries = 0;
+  for (int v = 0; v < n && stream; ++v) {
+    if (labeling.counts_[v] < 0) {
+      throw std::runtime_error("corrupt landmark labeling file: " + path);
+    }
+    labeling.begins_[v] = entries;
+    entries += labeling.counts_[v];
+  }
+  if (!stream || entries != labeling.label_entries_) {
+    throw std::runtime_error("corrupt landmark labeling file: " + path);
+  }
+  try {
+    inverse_order(labeling.order_);
+  } catch (const std::invalid_argument&) {
+    throw std::runtime_error("corrupt landmark labeling file: " + path);
+  }
+  labeling.hubs_.resize(entries);
+  labeling.distances_.resize(entries);
+  read_values(stream, labeling.hubs_.data(), entries);
+  read_values(stream, labeling.distances_.data(), entries);
+  if (!stream) {
+    throw std::runtime_error("truncated landmark labeling file: " + path);
+  }
+
+  // The updates index arrays by hub rank, and the queries merge labels by it,
+  // so every label must hold valid ranks in increasing order (and distances
+  // that a query can add without overflowing).
+  for (int v = 0; v < n; ++v) {
+    const long begin = labeling.begins_[v];
+    const long end = begin + labeling.counts_[v];
+    for (long k = begin; k < end; ++k) {
+      const int hub = labeling.hubs_[k];
+      const int distance = labeling.distances_[k];
+      if (hub < 0 || hub >= n || (k > begin && hub <= labeling.hubs_[k - 1]) ||
+          distance < 0 || distance >= kPadDistance) {
+        throw std::runtime_error("corrupt landmark labeling file: " + path);
+      }
+    }
+  }
+  labeling.compact();
+  return labeling;
+}
@@ -0,0 +1,199 @@
+#ifndef _landmark_labeling_hpp_
+#define _landmark_labeling_hpp_
+
+#include <string>
+#include <vector>
+
+#include "aligned_allocator.hpp"
+#include "csr_graph.hpp"
+#include "traversal_workspace.hpp"
+
+// The LandmarkLabeling class is an exact distance oracle for an undirected
+// graph: a pruned landmark labeling (a 2-hop cover).
+//
+// Every vertex v has a label, a list of (hub, distance from v to the hub)
+// pairs, such that for any two vertices u and v some shortest path from u to v
+// passes through a hub in both labels. The distance between u and v is then
+// the least (distance from u to the hub) + (distance from v to the hub) over
+// the hubs common to both labels, found by merging the two labels, with no
+// search of the graph.
+//
+// The labels are built by a Djikstra's algorithm search from every vertex, in
+// hub-first (descending degree) order, that is pruned at every vertex whose
+// distance is already answered by the labels so far. Starting from the hubs
+// keeps the labels short, as most shortest paths pass through a hub.
+//
+// The labels are stored sorted by hub rank in one contiguous, 64-byte aligned
+// arena, each padded to a multiple of 16 entries, so that the merge of two
+// labels compares whole blocks of hubs at once with (AVX-512 or AVX2, when
+// compiled for them) vector instructions.
+//
+// An edge that is added or made shorter is folded into the labels by resuming
+// the pruned searches of the hubs of its two vertices from across the edge. A
+// label that outgrows its slot moves to the end of the arena.
+//
+// An edge that is removed or made longer only changes the shortest paths from
+// the hubs it was tight for (those that reached one of its vertices through
+// the other), which the labels themselves identify. The entries of those hubs
+// are dropped from every label and their pruned searches rerun, in rank
+// order; the labels of every other hub stay as they are.
+//
+// For more information, see Akiba, Iwata and Yoshida, "Fast exact
+// shortest-path distance queries on large networks by pruned landmark
+// labeling", SIGMOD 2013, and "Dynamic and historical shortest-path distance
+// queries on large evolving networks by pruned landmark labeling", WWW 2014,
+// and D'Angelo, D'Emidio and Frigioni, "Fully dynamic 2-hop cover labeling",
+// ACM JEA 2019.
+class LandmarkLabeling {
+ public:
+  //
+  // Constructors and Destructors
+  //
+
+  // The constructor. Builds the labels of `graph`.
+  //
+  // ASSUMES: graph is undirected (every edge is stored in both directions),
+  // its edge weights are non-negative, and every distance is less than
+  // std::numeric_limits<int>::max() / 4.
+  explicit LandmarkLabeling(const CsrGraph& graph);
+
+  // The copy constructor.
+  LandmarkLabeling(const LandmarkLabeling& other) = default;
+
+  // The copy assignment constructor.
+  LandmarkLabeling& operator=(const LandmarkLabeling& other) = default;
+
+  // The move constructor.
+  LandmarkLabeling(LandmarkLabeling&& other) = default;
+
+  // The move assignment constructor.
+  LandmarkLabeling& operator=(LandmarkLabeling&& other) = default;
+
+  // The destructor.
+  ~LandmarkLabeling() = default;
+
+  //
+  // Accessors
+  //
+
+  // Returns the number of vertices of the graph.
+  int vertex_count() const noexcept;
+
+  // Returns the total number of (hub, distance) entries over all labels,
+  // excluding padding.
+  long label_entries() const noexcept;
+
+  // Returns the number of bytes used by the labels, including padding and the
+  // slots left behind by labels that moved.
+  long memory_bytes() const noexcept;
+
+  // Returns the time taken to build the labels, in seconds (zero for labels
+  // that were loaded).
+  double build_seconds() const noexcept;
+
+  //
+  // Queries
+  //
+
+  // Returns the length of the shortest path between vertex u and vertex v, or
+  // std::numeric_limits<int>::max() if there is no path.
+  //
+  // Throws a std::range_error exception if u or v is not a valid vertex.
+  int distance(const int u, const int v) const;
+
+  //
+  // Modifiers
+  //
+
+  // Updates the labels after the edge between vertex a and vertex b of
+  // `graph` was added or made shorter.
+  //
+  // Throws a std::range_error exception if a or b is not a valid vertex, or a
+  // std::invalid_argument exception if there is no edge between them.
+  //
+  // ASSUMES: graph is the graph the labels were built from, with that one
+  // change.
+  void edge_decreased(const CsrGraph& graph, const int a, const int b);
+
+  // Updates the labels after the edge between vertex a and vertex b of
+  // `graph`, which had weight old_weight, was removed or made longer.
+  //
+  // Throws a std::range_error exception if a or b is not a valid vertex.
+  //
+  // ASSUMES: graph is the graph the labels were built from, with that one
+  // change.
+  void edge_increased(
+      const CsrGraph& graph, const int a, const int b, const int old_weight);
+
+  //
+  // Persistence
+  //
+
+  // Writes the labels to the file at `path`.
+  //
+  // Throws a std::runtime_error exception if the file cannot be written.
+  void save(const std::string& path) const;
+
+  // Returns the labels read from the file at `path`, as written by save.
+  //
+  // Throws a std::runtime_error exception if the file cannot be read or is not
+  // a file written by save: if its sizes do not match its length, its vertex
+  // order is not a permutation, or a label holds a hub rank out of range or
+  // out of order.
+  static LandmarkLabeling load(const std::string& path);
+
+ private:
+  // Creates empty labels, for load.
+  LandmarkLabeling() = default;
+
+  // Moves every label to a slot of its padded size, one after the other,
+  // dropping the slots left behind by labels that moved.
+  void compact();
+
+  // Runs the pruned search of the hub of the given rank from vertex start, at
+  // the given distance from the hub, adding entries to the labels it reaches.
+  //
+  // The search is pruned only by the hubs of this rank or a higher one (a
+  // lower number), so that entries of lower-ranked hubs left behind by
+  // edge_decreased never hide a shortest path the labels need.
+  void resume_search(
+      const CsrGraph& graph, const int rank, const int start,
+      const int start_distance, TraversalWorkspace& workspace,
+      std::vector<int>& root_distance);
+
+  // Adds the entry (rank, distance) to the label of vertex v, or lowers the
+  // distance of its entry for rank.
+  void insert_entry(const int v, const int rank, const int distance);
+
+  // Removes the entries of the hubs with removed[rank] true from every label.
+  void remove_entries(const std::vector<char>& removed);
+
+  // The vertices in hub (rank) order.
+  std::vector<int> order_;
+
+  // The position in the arena of each vertex's label. Every position is a
+  // multiple of 16.
+  std::vector<long> begins_;
+
+  // The number of entries in each vertex's label, excluding padding.
+  std::vector<int> counts_;
+
+  // The size of each vertex's slot in the arena, a multiple of 16.
+  std::vector<int> capacities_;
+
+  // The hub ranks of the label entries. The entries of a label are sorted by
+  // increasing rank, and padded to the end of its slot with kPadHub.
+  std::vector<int, AlignedAllocator<int>> hubs_;
+
+  // The distances to the hubs of the label entries, in the same order as
+  // hubs_. Padding entries have distance kPadDistance.
+  std::vector<int, AlignedAllocator<int>> distances_;
+
+  // The number of entries, excluding padding.
+  long label_entries_ = 0;
+
+  // The time taken to build the labels, in seconds.
+  double build_seconds_ = 0.0;
+};
+
+#endif
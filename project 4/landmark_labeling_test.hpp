@@ -0,0 +1,225 @@
+#ifndef _landmark_labeling_test_hpp_
+#define _landmark_labeling_test_hpp_
+
+#include "landmark_labeling.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "adjacency_list_graph.hpp"
+#include "csr_graph.hpp"
+#include "doctest.hpp"
+#include "edge.hpp"
+#include "graph_traversal.hpp"
+#include "test_random.hpp"
+#include "undirected_graph.hpp"
+
+TEST_CASE("LandmarkLabeling") {
+  // A pseudo-random undirected graph with a few hubs, sparse enough to leave
+  // it in several components, and with the last two vertices isolated.
+  constexpr int kVertexCount = 150;
+  constexpr int kIsolated = kVertexCount - 2;
+  auto graph = random_graph<UndirectedGraph<AdjacencyListGraph>>(
+      kVertexCount, 120, 100, 11, 2);
+  TestRandom random(12);
+  for (int hub = 0; hub < 5; ++hub) {
+    for (int e = 0; e < 12; ++e) {
+      const int v = random.next(kIsolated);
+      if (v != hub) {
+        graph.add_edge(hub, v, 1 + random.next(100));
+      }
+    }
+  }
+  const CsrGraph csr(graph);
+  const LandmarkLabeling labeling(csr);
+
+  SUBCASE("MatchesShortestPath") {
+    REQUIRE_EQ(labeling.vertex_count(), kVertexCount);
+    int mismatches = 0;
+    for (int u = 0; u < kVertexCount; ++u) {
+      const std::vector<int> expected = shortest_path(graph, u);
+      for (int v = 0; v < kVertexCount; ++v) {
+        mismatches += labeling.distance(u, v) != expected[v];
+      }
+    }
+    CHECK_EQ(mismatches, 0);
+    CHECK_EQ(
+        labeling.distance(kIsolated, kIsolated + 1),
+        std::numeric_limits<int>::max());
+    CHECK_EQ(labeling.distance(kIsolated, kIsolated), 0);
+  }
+
+  SUBCASE("Sizes") {
+    // Every vertex is at least its own hub, and the labels are padded.
+    CHECK_GE(labeling.label_entries(), kVertexCount);
+    CHECK_GE(
+        labeling.memory_bytes(),
+        labeling.label_entries() * 2 * static_cast<long>(sizeof(int)));
+    CHECK_GE(labeling.build_seconds(), 0.0);
+  }
+
+  SUBCASE("BadVerticesThrowException") {
+    CHECK_THROWS_AS(labeling.distance(-1, 0), std::range_error);
+    CHECK_THROWS_AS(labeling.distance(0, kVertexCount), std::range_error);
+  }
+
+  SUBCASE("EdgesAddedOrShortened") {
+    // Join the components and shorten paths, then check every pair.
+    UndirectedGraph<AdjacencyListGraph> changed = graph;
+    CsrGraph changed_csr = csr;
+    LandmarkLabeling updated = labeling;
+    int mismatches = 0;
+    for (int step = 0; step < 40; ++step) {
+      const int i = random.next(kVertexCount);
+      const int j = random.next(kVertexCount);
+      const int weight = 1 + random.next(30);
+      if (i == j ||
+          (changed.has_edge(i, j) && changed.edge_weight(i, j) <= weight)) {
+        continue;
+      }
+      changed.add_edge(i, j, weight);
+      changed_csr.set_edge(i, j, weight);
+      changed_csr.set_edge(j, i, weight);
+      updated.edge_decreased(changed_csr, i, j);
+      if (step % 8 == 7) {
+        for (int u = 0; u < kVertexCount; ++u) {
+          const std::vector<int> expected = shortest_path(changed, u);
+          for (int v = 0; v < kVertexCount; ++v) {
+            mismatches += updated.distance(u, v) != expected[v];
+          }
+        }
+      }
+    }
+    CHECK_EQ(mismatches, 0);
+    CHECK_GT(updated.label_entries(), labeling.label_entries());
+    CHECK_THROWS_AS(
+        updated.edge_decreased(changed_csr, 0, kVertexCount),
+        std::range_error);
+  }
+
+  SUBCASE("EdgesRemovedOrLengthened") {
+    // Remove and lengthen edges (interleaved with shortenings, so that the
+    // repairs also run on labels edge_decreased has changed), then check every
+    // pair.
+    UndirectedGraph<AdjacencyListGraph> changed = graph;
+    CsrGraph changed_csr = csr;
+    LandmarkLabeling updated = labeling;
+    int mismatches = 0;
+    for (int step = 0; step < 60; ++step) {
+      const std::vector<Edge> edges = changed.edges();
+      const Edge& edge = edges[random.next(edges.size())];
+      const int i = edge.i();
+      const int j = edge.j();
+      const int old_weight = edge.weight();
+      if (step % 3 == 0) {
+        changed.remove_edge(i, j);
+        changed_csr.remove_edge(i, j);
+        changed_csr.remove_edge(j, i);
+        updated.edge_increased(changed_csr, i, j, old_weight);
+      } else if (step % 3 == 1) {
+        const int weight = old_weight + 1 + random.next(50);
+        changed.add_edge(i, j, weight);
+        changed_csr.set_edge(i, j, weight);
+        changed_csr.set_edge(j, i, weight);
+        updated.edge_increased(changed_csr, i, j, old_weight);
+      } else if (old_weight > 1) {
+        const int weight = 1 + random.next(old_weight - 1);
+        changed.add_edge(i, j, weight);
+        changed_csr.set_edge(i, j, weight);
+        changed_csr.set_edge(j, i, weight);
+        updated.edge_decreased(changed_csr, i, j);
+      }
+      if (step % 6 == 5) {
+        for (int u = 0; u < kVertexCount; ++u) {
+          const std::vector<int> expected = shortest_path(changed, u);
+          for (int v = 0; v < kVertexCount; ++v) {
+            mismatches += updated.distance(u, v) != expected[v];
+          }
+        }
+      }
+    }
+    CHECK_EQ(mismatches, 0);
+    CHECK_THROWS_AS(
+        updated.edge_increased(changed_csr, -1, 0, 1), std::range_error);
+    CHECK_THROWS_AS(
+        updated.edge_increased(changed_csr, 0, kVertexCount, 1),
+        std::range_error);
+  }
+
+  SUBCASE("UntouchedHubsKeepTheirEntries") {
+    // Lengthening an edge no shortest path uses changes no label.
+    int i = -1;
+    int j = -1;
+    for (const Edge& edge : graph.edges()) {
+      if (labeling.distance(edge.i(), edge.j()) < edge.weight()) {
+        i = edge.i();
+        j = edge.j();
+        break;
+      }
+    }
+    REQUIRE_NE(i, -1);
+    const int old_weight = graph.edge_weight(i, j);
+    CsrGraph changed_csr = csr;
+    changed_csr.set_edge(i, j, old_weight + 10);
+    changed_csr.set_edge(j, i, old_weight + 10);
+    LandmarkLabeling updated = labeling;
+    updated.edge_increased(changed_csr, i, j, old_weight);
+    CHECK_EQ(updated.label_entries(), labeling.label_entries());
+    CHECK_EQ(updated.memory_bytes(), labeling.memory_bytes());
+  }
+
+  SUBCASE("SaveAndLoad") {
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "landmark_labeling_test.bin")
+            .string();
+    labeling.save(path);
+    const LandmarkLabeling loaded = LandmarkLabeling::load(path);
+    std::remove(path.c_str());
+    CHECK_EQ(loaded.vertex_count(), kVertexCount);
+    CHECK_EQ(loaded.label_entries(), labeling.label_entries());
+    CHECK_EQ(loaded.memory_bytes(), labeling.memory_bytes());
+    CHECK_EQ(loaded.build_seconds(), 0.0);
+    int mismatches = 0;
+    for (int u = 0; u < kVertexCount; ++u) {
+      for (int v = 0; v < kVertexCount; ++v) {
+        mismatches += loaded.distance(u, v) != labeling.distance(u, v);
+      }
+    }
+    CHECK_EQ(mismatches, 0);
+
+    // Saved files with one value overwritten: the number of entries (after
+    // the 8-byte magic and the vertex count), the first two vertices of the
+    // order (both set to 0), and the first hub rank of the first label (after
+    // the order and the counts).
+    const auto corrupted = [&](const long offset, const auto value) {
+      labeling.save(path);
+      std::fstream stream(
+          path, std::ios::binary | std::ios::in | std::ios::out);
+      stream.seekp(offset);
+      stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+      stream.close();
+      CHECK_THROWS_AS(LandmarkLabeling::load(path), std::runtime_error);
+    };
+    corrupted(16, std::int64_t{1} << 40);
+    corrupted(24, std::int64_t{0});
+    corrupted(24 + 8 * kVertexCount, kVertexCount);
+    corrupted(24 + 8 * kVertexCount, -1);
+
+    // A file that is not labels, or is missing.
+    {
+      std::ofstream stream(path, std::ios::binary);
+      stream << "not labels";
+    }
+    CHECK_THROWS_AS(LandmarkLabeling::load(path), std::runtime_error);
+    std::remove(path.c_str());
+    CHECK_THROWS_AS(LandmarkLabeling::load(path), std::runtime_error);
+  }
+}
+
+#endif
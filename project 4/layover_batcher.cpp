@@ -0,0 +1,154 @@
+#include "layover_batcher.hpp"
+
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "airport_network.hpp"
+#include "cancellation_token.hpp"
+#include "distance_table.hpp"
+
+LayoverBatcher::LayoverBatcher(
+    const AirportNetwork& network, const int max_batch, const int max_direct)
+    : network_(network), max_batch_(max_batch), max_direct_(max_direct) {
+  if (max_batch <= 0) {
+    throw std::invalid_argument(
+        "max_batch must be positive: " + std::to_string(max_batch));
+  }
+  if (max_direct <= 0) {
+    throw std::invalid_argument(
+        "max_direct must be positive: " + std::to_string(max_direct));
+  }
+}
+
+std::vector<int> LayoverBatcher::least_distance_within_layovers(
+    const std::string& code, const int max_layovers,
+    const CancellationToken& cancellation) {
+  Query query{&code, max_layovers, &cancellation, {}, nullptr, false, {}};
+  std::unique_lock<std::mutex> lock(mutex_);
+  queue_.push_back(&query);
+  while (!query.done) {
+    if (!running_ && queue_.size() >= kMinBatch) {
+      // The batch may not hold this query, if the queue is longer than
+      // max_batch_, in which case the loop goes on.
+      lead_batch(lock);
+    } else if (
+        !running_ && direct_ < max_direct_ && queue_.size() < kMinBatch &&
+        queue_.front() == &query) {
+      // Queries leave the queue for answering on their own in order of
+      // arrival, and not while a batch runs (which uses every core), so that
+      // the queries arriving meanwhile make up the next batch.
+      queue_.pop_front();
+      direct_++;
+      wake_front();
+      lock.unlock();
+      run_batch({&query});
+      lock.lock();
+      direct_--;
+      query.done = true;
+      wake_front();
+    } else {
+      query.wake.wait(lock);
+    }
+  }
+  if (query.error != nullptr) {
+    std::rethrow_exception(query.error);
+  }
+  return std::move(query.distances);
+}
+
+long LayoverBatcher::batch_count() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return batch_count_;
+}
+
+void LayoverBatcher::lead_batch(std::unique_lock<std::mutex>& lock) {
+  std::vector<Query*> batch;
+  while (!queue_.empty() && batch.size() < max_batch_) {
+    batch.push_back(queue_.front());
+    queue_.pop_front();
+  }
+  running_ = true;
+  batch_count_++;
+  lock.unlock();
+  run_batch(batch);
+  lock.lock();
+  for (Query* answered : batch) {
+    answered->done = true;
+    answered->wake.notify_one();
+  }
+  running_ = false;
+  wake_front();
+}
+
+void LayoverBatcher::wake_front() {
+  if (!queue_.empty()) {
+    queue_.front()->wake.notify_one();
+  }
+}
+
+void LayoverBatcher::run_batch(const std::vector<Query*>& batch) const {
+  std::map<int, std::vector<Query*>> by_layovers;
+  for (Query* query : batch) {
+    try {
+      // Shed the queries whose callers have given up while they waited.
+      query->cancellation->throw_if_cancelled();
+      by_layovers[query->max_layovers].push_back(query);
+    } catch (...) {
+      query->error = std::current_exception();
+    }
+  }
+  for (const auto& group : by_layovers) {
+    const int max_layovers = group.first;
+    if (group.second.size() < kMinBatch || max_layovers < 0) {
+      // Too few to share a search, or nothing to answer but the exception.
+      for (Query* query : group.second) {
+        try {
+          query->distances = network_.least_distance_within_layovers(
+              *query->code, max_layovers, *query->cancellation);
+        } catch (...) {
+          query->error = std::current_exception();
+        }
+      }
+      continue;
+    }
+    // A bad code fails its own query rather than the whole table.
+    std::vector<Query*> valid;
+    std::vector<std::string> codes;
+    for (Query* query : group.second) {
+      try {
+        network_.airport_database().index(*query->code);
+        valid.push_back(query);
+        codes.push_back(*query->code);
+      } catch (...) {
+        query->error = std::current_exception();
+      }
+    }
+    if (valid.empty()) {
+      continue;
+    }
+    try {
+      const DistanceTable table =
+          network_.layover_distance_table(codes, max_layovers);
+      for (Query* query : valid) {
+        query->distances.resize(table.rows());
+      }
+      // Row by row, so that the table is read in order.
+      for (int i = 0; i < table.rows(); ++i) {
+        const int* row = table.row(i);
+        for (int c = 0; c < valid.size(); ++c) {
+          valid[c]->distances[i] = row[c];
+        }
+      }
+    } catch (...) {
+      for (Query* query : valid) {
+        query->error = std::current_exception();
+      }
+    }
+  }
+}
@@ -0,0 +1,147 @@
+#ifndef _layover_batcher_hpp_
+#define _layover_batcher_hpp_
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "airport_network.hpp"
+#include "cancellation_token.hpp"
+
+// The LayoverBatcher class answers least_distance_within_layovers queries on
+// an AirportNetwork from many threads at once, coalescing the queries that
+// arrive together into one call of the multi-source engine,
+// layover_distance_table.
+//
+// The engine has a fixed cost of a few separate searches, so it only pays off
+// from kMinBatch sources on (on the large database, a table of 16 sources
+// takes about 40% as long as 16 separate searches, and one of 64 about 55%).
+// Hence a query is answered on its own, at once, while fewer than max_direct
+// queries are being answered that way. Beyond that, queries queue up, and once
+// kMinBatch are waiting and no batch is running, the thread of the latest
+// takes the queue (up to max_batch queries) as the next batch. Batches thus
+// form only when queries arrive faster than they are answered. One batch runs
+// at a time, as the engine is parallel itself.
+//
+// Under overload, queries may wait long enough for their callers to give up.
+// A query whose CancellationToken is cancelled (or past its deadline) by the
+// time its batch runs is dropped from the batch rather than answered.
+class LayoverBatcher {
+ public:
+  // The fewest queries run as a batch.
+  static constexpr int kMinBatch = 16;
+
+  //
+  // Constructors and Destructors
+  //
+
+  // The constructor. Answers at most max_direct queries on `network` at a
+  // time on their own (by default, one for each hardware thread), and batches
+  // the others, at most max_batch at a time.
+  //
+  // Throws a std::invalid_argument exception if max_batch or max_direct is
+  // not positive.
+  //
+  // ASSUMES: network outlives the batcher, and is not changed meanwhile.
+  explicit LayoverBatcher(
+      const AirportNetwork& network, const int max_batch = 64,
+      const int max_direct = std::max(
+          1, static_cast<int>(std::thread::hardware_concurrency())));
+
+  // Batchers cannot be copied, as threads wait on them.
+  LayoverBatcher(const LayoverBatcher& other) = delete;
+  LayoverBatcher& operator=(const LayoverBatcher& other) = delete;
+
+  // The destructor.
+  //
+  // ASSUMES: No query is waiting on the batcher.
+  ~LayoverBatcher() = default;
+
+  //
+  // Queries
+  //
+
+  // Returns network.least_distance_within_layovers(code, max_layovers),
+  // answered on its own or as part of a batch.
+  //
+  // Throws a std::invalid_argument exception if `code` is not an airport code
+  // in the database or if max_layovers is negative, and an
+  // OperationCancelled exception if `cancellation` is cancelled before the
+  // query is answered (a DeadlineExceeded exception if its deadline passes).
+  // A query answered in a batch is only checked before the batch runs.
+  std::vector<int> least_distance_within_layovers(
+      const std::string& code, const int max_layovers,
+      const CancellationToken& cancellation = CancellationToken());
+
+  // Returns the number of batches run so far. Queries answered on their own
+  // are not counted.
+  long batch_count() const;
+
+ private:
+  // A query waiting to be answered, owned by the thread that asked it.
+  struct Query {
+    const std::string* code;
+    int max_layovers;
+    const CancellationToken* cancellation;
+    std::vector<int> distances;
+    std::exception_ptr error;
+    bool done;
+
+    // Signaled when the query has been answered, or may be able to go on
+    // (when it is at the front of the queue).
+    std::condition_variable wake;
+  };
+
+  // Runs the next batch, from the front of queue_.
+  //
+  // ASSUMES: `lock` holds mutex_, and no batch is running.
+  void lead_batch(std::unique_lock<std::mutex>& lock);
+
+  // Wakes the thread of the query at the front of queue_ (if any) to check
+  // whether it can go on, after the batch or the queries answered on their
+  // own have changed.
+  //
+  // ASSUMES: mutex_ is held.
+  void wake_front();
+
+  // Answers the queries of `batch`, with one engine call for each number of
+  // layovers asked for by at least kMinBatch of them, and separately
+  // otherwise. The queries already cancelled get their exception instead.
+  void run_batch(const std::vector<Query*>& batch) const;
+
+  // The network queried.
+  const AirportNetwork& network_;
+
+  // The most queries in a batch.
+  const int max_batch_;
+
+  // The most queries answered on their own at a time.
+  const int max_direct_;
+
+  // Guards queue_, direct_, running_, batch_count_ and the done flags of the
+  // queries.
+  //
+  // Each waiting thread sleeps on its own query, and only the thread that
+  // can act is woken, so that a crowd of waiting threads is not woken for
+  // every answer.
+  mutable std::mutex mutex_;
+
+  // The queries not yet taken into a batch, in order of arrival.
+  std::deque<Query*> queue_;
+
+  // The number of queries being answered on their own.
+  int direct_ = 0;
+
+  // Whether a batch is running.
+  bool running_ = false;
+
+  // The number of batches run.
+  long batch_count_ = 0;
+};
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef _layover_batcher_test_hpp_
+#define _layover_batcher_test_hpp_
+
+// Unit tests for the LayoverBatcher class.
+#include "layover_batcher.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "airport_database.hpp"
+#include "airport_network.hpp"
+#include "doctest.hpp"
+
+TEST_CASE("LayoverBatcher") {
+  const AirportDatabase airport_database =
+      AirportDatabase("data_airports.txt", "data_flights.txt");
+  const AirportNetwork airport_network = AirportNetwork(airport_database);
+  // Answering one query at a time on its own, so that the others queue up
+  // for batches.
+  LayoverBatcher batcher(airport_network, 64, 1);
+
+  SUBCASE("BadArgumentsThrowException") {
+    CHECK_THROWS_AS(LayoverBatcher(airport_network, 0), std::invalid_argument);
+    CHECK_THROWS_AS(
+        LayoverBatcher(airport_network, 1, 0), std::invalid_argument);
+    CHECK_THROWS_AS(
+        batcher.least_distance_within_layovers("ACO", 1),
+        std::invalid_argument);
+    CHECK_THROWS_AS(
+        batcher.least_distance_within_layovers("LAX", -1),
+        std::invalid_argument);
+  }
+
+  SUBCASE("LoneQueryRunsAtOnce") {
+    CHECK_EQ(
+        batcher.least_distance_within_layovers("LAX", 1),
+        airport_network.least_distance_within_layovers("LAX", 1));
+    CHECK_EQ(batcher.batch_count(), 0);
+  }
+
+  SUBCASE("ConcurrentQueriesMatchNetwork") {
+    // Each thread asks about its own airports, for one or two layovers, and
+    // one thread also asks about an unknown airport, which must fail without
+    // failing the batch it is in.
+    const int kThreads = 24;
+    const int kQueries = 4;
+    std::atomic<int> mismatches(0);
+    std::atomic<int> failures(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+      threads.emplace_back([&, t]() {
+        for (int q = 0; q < kQueries; ++q) {
+          const std::string code =
+              airport_database.code((t * kQueries + q) * 83);
+          const int max_layovers = 1 + (t + q) % 2;
+          mismatches += batcher.least_distance_within_layovers(
+              code, max_layovers) !=
+              airport_network.least_distance_within_layovers(
+                  code, max_layovers);
+        }
+        if (t == 0) {
+          try {
+            batcher.least_distance_within_layovers("ACO", 1);
+          } catch (const std::invalid_argument&) {
+            failures++;
+          }
+        }
+      });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+    CHECK_EQ(mismatches.load(), 0);
+    CHECK_EQ(failures.load(), 1);
+    CHECK_LE(batcher.batch_count(), kThreads * kQueries + 1);
+  }
+}
+
+#endif
@@ -6,6 +6,31 @@
 #include "adjacency_matrix_graph_test.hpp"
 #include "airport_test.hpp"
 #include "airport_network_test.hpp"
+#include "all_pairs_shortest_path_test.hpp"
+#include "async_airport_network_test.hpp"
+#include "bit_matrix_graph_test.hpp"
+#include "bounds_check_test.hpp"
+#include "cancellation_token_test.hpp"
+#include "compute_executor_test.hpp"
+#include "csr_graph_test.hpp"
+#include "disjoint_sets_test.hpp"
+#include "distance_table_test.hpp"
+#include "edge_index_test.hpp"
 #include "edge_test.hpp"
+#include "graph_search_test.hpp"
 #include "graph_traversal_test.hpp"
-#include "undirected_graph_test.hpp"
\ No newline at end of file
+#include "landmark_labeling_test.hpp"
+#include "layover_batcher_test.hpp"
+#include "many_to_many_test.hpp"
+#include "min_plus_test.hpp"
+#include "parallel_for_test.hpp"
+#include "permutation_test.hpp"
+#include "query_protocol_test.hpp"
+#include "query_server_test.hpp"
+#include "shortest_path_tree_test.hpp"
+#include "spatial_index_test.hpp"
+#include "traversal_workspace_test.hpp"
+#include "undirected_graph_test.hpp"
+#include "versioned_airport_network_test.hpp"
+#include "vertex_order_test.hpp"
+#include "vertex_set_test.hpp"
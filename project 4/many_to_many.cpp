@@ -0,0 +1,232 @@
+#include "many_to_many.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "distance_table.hpp"
+#include "parallel_for.hpp"
+#include "traversal_workspace.hpp"
+
+namespace {
+
+constexpr int kIntMax = std::numeric_limits<int>::max();
+
+// The entries of every vertex's bucket, stored flat: the entries of vertex v
+// are at positions offsets[v] up to (but not including) offsets[v + 1].
+struct Buckets {
+  std::vector<int> offsets;
+
+  // The column of the target of each entry.
+  std::vector<int> target;
+
+  // The distance from the vertex of each entry to its target.
+  std::vector<int> distance;
+};
+
+// A ball of vertices around a target, as found by a backward search.
+struct Ball {
+  // The settled (vertex, distance to the target) pairs.
+  std::vector<std::pair<int, int>> members;
+
+  // Every vertex closer than radius to the target is a member, and radius is
+  // kIntMax if every vertex that can reach the target is a member.
+  int radius;
+};
+
+// Throws a std::range_error exception if any of `vertices` is not a vertex of
+// a graph with vertex_count-many vertices.
+void check_vertices(const std::vector<int>& vertices, const int vertex_count) {
+  for (const int v : vertices) {
+    if (v < 0 || v >= vertex_count) {
+      throw std::range_error("invalid vertex: " + std::to_string(v));
+    }
+  }
+}
+
+// Runs Djikstra's algorithm from vertex start over `graph` until ball_size
+// vertices are settled, and returns the ball of settled vertices.
+Ball search_ball(
+    const CsrGraph& graph, const int start, const int ball_size,
+    TraversalWorkspace& workspace) {
+  const std::vector<int>& targets = graph.targets();
+  const std::vector<int>& weights = graph.weights();
+  workspace.reset(graph.vertex_count());
+  workspace.set_distance(start, 0);
+  std::vector<std::pair<int, int>>& queue = workspace.queue();
+  const std::greater<std::pair<int, int>> later;
+  queue.emplace_back(0, start);
+
+  Ball ball = {{}, kIntMax};
+  while (!queue.empty()) {
+    std::pop_heap(queue.begin(), queue.end(), later);
+    const int current_distance = queue.back().first;
+    const int current = queue.back().second;
+    queue.pop_back();
+    if (workspace.settled(current)) {
+      continue;
+    }
+    if (ball.members.size() == ball_size) {
+      // Every vertex closer than this one is already settled.
+      ball.radius = current_distance;
+      break;
+    }
+    workspace.settle(current);
+    ball.members.emplace_back(current, current_distance);
+    for (int e = graph.offset(current); e < graph.offset(current + 1); ++e) {
+      const int v = targets[e];
+      const int candidate = current_distance + weights[e];
+      if (!workspace.settled(v) && candidate < workspace.distance(v)) {
+        workspace.set_distance(v, candidate);
+        queue.emplace_back(candidate, v);
+        std::push_heap(queue.begin(), queue.end(), later);
+      }
+    }
+  }
+  return ball;
+}
+
+// Returns the buckets of the vertices of a graph with vertex_count-many
+// vertices, given the balls around each target.
+Buckets fill_buckets(const std::vector<Ball>& balls, const int vertex_count) {
+  Buckets buckets;
+  buckets.offsets.assign(vertex_count + 1, 0);
+  for (const Ball& ball : balls) {
+    for (const std::pair<int, int>& member : ball.members) {
+      buckets.offsets[member.first + 1]++;
+    }
+  }
+  for (int v = 0; v < vertex_count; ++v) {
+    buckets.offsets[v + 1] += buckets.offsets[v];
+  }
+  buckets.target.resize(buckets.offsets[vertex_count]);
+  buckets.distance.resize(buckets.offsets[vertex_count]);
+  std::vector<int> next(buckets.offsets.begin(), buckets.offsets.end() - 1);
+  for (int c = 0; c < balls.size(); ++c) {
+    for (const std::pair<int, int>& member : balls[c].members) {
+      const int position = next[member.first]++;
+      buckets.target[position] = c;
+      buckets.distance[position] = member.second;
+    }
+  }
+  return buckets;
+}
+
+// Returns how far the forward search needs to reach so that no target can
+// still get closer: the largest best[c] - radius[c] over the columns c.
+long long search_limit(const int* best, const std::vector<int>& radius) {
+  long long limit = std::numeric_limits<long long>::min();
+  for (int c = 0; c < radius.size(); ++c) {
+    if (radius[c] == kIntMax) {
+      // Every vertex that can reach the target is in its bucket, so the
+      // target needs no more searching.
+      continue;
+    }
+    if (best[c] == kIntMax) {
+      return std::numeric_limits<long long>::max();
+    }
+    limit = std::max(limit, static_cast<long long>(best[c]) - radius[c]);
+  }
+  return limit;
+}
+
+// Runs the forward search from vertex start over `graph`, setting best[c] to
+// the distance from vertex start to target c for every column c.
+void search_forward(
+    const CsrGraph& graph, const Buckets& buckets,
+    const std::vector<int>& radius, const int start, int* best,
+    TraversalWorkspace& workspace) {
+  const std::vector<int>& targets = graph.targets();
+  const std::vector<int>& weights = graph.weights();
+
+  // Combines a path of length `distance` to vertex v with v's bucket.
+  const auto scan_bucket = [&](const int v, const int distance) {
+    for (int b = buckets.offsets[v]; b < buckets.offsets[v + 1]; ++b) {
+      const long long through =
+          static_cast<long long>(distance) + buckets.distance[b];
+      if (through < best[buckets.target[b]]) {
+        best[buckets.target[b]] = through;
+      }
+    }
+  };
+
+  workspace.reset(graph.vertex_count());
+  workspace.set_distance(start, 0);
+  scan_bucket(start, 0);
+  std::vector<std::pair<int, int>>& queue = workspace.queue();
+  const std::greater<std::pair<int, int>> later;
+  queue.emplace_back(0, start);
+
+  // The limit only decreases as best improves, so a stale limit is safe to
+  // compare against; it is recomputed only when the search seems to be done.
+  long long limit = search_limit(best, radius);
+  while (!queue.empty()) {
+    std::pop_heap(queue.begin(), queue.end(), later);
+    const int current_distance = queue.back().first;
+    const int current = queue.back().second;
+    queue.pop_back();
+    if (workspace.settled(current)) {
+      continue;
+    }
+    if (current_distance > limit) {
+      limit = search_limit(best, radius);
+      if (current_distance > limit) {
+        break;
+      }
+    }
+    workspace.settle(current);
+    for (int e = graph.offset(current); e < graph.offset(current + 1); ++e) {
+      const int v = targets[e];
+      const int candidate = current_distance + weights[e];
+      if (!workspace.settled(v) && candidate < workspace.distance(v)) {
+        workspace.set_distance(v, candidate);
+        scan_bucket(v, candidate);
+        queue.emplace_back(candidate, v);
+        std::push_heap(queue.begin(), queue.end(), later);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+DistanceTable many_to_many_distances(
+    const CsrGraph& graph, const std::vector<int>& sources,
+    const std::vector<int>& targets, const int ball_size) {
+  check_vertices(sources, graph.vertex_count());
+  check_vertices(targets, graph.vertex_count());
+  if (ball_size < 1) {
+    throw std::invalid_argument(
+        "invalid ball_size: " + std::to_string(ball_size));
+  }
+
+  const CsrGraph in_edges = graph.transpose();
+  std::vector<Ball> balls(targets.size());
+  parallel_for(targets.size(), [&](const int begin, const int end) {
+    TraversalWorkspace workspace;
+    for (int c = begin; c < end; ++c) {
+      balls[c] = search_ball(in_edges, targets[c], ball_size, workspace);
+    }
+  });
+  std::vector<int> radius(targets.size());
+  for (int c = 0; c < targets.size(); ++c) {
+    radius[c] = balls[c].radius;
+  }
+  const Buckets buckets = fill_buckets(balls, graph.vertex_count());
+  balls.clear();
+
+  DistanceTable distances(sources.size(), targets.size(), kIntMax);
+  parallel_for(sources.size(), [&](const int begin, const int end) {
+    TraversalWorkspace workspace;
+    for (int r = begin; r < end; ++r) {
+      search_forward(
+          graph, buckets, radius, sources[r], distances.row(r), workspace);
+    }
+  });
+  return distances;
+}
@@ -0,0 +1,42 @@
+#ifndef _many_to_many_hpp_
+#define _many_to_many_hpp_
+
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "distance_table.hpp"
+
+// Returns the table whose entry in row r and column c is the length of the
+// shortest path from vertex sources[r] to vertex targets[c] in `graph`
+// (std::numeric_limits<int>::max() if there is none).
+//
+// This is a bucket-based many-to-many search, in two phases:
+//
+// * A backward search from each target t settles the ball_size-many vertices
+//   closest to it (in the graph with every edge reversed), and leaves
+//   (t, distance to t) in the bucket of each of them. Every vertex closer to
+//   t than the ball's radius, r(t), is then in the ball.
+// * A forward search from each source scans the bucket of every vertex it
+//   reaches, combining its distance to the vertex with the bucket's distances
+//   to the targets. A shortest path to t enters the ball of t from a vertex at
+//   least r(t) from t, so the search can stop once its frontier is more than
+//   best(t) - r(t) away for every target t, instead of reaching every target.
+//
+// The buckets are stored flat, vertex after vertex, and both the backward and
+// the forward searches run in parallel.
+//
+// Larger balls let the forward searches stop sooner, at the cost of more
+// bucket entries (|targets| * ball_size at most) to build and scan. They pay
+// off when the targets are clustered; when they are spread over the whole
+// graph the forward searches reach most of it regardless, and small balls are
+// cheaper.
+//
+// Throws a std::range_error exception if any source or target is not a valid
+// vertex and a std::invalid_argument exception if ball_size is not positive.
+//
+// ASSUMES: The edge weights are non-negative.
+DistanceTable many_to_many_distances(
+    const CsrGraph& graph, const std::vector<int>& sources,
+    const std::vector<int>& targets, const int ball_size = 64);
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef _many_to_many_test_hpp_
+#define _many_to_many_test_hpp_
+
+#include "many_to_many.hpp"
+
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "adjacency_list_graph.hpp"
+#include "csr_graph.hpp"
+#include "distance_table.hpp"
+#include "doctest.hpp"
+#include "graph_traversal.hpp"
+#include "test_random.hpp"
+
+TEST_CASE("ManyToManyDistances") {
+  // A pseudo-random directed graph, sparse enough to leave some vertices
+  // unreachable from others.
+  constexpr int kVertexCount = 120;
+  const auto graph =
+      random_graph<AdjacencyListGraph>(kVertexCount, 200, 50, 5);
+  const CsrGraph csr(graph);
+
+  std::vector<int> sources;
+  for (int v = 0; v < kVertexCount; v += 7) {
+    sources.push_back(v);
+  }
+  const std::vector<int> targets({3, 3, 0, 17, 64, 119, 8, 42});
+
+  SUBCASE("BadArgumentsThrowException") {
+    CHECK_THROWS_AS(
+        many_to_many_distances(csr, {0, kVertexCount}, targets),
+        std::range_error);
+    CHECK_THROWS_AS(
+        many_to_many_distances(csr, sources, {-1}), std::range_error);
+    CHECK_THROWS_AS(
+        many_to_many_distances(csr, sources, targets, 0),
+        std::invalid_argument);
+  }
+
+  SUBCASE("MatchesShortestPathForEveryBallSize") {
+    for (const int ball_size : {1, 2, 5, 30, 1000}) {
+      const DistanceTable distances =
+          many_to_many_distances(csr, sources, targets, ball_size);
+      REQUIRE_EQ(distances.rows(), sources.size());
+      REQUIRE_EQ(distances.cols(), targets.size());
+      int mismatches = 0;
+      for (int r = 0; r < sources.size(); ++r) {
+        const std::vector<int> expected = shortest_path(graph, sources[r]);
+        for (int c = 0; c < targets.size(); ++c) {
+          mismatches += distances.at(r, c) != expected[targets[c]];
+        }
+      }
+      CHECK_EQ(mismatches, 0);
+    }
+  }
+
+  SUBCASE("EmptySourcesOrTargets") {
+    CHECK_EQ(many_to_many_distances(csr, {}, targets).rows(), 0);
+    CHECK_EQ(many_to_many_distances(csr, sources, {}).cols(), 0);
+  }
+}
+
+#endif
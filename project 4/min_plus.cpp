@@ -0,0 +1,143 @@
+#include "min_plus.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "csr_graph.hpp"
+#include "distance_table.hpp"
+#include "parallel_for.hpp"
+
+namespace {
+
+constexpr int kIntMax = std::numeric_limits<int>::max();
+
+// Returns weight + distance, or kIntMax if distance is kIntMax or the sum would
+// overflow.
+//
+// Clamping distance to kIntMax - weight first means the sum never overflows,
+// and needs only a min and an add, which vectorize.
+inline int extend(const int weight, const int distance) {
+  return std::min(distance, kIntMax - weight) + weight;
+}
+
+// Performs y[c] = min(y[c], extend(weight, x[c])) for 0 <= c < count.
+//
+// ASSUMES: x and y are 64-byte aligned and count is a multiple of 16.
+void relax_row(int* y, const int weight, const int* x, const int count) {
+  int c = 0;
+#if defined(__AVX512F__)
+  const __m512i weights = _mm512_set1_epi32(weight);
+  const __m512i limits = _mm512_set1_epi32(kIntMax - weight);
+  for (; c < count; c += 16) {
+    const __m512i through = _mm512_add_epi32(
+        _mm512_min_epi32(_mm512_load_si512(x + c), limits), weights);
+    _mm512_store_si512(
+        y + c, _mm512_min_epi32(_mm512_load_si512(y + c), through));
+  }
+#elif defined(__AVX2__)
+  const __m256i weights = _mm256_set1_epi32(weight);
+  const __m256i limits = _mm256_set1_epi32(kIntMax - weight);
+  for (; c < count; c += 8) {
+    __m256i* target = reinterpret_cast<__m256i*>(y + c);
+    const __m256i source =
+        _mm256_load_si256(reinterpret_cast<const __m256i*>(x + c));
+    const __m256i through =
+        _mm256_add_epi32(_mm256_min_epi32(source, limits), weights);
+    _mm256_store_si256(
+        target, _mm256_min_epi32(_mm256_load_si256(target), through));
+  }
+#endif
+  for (; c < count; ++c) {
+    y[c] = std::min(y[c], extend(weight, x[c]));
+  }
+}
+
+// Performs result = min(result, matrix * table) (in the min-plus semiring) on
+// rows [begin, end) of result.
+void multiply_rows(
+    const CsrGraph& matrix, const DistanceTable& table, DistanceTable& result,
+    const int begin, const int end) {
+  const std::vector<int>& targets = matrix.targets();
+  const std::vector<int>& weights = matrix.weights();
+  for (int i = begin; i < end; ++i) {
+    int* row = result.row(i);
+    for (int e = matrix.offset(i); e < matrix.offset(i + 1); ++e) {
+      relax_row(row, weights[e], table.row(targets[e]), table.stride());
+    }
+  }
+}
+
+}  // namespace
+
+std::vector<int> min_plus_multiply(
+    const CsrGraph& matrix, const std::vector<int>& vector) {
+  if (vector.size() != matrix.vertex_count()) {
+    throw std::invalid_argument(
+        "vector has " + std::to_string(vector.size()) + " entries, expected " +
+            std::to_string(matrix.vertex_count()));
+  }
+  const std::vector<int>& targets = matrix.targets();
+  const std::vector<int>& weights = matrix.weights();
+  std::vector<int> result(matrix.vertex_count(), kIntMax);
+  parallel_for(matrix.vertex_count(), [&](const int begin, const int end) {
+    for (int i = begin; i < end; ++i) {
+      int best = kIntMax;
+      for (int e = matrix.offset(i); e < matrix.offset(i + 1); ++e) {
+        best = std::min(best, extend(weights[e], vector[targets[e]]));
+      }
+      result[i] = best;
+    }
+  }, 1024);
+  return result;
+}
+
+DistanceTable min_plus_multiply(
+    const CsrGraph& matrix, const DistanceTable& table) {
+  if (table.rows() != matrix.vertex_count()) {
+    throw std::invalid_argument(
+        "table has " + std::to_string(table.rows()) + " rows, expected " +
+            std::to_string(matrix.vertex_count()));
+  }
+  DistanceTable result(table.rows(), table.cols(), kIntMax);
+  parallel_for(table.rows(), [&](const int begin, const int end) {
+    multiply_rows(matrix, table, result, begin, end);
+  }, 64);
+  return result;
+}
+
+DistanceTable hop_distance_table(
+    const CsrGraph& matrix, const std::vector<int>& targets,
+    const int max_edges) {
+  if (max_edges < 0) {
+    throw std::invalid_argument("max_edges cannot be negative");
+  }
+  DistanceTable current(matrix.vertex_count(), targets.size(), kIntMax);
+  for (int c = 0; c < targets.size(); ++c) {
+    if (targets[c] < 0 || targets[c] >= matrix.vertex_count()) {
+      throw std::range_error("invalid target: " + std::to_string(targets[c]));
+    }
+    current.set(targets[c], c, 0);
+  }
+
+  for (int round = 0; round < max_edges; ++round) {
+    // Starting from a copy of the current table (rather than from "no path")
+    // keeps the paths with fewer edges: next = min(current, matrix * current).
+    DistanceTable next = current;
+    parallel_for(current.rows(), [&](const int begin, const int end) {
+      multiply_rows(matrix, current, next, begin, end);
+    }, 64);
+    if (next == current) {
+      break;
+    }
+    current = std::move(next);
+  }
+  return current;
+}
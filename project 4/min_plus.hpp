@@ -0,0 +1,56 @@
+#ifndef _min_plus_hpp_
+#define _min_plus_hpp_
+
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "distance_table.hpp"
+
+// Sparse matrix products over the min-plus (tropical) semiring, in which
+// "addition" is min and "multiplication" is +, and
+// std::numeric_limits<int>::max() plays the role of zero (no path).
+//
+// A CsrGraph is treated as the sparse matrix A whose entry A[i][j] is the
+// weight of the edge from vertex i to vertex j (zero, i.e. no path, if there
+// is no edge). Multiplying A by a vector or table of path lengths extends every
+// path by one edge, so repeated products give distances with a bounded number
+// of edges. Other semiring queries (such as reachability or widest paths)
+// follow the same pattern with a different pair of operations.
+//
+// ASSUMES: The edge weights are non-negative.
+
+// Returns the min-plus product of the matrix and the vector, i.e., the vector
+// y with y[i] = min over edges (i, j) of (A[i][j] + vector[j]).
+//
+// Throws a std::invalid_argument exception if vector.size() is not
+// matrix.vertex_count().
+std::vector<int> min_plus_multiply(
+    const CsrGraph& matrix, const std::vector<int>& vector);
+
+// Returns the min-plus product of the matrix and the table, i.e., the table Y
+// with Y[i][c] = min over edges (i, j) of (A[i][j] + table[j][c]).
+//
+// The rows of the result are computed in parallel, and each row is a sequence
+// of element-wise (AVX-512 or AVX2, when compiled for them) min-plus updates
+// of whole rows of `table`.
+//
+// Throws a std::invalid_argument exception if table.rows() is not
+// matrix.vertex_count().
+DistanceTable min_plus_multiply(
+    const CsrGraph& matrix, const DistanceTable& table);
+
+// Returns the table whose entry in row i and column c is the length of the
+// shortest path from vertex i to vertex targets[c] that uses at most
+// max_edges edges (std::numeric_limits<int>::max() if there is none).
+//
+// This starts from the table with a zero for every (targets[c], c) and
+// repeatedly takes its element-wise minimum with its min-plus product with
+// the matrix, stopping early once a product changes nothing.
+//
+// Throws a std::range_error exception if a target is not a valid vertex and a
+// std::invalid_argument exception if max_edges is negative.
+DistanceTable hop_distance_table(
+    const CsrGraph& matrix, const std::vector<int>& targets,
+    const int max_edges);
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef _min_plus_test_hpp_
+#define _min_plus_test_hpp_
+
+#include "min_plus.hpp"
+
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "adjacency_list_graph.hpp"
+#include "csr_graph.hpp"
+#include "distance_table.hpp"
+#include "doctest.hpp"
+#include "graph_traversal.hpp"
+#include "test_random.hpp"
+#include "undirected_graph.hpp"
+
+TEST_CASE("MinPlusMultiply") {
+  constexpr int kMax = std::numeric_limits<int>::max();
+  AdjacencyListGraph graph(3);
+  graph.add_edge(0, 1, 2);
+  graph.add_edge(0, 2, 10);
+  graph.add_edge(1, 2, 3);
+  const CsrGraph matrix(graph);
+
+  SUBCASE("MatrixVector") {
+    CHECK_EQ(
+        min_plus_multiply(matrix, std::vector<int>({kMax, kMax, 0})),
+        std::vector<int>({10, 3, kMax}));
+    CHECK_EQ(
+        min_plus_multiply(matrix, std::vector<int>({kMax, 5, 0})),
+        std::vector<int>({7, 3, kMax}));
+    CHECK_THROWS_AS(
+        min_plus_multiply(matrix, std::vector<int>({0, 0})),
+        std::invalid_argument);
+  }
+
+  SUBCASE("MatrixTableMatchesMatrixVector") {
+    DistanceTable table(3, 2, kMax);
+    table.set(2, 0, 0);
+    table.set(1, 1, 5);
+    table.set(2, 1, 0);
+    const DistanceTable product = min_plus_multiply(matrix, table);
+    for (int i = 0; i < 3; ++i) {
+      CHECK_EQ(product.at(i, 0), std::vector<int>({10, 3, kMax})[i]);
+      CHECK_EQ(product.at(i, 1), std::vector<int>({7, 3, kMax})[i]);
+    }
+    CHECK_THROWS_AS(
+        min_plus_multiply(matrix, DistanceTable(2, 2, 0)),
+        std::invalid_argument);
+  }
+}
+
+TEST_CASE("HopDistanceTable") {
+  constexpr int kVertexCount = 80;
+  const auto graph = random_graph<UndirectedGraph<AdjacencyListGraph>>(
+      kVertexCount, 160, 100, 31);
+  const CsrGraph matrix(graph);
+
+  SUBCASE("InvalidArgumentsThrowException") {
+    CHECK_THROWS_AS(
+        hop_distance_table(matrix, {0, kVertexCount}, 2), std::range_error);
+    CHECK_THROWS_AS(
+        hop_distance_table(matrix, {0}, -1), std::invalid_argument);
+  }
+
+  SUBCASE("ColumnsMatchShortestPathWithinHops") {
+    // Columns for 20 targets span two AVX-512 registers per row.
+    std::vector<int> targets;
+    for (int t = 0; t < 20; ++t) {
+      targets.push_back(3 * t + 1);
+    }
+    for (const int max_edges : {0, 1, 2, 3, kVertexCount}) {
+      const DistanceTable table =
+          hop_distance_table(matrix, targets, max_edges);
+      for (int c = 0; c < targets.size(); ++c) {
+        const std::vector<int> expected =
+            shortest_path_within_hops(graph, targets[c], max_edges);
+        for (int i = 0; i < kVertexCount; ++i) {
+          CHECK_EQ(table.at(i, c), expected[i]);
+        }
+      }
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,111 @@
+#include "parallel_for.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "compute_executor.hpp"
+
+namespace {
+
+// Returns the number of hardware threads, or 1 if it is unknown.
+int hardware_threads() {
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Returns the pool of worker threads of parallel_for, starting it on first
+// use. The calling thread of parallel_for runs subranges too, so the pool has
+// one thread fewer than the hardware (but at least one).
+ComputeExecutor& worker_pool() {
+  static ComputeExecutor pool(std::max(1, hardware_threads() - 1));
+  return pool;
+}
+
+// The state of one call of parallel_for, shared with the workers helping it.
+// A worker may only get to its task after the call has returned (when the
+// calling thread ran every subrange itself), so the state is held by
+// shared_ptr rather than on the stack of the call.
+struct Job {
+  Job(const int count, const int chunks,
+      const std::function<void(int, int)>& body)
+      : count(count), chunks(chunks), body(body) {}
+
+  // Runs unclaimed subranges until there are none left.
+  void run() {
+    for (int chunk = next_chunk.fetch_add(1); chunk < chunks;
+         chunk = next_chunk.fetch_add(1)) {
+      const int begin = static_cast<long>(count) * chunk / chunks;
+      const int end = static_cast<long>(count) * (chunk + 1) / chunks;
+      std::exception_ptr exception;
+      try {
+        body(begin, end);
+      } catch (...) {
+        exception = std::current_exception();
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      if (exception && !first_exception) {
+        first_exception = exception;
+      }
+      if (++finished == chunks) {
+        all_finished.notify_one();
+      }
+    }
+  }
+
+  const int count;
+  const int chunks;
+
+  // Only called for claimed subranges, all of which finish before the call
+  // returns, so the reference does not outlive the function.
+  const std::function<void(int, int)>& body;
+
+  // The next subrange to claim.
+  std::atomic<int> next_chunk{0};
+
+  // Guards finished and first_exception.
+  std::mutex mutex;
+
+  // Signaled when the last subrange finishes.
+  std::condition_variable all_finished;
+
+  // The number of subranges finished.
+  int finished = 0;
+
+  // The first exception thrown by body, if any.
+  std::exception_ptr first_exception;
+};
+
+}  // namespace
+
+void parallel_for(
+    const int count, const std::function<void(int, int)>& body,
+    const int min_chunk, const int max_threads) {
+  if (count <= 0) {
+    return;
+  }
+  const int threads = max_threads > 0 ? max_threads : hardware_threads();
+  const int chunks =
+      std::min(threads, std::max(1, count / std::max(1, min_chunk)));
+  if (chunks == 1) {
+    body(0, count);
+    return;
+  }
+
+  const std::shared_ptr<Job> job = std::make_shared<Job>(count, chunks, body);
+  ComputeExecutor& pool = worker_pool();
+  const int helpers = std::min(chunks - 1, pool.thread_count());
+  for (int h = 0; h < helpers; ++h) {
+    pool.post([job]() { job->run(); });
+  }
+  job->run();
+  std::unique_lock<std::mutex> lock(job->mutex);
+  job->all_finished.wait(lock, [&job]() { return job->finished == job->chunks; });
+  if (job->first_exception) {
+    std::rethrow_exception(job->first_exception);
+  }
+}
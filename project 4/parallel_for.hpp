@@ -0,0 +1,29 @@
+#ifndef _parallel_for_hpp_
+#define _parallel_for_hpp_
+
+#include <functional>
+
+// Calls body(begin, end) on disjoint, contiguous subranges [begin, end) that
+// together cover [0, count), running the calls on up to max_threads threads
+// (if max_threads is not positive, std::thread::hardware_concurrency()).
+//
+// The calls run on the calling thread and on a pool of worker threads that is
+// started on first use and kept for the life of the program, so a loop making
+// many short calls (e.g., one per phase of Floyd-Warshall) does not pay for
+// starting threads each time. The calling thread takes subranges too, and
+// takes every subrange no worker has started, so the call never waits for a
+// busy worker to become free, and calls may be nested or made from several
+// threads at once.
+//
+// The call returns once every subrange is done. If count is at most
+// min_chunk, body(0, count) is simply called on the calling thread. If any
+// call throws, the first exception thrown is rethrown (after every call has
+// finished).
+//
+// ASSUMES: The calls to body on different subranges are safe to run
+// concurrently.
+void parallel_for(
+    const int count, const std::function<void(int, int)>& body,
+    const int min_chunk = 1, const int max_threads = 0);
+
+#endif
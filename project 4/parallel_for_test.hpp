@@ -0,0 +1,77 @@
+#ifndef _parallel_for_test_hpp_
+#define _parallel_for_test_hpp_
+
+#include "parallel_for.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+#include "doctest.hpp"
+
+TEST_CASE("ParallelFor") {
+  SUBCASE("CoversEveryIndexOnce") {
+    std::vector<int> visits(1000, 0);
+    parallel_for(visits.size(), [&](const int begin, const int end) {
+      for (int i = begin; i < end; ++i) {
+        visits[i]++;
+      }
+    });
+    CHECK_EQ(visits, std::vector<int>(1000, 1));
+  }
+
+  SUBCASE("EmptyRangeDoesNothing") {
+    bool called = false;
+    parallel_for(0, [&](const int, const int) { called = true; });
+    CHECK_FALSE(called);
+  }
+
+  SUBCASE("RethrowsExceptions") {
+    CHECK_THROWS_AS(
+        parallel_for(100, [](const int begin, const int) {
+          if (begin == 0) {
+            throw std::runtime_error("failed");
+          }
+        }),
+        std::runtime_error);
+  }
+
+  SUBCASE("SharesTheWorkWithThePool") {
+    // More subranges than the hardware may have threads, so that the pool is
+    // used even on a single core.
+    std::vector<int> visits(1000, 0);
+    for (int repeat = 0; repeat < 50; ++repeat) {
+      parallel_for(visits.size(), [&](const int begin, const int end) {
+        for (int i = begin; i < end; ++i) {
+          visits[i]++;
+        }
+      }, 1, 4);
+    }
+    CHECK_EQ(visits, std::vector<int>(1000, 50));
+  }
+
+  SUBCASE("NestedCallsFinish") {
+    std::vector<int> visits(400, 0);
+    parallel_for(4, [&](const int begin, const int end) {
+      for (int outer = begin; outer < end; ++outer) {
+        parallel_for(100, [&](const int inner_begin, const int inner_end) {
+          for (int i = inner_begin; i < inner_end; ++i) {
+            visits[100 * outer + i]++;
+          }
+        }, 1, 4);
+      }
+    }, 1, 4);
+    CHECK_EQ(visits, std::vector<int>(400, 1));
+  }
+
+  SUBCASE("RethrowsExceptionsFromThePool") {
+    CHECK_THROWS_AS(
+        parallel_for(100, [](const int begin, const int) {
+          if (begin != 0) {
+            throw std::runtime_error("failed");
+          }
+        }, 1, 4),
+        std::runtime_error);
+  }
+}
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef _path_length_hpp_
+#define _path_length_hpp_
+
+#include <cstdint>
+
+// The PathLength class template selects, at compile time, the type in which
+// the lengths of paths over edges of type Weight are summed (and so the width
+// of the distances stored and queued by the traversals over a
+// BasicCsrGraph<Weight> or a graph with Weight weights; see
+// weighted_shortest_path and PathLengthWorkspace):
+//
+// * std::uint16_t weights (e.g., miles, which all fit in 16 bits) are summed
+//   in std::uint32_t, which holds any path of up to 65537 edges.
+// * std::int32_t weights are summed in std::int64_t, so that long paths on
+//   large synthetic graphs cannot overflow.
+// * std::int64_t weights are summed in std::int64_t, saturating at its
+//   maximum.
+// * float weights are summed in double.
+template <class Weight>
+struct PathLength;
+
+template <>
+struct PathLength<std::uint16_t> {
+  using type = std::uint32_t;
+};
+
+template <>
+struct PathLength<std::int32_t> {
+  using type = std::int64_t;
+};
+
+template <>
+struct PathLength<std::int64_t> {
+  using type = std::int64_t;
+};
+
+template <>
+struct PathLength<float> {
+  using type = double;
+};
+
+#endif
@@ -0,0 +1,15 @@
+#include "permutation.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+std::vector<int> inverse_order(const std::vector<int>& order) {
+  std::vector<int> inverse(order.size(), -1);
+  for (int k = 0; k < order.size(); ++k) {
+    if (order[k] < 0 || order[k] >= order.size() || inverse[order[k]] != -1) {
+      throw std::invalid_argument("order is not a permutation");
+    }
+    inverse[order[k]] = k;
+  }
+  return inverse;
+}
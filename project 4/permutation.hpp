@@ -0,0 +1,21 @@
+#ifndef _permutation_hpp_
+#define _permutation_hpp_
+
+#include <vector>
+
+// Helpers for permutations of 0, 1, ..., n - 1, such as the vertex orders of
+// vertex_order.hpp and the relabelings of AirportDatabase::reordered. They
+// depend on nothing graph-specific, so the database can validate an order
+// without pulling in the graph layer.
+//
+// A permutation `order` is read as in vertex_order.hpp: order[k] is the (old)
+// index that is given the new index k.
+
+// Returns the inverse of the permutation `order`, i.e., the new label of each
+// old vertex.
+//
+// Throws a std::invalid_argument exception if order is not a permutation of
+// 0, 1, ..., order.size() - 1.
+std::vector<int> inverse_order(const std::vector<int>& order);
+
+#endif
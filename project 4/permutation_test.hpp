@@ -0,0 +1,31 @@
+#ifndef _permutation_test_hpp_
+#define _permutation_test_hpp_
+
+// Unit tests for the permutation helpers.
+
+#include "permutation.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+#include "doctest.hpp"
+
+TEST_CASE("Permutation") {
+  SUBCASE("InverseOrder") {
+    CHECK_EQ(
+        inverse_order(std::vector<int>({2, 0, 1})),
+        std::vector<int>({1, 2, 0}));
+    CHECK_EQ(inverse_order(std::vector<int>()), std::vector<int>());
+  }
+
+  SUBCASE("NotAPermutationThrowsException") {
+    CHECK_THROWS_AS(
+        inverse_order(std::vector<int>({0, 0, 1})), std::invalid_argument);
+    CHECK_THROWS_AS(
+        inverse_order(std::vector<int>({0, 3, 1})), std::invalid_argument);
+    CHECK_THROWS_AS(
+        inverse_order(std::vector<int>({-1, 0})), std::invalid_argument);
+  }
+}
+
+#endif
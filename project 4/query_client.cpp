@@ -0,0 +1,88 @@
+#include "query_client.hpp"
+
+#include <unistd.h>
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cancellation_token.hpp"
+#include "query_protocol.hpp"
+
+QueryClient::QueryClient(const std::string& socket_path)
+    : socket_(connect_to(socket_path)) {}
+
+QueryClient::~QueryClient() {
+  ::close(socket_);
+}
+
+std::vector<std::string> QueryClient::airport_codes() {
+  QueryRequest request;
+  request.type = QueryType::kAirportCodes;
+  return std::move(call(request).codes);
+}
+
+std::vector<int> QueryClient::least_distance(const std::string& code) {
+  QueryRequest request;
+  request.type = QueryType::kLeastDistance;
+  request.code = code;
+  return std::move(call(request).distances);
+}
+
+int QueryClient::least_distance(
+    const std::string& from_code, const std::string& to_code) {
+  QueryRequest request;
+  request.type = QueryType::kLeastDistanceBetween;
+  request.code = from_code;
+  request.to_code = to_code;
+  const QueryResponse response = call(request);
+  if (response.distances.size() != 1) {
+    throw std::runtime_error("malformed response: expected one distance");
+  }
+  return response.distances[0];
+}
+
+std::vector<std::string> QueryClient::at_most_one_layover(
+    const std::string& code) {
+  QueryRequest request;
+  request.type = QueryType::kAtMostOneLayover;
+  request.code = code;
+  return std::move(call(request).codes);
+}
+
+std::vector<int> QueryClient::least_distance_within_layovers(
+    const std::string& code, const int max_layovers) {
+  QueryRequest request;
+  request.type = QueryType::kLayoverDistances;
+  request.code = code;
+  request.max_layovers = max_layovers;
+  return std::move(call(request).distances);
+}
+
+QueryResponse QueryClient::call(const QueryRequest& request) {
+  write_frame(socket_, encode_request(request));
+  std::string payload;
+  if (!read_frame(socket_, payload)) {
+    throw std::runtime_error("server closed the connection");
+  }
+  QueryResponse response;
+  try {
+    response = decode_response(payload);
+  } catch (const std::invalid_argument& error) {
+    throw std::runtime_error(
+        std::string("malformed response: ") + error.what());
+  }
+  switch (response.status) {
+    case QueryStatus::kOk:
+      return response;
+    case QueryStatus::kInvalidArgument:
+      throw std::invalid_argument(response.error);
+    case QueryStatus::kDeadlineExceeded:
+      throw DeadlineExceeded();
+    case QueryStatus::kCancelled:
+      throw OperationCancelled();
+    default:
+      throw std::runtime_error("request rejected: " + response.error);
+  }
+}
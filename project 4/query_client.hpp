@@ -0,0 +1,80 @@
+#ifndef _query_client_hpp_
+#define _query_client_hpp_
+
+#include <string>
+#include <vector>
+
+#include "query_protocol.hpp"
+
+// The QueryClient class asks a QueryServer (see query_server.hpp) the queries
+// of AirportNetwork over one connection, so that a process can use a network
+// loaded by a long-running server instead of loading its own.
+//
+// A client sends one request at a time and waits for its answer. Threads
+// asking concurrently should each use their own client.
+class QueryClient {
+ public:
+  //
+  // Constructors and Destructors
+  //
+
+  // The constructor. Connects to the server listening on the Unix domain
+  // socket at socket_path.
+  //
+  // Throws a std::runtime_error exception if the connection fails.
+  explicit QueryClient(const std::string& socket_path);
+
+  // Clients cannot be copied, as each owns its connection.
+  QueryClient(const QueryClient& other) = delete;
+  QueryClient& operator=(const QueryClient& other) = delete;
+
+  // The destructor. Closes the connection.
+  ~QueryClient();
+
+  //
+  // Queries
+  //
+  // Each query is answered as the AirportNetwork method of the same name
+  // would answer it, and throws a std::invalid_argument exception where that
+  // method would (with the server's message). Each throws a DeadlineExceeded
+  // exception if the query ran past the server's time limit, an
+  // OperationCancelled exception if the server stopped before answering it,
+  // and a std::runtime_error exception if the connection fails or the server
+  // rejects the request.
+
+  // Returns the codes of all airports, by index, so that the distances
+  // returned by least_distance can be matched to airports.
+  std::vector<std::string> airport_codes();
+
+  // Returns the shortest path distance of travel (in miles) when flying from
+  // `code` to each airport, by index.
+  std::vector<int> least_distance(const std::string& code);
+
+  // Returns the shortest path distance of travel (in miles) when flying from
+  // `from_code` to `to_code`, or std::numeric_limits<int>::max() if there is
+  // no itinerary between them.
+  int least_distance(const std::string& from_code, const std::string& to_code);
+
+  // Returns the airport codes that are at most one layover away from `code`.
+  std::vector<std::string> at_most_one_layover(const std::string& code);
+
+  // Returns the shortest path distance of travel (in miles) when flying from
+  // `code` to each airport, by index, with at most max_layovers layovers.
+  std::vector<int> least_distance_within_layovers(
+      const std::string& code, const int max_layovers);
+
+ private:
+  // Sends `request` and returns the server's (kOk) response.
+  //
+  // Throws a std::invalid_argument exception if the response is
+  // kInvalidArgument, a DeadlineExceeded exception if it is
+  // kDeadlineExceeded, an OperationCancelled exception if it is kCancelled,
+  // and a std::runtime_error exception if the connection fails or the
+  // response is kBadRequest.
+  QueryResponse call(const QueryRequest& request);
+
+  // The connection to the server.
+  int socket_;
+};
+
+#endif
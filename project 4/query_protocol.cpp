@@ -0,0 +1,340 @@
+#include "query_protocol.hpp"
+
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+// The longest string that fits its 2-byte length.
+constexpr int kMaxStringSize = 0xffff;
+
+// Appends the little-endian bytes of `value` to `payload`.
+void append_u32(std::string& payload, const std::uint32_t value) {
+  for (int shift = 0; shift < 32; shift += 8) {
+    payload.push_back(static_cast<char>((value >> shift) & 0xff));
+  }
+}
+
+// Returns the little-endian 4-byte integer at `bytes`.
+std::uint32_t load_u32(const char* bytes) {
+  std::uint32_t value = 0;
+  for (int k = 0; k < 4; ++k) {
+    value |= std::uint32_t(static_cast<std::uint8_t>(bytes[k])) << (8 * k);
+  }
+  return value;
+}
+
+// Appends the little-endian bytes of each of `values` to `payload`.
+void append_i32s(std::string& payload, const std::vector<int>& values) {
+  const std::size_t start = payload.size();
+  payload.resize(start + 4 * values.size());
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  // The array is already in the wire format, so copy it whole.
+  if (!values.empty()) {
+    std::memcpy(&payload[start], values.data(), 4 * values.size());
+  }
+#else
+  for (std::size_t k = 0; k < values.size(); ++k) {
+    const std::uint32_t value = values[k];
+    for (int b = 0; b < 4; ++b) {
+      payload[start + 4 * k + b] = static_cast<char>((value >> (8 * b)) & 0xff);
+    }
+  }
+#endif
+}
+
+// Appends `value` to `payload` as a 2-byte length and its bytes.
+//
+// Throws a std::invalid_argument exception if value is longer than
+// kMaxStringSize.
+void append_string(std::string& payload, const std::string& value) {
+  if (value.size() > kMaxStringSize) {
+    throw std::invalid_argument(
+        "string too long: " + std::to_string(value.size()) + " bytes");
+  }
+  payload.push_back(static_cast<char>(value.size() & 0xff));
+  payload.push_back(static_cast<char>(value.size() >> 8));
+  payload += value;
+}
+
+// The PayloadReader class reads the fields of a payload in order, throwing a
+// std::invalid_argument exception if the payload ends too soon.
+class PayloadReader {
+ public:
+  explicit PayloadReader(const std::string& payload) : payload_(payload) {}
+
+  // Returns the next 1-byte unsigned integer.
+  std::uint8_t u8() {
+    require(1);
+    return static_cast<std::uint8_t>(payload_[position_++]);
+  }
+
+  // Returns the next 4-byte unsigned integer.
+  std::uint32_t u32() {
+    require(4);
+    const std::uint32_t value = load_u32(payload_.data() + position_);
+    position_ += 4;
+    return value;
+  }
+
+  // Returns the next 4-byte signed integer.
+  int i32() {
+    return static_cast<int>(u32());
+  }
+
+  // Reads the next values.size() 4-byte signed integers into `values`.
+  void i32s(std::vector<int>& values) {
+    require(4 * values.size());
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    if (!values.empty()) {
+      std::memcpy(
+          values.data(), payload_.data() + position_, 4 * values.size());
+    }
+    position_ += 4 * values.size();
+#else
+    for (int& value : values) {
+      value = i32();
+    }
+#endif
+  }
+
+  // Returns the next string.
+  std::string string() {
+    const int low = u8();
+    const int size = low | (u8() << 8);
+    require(size);
+    std::string value = payload_.substr(position_, size);
+    position_ += size;
+    return value;
+  }
+
+  // Throws a std::invalid_argument exception if any bytes are left.
+  void finish() const {
+    if (position_ != payload_.size()) {
+      throw std::invalid_argument(
+          "payload has " + std::to_string(payload_.size() - position_) +
+              " unexpected trailing bytes");
+    }
+  }
+
+ private:
+  // Throws a std::invalid_argument exception if fewer than `count` bytes
+  // are left.
+  void require(const std::size_t count) const {
+    if (payload_.size() - position_ < count) {
+      throw std::invalid_argument("payload is truncated");
+    }
+  }
+
+  // The payload read.
+  const std::string& payload_;
+
+  // The index of the next byte to read.
+  std::size_t position_ = 0;
+};
+
+// Reads exactly `size` bytes from the socket fd into `buffer`. Returns the
+// number of bytes read, which is less than size only if fd was closed.
+//
+// Throws a std::runtime_error exception if the read fails.
+std::size_t read_fully(const int fd, char* buffer, const std::size_t size) {
+  std::size_t done = 0;
+  while (done < size) {
+    const ssize_t count = ::recv(fd, buffer + done, size - done, 0);
+    if (count < 0 && errno == EINTR) {
+      continue;
+    }
+    if (count < 0) {
+      throw std::runtime_error(
+          std::string("cannot read frame: ") + std::strerror(errno));
+    }
+    if (count == 0) {
+      break;
+    }
+    done += count;
+  }
+  return done;
+}
+
+}  // namespace
+
+std::string encode_request(const QueryRequest& request) {
+  std::string payload;
+  payload.push_back(static_cast<char>(request.type));
+  switch (request.type) {
+    case QueryType::kAirportCodes:
+      break;
+    case QueryType::kLeastDistanceBetween:
+      append_string(payload, request.code);
+      append_string(payload, request.to_code);
+      break;
+    case QueryType::kLayoverDistances:
+      append_string(payload, request.code);
+      append_u32(payload, request.max_layovers);
+      break;
+    default:
+      append_string(payload, request.code);
+      break;
+  }
+  return payload;
+}
+
+QueryRequest decode_request(const std::string& payload) {
+  PayloadReader reader(payload);
+  QueryRequest request;
+  const std::uint8_t type = reader.u8();
+  request.type = static_cast<QueryType>(type);
+  switch (request.type) {
+    case QueryType::kAirportCodes:
+      break;
+    case QueryType::kLeastDistance:
+    case QueryType::kAtMostOneLayover:
+      request.code = reader.string();
+      break;
+    case QueryType::kLeastDistanceBetween:
+      request.code = reader.string();
+      request.to_code = reader.string();
+      break;
+    case QueryType::kLayoverDistances:
+      request.code = reader.string();
+      request.max_layovers = reader.i32();
+      break;
+    default:
+      throw std::invalid_argument(
+          "unknown query type: " + std::to_string(type));
+  }
+  reader.finish();
+  return request;
+}
+
+std::string encode_response(const QueryResponse& response) {
+  std::string payload;
+  payload.push_back(static_cast<char>(response.status));
+  if (response.status != QueryStatus::kOk) {
+    append_string(payload, response.error.substr(0, kMaxStringSize));
+    return payload;
+  }
+  payload.reserve(
+      payload.size() + 8 + 4 * response.distances.size() +
+      5 * response.codes.size());
+  append_u32(payload, response.distances.size());
+  append_i32s(payload, response.distances);
+  append_u32(payload, response.codes.size());
+  for (const std::string& code : response.codes) {
+    append_string(payload, code);
+  }
+  return payload;
+}
+
+QueryResponse decode_response(const std::string& payload) {
+  PayloadReader reader(payload);
+  QueryResponse response;
+  const std::uint8_t status = reader.u8();
+  response.status = static_cast<QueryStatus>(status);
+  switch (response.status) {
+    case QueryStatus::kOk: {
+      // Each distance takes 4 bytes and each code at least 2, so a count
+      // larger than the payload is malformed rather than a reason to allocate.
+      const std::uint32_t distance_count = reader.u32();
+      if (distance_count > payload.size() / 4) {
+        throw std::invalid_argument("payload is truncated");
+      }
+      response.distances.resize(distance_count);
+      reader.i32s(response.distances);
+      const std::uint32_t code_count = reader.u32();
+      if (code_count > payload.size() / 2) {
+        throw std::invalid_argument("payload is truncated");
+      }
+      response.codes.reserve(code_count);
+      for (std::uint32_t c = 0; c < code_count; ++c) {
+        response.codes.push_back(reader.string());
+      }
+      break;
+    }
+    case QueryStatus::kInvalidArgument:
+    case QueryStatus::kBadRequest:
+    case QueryStatus::kDeadlineExceeded:
+    case QueryStatus::kCancelled:
+      response.error = reader.string();
+      break;
+    default:
+      throw std::invalid_argument(
+          "unknown query status: " + std::to_string(status));
+  }
+  reader.finish();
+  return response;
+}
+
+int connect_to(const std::string& socket_path) {
+  sockaddr_un address = {};
+  address.sun_family = AF_UNIX;
+  if (socket_path.empty() || socket_path.size() >= sizeof(address.sun_path)) {
+    throw std::runtime_error("invalid socket path: " + socket_path);
+  }
+  std::strcpy(address.sun_path, socket_path.c_str());
+  const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0 ||
+      ::connect(
+          fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) !=
+          0) {
+    const std::string message =
+        "cannot connect to " + socket_path + ": " + std::strerror(errno);
+    if (fd >= 0) {
+      ::close(fd);
+    }
+    throw std::runtime_error(message);
+  }
+  return fd;
+}
+
+void write_frame(const int fd, const std::string& payload) {
+  std::string frame;
+  frame.reserve(4 + payload.size());
+  append_u32(frame, payload.size());
+  frame += payload;
+  std::size_t done = 0;
+  while (done < frame.size()) {
+    // MSG_NOSIGNAL makes a write to a closed connection fail with EPIPE,
+    // rather than raise SIGPIPE and end the process.
+    const ssize_t count = ::send(
+        fd, frame.data() + done, frame.size() - done, MSG_NOSIGNAL);
+    if (count < 0 && errno == EINTR) {
+      continue;
+    }
+    if (count < 0) {
+      throw std::runtime_error(
+          std::string("cannot write frame: ") + std::strerror(errno));
+    }
+    done += count;
+  }
+}
+
+bool read_frame(const int fd, std::string& payload) {
+  char header[4];
+  const std::size_t header_size = read_fully(fd, header, sizeof(header));
+  if (header_size == 0) {
+    return false;
+  }
+  if (header_size < sizeof(header)) {
+    throw std::runtime_error("connection closed in a frame header");
+  }
+  const std::uint32_t size = load_u32(header);
+  if (size > kMaxPayloadSize) {
+    throw std::runtime_error(
+        "frame too long: " + std::to_string(size) + " bytes");
+  }
+  payload.resize(size);
+  if (read_fully(fd, &payload[0], size) < size) {
+    throw std::runtime_error("connection closed in a frame");
+  }
+  return true;
+}
@@ -0,0 +1,133 @@
+#ifndef _query_protocol_hpp_
+#define _query_protocol_hpp_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// The binary protocol spoken between the airport query server (see
+// query_server.hpp) and its clients (see query_client.hpp) over a Unix domain
+// socket.
+//
+// Each message is a frame: its length as a 4-byte unsigned integer, then that
+// many bytes of payload. Integers are little-endian, distances are 4-byte
+// signed integers (std::numeric_limits<int>::max() for no itinerary), and
+// strings are a 2-byte length followed by their bytes.
+//
+// A request payload is its QueryType as one byte, then its arguments:
+//   kAirportCodes:         (none)
+//   kLeastDistance:        code
+//   kLeastDistanceBetween: from code, to code
+//   kAtMostOneLayover:     code
+//   kLayoverDistances:     code, max_layovers (4-byte signed integer)
+//
+// A response payload is its QueryStatus as one byte. A kOk response goes on
+// with the number of distances and the distances, then the number of codes
+// and the codes (either may be empty, depending on the request). Any other
+// status goes on with an error message.
+//
+// A connection carries one request at a time: the client waits for the
+// response before sending its next request.
+
+// The kinds of queries.
+enum class QueryType : std::uint8_t {
+  kAirportCodes = 1,
+  kLeastDistance = 2,
+  kLeastDistanceBetween = 3,
+  kAtMostOneLayover = 4,
+  kLayoverDistances = 5,
+};
+
+// The outcomes of queries.
+enum class QueryStatus : std::uint8_t {
+  kOk = 0,
+  // The query named an unknown airport, or had an out of range argument (the
+  // cases in which AirportNetwork throws a std::invalid_argument exception).
+  kInvalidArgument = 1,
+  // The request could not be decoded.
+  kBadRequest = 2,
+  // The query ran past the time limit of the server, and was abandoned.
+  kDeadlineExceeded = 3,
+  // The server stopped before the query was answered.
+  kCancelled = 4,
+};
+
+// A decoded request.
+struct QueryRequest {
+  QueryType type = QueryType::kAirportCodes;
+
+  // The airport the query is about (the from airport for
+  // kLeastDistanceBetween). Unused for kAirportCodes.
+  std::string code;
+
+  // The to airport, for kLeastDistanceBetween only.
+  std::string to_code;
+
+  // The most layovers, for kLayoverDistances only.
+  int max_layovers = 0;
+};
+
+// A decoded response.
+struct QueryResponse {
+  QueryStatus status = QueryStatus::kOk;
+
+  // The distances answered, by airport index (a single distance for
+  // kLeastDistanceBetween).
+  std::vector<int> distances;
+
+  // The airport codes answered.
+  std::vector<std::string> codes;
+
+  // The error message, if status is not kOk.
+  std::string error;
+};
+
+// The longest payload accepted, which bounds the memory a malformed or
+// malicious frame can make the reader allocate.
+constexpr std::uint32_t kMaxPayloadSize = 1 << 24;
+
+// Returns the payload encoding `request`.
+//
+// Throws a std::invalid_argument exception if a code is longer than 65535
+// bytes.
+std::string encode_request(const QueryRequest& request);
+
+// Returns the request encoded in `payload`.
+//
+// Throws a std::invalid_argument exception if payload is not a well-formed
+// request.
+QueryRequest decode_request(const std::string& payload);
+
+// Returns the payload encoding `response`. An error message longer than 65535
+// bytes is cut short.
+//
+// Throws a std::invalid_argument exception if a code is longer than 65535
+// bytes.
+std::string encode_response(const QueryResponse& response);
+
+// Returns the response encoded in `payload`.
+//
+// Throws a std::invalid_argument exception if payload is not a well-formed
+// response.
+QueryResponse decode_response(const std::string& payload);
+
+// Returns a socket connected to the server listening on the Unix domain
+// socket at socket_path.
+//
+// Throws a std::runtime_error exception if the connection fails.
+int connect_to(const std::string& socket_path);
+
+// Writes `payload` as one frame to the socket fd.
+//
+// Throws a std::runtime_error exception if the write fails.
+void write_frame(const int fd, const std::string& payload);
+
+// Reads one frame from the socket fd into `payload`. Returns false if the
+// connection was closed before the frame started.
+//
+// Throws a std::runtime_error exception if the read fails, if fd is closed
+// part way through the frame, or if the frame is longer than
+// kMaxPayloadSize.
+bool read_frame(const int fd, std::string& payload);
+
+#endif
@@ -0,0 +1,113 @@
+#ifndef _query_protocol_test_hpp_
+#define _query_protocol_test_hpp_
+
+// Unit tests for the query server protocol.
+#include "query_protocol.hpp"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "doctest.hpp"
+
+TEST_CASE("QueryProtocol") {
+  SUBCASE("RequestsRoundTrip") {
+    QueryRequest codes;
+    codes.type = QueryType::kAirportCodes;
+    QueryRequest between;
+    between.type = QueryType::kLeastDistanceBetween;
+    between.code = "LAX";
+    between.to_code = "ORD";
+    QueryRequest layovers;
+    layovers.type = QueryType::kLayoverDistances;
+    layovers.code = "DEC";
+    layovers.max_layovers = 3;
+    for (const QueryRequest& request : {codes, between, layovers}) {
+      const QueryRequest decoded = decode_request(encode_request(request));
+      CHECK_EQ(decoded.type, request.type);
+      CHECK_EQ(decoded.code, request.code);
+      CHECK_EQ(decoded.to_code, request.to_code);
+      CHECK_EQ(decoded.max_layovers, request.max_layovers);
+    }
+    // One byte of type, two of length and three of code.
+    QueryRequest single;
+    single.type = QueryType::kLeastDistance;
+    single.code = "LAX";
+    CHECK_EQ(encode_request(single).size(), 6);
+  }
+
+  SUBCASE("ResponsesRoundTrip") {
+    QueryResponse answer;
+    answer.distances = {0, 1739, std::numeric_limits<int>::max()};
+    answer.codes = {"LAX", "ORD", ""};
+    const QueryResponse decoded = decode_response(encode_response(answer));
+    CHECK_EQ(decoded.status, QueryStatus::kOk);
+    CHECK_EQ(decoded.distances, answer.distances);
+    CHECK_EQ(decoded.codes, answer.codes);
+
+    QueryResponse error;
+    error.status = QueryStatus::kInvalidArgument;
+    error.error = "invalid code: ACO";
+    error.distances = {1};
+    const QueryResponse decoded_error = decode_response(encode_response(error));
+    CHECK_EQ(decoded_error.status, QueryStatus::kInvalidArgument);
+    CHECK_EQ(decoded_error.error, error.error);
+    CHECK(decoded_error.distances.empty());
+
+    error.status = QueryStatus::kDeadlineExceeded;
+    error.error = "deadline exceeded";
+    CHECK_EQ(
+        decode_response(encode_response(error)).status,
+        QueryStatus::kDeadlineExceeded);
+  }
+
+  SUBCASE("MalformedPayloadsThrowException") {
+    QueryRequest request;
+    request.type = QueryType::kLayoverDistances;
+    request.code = "LAX";
+    const std::string payload = encode_request(request);
+    CHECK_THROWS_AS(decode_request(""), std::invalid_argument);
+    CHECK_THROWS_AS(decode_request(std::string(1, 99)), std::invalid_argument);
+    CHECK_THROWS_AS(
+        decode_request(payload.substr(0, payload.size() - 1)),
+        std::invalid_argument);
+    CHECK_THROWS_AS(decode_request(payload + "x"), std::invalid_argument);
+
+    // A count far larger than the payload is rejected before allocating.
+    const std::string huge = std::string(1, 0) + std::string(4, '\xff');
+    CHECK_THROWS_AS(decode_response(huge), std::invalid_argument);
+
+    request.code = std::string(70000, 'x');
+    CHECK_THROWS_AS(encode_request(request), std::invalid_argument);
+  }
+
+  SUBCASE("Frames") {
+    int sockets[2];
+    REQUIRE_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+    write_frame(sockets[0], "first");
+    write_frame(sockets[0], "");
+    write_frame(sockets[0], std::string(50000, 'z'));
+    std::string payload;
+    CHECK(read_frame(sockets[1], payload));
+    CHECK_EQ(payload, "first");
+    CHECK(read_frame(sockets[1], payload));
+    CHECK_EQ(payload, "");
+    CHECK(read_frame(sockets[1], payload));
+    CHECK_EQ(payload, std::string(50000, 'z'));
+
+    // A frame cut short is an error; a connection closed between frames is
+    // not.
+    const char partial[] = {10, 0, 0, 0, 'a'};
+    REQUIRE_EQ(::write(sockets[0], partial, sizeof(partial)), sizeof(partial));
+    ::close(sockets[0]);
+    CHECK_THROWS_AS(read_frame(sockets[1], payload), std::runtime_error);
+    CHECK_FALSE(read_frame(sockets[1], payload));
+    ::close(sockets[1]);
+  }
+}
+
+#endif
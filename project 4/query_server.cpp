@@ -0,0 +1,221 @@
+#include "query_server.hpp"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "airport_network.hpp"
+#include "cancellation_token.hpp"
+#include "layover_batcher.hpp"
+#include "query_protocol.hpp"
+
+namespace {
+
+// Returns the codes of the airports of `network`, by index.
+std::vector<std::string> codes_by_index(const AirportNetwork& network) {
+  std::vector<std::string> codes;
+  codes.reserve(network.num_airports());
+  for (int i = 0; i < network.num_airports(); ++i) {
+    codes.push_back(network.airport_database().code(i));
+  }
+  return codes;
+}
+
+// Returns the address of the Unix domain socket at `path`.
+//
+// Throws a std::runtime_error exception if path is too long for an address.
+sockaddr_un socket_address(const std::string& path) {
+  sockaddr_un address = {};
+  address.sun_family = AF_UNIX;
+  if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+    throw std::runtime_error("invalid socket path: " + path);
+  }
+  std::strcpy(address.sun_path, path.c_str());
+  return address;
+}
+
+// Returns an error message for the failed system call `call`.
+std::string system_error(const std::string& call, const std::string& path) {
+  return call + " " + path + ": " + std::strerror(errno);
+}
+
+}  // namespace
+
+QueryServer::QueryServer(
+    const AirportNetwork& network, const std::string& socket_path,
+    const std::chrono::milliseconds time_limit)
+    : network_(network),
+      socket_path_(socket_path),
+      codes_(codes_by_index(network)),
+      time_limit_(time_limit),
+      layover_batcher_(network) {
+  if (time_limit < std::chrono::milliseconds::zero()) {
+    throw std::invalid_argument("time_limit cannot be negative");
+  }
+  const sockaddr_un address = socket_address(socket_path);
+  const sockaddr* generic_address =
+      reinterpret_cast<const sockaddr*>(&address);
+  // A socket file nobody listens on is left over from a server that did not
+  // exit cleanly, and is replaced; a live one is not.
+  bool live = false;
+  try {
+    ::close(connect_to(socket_path));
+    live = true;
+  } catch (const std::runtime_error&) {
+  }
+  if (live) {
+    throw std::runtime_error(
+        "a server is already listening at " + socket_path);
+  }
+  ::unlink(socket_path.c_str());
+  listener_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (listener_ < 0) {
+    throw std::runtime_error(system_error("socket", socket_path));
+  }
+  if (::bind(listener_, generic_address, sizeof(address)) != 0 ||
+      ::listen(listener_, SOMAXCONN) != 0) {
+    const std::string message = system_error("listen", socket_path);
+    ::close(listener_);
+    throw std::runtime_error(message);
+  }
+  if (::pipe2(wake_pipe_, O_CLOEXEC) != 0) {
+    const std::string message = system_error("pipe for", socket_path);
+    ::close(listener_);
+    ::unlink(socket_path.c_str());
+    throw std::runtime_error(message);
+  }
+}
+
+QueryServer::~QueryServer() {
+  ::close(listener_);
+  ::close(wake_pipe_[0]);
+  ::close(wake_pipe_[1]);
+  ::unlink(socket_path_.c_str());
+}
+
+void QueryServer::run() {
+  while (true) {
+    pollfd events[2] = {{listener_, POLLIN, 0}, {wake_pipe_[0], POLLIN, 0}};
+    if (::poll(events, 2, -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    }
+    if (events[1].revents != 0) {
+      break;
+    }
+    const int connection =
+        ::accept4(listener_, nullptr, nullptr, SOCK_CLOEXEC);
+    if (connection < 0) {
+      continue;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopping_) {
+      ::close(connection);
+      break;
+    }
+    connections_.insert(connection);
+    std::thread(&QueryServer::serve, this, connection).detach();
+  }
+  // Shutting a connection down wakes its thread from reading the next
+  // request, and the thread then closes it.
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (const int connection : connections_) {
+    ::shutdown(connection, SHUT_RDWR);
+  }
+  connection_closed_.wait(lock, [this]() { return connections_.empty(); });
+}
+
+void QueryServer::stop() {
+  stop_source_.cancel();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!stopping_) {
+    stopping_ = true;
+    const char byte = 0;
+    while (::write(wake_pipe_[1], &byte, 1) < 0 && errno == EINTR) {
+    }
+  }
+}
+
+QueryResponse QueryServer::answer(const QueryRequest& request) {
+  CancellationToken cancellation = stop_source_.token();
+  if (time_limit_ != std::chrono::milliseconds::zero()) {
+    cancellation = cancellation.with_timeout(time_limit_);
+  }
+  QueryResponse response;
+  try {
+    switch (request.type) {
+      case QueryType::kAirportCodes:
+        response.codes = codes_;
+        break;
+      case QueryType::kLeastDistance:
+        response.distances =
+            network_.least_distance(request.code, cancellation);
+        break;
+      case QueryType::kLeastDistanceBetween:
+        response.distances.push_back(
+            network_.least_distance(request.code, request.to_code));
+        break;
+      case QueryType::kAtMostOneLayover:
+        response.codes =
+            network_.at_most_one_layover(request.code, cancellation);
+        break;
+      case QueryType::kLayoverDistances:
+        response.distances = layover_batcher_.least_distance_within_layovers(
+            request.code, request.max_layovers, cancellation);
+        break;
+      default:
+        response.status = QueryStatus::kBadRequest;
+        response.error = "unknown query type";
+        break;
+    }
+  } catch (const std::invalid_argument& error) {
+    response = QueryResponse();
+    response.status = QueryStatus::kInvalidArgument;
+    response.error = error.what();
+  } catch (const DeadlineExceeded& error) {
+    response = QueryResponse();
+    response.status = QueryStatus::kDeadlineExceeded;
+    response.error = error.what();
+  } catch (const OperationCancelled& error) {
+    response = QueryResponse();
+    response.status = QueryStatus::kCancelled;
+    response.error = error.what();
+  }
+  return response;
+}
+
+void QueryServer::serve(const int connection) {
+  std::string payload;
+  try {
+    while (read_frame(connection, payload)) {
+      QueryResponse response;
+      try {
+        response = answer(decode_request(payload));
+      } catch (const std::invalid_argument& error) {
+        // The frame was read whole, so the connection can go on.
+        response.status = QueryStatus::kBadRequest;
+        response.error = error.what();
+      }
+      write_frame(connection, encode_response(response));
+    }
+  } catch (const std::runtime_error&) {
+    // The connection failed or sent a frame too long to read; drop it.
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  ::close(connection);
+  connections_.erase(connection);
+  connection_closed_.notify_all();
+}
@@ -0,0 +1,120 @@
+#ifndef _query_server_hpp_
+#define _query_server_hpp_
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "airport_network.hpp"
+#include "cancellation_token.hpp"
+#include "layover_batcher.hpp"
+#include "query_protocol.hpp"
+
+// The QueryServer class answers queries on one AirportNetwork over a Unix
+// domain socket, in the protocol of query_protocol.hpp, so that short-lived
+// processes can ask a few questions (see QueryClient) without each loading
+// the database and building the network.
+//
+// Every connection is served by its own thread, relying on the queries of
+// AirportNetwork being safe to run concurrently. The layover queries of all
+// connections go through a LayoverBatcher, so that those arriving together
+// are answered by one multi-source search. The other queries are answered
+// directly, as the distance oracle and the cached shortest path trees answer
+// them faster than a batch could.
+//
+// To shed work under overload, the server can be given a time limit per
+// query: a search still running (or a layover query still waiting for its
+// batch) when the limit passes is abandoned and answered kDeadlineExceeded.
+// Stopping the server likewise cancels the searches in progress.
+class QueryServer {
+ public:
+  //
+  // Constructors and Destructors
+  //
+
+  // The constructor. Listens for connections on a Unix domain socket at
+  // socket_path, replacing a stale socket file there, and answers them from
+  // `network` once run() is called, allowing each query at most time_limit
+  // (or, if time_limit is zero, as long as it takes).
+  //
+  // Throws a std::runtime_error exception if the socket cannot be created,
+  // or if another server is listening at socket_path, and a
+  // std::invalid_argument exception if time_limit is negative.
+  //
+  // ASSUMES: network outlives the server, and is not changed meanwhile.
+  QueryServer(
+      const AirportNetwork& network, const std::string& socket_path,
+      const std::chrono::milliseconds time_limit =
+          std::chrono::milliseconds::zero());
+
+  // Servers cannot be copied, as they own their socket.
+  QueryServer(const QueryServer& other) = delete;
+  QueryServer& operator=(const QueryServer& other) = delete;
+
+  // The destructor. Closes the socket and removes its file.
+  //
+  // ASSUMES: run() is not running.
+  ~QueryServer();
+
+  //
+  // Serving
+  //
+
+  // Accepts and serves connections until stop() is called, then closes the
+  // connections still open and returns once their threads have finished.
+  void run();
+
+  // Makes run() return, e.g., from another thread or from a thread waiting
+  // for a signal. If run() has not been called yet, it returns at once when
+  // it is.
+  void stop();
+
+  // Returns the answer to `request`, as it would be sent to a client.
+  QueryResponse answer(const QueryRequest& request);
+
+ private:
+  // Answers the requests on `connection` until it is closed, then closes it.
+  void serve(const int connection);
+
+  // The network queried.
+  const AirportNetwork& network_;
+
+  // The path of the socket file.
+  const std::string socket_path_;
+
+  // The codes of the airports, by index, as answered to kAirportCodes.
+  const std::vector<std::string> codes_;
+
+  // The time limit of each query, or zero for none.
+  const std::chrono::milliseconds time_limit_;
+
+  // Cancelled by stop(), to abandon the searches in progress.
+  CancellationSource stop_source_;
+
+  // Coalesces the layover queries of all connections.
+  LayoverBatcher layover_batcher_;
+
+  // The listening socket.
+  int listener_;
+
+  // A pipe whose read end becomes readable when stop() is called, to wake
+  // run() from waiting for connections.
+  int wake_pipe_[2];
+
+  // Guards connections_ and stopping_.
+  std::mutex mutex_;
+
+  // Signaled when a connection is closed.
+  std::condition_variable connection_closed_;
+
+  // The open connections.
+  std::unordered_set<int> connections_;
+
+  // Whether stop() has been called.
+  bool stopping_ = false;
+};
+
+#endif
@@ -0,0 +1,119 @@
+#ifndef _query_server_test_hpp_
+#define _query_server_test_hpp_
+
+// Unit tests for the QueryServer and QueryClient classes.
+#include "query_server.hpp"
+
+#include <unistd.h>
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "airport_database.hpp"
+#include "airport_network.hpp"
+#include "doctest.hpp"
+#include "query_client.hpp"
+#include "query_protocol.hpp"
+
+TEST_CASE("QueryServer") {
+  const AirportDatabase airport_database =
+      AirportDatabase("small_data_airports.txt", "small_data_flights.txt");
+  const AirportNetwork airport_network = AirportNetwork(airport_database);
+  const std::string socket_path =
+      "/tmp/query_server_test_" + std::to_string(::getpid()) + ".sock";
+  QueryServer server(airport_network, socket_path);
+  std::thread serving([&server]() { server.run(); });
+
+  SUBCASE("ClientAnswersMatchNetwork") {
+    QueryClient client(socket_path);
+    std::vector<std::string> codes;
+    for (int i = 0; i < airport_database.size(); ++i) {
+      codes.push_back(airport_database.code(i));
+    }
+    CHECK_EQ(client.airport_codes(), codes);
+    for (const std::string& code : codes) {
+      CHECK_EQ(
+          client.least_distance(code), airport_network.least_distance(code));
+      CHECK_EQ(
+          client.least_distance(code, "LAX"),
+          airport_network.least_distance(code, "LAX"));
+      CHECK_EQ(
+          client.at_most_one_layover(code),
+          airport_network.at_most_one_layover(code));
+      CHECK_EQ(
+          client.least_distance_within_layovers(code, 1),
+          airport_network.least_distance_within_layovers(code, 1));
+    }
+  }
+
+  SUBCASE("ErrorsKeepTheConnection") {
+    QueryClient client(socket_path);
+    CHECK_THROWS_AS(client.least_distance("ACO"), std::invalid_argument);
+    CHECK_THROWS_AS(
+        client.least_distance_within_layovers("LAX", -1),
+        std::invalid_argument);
+    const int lax_dec = airport_network.least_distance("LAX", "DEC");
+    CHECK_EQ(client.least_distance("LAX", "DEC"), lax_dec);
+
+    const int connection = connect_to(socket_path);
+    std::string payload;
+    write_frame(connection, std::string(1, 99));
+    REQUIRE(read_frame(connection, payload));
+    CHECK_EQ(decode_response(payload).status, QueryStatus::kBadRequest);
+    QueryRequest request;
+    request.type = QueryType::kLeastDistanceBetween;
+    request.code = "LAX";
+    request.to_code = "DEC";
+    write_frame(connection, encode_request(request));
+    REQUIRE(read_frame(connection, payload));
+    CHECK_EQ(decode_response(payload).distances, std::vector<int>{lax_dec});
+    ::close(connection);
+  }
+
+  SUBCASE("OneServerPerSocket") {
+    CHECK_THROWS_AS(
+        QueryServer(airport_network, socket_path), std::runtime_error);
+    CHECK_THROWS_AS(
+        QueryServer(airport_network, std::string(200, 'x')),
+        std::runtime_error);
+    CHECK_THROWS_AS(
+        QueryServer(
+            airport_network, socket_path + ".other",
+            std::chrono::milliseconds(-1)),
+        std::invalid_argument);
+  }
+
+  SUBCASE("StopClosesOpenConnections") {
+    QueryClient idle(socket_path);
+    CHECK_EQ(idle.least_distance("LAX", "ORD"), 1739);
+    server.stop();
+    serving.join();
+    CHECK_THROWS_AS(idle.least_distance("LAX", "ORD"), std::runtime_error);
+  }
+
+  SUBCASE("StopCancelsSearches") {
+    server.stop();
+    serving.join();
+    QueryRequest request;
+    request.type = QueryType::kLayoverDistances;
+    request.code = "LAX";
+    request.max_layovers = 1;
+    CHECK_EQ(server.answer(request).status, QueryStatus::kCancelled);
+    request.type = QueryType::kAtMostOneLayover;
+    CHECK_EQ(server.answer(request).status, QueryStatus::kCancelled);
+    // The distance oracle does not search, so it still answers.
+    request.type = QueryType::kLeastDistanceBetween;
+    request.to_code = "ORD";
+    CHECK_EQ(server.answer(request).distances, std::vector<int>{1739});
+  }
+
+  server.stop();
+  if (serving.joinable()) {
+    serving.join();
+  }
+}
+
+#endif
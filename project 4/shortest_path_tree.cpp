@@ -0,0 +1,333 @@
+#include "shortest_path_tree.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cancellation_token.hpp"
+#include "csr_graph.hpp"
+
+namespace {
+
+constexpr int kIntMax = std::numeric_limits<int>::max();
+
+}  // namespace
+
+//
+// ShortestPathTree
+//
+
+ShortestPathTree::ShortestPathTree(
+    const CsrGraph& graph, const int source,
+    const CancellationToken& cancellation)
+    : source_(source) {
+  const int vertex_count = graph.vertex_count();
+  if (source < 0 || source >= vertex_count) {
+    throw std::range_error("invalid source: " + std::to_string(source));
+  }
+  distance_.assign(vertex_count, kIntMax);
+  parent_.assign(vertex_count, -1);
+  first_child_.assign(vertex_count, -1);
+  next_sibling_.assign(vertex_count, -1);
+  previous_sibling_.assign(vertex_count, -1);
+  distance_[source] = 0;
+  queue_.emplace_back(0, source);
+  propagate(graph, cancellation);
+}
+
+int ShortestPathTree::source() const noexcept {
+  return source_;
+}
+
+int ShortestPathTree::vertex_count() const noexcept {
+  return distance_.size();
+}
+
+const std::vector<int>& ShortestPathTree::distances() const noexcept {
+  return distance_;
+}
+
+int ShortestPathTree::parent(const int v) const {
+  if (v < 0 || v >= vertex_count()) {
+    throw std::range_error("invalid v: " + std::to_string(v));
+  }
+  return parent_[v];
+}
+
+bool ShortestPathTree::shortened_by(
+    const CsrGraph& graph, const int i, const int j) const {
+  const int weight = graph.edge_weight(i, j);
+  return (distance_[i] != kIntMax && distance_[i] + weight < distance_[j]) ||
+         (distance_[j] != kIntMax && distance_[j] + weight < distance_[i]);
+}
+
+bool ShortestPathTree::uses_edge(const int i, const int j) const {
+  if (i < 0 || i >= vertex_count()) {
+    throw std::range_error("invalid i: " + std::to_string(i));
+  }
+  if (j < 0 || j >= vertex_count()) {
+    throw std::range_error("invalid j: " + std::to_string(j));
+  }
+  return parent_[j] == i || parent_[i] == j;
+}
+
+void ShortestPathTree::edge_decreased(
+    const CsrGraph& graph, const int i, const int j) {
+  const int weight = graph.edge_weight(i, j);
+  for (const std::pair<int, int>& edge :
+       {std::make_pair(i, j), std::make_pair(j, i)}) {
+    const int from = edge.first;
+    const int to = edge.second;
+    if (distance_[from] != kIntMax &&
+        distance_[from] + weight < distance_[to]) {
+      distance_[to] = distance_[from] + weight;
+      set_parent(to, from);
+      queue_.emplace_back(distance_[to], to);
+    }
+  }
+  propagate(graph);
+}
+
+void ShortestPathTree::edge_increased(
+    const CsrGraph& graph, const int i, const int j) {
+  // Only a tree edge can lengthen a shortest path, and then only those of the
+  // vertices below it.
+  if (!uses_edge(i, j)) {
+    return;
+  }
+  const int root = parent_[j] == i ? j : i;
+
+  std::vector<int> cut(1, root);
+  for (int k = 0; k < cut.size(); ++k) {
+    for (int c = first_child_[cut[k]]; c != -1; c = next_sibling_[c]) {
+      cut.push_back(c);
+    }
+  }
+  for (const int v : cut) {
+    distance_[v] = kIntMax;
+  }
+
+  // Give each cut vertex its best distance through a neighbor outside the cut
+  // (whose distance cannot have changed), then let the search settle the
+  // paths between cut vertices.
+  const std::vector<int>& targets = graph.targets();
+  const std::vector<int>& weights = graph.weights();
+  std::vector<std::pair<int, int>> best(cut.size(), {kIntMax, -1});
+  for (int k = 0; k < cut.size(); ++k) {
+    const int v = cut[k];
+    for (int e = graph.offset(v); e < graph.offset(v + 1); ++e) {
+      const int u = targets[e];
+      if (distance_[u] != kIntMax &&
+          distance_[u] + weights[e] < best[k].first) {
+        best[k] = {distance_[u] + weights[e], u};
+      }
+    }
+  }
+  for (int k = 0; k < cut.size(); ++k) {
+    distance_[cut[k]] = best[k].first;
+    set_parent(cut[k], best[k].second);
+    if (best[k].second != -1) {
+      queue_.emplace_back(best[k].first, cut[k]);
+    }
+  }
+  propagate(graph);
+}
+
+void ShortestPathTree::set_parent(const int v, const int p) noexcept {
+  const int old_parent = parent_[v];
+  if (old_parent == p) {
+    return;
+  }
+  if (old_parent != -1) {
+    if (previous_sibling_[v] != -1) {
+      next_sibling_[previous_sibling_[v]] = next_sibling_[v];
+    } else {
+      first_child_[old_parent] = next_sibling_[v];
+    }
+    if (next_sibling_[v] != -1) {
+      previous_sibling_[next_sibling_[v]] = previous_sibling_[v];
+    }
+  }
+  parent_[v] = p;
+  previous_sibling_[v] = -1;
+  next_sibling_[v] = -1;
+  if (p != -1) {
+    next_sibling_[v] = first_child_[p];
+    if (first_child_[p] != -1) {
+      previous_sibling_[first_child_[p]] = v;
+    }
+    first_child_[p] = v;
+  }
+}
+
+void ShortestPathTree::propagate(
+    const CsrGraph& graph, const CancellationToken& cancellation) {
+  const std::vector<int>& targets = graph.targets();
+  const std::vector<int>& weights = graph.weights();
+  const std::greater<std::pair<int, int>> later;
+  std::make_heap(queue_.begin(), queue_.end(), later);
+  int settled = 0;
+  while (!queue_.empty()) {
+    std::pop_heap(queue_.begin(), queue_.end(), later);
+    const int current_distance = queue_.back().first;
+    const int current = queue_.back().second;
+    queue_.pop_back();
+    if (current_distance != distance_[current]) {
+      // A stale entry, superseded by a shorter path found later.
+      continue;
+    }
+    if (++settled % CancellationToken::kCheckInterval == 0) {
+      cancellation.throw_if_cancelled();
+    }
+    for (int e = graph.offset(current); e < graph.offset(current + 1); ++e) {
+      const int v = targets[e];
+      const int candidate = current_distance + weights[e];
+      if (candidate < distance_[v]) {
+        distance_[v] = candidate;
+        set_parent(v, current);
+        queue_.emplace_back(candidate, v);
+        std::push_heap(queue_.begin(), queue_.end(), later);
+      }
+    }
+  }
+}
+
+//
+// ShortestPathTreeCache
+//
+
+ShortestPathTreeCache::ShortestPathTreeCache(const int capacity) {
+  if (capacity <= 0) {
+    throw std::invalid_argument(
+        "capacity must be positive: " + std::to_string(capacity));
+  }
+  shard_count_ = std::min(capacity, kMaxShards);
+  shards_ = std::make_unique<Shard[]>(shard_count_);
+  for (int s = 0; s < shard_count_; ++s) {
+    // Spread the capacity as evenly as possible over the shards.
+    shards_[s].capacity =
+        capacity / shard_count_ + (s < capacity % shard_count_ ? 1 : 0);
+  }
+}
+
+ShortestPathTreeCache::ShortestPathTreeCache(
+    const ShortestPathTreeCache& other) {
+  share_shards_of(other);
+}
+
+ShortestPathTreeCache& ShortestPathTreeCache::operator=(
+    const ShortestPathTreeCache& other) {
+  if (this != &other) {
+    share_shards_of(other);
+  }
+  return *this;
+}
+
+int ShortestPathTreeCache::size() const {
+  int size = 0;
+  for (int s = 0; s < shard_count_; ++s) {
+    std::lock_guard<std::mutex> lock(shards_[s].mutex);
+    size += shards_[s].trees.size();
+  }
+  return size;
+}
+
+std::vector<int> ShortestPathTreeCache::distances(
+    const CsrGraph& graph, const int source,
+    const CancellationToken& cancellation) {
+  if (source < 0 || source >= graph.vertex_count()) {
+    throw std::range_error("invalid source: " + std::to_string(source));
+  }
+  Shard& shard = shard_of(source);
+  std::shared_ptr<const ShortestPathTree> cached;
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const auto found = shard.trees.find(source);
+    if (found != shard.trees.end()) {
+      cached = found->second;
+    }
+  }
+  if (cached != nullptr) {
+    // Holding the tree keeps it alive (and unchanged, as a change would copy
+    // it first) even if it is evicted meanwhile.
+    return cached->distances();
+  }
+  // Build the tree without holding the lock, so that other sources can be
+  // answered meanwhile.
+  auto tree = std::make_shared<ShortestPathTree>(graph, source, cancellation);
+  std::vector<int> distances = tree->distances();
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  if (shard.trees.find(source) == shard.trees.end()) {
+    if (shard.trees.size() >= shard.capacity) {
+      shard.trees.erase(shard.sources.front());
+      shard.sources.pop_front();
+    }
+    shard.trees.emplace(source, std::move(tree));
+    shard.sources.push_back(source);
+  }
+  return distances;
+}
+
+void ShortestPathTreeCache::edge_decreased(
+    const CsrGraph& graph, const int i, const int j) {
+  for (int s = 0; s < shard_count_; ++s) {
+    std::lock_guard<std::mutex> lock(shards_[s].mutex);
+    for (auto& entry : shards_[s].trees) {
+      if (entry.second->shortened_by(graph, i, j)) {
+        unshare(entry.second);
+        entry.second->edge_decreased(graph, i, j);
+      }
+    }
+  }
+}
+
+void ShortestPathTreeCache::edge_increased(
+    const CsrGraph& graph, const int i, const int j) {
+  for (int s = 0; s < shard_count_; ++s) {
+    std::lock_guard<std::mutex> lock(shards_[s].mutex);
+    for (auto& entry : shards_[s].trees) {
+      if (entry.second->uses_edge(i, j)) {
+        unshare(entry.second);
+        entry.second->edge_increased(graph, i, j);
+      }
+    }
+  }
+}
+
+void ShortestPathTreeCache::clear() {
+  for (int s = 0; s < shard_count_; ++s) {
+    std::lock_guard<std::mutex> lock(shards_[s].mutex);
+    shards_[s].trees.clear();
+    shards_[s].sources.clear();
+  }
+}
+
+ShortestPathTreeCache::Shard& ShortestPathTreeCache::shard_of(
+    const int source) const noexcept {
+  return shards_[source % shard_count_];
+}
+
+void ShortestPathTreeCache::share_shards_of(
+    const ShortestPathTreeCache& other) {
+  auto shards = std::make_unique<Shard[]>(other.shard_count_);
+  for (int s = 0; s < other.shard_count_; ++s) {
+    std::lock_guard<std::mutex> lock(other.shards_[s].mutex);
+    shards[s].capacity = other.shards_[s].capacity;
+    shards[s].trees = other.shards_[s].trees;
+    shards[s].sources = other.shards_[s].sources;
+  }
+  shard_count_ = other.shard_count_;
+  shards_ = std::move(shards);
+}
+
+void ShortestPathTreeCache::unshare(std::shared_ptr<ShortestPathTree>& tree) {
+  if (tree.use_count() > 1) {
+    tree = std::make_shared<ShortestPathTree>(*tree);
+  }
+}
@@ -0,0 +1,244 @@
+#ifndef _shortest_path_tree_hpp_
+#define _shortest_path_tree_hpp_
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "cancellation_token.hpp"
+#include "csr_graph.hpp"
+
+// The ShortestPathTree class holds the shortest path distances from one source
+// vertex of an undirected graph, with the tree of shortest paths, and repairs
+// them when an edge changes instead of running Djikstra's algorithm again.
+//
+// The repair follows Ramalingam and Reps, "An incremental algorithm for a
+// generalization of the shortest-path problem", J. Algorithms 21 (1996):
+//  * When an edge is added or made shorter, only the vertices whose distance
+//    improves through it are visited, by a Djikstra's algorithm search started
+//    at the edge.
+//  * When an edge is removed or made longer, only the vertices below it in the
+//    tree (if it is a tree edge at all) can get farther away. Those vertices
+//    are cut from the tree, each is given its best distance through a
+//    neighbor outside the cut, and a Djikstra's algorithm search among them
+//    settles the rest.
+// Either way the work is proportional to the part of the tree that changes,
+// which is usually a few airports rather than the whole network.
+class ShortestPathTree {
+ public:
+  //
+  // Constructors and Destructors
+  //
+
+  // The constructor. Finds the shortest paths from `source` in `graph`.
+  //
+  // Throws a std::range_error exception if source is not a valid vertex, and
+  // an OperationCancelled exception if `cancellation` is cancelled during the
+  // search (it is checked once every CancellationToken::kCheckInterval
+  // settled vertices).
+  //
+  // ASSUMES: graph is undirected (every edge is stored in both directions) and
+  // its edge weights are positive.
+  ShortestPathTree(
+      const CsrGraph& graph, const int source,
+      const CancellationToken& cancellation = CancellationToken());
+
+  // The copy constructor.
+  ShortestPathTree(const ShortestPathTree& other) = default;
+
+  // The copy assignment constructor.
+  ShortestPathTree& operator=(const ShortestPathTree& other) = default;
+
+  // The move constructor.
+  ShortestPathTree(ShortestPathTree&& other) = default;
+
+  // The move assignment constructor.
+  ShortestPathTree& operator=(ShortestPathTree&& other) = default;
+
+  // The destructor.
+  ~ShortestPathTree() = default;
+
+  //
+  // Accessors
+  //
+
+  // Returns the source vertex.
+  int source() const noexcept;
+
+  // Returns the number of vertices of the graph.
+  int vertex_count() const noexcept;
+
+  // Returns the length of the shortest path from the source to each vertex,
+  // with std::numeric_limits<int>::max() for vertices with no path.
+  const std::vector<int>& distances() const noexcept;
+
+  // Returns the vertex before v on its shortest path from the source, or -1 if
+  // v is the source or has no path.
+  //
+  // Throws a std::range_error exception if v is not a valid vertex.
+  int parent(const int v) const;
+
+  // Returns whether the edge between vertex i and vertex j of `graph` gives a
+  // shorter path to either of them, i.e., whether edge_decreased would change
+  // the tree.
+  //
+  // Throws a std::range_error exception if i or j is not a valid vertex, or a
+  // std::invalid_argument exception if there is no edge between them.
+  bool shortened_by(const CsrGraph& graph, const int i, const int j) const;
+
+  // Returns whether the edge between vertex i and vertex j is in the tree,
+  // i.e., whether edge_increased could change the tree.
+  //
+  // Throws a std::range_error exception if i or j is not a valid vertex.
+  bool uses_edge(const int i, const int j) const;
+
+  //
+  // Modifiers
+  //
+
+  // Repairs the tree after the edge between vertex i and vertex j of `graph`
+  // was added or made shorter.
+  //
+  // Throws a std::range_error exception if i or j is not a valid vertex.
+  //
+  // ASSUMES: graph is the graph the tree was built from, with that one change.
+  void edge_decreased(const CsrGraph& graph, const int i, const int j);
+
+  // Repairs the tree after the edge between vertex i and vertex j of `graph`
+  // was removed or made longer.
+  //
+  // Throws a std::range_error exception if i or j is not a valid vertex.
+  //
+  // ASSUMES: graph is the graph the tree was built from, with that one change.
+  void edge_increased(const CsrGraph& graph, const int i, const int j);
+
+ private:
+  // Makes p the parent of v in the tree (or detaches v if p is -1).
+  void set_parent(const int v, const int p) noexcept;
+
+  // Runs Djikstra's algorithm from the (distance, vertex) pairs in queue_,
+  // lowering distances wherever a shorter path is found.
+  //
+  // Throws an OperationCancelled exception if `cancellation` is found
+  // cancelled, leaving the tree incomplete.
+  void propagate(
+      const CsrGraph& graph,
+      const CancellationToken& cancellation = CancellationToken());
+
+  // The source vertex.
+  int source_;
+
+  // The distance from the source to each vertex.
+  std::vector<int> distance_;
+
+  // The parent of each vertex in the tree, or -1.
+  std::vector<int> parent_;
+
+  // The children of each vertex as a doubly linked list: the first child of
+  // each vertex, and the next and previous siblings of each vertex (or -1), so
+  // that a vertex moves between parents in O(1).
+  std::vector<int> first_child_;
+  std::vector<int> next_sibling_;
+  std::vector<int> previous_sibling_;
+
+  // The priority queue storage of (distance, vertex) pairs, kept between
+  // repairs so that it is not reallocated.
+  std::vector<std::pair<int, int>> queue_;
+};
+
+// The ShortestPathTreeCache class is a thread-safe cache of the shortest path
+// trees from the most recently requested sources of one graph, which repairs
+// every cached tree when the graph changes.
+//
+// The cache is split into shards by source, each with its own lock, so that
+// threads asking for different sources rarely wait for each other, and a
+// lookup holds its lock only to find the tree (the distances are copied out
+// after it is released). When a shard is full, the tree that was added to it
+// earliest is evicted.
+//
+// Copies of a cache share their trees, and a shared tree is copied only when
+// a change to the graph actually alters it, so copying a cache (along with the
+// rest of a network, for a new version) is cheap.
+class ShortestPathTreeCache {
+ public:
+  // The most shards a cache is split into.
+  static constexpr int kMaxShards = 16;
+
+  // The constructor. Creates an empty cache holding at most `capacity` trees.
+  //
+  // Throws a std::invalid_argument exception if capacity is not positive.
+  explicit ShortestPathTreeCache(const int capacity = 64);
+
+  // The copy constructor. The copy shares the trees of `other`.
+  ShortestPathTreeCache(const ShortestPathTreeCache& other);
+
+  // The copy assignment constructor. The cache then shares the trees of
+  // `other`.
+  ShortestPathTreeCache& operator=(const ShortestPathTreeCache& other);
+
+  // The destructor.
+  ~ShortestPathTreeCache() = default;
+
+  // Returns the number of trees in the cache.
+  int size() const;
+
+  // Returns the distances from `source` in `graph`, from the cached tree or
+  // from a tree built (and cached) for the call.
+  //
+  // Throws a std::range_error exception if source is not a valid vertex, and
+  // an OperationCancelled exception if `cancellation` is cancelled while the
+  // tree is built (the unfinished tree is then not cached).
+  std::vector<int> distances(
+      const CsrGraph& graph, const int source,
+      const CancellationToken& cancellation = CancellationToken());
+
+  // Repairs every cached tree after the edge between vertex i and vertex j of
+  // `graph` was added or made shorter.
+  void edge_decreased(const CsrGraph& graph, const int i, const int j);
+
+  // Repairs every cached tree after the edge between vertex i and vertex j of
+  // `graph` was removed or made longer.
+  void edge_increased(const CsrGraph& graph, const int i, const int j);
+
+  // Empties the cache.
+  void clear();
+
+ private:
+  // One shard of the cache.
+  struct Shard {
+    // The most trees held by the shard.
+    int capacity;
+
+    // Guards trees and sources.
+    std::mutex mutex;
+
+    // The cached trees, by source. A tree may be shared with copies of the
+    // cache, and is then copied before it is changed.
+    std::unordered_map<int, std::shared_ptr<ShortestPathTree>> trees;
+
+    // The sources of the cached trees, earliest added first.
+    std::deque<int> sources;
+  };
+
+  // Returns the shard holding the tree from `source`.
+  Shard& shard_of(const int source) const noexcept;
+
+  // Replaces shards_ with shards sharing the trees of `other`.
+  void share_shards_of(const ShortestPathTreeCache& other);
+
+  // Replaces `tree` with a copy of it if it is shared with another cache, so
+  // that it can be changed.
+  static void unshare(std::shared_ptr<ShortestPathTree>& tree);
+
+  // The number of shards: kMaxShards, or capacity if that is smaller (so that
+  // every shard holds at least one tree).
+  int shard_count_;
+
+  // The shards. The tree from source s is in shard s % shard_count_.
+  std::unique_ptr<Shard[]> shards_;
+};
+
+#endif
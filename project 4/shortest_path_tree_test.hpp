@@ -0,0 +1,112 @@
+#ifndef _shortest_path_tree_test_hpp_
+#define _shortest_path_tree_test_hpp_
+
+#include "shortest_path_tree.hpp"
+
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "adjacency_list_graph.hpp"
+#include "csr_graph.hpp"
+#include "doctest.hpp"
+#include "graph_traversal.hpp"
+#include "test_random.hpp"
+#include "undirected_graph.hpp"
+
+TEST_CASE("ShortestPathTree") {
+  // A pseudo-random undirected graph, kept in step with its CSR snapshot.
+  constexpr int kVertexCount = 80;
+  auto graph = random_graph<UndirectedGraph<AdjacencyListGraph>>(
+      kVertexCount, 120, 40, 3);
+  CsrGraph csr(graph);
+  TestRandom random(4);
+
+  SUBCASE("BadVerticesThrowException") {
+    CHECK_THROWS_AS(ShortestPathTree(csr, -1), std::range_error);
+    ShortestPathTree tree(csr, 0);
+    CHECK_THROWS_AS(tree.parent(kVertexCount), std::range_error);
+    CHECK_THROWS_AS(
+        tree.edge_increased(csr, 0, kVertexCount), std::range_error);
+  }
+
+  SUBCASE("RepairsMatchShortestPath") {
+    std::vector<ShortestPathTree> trees;
+    for (const int source : {0, 17, 42}) {
+      trees.emplace_back(csr, source);
+    }
+    int mismatches = 0;
+    for (int step = 0; step < 300; ++step) {
+      const int i = random.next(kVertexCount);
+      const int j = random.next(kVertexCount);
+      if (i == j) {
+        continue;
+      }
+      const int old_weight = graph.has_edge(i, j) ? graph.edge_weight(i, j) : 0;
+      const int weight = random.one_in(3) ? 0 : 1 + random.next(40);
+      if (weight == 0 && old_weight == 0) {
+        continue;
+      }
+      if (weight == 0) {
+        graph.remove_edge(i, j);
+        csr.remove_edge(i, j);
+        csr.remove_edge(j, i);
+      } else {
+        graph.add_edge(i, j, weight);
+        csr.set_edge(i, j, weight);
+        csr.set_edge(j, i, weight);
+      }
+      for (ShortestPathTree& tree : trees) {
+        if (old_weight == 0 || (weight != 0 && weight < old_weight)) {
+          tree.edge_decreased(csr, i, j);
+        } else {
+          tree.edge_increased(csr, i, j);
+        }
+        const std::vector<int> expected = shortest_path(graph, tree.source());
+        mismatches += tree.distances() != expected;
+        // Every vertex with a path hangs from a parent one edge closer.
+        for (int v = 0; v < kVertexCount; ++v) {
+          const int parent = tree.parent(v);
+          if (parent == -1) {
+            mismatches += v != tree.source() &&
+                          expected[v] != std::numeric_limits<int>::max();
+          } else {
+            mismatches += !graph.has_edge(parent, v) ||
+                          expected[parent] + graph.edge_weight(parent, v) !=
+                              expected[v];
+          }
+        }
+      }
+    }
+    CHECK_EQ(mismatches, 0);
+  }
+
+  SUBCASE("Cache") {
+    CHECK_THROWS_AS(ShortestPathTreeCache(0), std::invalid_argument);
+    ShortestPathTreeCache cache(2);
+    CHECK_EQ(cache.distances(csr, 0), shortest_path(graph, 0));
+    CHECK_EQ(cache.distances(csr, 1), shortest_path(graph, 1));
+    CHECK_EQ(cache.distances(csr, 0), shortest_path(graph, 0));
+    CHECK_EQ(cache.size(), 2);
+    CHECK_EQ(cache.distances(csr, 2), shortest_path(graph, 2));
+    CHECK_EQ(cache.size(), 2);
+    CHECK_THROWS_AS(cache.distances(csr, kVertexCount), std::range_error);
+
+    // A copy shares the trees, but repairs only its own.
+    const std::vector<int> before = shortest_path(graph, 2);
+    ShortestPathTreeCache copy = cache;
+    CHECK_EQ(copy.size(), 2);
+    graph.add_edge(0, 1, 1);
+    csr.set_edge(0, 1, 1);
+    csr.set_edge(1, 0, 1);
+    cache.edge_decreased(csr, 0, 1);
+    CHECK_EQ(cache.distances(csr, 2), shortest_path(graph, 2));
+    CHECK_EQ(copy.distances(csr, 2), before);
+    CHECK_NE(before, shortest_path(graph, 2));
+
+    cache.clear();
+    CHECK_EQ(cache.size(), 0);
+  }
+}
+
+#endif
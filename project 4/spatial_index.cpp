@@ -0,0 +1,264 @@
+#include "spatial_index.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// The radius of the Earth, as used by Airport::distance_miles.
+constexpr double kEarthRadiusMiles = 3956.0;
+
+// The number of dimensions of the unit vectors.
+constexpr int kDimensions = 3;
+
+// Returns the great-circle distance in miles between two points whose unit
+// vectors have the given squared chord distance.
+int chord_to_miles(const double squared_chord) {
+  const double half_chord = std::min(std::sqrt(squared_chord) / 2.0, 1.0);
+  return kEarthRadiusMiles * 2.0 * std::asin(half_chord);
+}
+
+// Returns the squared chord distance between the unit vectors of two points
+// that are the given number of great-circle miles apart.
+double miles_to_squared_chord(const double miles) {
+  const double angle = std::min(miles / kEarthRadiusMiles, M_PI);
+  const double chord = 2.0 * std::sin(angle / 2.0);
+  return chord * chord;
+}
+
+// A subtree still to be searched, with a lower bound on the squared chord
+// distance from the query to any of its points.
+struct PendingSubtree {
+  int begin;
+  int end;
+  double bound;
+};
+
+}  // namespace
+
+SpatialIndex::SpatialIndex(
+    const std::vector<double>& latitudes,
+    const std::vector<double>& longitudes) {
+  if (latitudes.size() != longitudes.size()) {
+    throw std::invalid_argument(
+        "got " + std::to_string(latitudes.size()) + " latitudes and " +
+            std::to_string(longitudes.size()) + " longitudes");
+  }
+  const int n = latitudes.size();
+  x_.resize(n);
+  y_.resize(n);
+  z_.resize(n);
+  point_.resize(n);
+  axis_.resize(n);
+  for (int k = 0; k < n; ++k) {
+    const UnitVector v = to_unit_vector(latitudes[k], longitudes[k]);
+    x_[k] = v.x;
+    y_[k] = v.y;
+    z_[k] = v.z;
+    point_[k] = k;
+  }
+  build(0, n);
+}
+
+//
+// Accessors
+//
+
+int SpatialIndex::size() const noexcept {
+  return point_.size();
+}
+
+//
+// Queries
+//
+
+std::vector<std::pair<int, int>> SpatialIndex::nearest(
+    const double latitude, const double longitude, const int count,
+    const std::function<bool(int)>& accept) const {
+  if (count < 0) {
+    throw std::invalid_argument("count cannot be negative");
+  }
+  const UnitVector query = to_unit_vector(latitude, longitude);
+
+  // A max-heap of the (squared chord, position) pairs of the best points so
+  // far, so its front is the one to replace when a closer point is found.
+  std::vector<std::pair<double, int>> best;
+  const auto worst = [&best, count]() {
+    return best.size() < count ? std::numeric_limits<double>::infinity()
+                               : best.front().first;
+  };
+
+  std::vector<PendingSubtree> pending({{0, size(), 0.0}});
+  while (!pending.empty() && count > 0) {
+    const PendingSubtree subtree = pending.back();
+    pending.pop_back();
+    if (subtree.begin >= subtree.end || subtree.bound > worst()) {
+      continue;
+    }
+    const int middle = (subtree.begin + subtree.end) / 2;
+    const double distance = squared_chord(query, middle);
+    if (distance < worst() && (!accept || accept(point_[middle]))) {
+      if (best.size() == count) {
+        std::pop_heap(best.begin(), best.end());
+        best.pop_back();
+      }
+      best.emplace_back(distance, middle);
+      std::push_heap(best.begin(), best.end());
+    }
+
+    // Search the side of the splitting plane containing the query first (it
+    // is pushed last), as the other side is at least the distance to the
+    // plane away.
+    const int axis = axis_[middle];
+    const double offset =
+        (axis == 0 ? query.x : axis == 1 ? query.y : query.z) -
+        coordinate(middle, axis);
+    const double far_bound = std::max(subtree.bound, offset * offset);
+    const PendingSubtree before = {
+        subtree.begin, middle, offset < 0 ? subtree.bound : far_bound};
+    const PendingSubtree after = {
+        middle + 1, subtree.end, offset < 0 ? far_bound : subtree.bound};
+    if (offset < 0) {
+      pending.push_back(after);
+      pending.push_back(before);
+    } else {
+      pending.push_back(before);
+      pending.push_back(after);
+    }
+  }
+
+  std::sort_heap(best.begin(), best.end());
+  std::vector<std::pair<int, int>> result;
+  result.reserve(best.size());
+  for (const std::pair<double, int>& entry : best) {
+    result.emplace_back(point_[entry.second], chord_to_miles(entry.first));
+  }
+  return result;
+}
+
+std::vector<std::pair<int, int>> SpatialIndex::within(
+    const double latitude, const double longitude, const int miles) const {
+  if (miles < 0) {
+    throw std::invalid_argument("miles cannot be negative");
+  }
+  const UnitVector query = to_unit_vector(latitude, longitude);
+  // The chord bound is slightly loose, so that rounding never drops a point;
+  // the points found are checked against `miles` exactly.
+  const double limit = miles_to_squared_chord(miles + 1.0);
+
+  std::vector<std::pair<double, int>> found;
+  std::vector<PendingSubtree> pending({{0, size(), 0.0}});
+  while (!pending.empty()) {
+    const PendingSubtree subtree = pending.back();
+    pending.pop_back();
+    if (subtree.begin >= subtree.end || subtree.bound > limit) {
+      continue;
+    }
+    const int middle = (subtree.begin + subtree.end) / 2;
+    const double distance = squared_chord(query, middle);
+    if (distance <= limit && chord_to_miles(distance) <= miles) {
+      found.emplace_back(distance, middle);
+    }
+    const int axis = axis_[middle];
+    const double offset =
+        (axis == 0 ? query.x : axis == 1 ? query.y : query.z) -
+        coordinate(middle, axis);
+    const double far_bound = std::max(subtree.bound, offset * offset);
+    pending.push_back(
+        {subtree.begin, middle, offset < 0 ? subtree.bound : far_bound});
+    pending.push_back(
+        {middle + 1, subtree.end, offset < 0 ? far_bound : subtree.bound});
+  }
+
+  std::sort(found.begin(), found.end());
+  std::vector<std::pair<int, int>> result;
+  result.reserve(found.size());
+  for (const std::pair<double, int>& entry : found) {
+    result.emplace_back(point_[entry.second], chord_to_miles(entry.first));
+  }
+  return result;
+}
+
+//
+// Helpers
+//
+
+SpatialIndex::UnitVector SpatialIndex::to_unit_vector(
+    const double latitude, const double longitude) {
+  const double phi = M_PI / 180.0 * latitude;
+  const double lambda = M_PI / 180.0 * longitude;
+  return {
+      std::cos(phi) * std::cos(lambda), std::cos(phi) * std::sin(lambda),
+      std::sin(phi)};
+}
+
+double SpatialIndex::coordinate(const int k, const int axis) const noexcept {
+  return axis == 0 ? x_[k] : axis == 1 ? y_[k] : z_[k];
+}
+
+double SpatialIndex::squared_chord(
+    const UnitVector& query, const int k) const noexcept {
+  const double dx = query.x - x_[k];
+  const double dy = query.y - y_[k];
+  const double dz = query.z - z_[k];
+  return dx * dx + dy * dy + dz * dz;
+}
+
+void SpatialIndex::build(const int begin, const int end) {
+  if (end - begin <= 0) {
+    return;
+  }
+  // Split on the axis along which the points are most spread out.
+  int axis = 0;
+  double widest = -1.0;
+  for (int a = 0; a < kDimensions; ++a) {
+    double low = std::numeric_limits<double>::infinity();
+    double high = -std::numeric_limits<double>::infinity();
+    for (int k = begin; k < end; ++k) {
+      low = std::min(low, coordinate(k, a));
+      high = std::max(high, coordinate(k, a));
+    }
+    if (high - low > widest) {
+      widest = high - low;
+      axis = a;
+    }
+  }
+
+  // Move the median (along the axis) to the middle position, with smaller
+  // coordinates before it and larger ones after it. The positions are sorted
+  // indirectly, then the arrays are permuted to match.
+  const int middle = (begin + end) / 2;
+  std::vector<int> order(end - begin);
+  for (int k = begin; k < end; ++k) {
+    order[k - begin] = k;
+  }
+  std::nth_element(
+      order.begin(), order.begin() + (middle - begin), order.end(),
+      [this, axis](const int a, const int b) {
+        return coordinate(a, axis) < coordinate(b, axis);
+      });
+  std::vector<double> x(order.size());
+  std::vector<double> y(order.size());
+  std::vector<double> z(order.size());
+  std::vector<int> point(order.size());
+  for (int k = 0; k < order.size(); ++k) {
+    x[k] = x_[order[k]];
+    y[k] = y_[order[k]];
+    z[k] = z_[order[k]];
+    point[k] = point_[order[k]];
+  }
+  std::copy(x.begin(), x.end(), x_.begin() + begin);
+  std::copy(y.begin(), y.end(), y_.begin() + begin);
+  std::copy(z.begin(), z.end(), z_.begin() + begin);
+  std::copy(point.begin(), point.end(), point_.begin() + begin);
+  axis_[middle] = axis;
+
+  build(begin, middle);
+  build(middle + 1, end);
+}
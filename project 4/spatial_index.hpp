@@ -0,0 +1,116 @@
+#ifndef _spatial_index_hpp_
+#define _spatial_index_hpp_
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+// The SpatialIndex class answers nearest-neighbor and radius queries, in
+// great-circle miles, over a fixed set of points 0, 1, ..., size() - 1 on the
+// globe.
+//
+// Each point is mapped to the unit vector (x, y, z) pointing at it from the
+// center of the Earth. The straight-line (chord) distance between two unit
+// vectors increases with the great-circle distance between the points, so the
+// queries run on a 3-dimensional k-d tree over the unit vectors, without any
+// special cases at the poles or the antimeridian.
+//
+// The tree is implicit: the points are stored in flat arrays, permuted so that
+// the splitting point of the subtree over positions [begin, end) is at the
+// middle position, with the points before it on one side of its splitting
+// plane and the points after it on the other.
+//
+// For more information, see https://en.wikipedia.org/wiki/K-d_tree.
+class SpatialIndex {
+ public:
+  //
+  // Constructors and Destructors
+  //
+
+  // The constructor. Indexes the points (latitudes[k], longitudes[k]), in
+  // degrees.
+  //
+  // Throws a std::invalid_argument exception if latitudes and longitudes have
+  // different sizes.
+  SpatialIndex(
+      const std::vector<double>& latitudes,
+      const std::vector<double>& longitudes);
+
+  // The copy constructor.
+  SpatialIndex(const SpatialIndex& other) = default;
+
+  // The copy assignment constructor.
+  SpatialIndex& operator=(const SpatialIndex& other) = default;
+
+  // The move constructor.
+  SpatialIndex(SpatialIndex&& other) = default;
+
+  // The move assignment constructor.
+  SpatialIndex& operator=(SpatialIndex&& other) = default;
+
+  // The destructor.
+  ~SpatialIndex() = default;
+
+  //
+  // Accessors
+  //
+
+  // Returns the number of points indexed.
+  int size() const noexcept;
+
+  //
+  // Queries
+  //
+
+  // Returns the (at most) `count` points closest to (latitude, longitude) for
+  // which accept returns true (every point, if accept is empty), as (point,
+  // great-circle distance in miles) pairs by increasing distance.
+  //
+  // Throws a std::invalid_argument exception if count is negative.
+  std::vector<std::pair<int, int>> nearest(
+      const double latitude, const double longitude, const int count,
+      const std::function<bool(int)>& accept = nullptr) const;
+
+  // Returns the points within `miles` great-circle miles of (latitude,
+  // longitude), as (point, great-circle distance in miles) pairs by
+  // increasing distance.
+  //
+  // Throws a std::invalid_argument exception if miles is negative.
+  std::vector<std::pair<int, int>> within(
+      const double latitude, const double longitude, const int miles) const;
+
+ private:
+  // A point being queried or stored, as a unit vector.
+  struct UnitVector {
+    double x;
+    double y;
+    double z;
+  };
+
+  // Returns the unit vector pointing at (latitude, longitude).
+  static UnitVector to_unit_vector(
+      const double latitude, const double longitude);
+
+  // Returns the coordinate `axis` (0, 1 or 2 for x, y or z) of position k.
+  double coordinate(const int k, const int axis) const noexcept;
+
+  // Returns the squared chord distance between `query` and position k.
+  double squared_chord(const UnitVector& query, const int k) const noexcept;
+
+  // Arranges positions [begin, end) as the subtree over them.
+  void build(const int begin, const int end);
+
+  // The x, y and z coordinates of the unit vector at each position.
+  std::vector<double> x_;
+  std::vector<double> y_;
+  std::vector<double> z_;
+
+  // The point at each position.
+  std::vector<int> point_;
+
+  // The axis of the splitting plane of the subtree whose splitting point is at
+  // each position.
+  std::vector<unsigned char> axis_;
+};
+
+#endif
@@ -0,0 +1,116 @@
+#ifndef _spatial_index_test_hpp_
+#define _spatial_index_test_hpp_
+
+// Unit tests for the SpatialIndex class.
+#include "spatial_index.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "airport.hpp"
+#include "doctest.hpp"
+#include "test_random.hpp"
+
+TEST_CASE("SpatialIndex") {
+  // Pseudo-random points, including some at the poles and on both sides of
+  // the antimeridian.
+  std::vector<double> latitudes({90.0, -90.0, 0.0, 0.0});
+  std::vector<double> longitudes({0.0, 0.0, 179.9, -179.9});
+  TestRandom random(17);
+  for (int k = 0; k < 2000; ++k) {
+    latitudes.push_back(-90.0 + random.next(18000) / 100.0);
+    longitudes.push_back(-180.0 + random.next(36000) / 100.0);
+  }
+  const SpatialIndex index(latitudes, longitudes);
+
+  // Returns the great-circle distance, in miles, between (latitude, longitude)
+  // and point k, as computed by Airport.
+  const auto miles_between = [&](const double latitude, const double longitude,
+                                 const int k) {
+    return Airport("", latitude, longitude)
+        .distance_miles(Airport("", latitudes[k], longitudes[k]));
+  };
+
+  SUBCASE("BadArgumentsThrowException") {
+    CHECK_THROWS_AS(SpatialIndex({0.0}, {}), std::invalid_argument);
+    CHECK_THROWS_AS(index.nearest(0.0, 0.0, -1), std::invalid_argument);
+    CHECK_THROWS_AS(index.within(0.0, 0.0, -1), std::invalid_argument);
+  }
+
+  SUBCASE("EmptyIndex") {
+    const SpatialIndex empty({}, {});
+    CHECK_EQ(empty.size(), 0);
+    CHECK(empty.nearest(0.0, 0.0, 3).empty());
+    CHECK(empty.within(0.0, 0.0, 30000).empty());
+  }
+
+  SUBCASE("NearestMatchesLinearScan") {
+    CHECK_EQ(index.size(), latitudes.size());
+    const std::vector<std::pair<double, double>> queries(
+        {{34.0, -118.4}, {89.9, 45.0}, {0.0, 180.0}, {-33.9, 151.2}});
+    for (const std::pair<double, double>& query : queries) {
+      std::vector<int> expected;
+      for (int k = 0; k < latitudes.size(); ++k) {
+        expected.push_back(miles_between(query.first, query.second, k));
+      }
+      std::sort(expected.begin(), expected.end());
+
+      const std::vector<std::pair<int, int>> nearest =
+          index.nearest(query.first, query.second, 10);
+      REQUIRE_EQ(nearest.size(), 10);
+      for (int r = 0; r < nearest.size(); ++r) {
+        CHECK_LE(std::abs(nearest[r].second - expected[r]), 1);
+        CHECK_LE(
+            std::abs(
+                nearest[r].second -
+                miles_between(query.first, query.second, nearest[r].first)),
+            1);
+      }
+    }
+    // The points across the antimeridian are about 14 miles apart.
+    const std::vector<std::pair<int, int>> nearest =
+        index.nearest(0.0, 179.9, 2);
+    CHECK_EQ(nearest[0], std::pair<int, int>(2, 0));
+    CHECK_EQ(nearest[1].first, 3);
+  }
+
+  SUBCASE("NearestWithAcceptSkipsRejectedPoints") {
+    const std::vector<std::pair<int, int>> nearest = index.nearest(
+        90.0, 0.0, 3, [](const int k) { return k % 2 == 1; });
+    REQUIRE_EQ(nearest.size(), 3);
+    for (const std::pair<int, int>& point : nearest) {
+      CHECK_EQ(point.first % 2, 1);
+    }
+    CHECK(index.nearest(0.0, 0.0, 1, [](const int) { return false; }).empty());
+  }
+
+  SUBCASE("WithinMatchesLinearScan") {
+    for (const int miles : {0, 300, 1500, 13000}) {
+      const std::vector<std::pair<int, int>> within =
+          index.within(40.0, -100.0, miles);
+      std::vector<bool> found(latitudes.size(), false);
+      for (int r = 0; r < within.size(); ++r) {
+        found[within[r].first] = true;
+        CHECK_LE(within[r].second, miles);
+        if (r > 0) {
+          CHECK_LE(within[r - 1].second, within[r].second);
+        }
+      }
+      // Allow for the two ways of computing distances rounding differently.
+      int missing = 0;
+      for (int k = 0; k < latitudes.size(); ++k) {
+        const int distance = miles_between(40.0, -100.0, k);
+        missing += (distance < miles && !found[k]) ||
+                   (distance > miles + 1 && found[k]);
+      }
+      CHECK_EQ(missing, 0);
+    }
+    CHECK_EQ(index.within(90.0, 0.0, 0).front().first, 0);
+  }
+}
+
+#endif
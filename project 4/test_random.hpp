@@ -0,0 +1,82 @@
+#ifndef _test_random_hpp_
+#define _test_random_hpp_
+
+// Helpers for the pseudo-random inputs of the unit tests.
+//
+// The inputs come from a fixed linear congruential generator rather than
+// <random>, so that they are the same on every run and with every standard
+// library, and a failing test can be replayed.
+
+#include <vector>
+
+#include "edge.hpp"
+
+// The TestRandom class is the generator.
+class TestRandom {
+ public:
+  // The constructor. The sequence of numbers is determined by `seed`.
+  explicit TestRandom(const unsigned int seed) : state_(seed) {}
+
+  // Returns a pseudo-random integer in [0, bound).
+  //
+  // ASSUMES: 0 < bound <= 2^24.
+  int next(const int bound) {
+    state_ = state_ * 1103515245 + 12345;
+    return static_cast<int>((state_ >> 8) % bound);
+  }
+
+  // Returns true about once in every `n` calls.
+  //
+  // ASSUMES: n > 0.
+  bool one_in(const int n) {
+    return next(n) == 0;
+  }
+
+ private:
+  // The state of the generator.
+  unsigned int state_;
+};
+
+// Returns edge_count-many pseudo-random edges between the vertices in
+// [0, vertex_count), with weights in [1, max_weight], drawn from a TestRandom
+// seeded with `seed`.
+//
+// There are no loops, but a pair of vertices may be drawn more than once (in
+// which case adding the edges in order keeps the last weight).
+//
+// ASSUMES: vertex_count > 1 and max_weight > 0.
+inline std::vector<Edge> random_edges(
+    const int vertex_count, const int edge_count, const int max_weight,
+    const unsigned int seed) {
+  TestRandom random(seed);
+  std::vector<Edge> edges;
+  edges.reserve(edge_count);
+  while (edges.size() < edge_count) {
+    const int i = random.next(vertex_count);
+    const int j = random.next(vertex_count);
+    const int weight = 1 + random.next(max_weight);
+    if (i != j) {
+      edges.emplace_back(i, j, weight);
+    }
+  }
+  return edges;
+}
+
+// Returns a GraphT with vertex_count vertices and the random_edges among its
+// first vertex_count - isolated vertices, so that the last `isolated` vertices
+// have no edges.
+//
+// ASSUMES: vertex_count - isolated > 1 and max_weight > 0.
+template <class GraphT>
+GraphT random_graph(
+    const int vertex_count, const int edge_count, const int max_weight,
+    const unsigned int seed, const int isolated = 0) {
+  GraphT graph(vertex_count);
+  for (const Edge& edge :
+       random_edges(vertex_count - isolated, edge_count, max_weight, seed)) {
+    graph.add_edge(edge.i(), edge.j(), edge.weight());
+  }
+  return graph;
+}
+
+#endif
@@ -0,0 +1,154 @@
+// A load test for the airport query server. Runs a number of client threads,
+// each with its own connection, that ask the server random queries as fast as
+// they are answered, and reports the throughput and the latencies.
+//
+// Usage: airport_load_test SOCKET_PATH [THREADS [QUERIES [MIX]]]
+//   THREADS: the number of client threads (default 8)
+//   QUERIES: the number of queries each thread asks (default 1000)
+//   MIX: the queries asked, one of
+//     pair     least_distance between two airports
+//     tree     least_distance from an airport to every airport
+//     hops     at_most_one_layover
+//     layover  least_distance_within_layovers with one layover (batched)
+//     mixed    all of the above in turn (the default)
+//
+// Build from the project directory with
+//   SOURCES="tools/airport_load_test.cpp $(ls *.cpp | grep -v main.cpp)"
+//   g++ -std=c++17 -O2 -pthread -I. -o airport_load_test $SOURCES
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "query_client.hpp"
+
+namespace {
+
+// The kinds of queries asked, in the order "mixed" takes them in.
+const std::vector<std::string> kQueryKinds = {"pair", "tree", "hops", "layover"};
+
+// Asks `client` one query of the given kind about airports picked from
+// `codes` with the pseudo-random `state`.
+void ask(
+    QueryClient& client, const std::string& kind,
+    const std::vector<std::string>& codes, std::uint32_t& state) {
+  state = state * 1103515245 + 12345;
+  const std::string& code = codes[(state >> 8) % codes.size()];
+  if (kind == "pair") {
+    state = state * 1103515245 + 12345;
+    client.least_distance(code, codes[(state >> 8) % codes.size()]);
+  } else if (kind == "tree") {
+    client.least_distance(code);
+  } else if (kind == "hops") {
+    client.at_most_one_layover(code);
+  } else {
+    client.least_distance_within_layovers(code, 1);
+  }
+}
+
+// Returns the given percentile of the sorted `latencies`.
+double percentile(const std::vector<double>& latencies, const double p) {
+  if (latencies.empty()) {
+    return 0.0;
+  }
+  const int index = std::min<int>(
+      latencies.size() - 1, p / 100.0 * latencies.size());
+  return latencies[index];
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc < 2 || argc > 5) {
+    std::cerr << "usage: " << argv[0]
+              << " SOCKET_PATH [THREADS [QUERIES [MIX]]]\n";
+    return 2;
+  }
+  const std::string socket_path = argv[1];
+  const int threads = argc > 2 ? std::stoi(argv[2]) : 8;
+  const int queries = argc > 3 ? std::stoi(argv[3]) : 1000;
+  const std::string mix = argc > 4 ? argv[4] : "mixed";
+  if (threads <= 0 || queries <= 0 ||
+      (mix != "mixed" &&
+       std::find(kQueryKinds.begin(), kQueryKinds.end(), mix) ==
+           kQueryKinds.end())) {
+    std::cerr << argv[0] << ": invalid THREADS, QUERIES or MIX\n";
+    return 2;
+  }
+
+  try {
+    const std::vector<std::string> codes =
+        QueryClient(socket_path).airport_codes();
+
+    // The latencies of each kind of query, in microseconds.
+    std::vector<std::vector<double>> latencies(kQueryKinds.size());
+    std::mutex latencies_mutex;
+    std::exception_ptr failure;
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> clients;
+    for (int t = 0; t < threads; ++t) {
+      clients.emplace_back([&, t]() {
+        std::vector<std::vector<double>> own(kQueryKinds.size());
+        try {
+          QueryClient client(socket_path);
+          std::uint32_t state = t + 1;
+          for (int q = 0; q < queries; ++q) {
+            const int kind = mix == "mixed"
+                ? (q + t) % kQueryKinds.size()
+                : std::find(kQueryKinds.begin(), kQueryKinds.end(), mix) -
+                    kQueryKinds.begin();
+            const auto asked = std::chrono::steady_clock::now();
+            ask(client, kQueryKinds[kind], codes, state);
+            const std::chrono::duration<double, std::micro> latency =
+                std::chrono::steady_clock::now() - asked;
+            own[kind].push_back(latency.count());
+          }
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(latencies_mutex);
+          failure = std::current_exception();
+        }
+        std::lock_guard<std::mutex> lock(latencies_mutex);
+        for (int k = 0; k < kQueryKinds.size(); ++k) {
+          latencies[k].insert(
+              latencies[k].end(), own[k].begin(), own[k].end());
+        }
+      });
+    }
+    for (std::thread& client : clients) {
+      client.join();
+    }
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (failure != nullptr) {
+      std::rethrow_exception(failure);
+    }
+
+    std::cout << threads << " threads x " << queries << " queries in "
+              << std::fixed << std::setprecision(3) << elapsed.count()
+              << " s: " << std::setprecision(0)
+              << threads * queries / elapsed.count() << " queries/s\n";
+    std::cout << std::setprecision(1);
+    for (int k = 0; k < kQueryKinds.size(); ++k) {
+      std::vector<double>& kind = latencies[k];
+      if (kind.empty()) {
+        continue;
+      }
+      std::sort(kind.begin(), kind.end());
+      std::cout << std::setw(8) << kQueryKinds[k] << ": " << kind.size()
+                << " queries, p50 " << percentile(kind, 50) << " us, p99 "
+                << percentile(kind, 99) << " us, max " << kind.back()
+                << " us\n";
+    }
+  } catch (const std::exception& error) {
+    std::cerr << argv[0] << ": " << error.what() << "\n";
+    return 1;
+  }
+  return 0;
+}
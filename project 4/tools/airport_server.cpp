@@ -0,0 +1,86 @@
+// The airport query server. Loads the airport database and builds the
+// network once, then answers the queries of QueryClients on a Unix domain
+// socket until it is sent SIGINT or SIGTERM.
+//
+// Usage: airport_server [--time-limit-ms=N] SOCKET_PATH
+//                       [AIRPORTS_FILE FLIGHTS_FILE]
+//
+// With --time-limit-ms, a query still searching after N milliseconds is
+// abandoned and answered with kDeadlineExceeded, so that the server sheds
+// work under overload rather than falling further behind.
+//
+// Build from the project directory with
+//   SOURCES="tools/airport_server.cpp $(ls *.cpp | grep -v main.cpp)"
+//   g++ -std=c++17 -O2 -pthread -I. -o airport_server $SOURCES
+#include <pthread.h>
+#include <signal.h>
+
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "airport_database.hpp"
+#include "airport_network.hpp"
+#include "query_server.hpp"
+
+int main(int argc, char* argv[]) {
+  const std::string time_limit_flag = "--time-limit-ms=";
+  std::chrono::milliseconds time_limit = std::chrono::milliseconds::zero();
+  int first = 1;
+  if (argc > 1 && std::string(argv[1]).rfind(time_limit_flag, 0) == 0) {
+    try {
+      time_limit = std::chrono::milliseconds(
+          std::stoi(std::string(argv[1]).substr(time_limit_flag.size())));
+    } catch (const std::exception&) {
+      time_limit = std::chrono::milliseconds(-1);
+    }
+    first = 2;
+  }
+  const int args = argc - first;
+  if ((args != 1 && args != 3) || time_limit.count() < 0) {
+    std::cerr << "usage: " << argv[0]
+              << " [--time-limit-ms=N] SOCKET_PATH"
+              << " [AIRPORTS_FILE FLIGHTS_FILE]\n";
+    return 2;
+  }
+  const std::string socket_path = argv[first];
+  const std::string airports_file =
+      args == 3 ? argv[first + 1] : "data_airports.txt";
+  const std::string flights_file =
+      args == 3 ? argv[first + 2] : "data_flights.txt";
+
+  // Block the stop signals in every thread, so that only the thread waiting
+  // for them below receives them.
+  sigset_t stop_signals;
+  sigemptyset(&stop_signals);
+  sigaddset(&stop_signals, SIGINT);
+  sigaddset(&stop_signals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &stop_signals, nullptr);
+
+  try {
+    const auto start = std::chrono::steady_clock::now();
+    const AirportDatabase airport_database(airports_file, flights_file);
+    const AirportNetwork airport_network(airport_database);
+    QueryServer server(airport_network, socket_path, time_limit);
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    std::cerr << "serving " << airport_network.num_airports()
+              << " airports and " << airport_network.num_flight_routes()
+              << " routes on "
+              << socket_path << " (loaded in " << elapsed.count() << " s)\n";
+
+    std::thread([&server, &stop_signals]() {
+      int signal = 0;
+      sigwait(&stop_signals, &signal);
+      server.stop();
+    }).detach();
+    server.run();
+  } catch (const std::exception& error) {
+    std::cerr << argv[0] << ": " << error.what() << "\n";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,123 @@
+// A benchmark of the EdgeAllocation options of AdjacencyListGraph. Builds the
+// airport graph of the full dataset (the UndirectedGraph AirportNetwork keeps)
+// over and over with the adjacency list nodes allocated from the heap and
+// from an arena, and reports the mean CPU time to build and to destroy it.
+//
+// The routes are read and their lengths computed once, up front, so only the
+// graph itself is timed.
+//
+// Usage: edge_allocation_benchmark [AIRPORTS FLIGHTS [RUNS [TRIALS]]]
+//   AIRPORTS, FLIGHTS: the data files (default data_airports.txt and
+//     data_flights.txt)
+//   RUNS: the number of graphs built and destroyed per trial (default 50)
+//   TRIALS: the number of times the comparison is repeated (default 3)
+//
+// Build from the project directory with
+//   SOURCES="$(ls *.cpp | grep -v main.cpp)"
+//   SOURCES="tools/edge_allocation_benchmark.cpp $SOURCES"
+//   g++ -std=c++17 -O2 -pthread -I. -o edge_allocation_benchmark $SOURCES
+#include <ctime>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "adjacency_list_graph.hpp"
+#include "airport.hpp"
+#include "airport_database.hpp"
+#include "bounds_check.hpp"
+#include "edge.hpp"
+#include "flight_route.hpp"
+#include "undirected_graph.hpp"
+
+namespace {
+
+// The graph type of AirportNetwork::airport_graph_.
+using AirportGraph = UndirectedGraph<BasicAdjacencyListGraph<DebugOnly>>;
+
+// The allocations compared, with their names.
+const std::vector<std::pair<EdgeAllocation, std::string>> kAllocations = {
+    {EdgeAllocation::kHeap, "heap"},
+    {EdgeAllocation::kArena, "arena"},
+};
+
+// Returns the edges of the airport graph of `database`, as AirportNetwork
+// builds it.
+std::vector<Edge> airport_edges(const AirportDatabase& database) {
+  std::vector<Edge> edges;
+  for (const FlightRoute& route : database.routes()) {
+    const Airport airport_one = database.airport(route.code_one());
+    const Airport airport_two = database.airport(route.code_two());
+    edges.emplace_back(
+        database.index(route.code_one()), database.index(route.code_two()),
+        airport_one.distance_miles(airport_two));
+  }
+  return edges;
+}
+
+// Returns the CPU time of `clocks` ticks, in milliseconds.
+double milliseconds(const std::clock_t clocks) {
+  return 1000.0 * clocks / CLOCKS_PER_SEC;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc != 1 && (argc < 3 || argc > 5)) {
+    std::cerr << "usage: " << argv[0]
+              << " [AIRPORTS FLIGHTS [RUNS [TRIALS]]]\n";
+    return 2;
+  }
+  const std::string airports = argc > 1 ? argv[1] : "data_airports.txt";
+  const std::string flights = argc > 1 ? argv[2] : "data_flights.txt";
+  const int runs = argc > 3 ? std::stoi(argv[3]) : 50;
+  const int trials = argc > 4 ? std::stoi(argv[4]) : 3;
+  if (runs <= 0 || trials <= 0) {
+    std::cerr << argv[0] << ": invalid RUNS or TRIALS\n";
+    return 2;
+  }
+
+  try {
+    const AirportDatabase database(airports, flights);
+    const std::vector<Edge> edges = airport_edges(database);
+    std::cout << database.size() << " airports, " << edges.size()
+              << " routes; mean CPU ms per graph over " << runs << " runs\n"
+              << std::fixed << std::setprecision(2);
+
+    long long sink = 0;
+    for (int trial = 0; trial < trials; ++trial) {
+      for (const std::pair<EdgeAllocation, std::string>& allocation :
+           kAllocations) {
+        std::clock_t build = 0;
+        std::clock_t destroy = 0;
+        for (int run = 0; run < runs; ++run) {
+          const std::clock_t started = std::clock();
+          auto graph = std::make_unique<AirportGraph>(
+              BasicAdjacencyListGraph<DebugOnly>(
+                  database.size(), allocation.first));
+          for (const Edge& edge : edges) {
+            graph->add_edge(edge.i(), edge.j(), edge.weight());
+          }
+          const std::clock_t built = std::clock();
+          sink += graph->edge_count();
+          graph.reset();
+          const std::clock_t destroyed = std::clock();
+          build += built - started;
+          destroy += destroyed - built;
+        }
+        std::cout << "trial " << trial + 1 << std::setw(7)
+                  << allocation.second << ": build " << std::setw(6)
+                  << milliseconds(build) / runs << " ms, destroy "
+                  << std::setw(6) << milliseconds(destroy) / runs << " ms\n";
+      }
+    }
+    // Use the graphs, so that building them cannot be optimized away.
+    return sink == 0 ? 1 : 0;
+  } catch (const std::exception& error) {
+    std::cerr << argv[0] << ": " << error.what() << "\n";
+    return 1;
+  }
+}
@@ -0,0 +1,218 @@
+// A benchmark of the storage policies of UndirectedGraph. Builds the airport
+// graph of the full dataset as UndirectedGraph<AdjacencyListGraph> (each edge
+// stored twice, once in each direction) and as
+// UndirectedGraph<SymmetricEdges> (each edge stored once), and reports the
+// heap memory each holds and the mean CPU time of:
+//
+//   build    adding every route to an empty graph
+//   edges    walking edges()
+//   sweep    visiting every edge at every vertex with its weight: out_edges
+//            and edge_weight for the mirrored graph, incident_edges for the
+//            symmetric one
+//   csr      taking a CsrGraph snapshot
+//   destroy  destroying the graph
+//
+// The memory is the growth of the heap in use (mallinfo2, so glibc only)
+// while the graph is built.
+//
+// Usage: undirected_storage_benchmark [AIRPORTS FLIGHTS [RUNS]]
+//   AIRPORTS, FLIGHTS: the data files (default data_airports.txt and
+//     data_flights.txt)
+//   RUNS: the number of graphs built and measured per policy (default 30)
+//
+// Build from the project directory with
+//   SOURCES="$(ls *.cpp | grep -v main.cpp)"
+//   SOURCES="tools/undirected_storage_benchmark.cpp $SOURCES"
+//   g++ -std=c++17 -O2 -pthread -I. -o undirected_storage_benchmark $SOURCES
+#include <malloc.h>
+
+#include <ctime>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "adjacency_list_graph.hpp"
+#include "airport.hpp"
+#include "airport_database.hpp"
+#include "csr_graph.hpp"
+#include "edge.hpp"
+#include "flight_route.hpp"
+#include "undirected_graph.hpp"
+
+namespace {
+
+// The mean CPU times of the steps timed, in milliseconds.
+struct Timings {
+  double build = 0.0;
+  double edges = 0.0;
+  double sweep = 0.0;
+  double csr = 0.0;
+  double destroy = 0.0;
+};
+
+// Returns the edges of the airport graph of `database`, as AirportNetwork
+// builds it.
+std::vector<Edge> airport_edges(const AirportDatabase& database) {
+  std::vector<Edge> edges;
+  for (const FlightRoute& route : database.routes()) {
+    const Airport airport_one = database.airport(route.code_one());
+    const Airport airport_two = database.airport(route.code_two());
+    edges.emplace_back(
+        database.index(route.code_one()), database.index(route.code_two()),
+        airport_one.distance_miles(airport_two));
+  }
+  return edges;
+}
+
+// Returns a GraphT with vertex_count vertices and `edges`.
+template <class GraphT>
+std::unique_ptr<GraphT> build_graph(
+    const int vertex_count, const std::vector<Edge>& edges) {
+  auto graph = std::make_unique<GraphT>(vertex_count);
+  for (const Edge& edge : edges) {
+    graph->add_edge(edge.i(), edge.j(), edge.weight());
+  }
+  return graph;
+}
+
+// Returns the bytes of heap in use.
+std::size_t heap_in_use() {
+  return mallinfo2().uordblks;
+}
+
+// Returns the sum of the weights of every edge at every vertex of `graph`.
+long long sweep(const UndirectedGraph<AdjacencyListGraph>& graph) {
+  long long sum = 0;
+  for (int i = 0; i < graph.vertex_count(); ++i) {
+    for (const int j : graph.out_edges(i)) {
+      sum += graph.edge_weight(i, j);
+    }
+  }
+  return sum;
+}
+
+// Returns the sum of the weights of every edge at every vertex of `graph`.
+long long sweep(const UndirectedGraph<SymmetricEdges>& graph) {
+  long long sum = 0;
+  for (int i = 0; i < graph.vertex_count(); ++i) {
+    for (const Edge& edge : graph.incident_edges(i)) {
+      sum += edge.weight();
+    }
+  }
+  return sum;
+}
+
+// Measures `runs` graphs of type GraphT built from `edges`, adding to `sink`
+// so that the work cannot be optimized away, and returns the mean times.
+template <class GraphT>
+Timings measure(
+    const int vertex_count, const std::vector<Edge>& edges, const int runs,
+    long long& sink) {
+  std::clock_t build = 0;
+  std::clock_t walk = 0;
+  std::clock_t swept = 0;
+  std::clock_t csr = 0;
+  std::clock_t destroy = 0;
+  for (int run = 0; run < runs; ++run) {
+    std::clock_t started = std::clock();
+    std::unique_ptr<GraphT> graph = build_graph<GraphT>(vertex_count, edges);
+    std::clock_t finished = std::clock();
+    build += finished - started;
+
+    started = finished;
+    for (const Edge& edge : graph->edges()) {
+      sink += edge.weight();
+    }
+    finished = std::clock();
+    walk += finished - started;
+
+    started = finished;
+    sink += sweep(*graph);
+    finished = std::clock();
+    swept += finished - started;
+
+    started = finished;
+    sink += CsrGraph(*graph).edge_count();
+    finished = std::clock();
+    csr += finished - started;
+
+    started = finished;
+    graph.reset();
+    finished = std::clock();
+    destroy += finished - started;
+  }
+  const double scale = 1000.0 / CLOCKS_PER_SEC / runs;
+  Timings timings;
+  timings.build = build * scale;
+  timings.edges = walk * scale;
+  timings.sweep = swept * scale;
+  timings.csr = csr * scale;
+  timings.destroy = destroy * scale;
+  return timings;
+}
+
+// Returns the growth of the heap in use while a GraphT is built from `edges`.
+template <class GraphT>
+std::size_t memory(const int vertex_count, const std::vector<Edge>& edges) {
+  const std::size_t before = heap_in_use();
+  const std::unique_ptr<GraphT> graph =
+      build_graph<GraphT>(vertex_count, edges);
+  return heap_in_use() - before;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc != 1 && argc != 3 && argc != 4) {
+    std::cerr << "usage: " << argv[0] << " [AIRPORTS FLIGHTS [RUNS]]\n";
+    return 2;
+  }
+  const std::string airports = argc > 1 ? argv[1] : "data_airports.txt";
+  const std::string flights = argc > 1 ? argv[2] : "data_flights.txt";
+  const int runs = argc > 3 ? std::stoi(argv[3]) : 30;
+  if (runs <= 0) {
+    std::cerr << argv[0] << ": invalid RUNS\n";
+    return 2;
+  }
+
+  try {
+    const AirportDatabase database(airports, flights);
+    const std::vector<Edge> edges = airport_edges(database);
+    const int n = database.size();
+
+    long long sink = 0;
+    const std::size_t mirrored_bytes =
+        memory<UndirectedGraph<AdjacencyListGraph>>(n, edges);
+    const std::size_t symmetric_bytes =
+        memory<UndirectedGraph<SymmetricEdges>>(n, edges);
+    const Timings mirrored =
+        measure<UndirectedGraph<AdjacencyListGraph>>(n, edges, runs, sink);
+    const Timings symmetric =
+        measure<UndirectedGraph<SymmetricEdges>>(n, edges, runs, sink);
+
+    std::cout << n << " airports; mean CPU ms over " << runs << " runs\n"
+              << std::setw(12) << "" << std::setw(12) << "mirrored"
+              << std::setw(12) << "symmetric" << "\n"
+              << std::fixed << std::setprecision(2) << std::setw(12)
+              << "heap (MB)" << std::setw(12) << mirrored_bytes / 1e6
+              << std::setw(12) << symmetric_bytes / 1e6 << "\n";
+    const auto row = [](const std::string& name, const double a,
+                        const double b) {
+      std::cout << std::setw(12) << name << std::setw(12) << a
+                << std::setw(12) << b << "\n";
+    };
+    row("build", mirrored.build, symmetric.build);
+    row("edges", mirrored.edges, symmetric.edges);
+    row("sweep", mirrored.sweep, symmetric.sweep);
+    row("csr", mirrored.csr, symmetric.csr);
+    row("destroy", mirrored.destroy, symmetric.destroy);
+    // Use the results, so that computing them cannot be optimized away.
+    return sink == 0 ? 1 : 0;
+  } catch (const std::exception& error) {
+    std::cerr << argv[0] << ": " << error.what() << "\n";
+    return 1;
+  }
+}
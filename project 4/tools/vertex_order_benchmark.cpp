@@ -0,0 +1,239 @@
+// A benchmark of the vertex orders of vertex_order.hpp. For each order, builds
+// the AirportNetwork of the full dataset relabeled in that order and times
+// uncached least_distance searches and least_distance_within_layovers sweeps
+// from the same pseudo-random airports, counting the cache misses of each with
+// the hardware performance counters (where the kernel allows it).
+//
+// The "input" order is the network as read from the data files, i.e., the
+// numbers before reordering.
+//
+// Usage: vertex_order_benchmark [AIRPORTS FLIGHTS [QUERIES]]
+//   AIRPORTS, FLIGHTS: the data files (default data_airports.txt and
+//     data_flights.txt)
+//   QUERIES: the number of distinct airports searched from (default 256, more
+//     than the shortest path tree cache holds, so every search runs)
+//
+// Build from the project directory with
+//   SOURCES="tools/vertex_order_benchmark.cpp $(ls *.cpp | grep -v main.cpp)"
+//   g++ -std=c++17 -O2 -pthread -I. -o vertex_order_benchmark $SOURCES
+//
+// The cache misses are read with perf_event_open, which needs
+// /proc/sys/kernel/perf_event_paranoid to be at most 2 (or CAP_PERFMON); where
+// it is not permitted they are reported as "n/a" and only the times are.
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "airport_database.hpp"
+#include "airport_network.hpp"
+#include "vertex_order.hpp"
+
+namespace {
+
+// The orders compared, with their names.
+const std::vector<std::pair<VertexOrder, std::string>> kOrders = {
+    {VertexOrder::kInput, "input"},
+    {VertexOrder::kBreadthFirst, "rcm"},
+    {VertexOrder::kHubFirst, "hub-first"},
+    {VertexOrder::kHilbert, "hilbert"},
+};
+
+// The number of layovers of the least_distance_within_layovers sweeps.
+constexpr int kLayovers = 3;
+
+// The MissCounter class counts the last level cache misses and the L1 data
+// cache read misses of this thread between start() and stop(), if the kernel
+// allows it.
+class MissCounter {
+ public:
+  MissCounter()
+      : last_level_(open_counter(
+            PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES)),
+        level_one_(open_counter(
+            PERF_TYPE_HW_CACHE,
+            PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16))) {}
+
+  MissCounter(const MissCounter&) = delete;
+  MissCounter& operator=(const MissCounter&) = delete;
+
+  ~MissCounter() {
+    for (const int fd : {last_level_, level_one_}) {
+      if (fd >= 0) {
+        close(fd);
+      }
+    }
+  }
+
+  // Returns whether the counters could be opened.
+  bool available() const {
+    return last_level_ >= 0 && level_one_ >= 0;
+  }
+
+  // Resets and starts the counters.
+  void start() {
+    for (const int fd : {last_level_, level_one_}) {
+      if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+    }
+  }
+
+  // Stops the counters, and returns the (last level, L1 data) misses since
+  // start().
+  std::pair<std::uint64_t, std::uint64_t> stop() {
+    return {read_counter(last_level_), read_counter(level_one_)};
+  }
+
+ private:
+  // Returns a disabled counter of the given event for this thread (in user
+  // space), or -1 if it cannot be opened.
+  static int open_counter(
+      const std::uint32_t type, const std::uint64_t config) {
+    perf_event_attr attributes;
+    std::memset(&attributes, 0, sizeof(attributes));
+    attributes.size = sizeof(attributes);
+    attributes.type = type;
+    attributes.config = config;
+    attributes.disabled = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    return syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+  }
+
+  // Stops the counter `fd` and returns its count (zero if it is not open).
+  static std::uint64_t read_counter(const int fd) {
+    std::uint64_t count = 0;
+    if (fd >= 0) {
+      ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+      if (read(fd, &count, sizeof(count)) != sizeof(count)) {
+        count = 0;
+      }
+    }
+    return count;
+  }
+
+  // The file descriptors of the counters, or -1.
+  int last_level_;
+  int level_one_;
+};
+
+// The time and cache misses per query of one kind of query.
+struct Measurement {
+  double microseconds;
+  double last_level_misses;
+  double level_one_misses;
+};
+
+// Runs query(code) for every code in `codes`, and returns the mean time and
+// cache misses per query.
+template <class Query>
+Measurement measure(
+    MissCounter& counter, const std::vector<std::string>& codes,
+    const Query& query) {
+  volatile int sink = 0;
+  counter.start();
+  const auto start = std::chrono::steady_clock::now();
+  for (const std::string& code : codes) {
+    sink = sink + query(code);
+  }
+  const std::chrono::duration<double, std::micro> elapsed =
+      std::chrono::steady_clock::now() - start;
+  const std::pair<std::uint64_t, std::uint64_t> misses = counter.stop();
+  return {
+      elapsed.count() / codes.size(),
+      static_cast<double>(misses.first) / codes.size(),
+      static_cast<double>(misses.second) / codes.size()};
+}
+
+// Prints one row of the table of results.
+void print(
+    const std::string& order, const std::string& query,
+    const Measurement& measurement, const bool counted) {
+  std::cout << std::setw(10) << order << std::setw(17) << query
+            << std::setw(12) << std::fixed << std::setprecision(1)
+            << measurement.microseconds;
+  if (counted) {
+    std::cout << std::setw(12) << std::setprecision(0)
+              << measurement.last_level_misses << std::setw(12)
+              << measurement.level_one_misses;
+  } else {
+    std::cout << std::setw(12) << "n/a" << std::setw(12) << "n/a";
+  }
+  std::cout << "\n";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc != 1 && argc != 3 && argc != 4) {
+    std::cerr << "usage: " << argv[0] << " [AIRPORTS FLIGHTS [QUERIES]]\n";
+    return 2;
+  }
+  const std::string airports = argc > 1 ? argv[1] : "data_airports.txt";
+  const std::string flights = argc > 1 ? argv[2] : "data_flights.txt";
+  const int queries = argc > 3 ? std::stoi(argv[3]) : 256;
+  if (queries <= 0) {
+    std::cerr << argv[0] << ": invalid QUERIES\n";
+    return 2;
+  }
+
+  try {
+    const AirportDatabase database(airports, flights);
+
+    // The same distinct airports, picked with a fixed linear congruential
+    // generator, are searched from in every order.
+    std::vector<std::string> codes;
+    std::vector<bool> picked(database.size(), false);
+    std::uint32_t state = 1;
+    while (codes.size() < queries && codes.size() < database.size()) {
+      state = state * 1103515245 + 12345;
+      const int index = (state >> 8) % database.size();
+      if (!picked[index]) {
+        picked[index] = true;
+        codes.push_back(database.code(index));
+      }
+    }
+
+    MissCounter counter;
+    std::cout << codes.size() << " airports, mean per query\n"
+              << std::setw(10) << "order" << std::setw(17) << "query"
+              << std::setw(12) << "time (us)" << std::setw(12) << "LLC miss"
+              << std::setw(12) << "L1D miss" << "\n";
+    for (const std::pair<VertexOrder, std::string>& order : kOrders) {
+      const AirportNetwork network(database, order.first);
+      // Warm the caches with one sweep (which, unlike a least_distance
+      // search, is not cached by the network).
+      network.least_distance_within_layovers(codes.front(), kLayovers);
+
+      print(
+          order.second, "least_distance",
+          measure(counter, codes, [&network](const std::string& code) {
+            return network.least_distance(code)[0];
+          }),
+          counter.available());
+      print(
+          order.second, "within_layovers",
+          measure(counter, codes, [&network](const std::string& code) {
+            return network.least_distance_within_layovers(
+                code, kLayovers)[0];
+          }),
+          counter.available());
+    }
+  } catch (const std::exception& error) {
+    std::cerr << argv[0] << ": " << error.what() << "\n";
+    return 1;
+  }
+  return 0;
+}
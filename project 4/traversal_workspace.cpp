@@ -0,0 +1,146 @@
+#include "traversal_workspace.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// The workspaces released on this thread and not yet leased again, most
+// recently released last. Workspaces grow to whatever graph they are reset
+// for, so the stack is shared by all pools.
+thread_local std::vector<std::unique_ptr<TraversalWorkspace>> free_workspaces;
+
+}  // namespace
+
+//
+// BasicTraversalWorkspace Accessors
+//
+
+template <class Distance>
+int BasicTraversalWorkspace<Distance>::vertex_count() const noexcept {
+  return distance_.size();
+}
+
+template <class Distance>
+bool BasicTraversalWorkspace<Distance>::seen(const int v) const noexcept {
+  return seen_stamp_[v] == generation_;
+}
+
+template <class Distance>
+Distance BasicTraversalWorkspace<Distance>::distance(
+    const int v) const noexcept {
+  return seen(v) ? distance_[v] : std::numeric_limits<Distance>::max();
+}
+
+template <class Distance>
+bool BasicTraversalWorkspace<Distance>::settled(const int v) const noexcept {
+  return settled_stamp_[v] == generation_;
+}
+
+template <class Distance>
+const std::vector<int>& BasicTraversalWorkspace<Distance>::touched()
+    const noexcept {
+  return touched_;
+}
+
+//
+// BasicTraversalWorkspace Modifiers
+//
+
+template <class Distance>
+void BasicTraversalWorkspace<Distance>::reset(const int vertex_count) {
+  if (vertex_count != distance_.size()) {
+    // Slots added for a bigger graph are stamped with generation zero, which
+    // is never current after the increment below.
+    seen_stamp_.resize(vertex_count, 0);
+    settled_stamp_.resize(vertex_count, 0);
+    distance_.resize(vertex_count);
+  }
+  generation_++;
+  if (generation_ == 0) {
+    // The generation counter wrapped around, so stale stamps could now look
+    // current. Clear them all, once every 2^32 resets.
+    std::fill(seen_stamp_.begin(), seen_stamp_.end(), 0);
+    std::fill(settled_stamp_.begin(), settled_stamp_.end(), 0);
+    generation_ = 1;
+  }
+  touched_.clear();
+  queue_.clear();
+}
+
+template <class Distance>
+void BasicTraversalWorkspace<Distance>::set_distance(
+    const int v, const Distance distance) {
+  if (seen_stamp_[v] != generation_) {
+    seen_stamp_[v] = generation_;
+    touched_.push_back(v);
+  }
+  distance_[v] = distance;
+}
+
+template <class Distance>
+void BasicTraversalWorkspace<Distance>::settle(const int v) noexcept {
+  settled_stamp_[v] = generation_;
+}
+
+template <class Distance>
+std::vector<std::pair<Distance, int>>&
+BasicTraversalWorkspace<Distance>::queue() noexcept {
+  return queue_;
+}
+
+template <class Distance>
+typename BasicTraversalWorkspace<Distance>::ScratchArray&
+BasicTraversalWorkspace<Distance>::scratch(const int k) noexcept {
+  return scratch_[k];
+}
+
+//
+// WorkspacePool
+//
+
+WorkspacePool::Lease::Lease(std::unique_ptr<TraversalWorkspace> workspace)
+    : workspace_(std::move(workspace)) {}
+
+WorkspacePool::Lease::~Lease() {
+  if (workspace_ != nullptr) {
+    WorkspacePool::release(std::move(workspace_));
+  }
+}
+
+TraversalWorkspace& WorkspacePool::Lease::operator*() const noexcept {
+  return *workspace_;
+}
+
+TraversalWorkspace* WorkspacePool::Lease::operator->() const noexcept {
+  return workspace_.get();
+}
+
+WorkspacePool::WorkspacePool(const WorkspacePool&) {}
+
+WorkspacePool& WorkspacePool::operator=(const WorkspacePool&) {
+  return *this;
+}
+
+WorkspacePool::Lease WorkspacePool::acquire() {
+  if (free_workspaces.empty()) {
+    return Lease(std::make_unique<TraversalWorkspace>());
+  }
+  std::unique_ptr<TraversalWorkspace> workspace =
+      std::move(free_workspaces.back());
+  free_workspaces.pop_back();
+  return Lease(std::move(workspace));
+}
+
+void WorkspacePool::release(std::unique_ptr<TraversalWorkspace> workspace) {
+  free_workspaces.push_back(std::move(workspace));
+}
+
+template class BasicTraversalWorkspace<int>;
+template class BasicTraversalWorkspace<std::uint32_t>;
+template class BasicTraversalWorkspace<std::int64_t>;
+template class BasicTraversalWorkspace<double>;
@@ -0,0 +1,215 @@
+#ifndef _traversal_workspace_hpp_
+#define _traversal_workspace_hpp_
+
+#include <array>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "aligned_allocator.hpp"
+
+// The BasicTraversalWorkspace class template holds the per-vertex scratch
+// state of a graph traversal (whether a vertex has been seen or settled, and
+// its tentative distance), so that it can be reused across traversals instead
+// of being allocated and initialized for every call.
+//
+// Every slot is stamped with the generation in which it was last written, and
+// a slot whose stamp is not the current generation reads as untouched. Hence
+// reset() is O(1) (apart from growing the workspace for a bigger graph), and a
+// traversal that only reaches a few vertices only ever writes those slots.
+//
+// Traversals that keep a value for every vertex anyway (such as the dense form
+// of Djikstra's algorithm, or the rounds of Bellman-Ford) use the scratch
+// arrays instead, which saves them an allocation per call but not the O(n)
+// initialization.
+//
+// The template parameter Distance is the type the distances are stored (and
+// queued) as. It is instantiated for int and for the PathLength types of the
+// edge weights (see path_length.hpp): std::uint32_t, std::int64_t and double.
+template <class Distance = int>
+class BasicTraversalWorkspace {
+ public:
+  // The type of the distances.
+  using DistanceType = Distance;
+
+  // The number of scratch arrays.
+  static constexpr int kScratchArrays = 2;
+
+  // The type of the scratch arrays, 64-byte aligned for SIMD loads.
+  using ScratchArray = std::vector<int, AlignedAllocator<int>>;
+
+  //
+  // Constructors and Destructors
+  //
+
+  // The default constructor. Creates a workspace for graphs with no vertices.
+  BasicTraversalWorkspace() = default;
+
+  // The copy constructor.
+  BasicTraversalWorkspace(const BasicTraversalWorkspace& other) = default;
+
+  // The copy assignment constructor.
+  BasicTraversalWorkspace& operator=(
+      const BasicTraversalWorkspace& other) = default;
+
+  // The move constructor.
+  BasicTraversalWorkspace(BasicTraversalWorkspace&& other) = default;
+
+  // The move assignment constructor.
+  BasicTraversalWorkspace& operator=(
+      BasicTraversalWorkspace&& other) = default;
+
+  // The destructor.
+  ~BasicTraversalWorkspace() = default;
+
+  //
+  // Accessors
+  //
+
+  // Returns the number of vertices the workspace was last reset for.
+  int vertex_count() const noexcept;
+
+  // Returns whether vertex v has been seen (given a distance) since the last
+  // reset.
+  //
+  // ASSUMES: 0 <= v < vertex_count().
+  bool seen(const int v) const noexcept;
+
+  // Returns the distance of vertex v, or std::numeric_limits<Distance>::max()
+  // if v has not been seen since the last reset.
+  //
+  // ASSUMES: 0 <= v < vertex_count().
+  Distance distance(const int v) const noexcept;
+
+  // Returns whether vertex v has been settled since the last reset.
+  //
+  // ASSUMES: 0 <= v < vertex_count().
+  bool settled(const int v) const noexcept;
+
+  // Returns the vertices seen since the last reset, in the order in which they
+  // were first seen.
+  const std::vector<int>& touched() const noexcept;
+
+  //
+  // Modifiers
+  //
+
+  // Prepares the workspace for a traversal of a graph with vertex_count-many
+  // vertices, marking every vertex as not seen and not settled.
+  void reset(const int vertex_count);
+
+  // Sets the distance of vertex v, marking it as seen.
+  //
+  // ASSUMES: 0 <= v < vertex_count().
+  void set_distance(const int v, const Distance distance);
+
+  // Marks vertex v as settled.
+  //
+  // ASSUMES: 0 <= v < vertex_count().
+  void settle(const int v) noexcept;
+
+  // Returns the storage for a priority queue of (distance, vertex) pairs, for
+  // traversals such as Djikstra's algorithm. It is emptied by reset.
+  std::vector<std::pair<Distance, int>>& queue() noexcept;
+
+  // Returns the k^th scratch array. Unlike the slots above, the scratch arrays
+  // are left alone by reset, and their size and contents are up to the
+  // traversal using them.
+  //
+  // ASSUMES: 0 <= k < kScratchArrays.
+  ScratchArray& scratch(const int k) noexcept;
+
+ private:
+  // The current generation. Slots stamped with any other value are untouched.
+  unsigned int generation_ = 0;
+
+  // The generation in which each vertex was last given a distance.
+  std::vector<unsigned int> seen_stamp_;
+
+  // The generation in which each vertex was last settled.
+  std::vector<unsigned int> settled_stamp_;
+
+  // The distance of each vertex, meaningful only if its seen_stamp_ is the
+  // current generation.
+  std::vector<Distance> distance_;
+
+  // The vertices seen in the current generation, in the order first seen.
+  std::vector<int> touched_;
+
+  // The priority queue storage handed out by queue().
+  std::vector<std::pair<Distance, int>> queue_;
+
+  // The arrays handed out by scratch().
+  std::array<ScratchArray, kScratchArrays> scratch_;
+};
+
+// The workspace with int distances, used by the traversals unless told
+// otherwise.
+using TraversalWorkspace = BasicTraversalWorkspace<int>;
+
+// The WorkspacePool class is a thread-safe pool of TraversalWorkspaces.
+//
+// Each thread running a traversal leases its own workspace for the duration
+// of the traversal, so concurrent traversals never share scratch state, and
+// workspaces (with their already-grown arrays) are reused by later traversals.
+//
+// The free workspaces are kept per thread, on a stack that grows to the
+// largest number of leases the thread has held at once (for nested
+// traversals), so leasing and releasing never take a lock and threads
+// querying in parallel do not contend for the pool. Workspaces grow to
+// whatever graph they are reset for, so the stacks are shared by all pools,
+// and a workspace released on a thread other than the one it was leased on
+// joins the stack of the releasing thread.
+class WorkspacePool {
+ public:
+  // The Lease class gives exclusive use of a workspace from a pool until it is
+  // destroyed, at which point the workspace is returned to the pool.
+  class Lease {
+   public:
+    // Leases cannot be copied, as the workspace is used exclusively.
+    Lease(const Lease& other) = delete;
+    Lease& operator=(const Lease& other) = delete;
+
+    // The move constructor.
+    Lease(Lease&& other) noexcept = default;
+
+    // The destructor, returning the workspace to the pool.
+    ~Lease();
+
+    // Returns the leased workspace.
+    TraversalWorkspace& operator*() const noexcept;
+    TraversalWorkspace* operator->() const noexcept;
+
+   private:
+    friend class WorkspacePool;
+
+    explicit Lease(std::unique_ptr<TraversalWorkspace> workspace);
+
+    // The leased workspace. Null after the lease has been moved from.
+    std::unique_ptr<TraversalWorkspace> workspace_;
+  };
+
+  // The default constructor. Creates an empty pool.
+  WorkspacePool() = default;
+
+  // The copy constructor. Workspaces are scratch space, so the copy starts
+  // with an empty pool rather than sharing or copying them.
+  WorkspacePool(const WorkspacePool& other);
+
+  // The copy assignment constructor. Leaves this pool unchanged.
+  WorkspacePool& operator=(const WorkspacePool& other);
+
+  // The destructor.
+  //
+  // ASSUMES: No leases from this pool are outstanding.
+  ~WorkspacePool() = default;
+
+  // Leases a workspace from the pool, creating one if none is free.
+  Lease acquire();
+
+ private:
+  // Returns a workspace to the stack of the calling thread.
+  static void release(std::unique_ptr<TraversalWorkspace> workspace);
+};
+
+#endif
@@ -0,0 +1,116 @@
+#ifndef _traversal_workspace_test_hpp_
+#define _traversal_workspace_test_hpp_
+
+// Unit tests for the TraversalWorkspace and WorkspacePool classes.
+#include "traversal_workspace.hpp"
+
+#include <limits>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "doctest.hpp"
+
+TEST_CASE("TraversalWorkspace") {
+  TraversalWorkspace workspace;
+  workspace.reset(5);
+
+  SUBCASE("ResetWorkspaceIsUntouched") {
+    CHECK_EQ(workspace.vertex_count(), 5);
+    for (int v = 0; v < 5; ++v) {
+      CHECK_FALSE(workspace.seen(v));
+      CHECK_FALSE(workspace.settled(v));
+      CHECK_EQ(workspace.distance(v), std::numeric_limits<int>::max());
+    }
+    CHECK(workspace.touched().empty());
+    CHECK(workspace.queue().empty());
+  }
+
+  SUBCASE("SetDistanceAndSettle") {
+    workspace.set_distance(3, 7);
+    workspace.set_distance(1, 2);
+    workspace.set_distance(3, 4);
+    workspace.settle(1);
+    CHECK(workspace.seen(3));
+    CHECK_EQ(workspace.distance(3), 4);
+    CHECK(workspace.settled(1));
+    CHECK_FALSE(workspace.settled(3));
+    CHECK_EQ(workspace.touched(), std::vector<int>({3, 1}));
+  }
+
+  SUBCASE("ResetForgetsPreviousTraversal") {
+    workspace.set_distance(2, 9);
+    workspace.settle(2);
+    workspace.queue().emplace_back(9, 2);
+    workspace.reset(5);
+    CHECK_FALSE(workspace.seen(2));
+    CHECK_FALSE(workspace.settled(2));
+    CHECK(workspace.touched().empty());
+    CHECK(workspace.queue().empty());
+  }
+
+  SUBCASE("ResetForBiggerGraph") {
+    workspace.set_distance(4, 1);
+    workspace.reset(10);
+    CHECK_EQ(workspace.vertex_count(), 10);
+    for (int v = 0; v < 10; ++v) {
+      CHECK_FALSE(workspace.seen(v));
+    }
+  }
+}
+
+TEST_CASE("WorkspacePool") {
+  WorkspacePool pool;
+
+  SUBCASE("ConcurrentLeasesAreDistinct") {
+    const WorkspacePool::Lease first = pool.acquire();
+    const WorkspacePool::Lease second = pool.acquire();
+    CHECK_NE(&*first, &*second);
+  }
+
+  SUBCASE("ReleasedWorkspaceIsReused") {
+    TraversalWorkspace* leased = nullptr;
+    {
+      const WorkspacePool::Lease lease = pool.acquire();
+      lease->reset(3);
+      leased = &*lease;
+    }
+    const WorkspacePool::Lease lease = pool.acquire();
+    CHECK_EQ(&*lease, leased);
+    CHECK_EQ(lease->vertex_count(), 3);
+  }
+
+  SUBCASE("NestedLeasesAreReused") {
+    std::vector<TraversalWorkspace*> leased;
+    {
+      const WorkspacePool::Lease outer = pool.acquire();
+      const WorkspacePool::Lease inner = pool.acquire();
+      leased = {&*outer, &*inner};
+    }
+    const WorkspacePool::Lease outer = pool.acquire();
+    const WorkspacePool::Lease inner = pool.acquire();
+    CHECK_EQ(std::vector<TraversalWorkspace*>({&*outer, &*inner}), leased);
+  }
+
+  SUBCASE("ThreadsReuseTheirOwnWorkspaces") {
+    std::vector<TraversalWorkspace*> first(4, nullptr);
+    std::vector<TraversalWorkspace*> second(4, nullptr);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&pool, &first, &second, t]() {
+        {
+          const WorkspacePool::Lease lease = pool.acquire();
+          first[t] = &*lease;
+        }
+        const WorkspacePool::Lease lease = pool.acquire();
+        second[t] = &*lease;
+      });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+    CHECK_EQ(first, second);
+  }
+}
+
+#endif
@@ -1,10 +1,28 @@
 #include "undirected_graph.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "edge.hpp"
+#include "edge_index.hpp"
+
 template <class T>
 UndirectedGraph<T>::UndirectedGraph(const int vertex_count)
     : directed_graph_(vertex_count),
       undirected_edge_count_(0) {}
 
+template <class T>
+UndirectedGraph<T>::UndirectedGraph(T directed_graph)
+    : directed_graph_(std::move(directed_graph)),
+      undirected_edge_count_(0) {
+  if (directed_graph_.edge_count() != 0) {
+    throw std::invalid_argument("directed graph must have no edges");
+  }
+}
+
 template <class T>
 int UndirectedGraph<T>::vertex_count() const noexcept {
   return directed_graph_.vertex_count();
@@ -21,7 +39,8 @@ bool UndirectedGraph<T>::has_edge(const int i, const int j) const {
 }
 
 template <class T>
-int UndirectedGraph<T>::edge_weight(const int i, const int j) const {
+typename UndirectedGraph<T>::WeightType UndirectedGraph<T>::edge_weight(
+    const int i, const int j) const {
   return directed_graph_.edge_weight(i, j);
 }
 
@@ -32,6 +51,22 @@ std::vector<int> UndirectedGraph<T>::out_edges(const int i) const {
   return directed_graph_.out_edges(i);
 }
 
+template <class T>
+bool UndirectedGraph<T>::has_edge_unchecked(const int i, const int j) const {
+  return directed_graph_.has_edge_unchecked(i, j);
+}
+
+template <class T>
+typename UndirectedGraph<T>::WeightType
+UndirectedGraph<T>::edge_weight_unchecked(const int i, const int j) const {
+  return directed_graph_.edge_weight_unchecked(i, j);
+}
+
+template <class T>
+std::vector<int> UndirectedGraph<T>::out_edges_unchecked(const int i) const {
+  return directed_graph_.out_edges_unchecked(i);
+}
+
 template <class T>
 std::vector<int> UndirectedGraph<T>::in_edges(const int j) const {
   // In a undirected graph, the in_edges and the out_edges for a vertex are the
@@ -45,21 +80,22 @@ std::vector<int> UndirectedGraph<T>::in_edges(const int j) const {
 }
 
 template <class T>
-std::vector<Edge> UndirectedGraph<T>::edges() const noexcept {
-  std::vector<Edge> edges = directed_graph_.edges();
+std::vector<BasicEdge<typename UndirectedGraph<T>::WeightType>>
+UndirectedGraph<T>::edges() const noexcept {
+  std::vector<BasicEdge<WeightType>> edges = directed_graph_.edges();
   // NOTE: In C++20, this would be more idiomatically accomplished using
   // std::erase_if.
   auto remove_iter = std::remove_if(
       edges.begin(),
       edges.end(),
-      [](const Edge& edge) { return edge.i() > edge.j(); });
+      [](const BasicEdge<WeightType>& edge) { return edge.i() > edge.j(); });
   edges.erase(remove_iter, edges.end());
   return edges;
 }
 
 template <class T>
 void UndirectedGraph<T>::add_edge(
-    const int i, const int j, const int edge_weight) {
+    const int i, const int j, const WeightType edge_weight) {
   // If the edge does not already exist, then increment our undirected edge
   // count.
   if (!directed_graph_.has_edge(i, j)) {
@@ -90,4 +126,197 @@ void UndirectedGraph<T>::remove_edge(const int i, const int j) {
 }
 
 template class UndirectedGraph<AdjacencyListGraph>;
-template class UndirectedGraph<AdjacencyMatrixGraph>;
\ No newline at end of file
+template class UndirectedGraph<AdjacencyMatrixGraph>;
+template class UndirectedGraph<BitMatrixGraph>;
+template class UndirectedGraph<BasicAdjacencyListGraph<Unchecked>>;
+template class UndirectedGraph<BasicAdjacencyListGraph<DebugOnly>>;
+template class UndirectedGraph<BasicAdjacencyMatrixGraph<Unchecked>>;
+template class UndirectedGraph<BasicAdjacencyMatrixGraph<DebugOnly>>;
+template class UndirectedGraph<BasicAdjacencyListGraph<Checked, std::uint16_t>>;
+template class UndirectedGraph<BasicAdjacencyListGraph<Checked, std::int64_t>>;
+template class UndirectedGraph<BasicAdjacencyListGraph<Checked, float>>;
+template class UndirectedGraph<
+    BasicAdjacencyMatrixGraph<Checked, std::uint16_t>>;
+template class UndirectedGraph<
+    BasicAdjacencyMatrixGraph<Checked, std::int64_t>>;
+template class UndirectedGraph<BasicAdjacencyMatrixGraph<Checked, float>>;
+
+//
+// UndirectedGraph<BasicSymmetricEdges<Bounds, Weight>>
+//
+
+template <class Bounds, class Weight>
+UndirectedGraph<BasicSymmetricEdges<Bounds, Weight>>::UndirectedGraph(
+    const int vertex_count)
+    : edge_index_(vertex_count),
+      incident_(vertex_count) {}
+
+template <class Bounds, class Weight>
+int UndirectedGraph<BasicSymmetricEdges<Bounds, Weight>>::vertex_count()
+    const noexcept {
+  return incident_.size();
+}
+
+template <class Bounds, class Weight>
+int UndirectedGraph<BasicSymmetricEdges<Bounds, Weight>>::edge_count()
+    const noexcept {
+  return edges_.size();
+}
+
+template <class Bounds, class Weight>
+bool UndirectedGraph<BasicSymmetricEdges<Bounds, Weight>>::has_edge(
+    const int i, const int j) const {
+  check_vertex(i, "i");
+  check_vertex(j, "j");
+  return has_edge_unchecked(i, j);
+}
+
+template <class Bounds, class Weight>
+Weight UndirectedGraph<BasicSymmetricEdges<Bounds, Weight>>::edge_weight(
+    const int i, const int j) const {
+  check_vertex(i, "i");
+  check_vertex(j, "j");
+  return edge_weight_unchecked(i, j);
+}
+
+template <class Bounds, class Weight>
+std::vector<int>
+UndirectedGraph<BasicSymmetricEdges<Bounds, Weight>>::out_edges(
+    const int i) const {
+  check_vertex(i, "i");
+  return out_edges_unchecked(i);
+}
+
+template <class Bounds, class Weight>
+bool UndirectedGraph<BasicSymmetricEdges<Bounds, Weight>>::has_edge_unchecked(
+    const int i, const int j) const {
+  return edge_index_[std::min(i, j)].contains(std::max(i, j));
+}
+
+template <class Bounds, class Weight>
+Weight
+UndirectedGraph<BasicSymmetricEdges<Bounds, Weight>>::edge_weight_unchecked(
+    const int i, const int j) const {
+  const int* position = edge_index_[std::min(i, j)].find(std::max(i, j));
+  if (position == nullptr) {
+    throw std::invalid_argument("no edge from i to j");
+  }
+  return edges_[*position].weight();
+}
+
+template <class Bounds, class Weight>
+std::vector<int>
+UndirectedGraph<BasicSymmetricEdges<Bounds, Weight>>::out_edges_unchecked(
+    const int i) const {
+  std::vector<int> outs;
+  outs.reserve(incident_[i].size());
+  for (const Edge& edge : IncidentEdges(edges_, i, incident_[i])) {
+    outs.push_back(edge.j());
+  }
+  return outs;
+}
+
+template <class Bounds, class Weight>
+std::vector<int> UndirectedGraph<BasicSymmetricEdges<Bounds, Weight>>::in_edges(
+    const int j) const {
+  // In an undirected graph, the in_edges and the out_edges for a vertex are
+  // the same.
+  return out_edges(j);
+}
+
+template <class Bounds, class Weight>
+typename UndirectedGraph<BasicSymmetricEdges<Bounds, Weight>>::IncidentEdges
+UndirectedGraph<BasicSymmetricEdges<Bounds, Weight>>::incident_edges(
+    const int i) const {
+  check_vertex(i, "i");
+  return IncidentEdges(edges_, i, incident_[i]);
+}
+
+template <class Bounds, class Weight>
+const std::vector<
+    typename UndirectedGraph<BasicSymmetricEdges<Bounds, Weight>>::Edge>&
+UndirectedGraph<BasicSymmetricEdges<Bounds, Weight>>::edges() const noexcept {
+  return edges_;
+}
+
+template <class Bounds, class Weight>
+void UndirectedGraph<BasicSymmetricEdges<Bounds, Weight>>::add_edge(
+    const int i, const int j, const Weight edge_weight) {
+  check_vertex(i, "i");
+  check_vertex(j, "j");
+  if (edge_weight == 0) {
+    throw std::invalid_argument("edge weight cannot be zero");
+  }
+  const int low = std::min(i, j);
+  const int high = std::max(i, j);
+  const int* position = edge_index_[low].find(high);
+  if (position != nullptr) {
+    edges_[*position].set_weight(edge_weight);
+    return;
+  }
+  const int added = edges_.size();
+  edges_.push_back(Edge(low, high, edge_weight));
+  edge_index_[low].insert_or_assign(high, added);
+  incident_[low].push_back(added);
+  if (low != high) {
+    incident_[high].push_back(added);
+  }
+}
+
+template <class Bounds, class Weight>
+void UndirectedGraph<BasicSymmetricEdges<Bounds, Weight>>::remove_edge(
+    const int i, const int j) {
+  check_vertex(i, "i");
+  check_vertex(j, "j");
+  const int low = std::min(i, j);
+  const int high = std::max(i, j);
+  const int* found = edge_index_[low].find(high);
+  if (found == nullptr) {
+    throw std::invalid_argument("no edge from i to j");
+  }
+  const int position = *found;
+  edge_index_[low].erase(high);
+  replace_position(low, position, -1);
+  if (low != high) {
+    replace_position(high, position, -1);
+  }
+  // Fill the hole with the last edge, so that edges_ stays contiguous.
+  const int last = edges_.size() - 1;
+  if (position != last) {
+    const Edge moved = edges_[last];
+    edges_[position] = moved;
+    edge_index_[moved.i()].insert_or_assign(moved.j(), position);
+    replace_position(moved.i(), last, position);
+    if (moved.i() != moved.j()) {
+      replace_position(moved.j(), last, position);
+    }
+  }
+  edges_.pop_back();
+}
+
+template <class Bounds, class Weight>
+void UndirectedGraph<BasicSymmetricEdges<Bounds, Weight>>::check_vertex(
+    const int vertex, const char* name) const {
+  ::check_vertex<Bounds>(vertex, vertex_count(), name);
+}
+
+template <class Bounds, class Weight>
+void UndirectedGraph<BasicSymmetricEdges<Bounds, Weight>>::replace_position(
+    const int vertex, const int position, const int replacement) {
+  std::vector<int>& positions = incident_[vertex];
+  std::vector<int>::iterator iter =
+      std::find(positions.begin(), positions.end(), position);
+  if (replacement == -1) {
+    *iter = positions.back();
+    positions.pop_back();
+  } else {
+    *iter = replacement;
+  }
+}
+
+template class UndirectedGraph<BasicSymmetricEdges<Checked>>;
+template class UndirectedGraph<BasicSymmetricEdges<Unchecked>>;
+template class UndirectedGraph<BasicSymmetricEdges<DebugOnly>>;
+template class UndirectedGraph<BasicSymmetricEdges<Checked, std::uint16_t>>;
+template class UndirectedGraph<BasicSymmetricEdges<Checked, std::int64_t>>;
+template class UndirectedGraph<BasicSymmetricEdges<Checked, float>>;
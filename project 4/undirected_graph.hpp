@@ -2,12 +2,18 @@
 #define _undirected_graph_hpp_
 
 #include <algorithm>
+#include <cstddef>
+#include <iterator>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "adjacency_list_graph.hpp"
 #include "adjacency_matrix_graph.hpp"
+#include "bounds_check.hpp"
+#include "bit_matrix_graph.hpp"
 #include "edge.hpp"
+#include "edge_index.hpp"
 
 // The UndirectedGraph class implements the Graph ADT for an undirected graph.
 //
@@ -16,9 +22,19 @@
 // implementation is that an edge between vertex i and vertex j in the
 // undirected graph is represented by edges from vertex i to vertex j and from
 // vertex j to vertex i in the directed graph.
+//
+// With T = SymmetricEdges, the graph instead stores each undirected edge once
+// (see UndirectedGraph<BasicSymmetricEdges<Bounds, Weight>> below).
+//
+// The edge weights have the type of the weights of T, so, e.g.,
+// UndirectedGraph<BasicAdjacencyListGraph<Checked, std::uint16_t>> stores
+// 16-bit weights.
 template <class T>
 class UndirectedGraph {
  public:
+  // The type of the edge weights.
+  using WeightType = typename T::WeightType;
+
   //
   // Constructors and Destructors
   //
@@ -31,6 +47,12 @@ class UndirectedGraph {
   // edges.
   UndirectedGraph(const int vertex_count);
 
+  // The constructor. Creates a graph over `directed_graph`, which gives the
+  // vertices and, e.g., how the edges are allocated.
+  //
+  // Throws a std::invalid_argument exception if directed_graph has edges.
+  explicit UndirectedGraph(T directed_graph);
+
   // The copy constructor.
   UndirectedGraph(const UndirectedGraph& other) = default;
 
@@ -65,20 +87,38 @@ class UndirectedGraph {
   // Returns the weight of the edge from vertex i to vertex j.
   //
   // Throws if 0 <= i, j < vertex_count() is violated or if !has_edge(i, j).
-  int edge_weight(const int i, const int j) const;
+  WeightType edge_weight(const int i, const int j) const;
 
   // Returns the vertices j with an edge from vertex i to vertex j.
   //
   // Throws if 0 <= i < vertex_count() is violated.
   std::vector<int> out_edges(const int i) const;
 
+  // The same as has_edge, except that i and j are never checked, as the
+  // unchecked accessors of T are used (see UncheckedView in
+  // bounds_check.hpp).
+  //
+  // ASSUMES: 0 <= i, j < vertex_count().
+  bool has_edge_unchecked(const int i, const int j) const;
+
+  // The same as edge_weight, except that i and j are never checked (a missing
+  // edge is still reported).
+  //
+  // ASSUMES: 0 <= i, j < vertex_count().
+  WeightType edge_weight_unchecked(const int i, const int j) const;
+
+  // The same as out_edges, except that i is never checked.
+  //
+  // ASSUMES: 0 <= i < vertex_count().
+  std::vector<int> out_edges_unchecked(const int i) const;
+
   // Returns the vertices i with an edge from vertex i to vertex j.
   //
   // Throws if 0 <= j < vertex_count() is violated.
   std::vector<int> in_edges(const int j) const;
   
   // Returns the edges in the graph, as a vector of Edge's.
-  std::vector<Edge> edges() const noexcept;
+  std::vector<BasicEdge<WeightType>> edges() const noexcept;
 
   //
   // Modifiers
@@ -90,7 +130,7 @@ class UndirectedGraph {
   // edge weight of the existing edge to `edge_weight`.
   //
   // Throws if 0 <= i, j < vertex_count() is violated or if edge_weight is zero.
-  void add_edge(const int i, const int j, const int edge_weight = 1);
+  void add_edge(const int i, const int j, const WeightType edge_weight = 1);
 
   // Removes the edge from vertex i to vertex j.
   //
@@ -108,4 +148,236 @@ class UndirectedGraph {
   int undirected_edge_count_;
 };
 
+// The storage policy of an UndirectedGraph that stores each undirected edge
+// once, rather than as a pair of directed edges in a directed graph, with the
+// bounds-check policy Bounds (see bounds_check.hpp) and weights of type
+// Weight, as for BasicAdjacencyListGraph.
+template <class Bounds = Checked, class Weight = int>
+struct BasicSymmetricEdges {};
+
+// The storage policy with checked bounds and int weights.
+using SymmetricEdges = BasicSymmetricEdges<>;
+
+// The UndirectedGraph<BasicSymmetricEdges<Bounds, Weight>> class template
+// implements the Graph ADT for an undirected graph, storing each edge once, in
+// the canonical form Edge(i, j, weight) with i <= j. Every bounds-check policy
+// is instantiated with int weights, and Checked also with the other weight
+// types of BasicEdge.
+//
+// Compared with the adapters over directed graphs, which store both
+// directions of every edge, adding an edge writes half as much, and edges()
+// returns the stored edges as they are, without copying them or filtering out
+// the reversed halves. Each vertex keeps the positions of its edges in
+// edges(), through which incident_edges gives the edges at a vertex as seen
+// from it, for traversals that would otherwise build a vector per call to
+// out_edges.
+template <class Bounds, class Weight>
+class UndirectedGraph<BasicSymmetricEdges<Bounds, Weight>> {
+ public:
+  // The type of the edge weights.
+  using WeightType = Weight;
+
+  // The type of the edges.
+  using Edge = BasicEdge<Weight>;
+
+  // A view of the edges at a vertex i, each oriented as Edge(i, j, weight)
+  // where j is the other end of the edge (see incident_edges).
+  //
+  // The view is invalidated by any call to a modifier of the graph.
+  class IncidentEdges {
+   public:
+    // The iterator over the edges in the view.
+    class Iterator {
+     public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = Edge;
+      using difference_type = std::ptrdiff_t;
+      using pointer = void;
+      using reference = Edge;
+
+      Iterator(
+          const std::vector<Edge>& edges, const int vertex,
+          std::vector<int>::const_iterator position)
+          : edges_(&edges), vertex_(vertex), position_(position) {}
+
+      Edge operator*() const {
+        const Edge& edge = (*edges_)[*position_];
+        return edge.i() == vertex_
+                   ? edge
+                   : Edge(vertex_, edge.i(), edge.weight());
+      }
+
+      Iterator& operator++() {
+        ++position_;
+        return *this;
+      }
+
+      bool operator==(const Iterator& other) const {
+        return position_ == other.position_;
+      }
+
+      bool operator!=(const Iterator& other) const {
+        return position_ != other.position_;
+      }
+
+     private:
+      const std::vector<Edge>* edges_;
+      int vertex_;
+      std::vector<int>::const_iterator position_;
+    };
+
+    IncidentEdges(
+        const std::vector<Edge>& edges, const int vertex,
+        const std::vector<int>& positions)
+        : edges_(edges), vertex_(vertex), positions_(positions) {}
+
+    Iterator begin() const {
+      return Iterator(edges_, vertex_, positions_.begin());
+    }
+
+    Iterator end() const {
+      return Iterator(edges_, vertex_, positions_.end());
+    }
+
+    // Returns the number of edges in the view.
+    int size() const noexcept {
+      return positions_.size();
+    }
+
+   private:
+    const std::vector<Edge>& edges_;
+    const int vertex_;
+    const std::vector<int>& positions_;
+  };
+
+  //
+  // Constructors and Destructors
+  //
+
+  // Delete the no argument constructor. It does not make sense to create a
+  // graph without knowing how many vertices there are.
+  UndirectedGraph() = delete;
+
+  // The constructor. Creates a graph with vertex_count-many vertices and no
+  // edges.
+  UndirectedGraph(const int vertex_count);
+
+  // The copy constructor.
+  UndirectedGraph(const UndirectedGraph& other) = default;
+
+  // The copy assignment constructor.
+  UndirectedGraph& operator=(const UndirectedGraph& other) = default;
+
+  // The move constructor.
+  UndirectedGraph(UndirectedGraph&& other) = default;
+
+  // The move assignment constructor.
+  UndirectedGraph& operator=(UndirectedGraph&& other) = default;
+
+  // The destructor.
+  ~UndirectedGraph() = default;
+
+  //
+  // Accessors
+  //
+
+  // Returns the number of vertices in the graph.
+  int vertex_count() const noexcept;
+
+  // Returns the number of edges in the graph.
+  int edge_count() const noexcept;
+
+  // Returns whether there is an edge between vertex i and vertex j.
+  //
+  // Throws if 0 <= i, j < vertex_count() is violated.
+  bool has_edge(const int i, const int j) const;
+
+  // Returns the weight of the edge between vertex i and vertex j.
+  //
+  // Throws if 0 <= i, j < vertex_count() is violated or if !has_edge(i, j).
+  Weight edge_weight(const int i, const int j) const;
+
+  // Returns the vertices j with an edge between vertex i and vertex j.
+  //
+  // Throws if 0 <= i < vertex_count() is violated.
+  std::vector<int> out_edges(const int i) const;
+
+  // The same as has_edge, except that i and j are never checked (see
+  // UncheckedView in bounds_check.hpp).
+  //
+  // ASSUMES: 0 <= i, j < vertex_count().
+  bool has_edge_unchecked(const int i, const int j) const;
+
+  // The same as edge_weight, except that i and j are never checked (a missing
+  // edge is still reported).
+  //
+  // ASSUMES: 0 <= i, j < vertex_count().
+  Weight edge_weight_unchecked(const int i, const int j) const;
+
+  // The same as out_edges, except that i is never checked.
+  //
+  // ASSUMES: 0 <= i < vertex_count().
+  std::vector<int> out_edges_unchecked(const int i) const;
+
+  // Returns the vertices i with an edge between vertex i and vertex j (which
+  // are the same as out_edges(j)).
+  //
+  // Throws if 0 <= j < vertex_count() is violated.
+  std::vector<int> in_edges(const int j) const;
+
+  // Returns the edges at vertex i, each as Edge(i, j, weight), without
+  // copying them.
+  //
+  // Throws if 0 <= i < vertex_count() is violated.
+  IncidentEdges incident_edges(const int i) const;
+
+  // Returns the edges in the graph, each once as Edge(i, j, weight) with
+  // i <= j, in no particular order.
+  //
+  // The reference is invalidated by any call to a modifier.
+  const std::vector<Edge>& edges() const noexcept;
+
+  //
+  // Modifiers
+  //
+
+  // Adds a new edge between vertex i and vertex j with the specified edge
+  // weight.
+  //
+  // If there is already an edge between vertex i and vertex j, this updates
+  // the edge weight of the existing edge to `edge_weight`.
+  //
+  // Throws if 0 <= i, j < vertex_count() is violated or if edge_weight is zero.
+  void add_edge(const int i, const int j, const Weight edge_weight = 1);
+
+  // Removes the edge between vertex i and vertex j.
+  //
+  // Throws if 0 <= i, j < vertex_count() is violated of if there is no edge
+  // between vertex i and vertex j.
+  void remove_edge(const int i, const int j);
+
+ private:
+  // Throws a std::range_error exception naming `name` if
+  // 0 <= vertex < vertex_count() is violated, provided kChecksBounds<Bounds>.
+  void check_vertex(const int vertex, const char* name) const;
+
+  // Replaces `position` by `replacement` in the positions of the edges at
+  // `vertex`, or, if replacement is -1, removes it.
+  void replace_position(
+      const int vertex, const int position, const int replacement);
+
+  // The edges in the graph, each once in canonical form (i <= j).
+  std::vector<Edge> edges_;
+
+  // The per-vertex indexes of the edges, used to answer has_edge and
+  // edge_weight.
+  //
+  // The i^th element of edge_index_ maps j to the position in edges_ of the
+  // edge between vertex i and vertex j, for every such edge with i <= j.
+  std::vector<EdgeIndex> edge_index_;
+
+  // The positions in edges_ of the edges at each vertex. A loop appears once.
+  std::vector<std::vector<int>> incident_;
+};
+
 #endif
\ No newline at end of file
@@ -2,10 +2,17 @@
 #define _undirected_graph_test_hpp_
 
 // Unit tests for the UndirectedGraph class.
+#include "test_random.hpp"
 #include "undirected_graph.hpp"
 
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
 #include "adjacency_list_graph.hpp"
 #include "adjacency_matrix_graph.hpp"
+#include "bit_matrix_graph.hpp"
 #include "doctest.hpp"
 #include "edge_test.hpp"
 #include "graph_adt_test.hpp"
@@ -138,5 +145,70 @@ TEST_CASE_TEMPLATE_DEFINE("UndirectedGraph", GraphT, UndirectedGraph) {
 
 TEST_CASE_TEMPLATE_INVOKE(UndirectedGraph, AdjacencyListGraph);
 TEST_CASE_TEMPLATE_INVOKE(UndirectedGraph, AdjacencyMatrixGraph);
+TEST_CASE_TEMPLATE_INVOKE(UndirectedGraph, BitMatrixGraph);
+TEST_CASE_TEMPLATE_INVOKE(UndirectedGraph, SymmetricEdges);
+
+TEST_CASE("SymmetricUndirectedGraph") {
+  SUBCASE("MatchesMirroredGraph") {
+    const int n = 40;
+    UndirectedGraph<AdjacencyListGraph> mirrored(n);
+    UndirectedGraph<SymmetricEdges> symmetric(n);
+    TestRandom random(47);
+    for (int step = 0; step < 3000; ++step) {
+      const int i = random.next(n);
+      const int j = random.next(n);
+      if (step % 3 == 2 && mirrored.has_edge(i, j)) {
+        mirrored.remove_edge(i, j);
+        symmetric.remove_edge(j, i);
+      } else {
+        mirrored.add_edge(i, j, 1 + step % 9);
+        symmetric.add_edge(i, j, 1 + step % 9);
+      }
+    }
+    CHECK_EQ(symmetric.edge_count(), mirrored.edge_count());
+    int mismatches = 0;
+    for (int i = 0; i < n; ++i) {
+      std::vector<int> expected = mirrored.out_edges(i);
+      std::vector<int> actual = symmetric.out_edges(i);
+      std::sort(expected.begin(), expected.end());
+      std::sort(actual.begin(), actual.end());
+      if (actual != expected) {
+        ++mismatches;
+      }
+      for (const Edge& edge : symmetric.incident_edges(i)) {
+        if (edge.i() != i ||
+            edge.weight() != mirrored.edge_weight(i, edge.j())) {
+          ++mismatches;
+        }
+      }
+    }
+    std::vector<Edge> expected_edges = mirrored.edges();
+    std::vector<Edge> actual_edges = symmetric.edges();
+    const auto by_ends = [](const Edge& lhs, const Edge& rhs) {
+      return std::make_pair(lhs.i(), lhs.j()) <
+             std::make_pair(rhs.i(), rhs.j());
+    };
+    std::sort(expected_edges.begin(), expected_edges.end(), by_ends);
+    std::sort(actual_edges.begin(), actual_edges.end(), by_ends);
+    CHECK_EQ(actual_edges, expected_edges);
+    CHECK_EQ(mismatches, 0);
+  }
+
+  SUBCASE("IncidentEdgesOfLoop") {
+    UndirectedGraph<SymmetricEdges> graph(3);
+    graph.add_edge(1, 1, 4);
+    graph.add_edge(2, 1, 6);
+    CHECK_EQ(graph.incident_edges(1).size(), 2);
+    CHECK_EQ(graph.incident_edges(0).size(), 0);
+    CHECK_EQ(graph.edges().size(), 2);
+    int weight_sum = 0;
+    for (const Edge& edge : graph.incident_edges(1)) {
+      CHECK_EQ(edge.i(), 1);
+      weight_sum += edge.weight();
+    }
+    CHECK_EQ(weight_sum, 10);
+    CHECK_THROWS_AS(graph.incident_edges(3), std::range_error);
+  }
+}
 
 #endif
\ No newline at end of file
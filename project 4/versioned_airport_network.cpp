@@ -0,0 +1,127 @@
+#include "versioned_airport_network.hpp"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "airport_database.hpp"
+#include "airport_network.hpp"
+#include "vertex_order.hpp"
+
+//
+// Pin
+//
+
+VersionedAirportNetwork::Pin::Pin(
+    const VersionedAirportNetwork* owner, const int slot,
+    const Version* version)
+    : owner_(owner), slot_(slot), version_(version) {}
+
+VersionedAirportNetwork::Pin::Pin(Pin&& other) noexcept
+    : owner_(other.owner_), slot_(other.slot_), version_(other.version_) {
+  other.owner_ = nullptr;
+}
+
+VersionedAirportNetwork::Pin::~Pin() {
+  if (owner_ != nullptr) {
+    owner_->hazards_[slot_].store(nullptr);
+    owner_->claimed_[slot_].store(false, std::memory_order_release);
+  }
+}
+
+const AirportNetwork& VersionedAirportNetwork::Pin::operator*()
+    const noexcept {
+  return version_->network;
+}
+
+const AirportNetwork* VersionedAirportNetwork::Pin::operator->()
+    const noexcept {
+  return &version_->network;
+}
+
+long VersionedAirportNetwork::Pin::version() const noexcept {
+  return version_->number;
+}
+
+//
+// VersionedAirportNetwork
+//
+
+VersionedAirportNetwork::VersionedAirportNetwork(
+    const AirportDatabase& airport_database, const VertexOrder order)
+    : current_(new Version{AirportNetwork(airport_database, order), 0}) {
+  for (int s = 0; s < kMaxPins; ++s) {
+    claimed_[s].store(false);
+    hazards_[s].store(nullptr);
+  }
+}
+
+VersionedAirportNetwork::~VersionedAirportNetwork() {
+  delete current_.load();
+  for (const Version* version : retired_) {
+    delete version;
+  }
+}
+
+VersionedAirportNetwork::Pin VersionedAirportNetwork::pin() const {
+  // Claim a free slot, yielding after every unsuccessful pass.
+  int slot = 0;
+  while (claimed_[slot].exchange(true, std::memory_order_acquire)) {
+    slot = (slot + 1) % kMaxPins;
+    if (slot == 0) {
+      std::this_thread::yield();
+    }
+  }
+
+  // Announce the current version, then check that it is still current: if so,
+  // a writer retiring it afterwards is bound to see the announcement. Both
+  // are sequentially consistent, which is what that argument needs.
+  const Version* version = current_.load();
+  while (true) {
+    hazards_[slot].store(version);
+    const Version* again = current_.load();
+    if (again == version) {
+      break;
+    }
+    version = again;
+  }
+  return Pin(this, slot, version);
+}
+
+long VersionedAirportNetwork::update(
+    const std::function<void(AirportNetwork&)>& change) {
+  std::lock_guard<std::mutex> lock(writer_mutex_);
+  const Version* old_version = current_.load();
+  auto new_version = std::make_unique<Version>(
+      Version{old_version->network, old_version->number + 1});
+  change(new_version->network);
+  const long number = new_version->number;
+  current_.store(new_version.release());
+  retired_.push_back(old_version);
+  reclaim();
+  return number;
+}
+
+int VersionedAirportNetwork::retained_versions() const {
+  std::lock_guard<std::mutex> lock(writer_mutex_);
+  return retired_.size() + 1;
+}
+
+void VersionedAirportNetwork::reclaim() {
+  std::vector<const Version*> pinned;
+  for (const Version* version : retired_) {
+    bool held = false;
+    for (int s = 0; s < kMaxPins && !held; ++s) {
+      held = hazards_[s].load() == version;
+    }
+    if (held) {
+      pinned.push_back(version);
+    } else {
+      delete version;
+    }
+  }
+  retired_.swap(pinned);
+}
@@ -0,0 +1,163 @@
+#ifndef _versioned_airport_network_hpp_
+#define _versioned_airport_network_hpp_
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "airport_database.hpp"
+#include "airport_network.hpp"
+#include "vertex_order.hpp"
+
+// The VersionedAirportNetwork class serves an AirportNetwork to any number of
+// reader threads while a writer applies route updates to it.
+//
+// Readers pin the current version of the network and query it for as long as
+// they hold the pin. A version never changes once published. A writer copies
+// the current version, changes the copy, and publishes it with one atomic
+// store, so readers see either the old or the new version, never a mix. The
+// copy is cheap, as copies of a network share the database, the spatial index,
+// the distance oracle, the shortest path trees and the chunks of the flight
+// graph's adjacency lists until the change touches them (see AirportNetwork
+// and BasicAdjacencyListGraph). Only the flat CSR arrays are copied whole,
+// which takes a few microseconds.
+//
+// Pinning takes no lock: a reader announces the version it is about to use in
+// a hazard pointer slot, and checks that it is still current. A writer frees
+// an old version once no slot holds it. Hence at most kMaxPins old versions
+// are ever kept, however slow the readers.
+//
+// Neither do the queries on a pinned version, with one exception:
+// least_distance for a single airport looks up and fills the cache of
+// shortest path trees, which locks one of its shards for the lookup or the
+// insertion (see ShortestPathTreeCache). Each version has a cache of its own
+// (sharing the trees cached when it was copied), so the lock is only
+// contended by readers of the same version, and it is held only to find or
+// insert a tree, never during a search.
+//
+// For more information, see Michael, "Hazard pointers: Safe memory
+// reclamation for lock-free objects", IEEE TPDS 15(6), 2004.
+class VersionedAirportNetwork {
+ private:
+  // A published version of the network.
+  struct Version {
+    AirportNetwork network;
+    long number;
+  };
+
+ public:
+  // The most pins held at once. A reader asking for a pin while all are held
+  // waits for one to be released.
+  static constexpr int kMaxPins = 128;
+
+  // The Pin class gives access to one version of the network until it is
+  // destroyed.
+  class Pin {
+   public:
+    // Pins cannot be copied, as each holds a hazard pointer slot.
+    Pin(const Pin& other) = delete;
+    Pin& operator=(const Pin& other) = delete;
+
+    // The move constructor.
+    Pin(Pin&& other) noexcept;
+
+    // The destructor, releasing the version.
+    ~Pin();
+
+    // Returns the pinned version of the network.
+    const AirportNetwork& operator*() const noexcept;
+    const AirportNetwork* operator->() const noexcept;
+
+    // Returns the number of the pinned version. The first version is zero, and
+    // each update adds one.
+    long version() const noexcept;
+
+   private:
+    friend class VersionedAirportNetwork;
+
+    Pin(const VersionedAirportNetwork* owner, const int slot,
+        const Version* version);
+
+    // The network the version belongs to. Null after the pin has been moved
+    // from.
+    const VersionedAirportNetwork* owner_;
+
+    // The hazard pointer slot held.
+    int slot_;
+
+    // The pinned version.
+    const Version* version_;
+  };
+
+  //
+  // Constructors and Destructors
+  //
+
+  // The constructor. Publishes AirportNetwork(airport_database, order) as
+  // version zero.
+  explicit VersionedAirportNetwork(
+      const AirportDatabase& airport_database,
+      const VertexOrder order = VertexOrder::kInput);
+
+  // Versioned networks cannot be copied, as pins refer to them.
+  VersionedAirportNetwork(const VersionedAirportNetwork& other) = delete;
+  VersionedAirportNetwork& operator=(const VersionedAirportNetwork& other) =
+      delete;
+
+  // The destructor.
+  //
+  // ASSUMES: No pins of this network are outstanding.
+  ~VersionedAirportNetwork();
+
+  //
+  // Readers
+  //
+
+  // Pins the current version of the network. Takes no lock.
+  Pin pin() const;
+
+  //
+  // Writers
+  //
+
+  // Publishes a new version of the network: a copy of the current version
+  // changed by `change`, e.g.,
+  //   versions.update([](AirportNetwork& network) {
+  //     network.add_route("LAX", "DEC");
+  //   });
+  // and returns its number. Updates from several threads are applied one at a
+  // time.
+  //
+  // If `change` throws an exception, nothing is published, and the exception
+  // is passed on.
+  long update(const std::function<void(AirportNetwork&)>& change);
+
+  // Returns the number of versions held in memory: the current version and
+  // the old versions still pinned.
+  int retained_versions() const;
+
+ private:
+  // Frees the retired versions that no hazard pointer slot holds.
+  //
+  // ASSUMES: writer_mutex_ is held.
+  void reclaim();
+
+  // The current version.
+  std::atomic<const Version*> current_;
+
+  // Whether each hazard pointer slot is held by a pin.
+  mutable std::array<std::atomic<bool>, kMaxPins> claimed_;
+
+  // The version each hazard pointer slot protects, or null.
+  mutable std::array<std::atomic<const Version*>, kMaxPins> hazards_;
+
+  // Serializes writers, and guards retired_.
+  mutable std::mutex writer_mutex_;
+
+  // The old versions not yet freed.
+  std::vector<const Version*> retired_;
+};
+
+#endif
@@ -0,0 +1,119 @@
+#ifndef _versioned_airport_network_test_hpp_
+#define _versioned_airport_network_test_hpp_
+
+#include "versioned_airport_network.hpp"
+
+#include <atomic>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "airport_database.hpp"
+#include "airport_network.hpp"
+#include "doctest.hpp"
+
+TEST_CASE("VersionedAirportNetwork") {
+  const AirportDatabase airport_database =
+      AirportDatabase("small_data_airports.txt", "small_data_flights.txt");
+  VersionedAirportNetwork versions(airport_database);
+  constexpr int kNoPath = std::numeric_limits<int>::max();
+
+  SUBCASE("PinnedVersionDoesNotChange") {
+    const VersionedAirportNetwork::Pin before = versions.pin();
+    CHECK_EQ(before.version(), 0);
+    CHECK_EQ(before->least_distance("LAX", "PGF"), kNoPath);
+
+    CHECK_EQ(
+        versions.update([](AirportNetwork& network) {
+          network.add_route("PGF", "DEC");
+        }),
+        1);
+    const VersionedAirportNetwork::Pin after = versions.pin();
+    CHECK_EQ(after.version(), 1);
+    CHECK_EQ(after->num_flight_routes(), 8);
+    CHECK_NE(after->least_distance("LAX", "PGF"), kNoPath);
+    CHECK_EQ(before->num_flight_routes(), 7);
+    CHECK_EQ(before->least_distance("LAX", "PGF"), kNoPath);
+  }
+
+  SUBCASE("FailedUpdatePublishesNothing") {
+    CHECK_THROWS_AS(
+        versions.update([](AirportNetwork& network) {
+          network.add_route("PGF", "DEC");
+          network.remove_route("PGF", "LAX");
+        }),
+        std::invalid_argument);
+    const VersionedAirportNetwork::Pin pin = versions.pin();
+    CHECK_EQ(pin.version(), 0);
+    CHECK_EQ(pin->num_flight_routes(), 7);
+  }
+
+  SUBCASE("OnlyPinnedVersionsAreKept") {
+    const auto toggle = [](AirportNetwork& network) {
+      if (network.num_flight_routes() == 7) {
+        network.add_route("PGF", "DEC");
+      } else {
+        network.remove_route("PGF", "DEC");
+      }
+    };
+    {
+      VersionedAirportNetwork::Pin first = versions.pin();
+      for (int u = 0; u < 5; ++u) {
+        versions.update(toggle);
+      }
+      CHECK_EQ(versions.retained_versions(), 2);
+      const VersionedAirportNetwork::Pin moved = std::move(first);
+      CHECK_EQ(moved.version(), 0);
+      versions.update(toggle);
+      CHECK_EQ(versions.retained_versions(), 2);
+    }
+    versions.update(toggle);
+    CHECK_EQ(versions.retained_versions(), 1);
+  }
+
+  SUBCASE("ReadersRunDuringUpdates") {
+    // The writer toggles the route PGF - DEC, so the odd versions have it.
+    std::atomic<bool> done(false);
+    std::atomic<int> mismatches(0);
+    std::atomic<long> reads(0);
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+      readers.emplace_back([&]() {
+        while (!done.load()) {
+          const VersionedAirportNetwork::Pin pin = versions.pin();
+          const bool odd = pin.version() % 2 == 1;
+          mismatches += pin->num_flight_routes() != (odd ? 8 : 7);
+          mismatches +=
+              (pin->least_distance("LAX", "PGF") != kNoPath) != odd;
+          mismatches += pin->same_component("LAX", "PGF") != odd;
+          reads++;
+        }
+      });
+    }
+    for (int u = 0; u < 200; ++u) {
+      versions.update([u](AirportNetwork& network) {
+        if (u % 2 == 0) {
+          network.add_route("PGF", "DEC");
+        } else {
+          network.remove_route("PGF", "DEC");
+        }
+      });
+      std::this_thread::yield();
+    }
+    done = true;
+    for (std::thread& reader : readers) {
+      reader.join();
+    }
+    CHECK_EQ(mismatches.load(), 0);
+    CHECK_GT(reads.load(), 0);
+
+    // Versions still pinned at the last update are freed by the next one.
+    CHECK_LE(versions.retained_versions(), 4);
+    versions.update([](AirportNetwork&) {});
+    CHECK_EQ(versions.retained_versions(), 1);
+  }
+}
+
+#endif
@@ -0,0 +1,131 @@
+#include "vertex_order.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "csr_graph.hpp"
+
+namespace {
+
+// The number of cells along each side of the Hilbert curve grid.
+constexpr std::uint32_t kHilbertSide = 1 << 16;
+
+// Returns the cell (between 0 and kHilbertSide - 1) of `value` on a grid over
+// [low, high].
+std::uint32_t grid_cell(
+    const double value, const double low, const double high) {
+  const double scaled = (value - low) / (high - low) * kHilbertSide;
+  return std::min<double>(std::max(scaled, 0.0), kHilbertSide - 1);
+}
+
+// Returns the distance along the Hilbert curve over the kHilbertSide by
+// kHilbertSide grid of cell (x, y).
+std::uint64_t hilbert_distance(std::uint32_t x, std::uint32_t y) {
+  std::uint64_t distance = 0;
+  for (std::uint32_t side = kHilbertSide / 2; side > 0; side /= 2) {
+    const std::uint32_t rx = (x & side) > 0;
+    const std::uint32_t ry = (y & side) > 0;
+    distance += std::uint64_t(side) * side * ((3 * rx) ^ ry);
+    // Rotate the quadrant so the curve in it has the standard orientation.
+    if (ry == 0) {
+      if (rx == 1) {
+        x = kHilbertSide - 1 - x;
+        y = kHilbertSide - 1 - y;
+      }
+      std::swap(x, y);
+    }
+  }
+  return distance;
+}
+
+}  // namespace
+
+std::vector<int> breadth_first_order(const CsrGraph& graph) {
+  const int n = graph.vertex_count();
+  const std::vector<int>& targets = graph.targets();
+  std::vector<int> degree(n);
+  for (int v = 0; v < n; ++v) {
+    degree[v] = graph.offset(v + 1) - graph.offset(v);
+  }
+  const auto by_degree = [&degree](const int a, const int b) {
+    return degree[a] < degree[b] || (degree[a] == degree[b] && a < b);
+  };
+
+  // Each component is started from its vertex of least degree, which tends to
+  // be on the periphery, so the breadth first levels are narrow.
+  std::vector<int> starts(n);
+  for (int v = 0; v < n; ++v) {
+    starts[v] = v;
+  }
+  std::sort(starts.begin(), starts.end(), by_degree);
+
+  // The order doubles as the queue of the breadth first searches.
+  std::vector<int> order;
+  order.reserve(n);
+  std::vector<bool> seen(n, false);
+  std::vector<int> neighbors;
+  for (const int start : starts) {
+    if (seen[start]) {
+      continue;
+    }
+    seen[start] = true;
+    order.push_back(start);
+    for (int k = order.size() - 1; k < order.size(); ++k) {
+      const int current = order[k];
+      neighbors.clear();
+      for (int e = graph.offset(current); e < graph.offset(current + 1); ++e) {
+        if (!seen[targets[e]]) {
+          seen[targets[e]] = true;
+          neighbors.push_back(targets[e]);
+        }
+      }
+      std::sort(neighbors.begin(), neighbors.end(), by_degree);
+      order.insert(order.end(), neighbors.begin(), neighbors.end());
+    }
+  }
+  std::reverse(order.begin(), order.end());
+  return order;
+}
+
+std::vector<int> hub_first_order(const CsrGraph& graph) {
+  std::vector<int> order(graph.vertex_count());
+  for (int v = 0; v < order.size(); ++v) {
+    order[v] = v;
+  }
+  const auto degree = [&graph](const int v) {
+    return graph.offset(v + 1) - graph.offset(v);
+  };
+  std::stable_sort(
+      order.begin(), order.end(),
+      [&degree](const int a, const int b) { return degree(a) > degree(b); });
+  return order;
+}
+
+std::vector<int> hilbert_order(
+    const std::vector<double>& latitudes,
+    const std::vector<double>& longitudes) {
+  if (latitudes.size() != longitudes.size()) {
+    throw std::invalid_argument(
+        "got " + std::to_string(latitudes.size()) + " latitudes and " +
+            std::to_string(longitudes.size()) + " longitudes");
+  }
+  std::vector<std::uint64_t> distance(latitudes.size());
+  for (int k = 0; k < latitudes.size(); ++k) {
+    distance[k] = hilbert_distance(
+        grid_cell(longitudes[k], -180.0, 180.0),
+        grid_cell(latitudes[k], -90.0, 90.0));
+  }
+  std::vector<int> order(latitudes.size());
+  for (int k = 0; k < order.size(); ++k) {
+    order[k] = k;
+  }
+  std::stable_sort(
+      order.begin(), order.end(),
+      [&distance](const int a, const int b) {
+        return distance[a] < distance[b];
+      });
+  return order;
+}
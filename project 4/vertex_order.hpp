@@ -0,0 +1,60 @@
+#ifndef _vertex_order_hpp_
+#define _vertex_order_hpp_
+
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "permutation.hpp"
+
+// Orders in which the vertices of a graph can be relabeled, so that vertices
+// that are used together are stored together in memory.
+//
+// Each order is returned as a permutation `order` of 0, 1, ..., n - 1, in
+// which order[k] is the (old) vertex that is given the new label k. See
+// permutation.hpp for inverse_order.
+enum class VertexOrder {
+  // The order of the input, unchanged.
+  kInput,
+
+  // Reverse Cuthill-McKee order, a breadth first order that keeps the
+  // neighbors of each vertex close to it.
+  kBreadthFirst,
+
+  // Descending order of degree, so the heavily connected hubs (which most
+  // searches pass through) share the first few cache lines.
+  kHubFirst,
+
+  // Order along a Hilbert curve over the positions of the vertices, so that
+  // vertices close on the map are close in memory.
+  kHilbert,
+};
+
+// Returns the reverse Cuthill-McKee order of the vertices of `graph`.
+//
+// Each connected component is visited in breadth first order from a vertex of
+// least degree, enqueuing the neighbors of every vertex by increasing degree,
+// and the whole order is then reversed.
+//
+// For more information, see
+// https://en.wikipedia.org/wiki/Cuthill%E2%80%93McKee_algorithm.
+//
+// ASSUMES: graph is undirected, i.e., every edge is stored in both directions.
+std::vector<int> breadth_first_order(const CsrGraph& graph);
+
+// Returns the vertices of `graph` by decreasing out-degree, breaking ties by
+// increasing vertex.
+std::vector<int> hub_first_order(const CsrGraph& graph);
+
+// Returns the points (latitudes[k], longitudes[k]) (in degrees) in order along
+// a Hilbert curve over a 65536 by 65536 grid covering the globe, breaking ties
+// by increasing k.
+//
+// For more information, see https://en.wikipedia.org/wiki/Hilbert_curve.
+//
+// Throws a std::invalid_argument exception if latitudes and longitudes have
+// different sizes.
+std::vector<int> hilbert_order(
+    const std::vector<double>& latitudes,
+    const std::vector<double>& longitudes);
+
+#endif
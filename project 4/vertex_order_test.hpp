@@ -0,0 +1,60 @@
+#ifndef _vertex_order_test_hpp_
+#define _vertex_order_test_hpp_
+
+// Unit tests for the vertex orders.
+#include "vertex_order.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "adjacency_list_graph.hpp"
+#include "csr_graph.hpp"
+#include "doctest.hpp"
+#include "undirected_graph.hpp"
+
+TEST_CASE("VertexOrder") {
+  // Two paths, 0 - 5 - 2 - 4 and 1 - 3, and a hub 6 adjacent to 0, 2 and 5.
+  UndirectedGraph<AdjacencyListGraph> graph(7);
+  graph.add_edge(0, 5, 1);
+  graph.add_edge(5, 2, 1);
+  graph.add_edge(2, 4, 1);
+  graph.add_edge(1, 3, 1);
+  graph.add_edge(6, 0, 1);
+  graph.add_edge(6, 2, 1);
+  graph.add_edge(6, 5, 1);
+  const CsrGraph csr(graph);
+
+  SUBCASE("OrdersArePermutations") {
+    for (const std::vector<int>& order :
+         {breadth_first_order(csr), hub_first_order(csr)}) {
+      std::vector<int> sorted = order;
+      std::sort(sorted.begin(), sorted.end());
+      CHECK_EQ(sorted, std::vector<int>({0, 1, 2, 3, 4, 5, 6}));
+    }
+  }
+
+  SUBCASE("BreadthFirstOrderKeepsComponentsTogether") {
+    // The components are started from their vertices of least degree, 1 and
+    // then 4, and the breadth first order is then reversed.
+    CHECK_EQ(breadth_first_order(csr), std::vector<int>({0, 6, 5, 2, 4, 3, 1}));
+  }
+
+  SUBCASE("HubFirstOrderIsByDecreasingDegree") {
+    CHECK_EQ(hub_first_order(csr), std::vector<int>({2, 5, 6, 0, 1, 3, 4}));
+  }
+
+  SUBCASE("HilbertOrderFollowsTheCurve") {
+    // The quadrants of the curve are visited lower left, upper left, upper
+    // right, lower right. Points 3 and 4 are the same, so stay in order.
+    const std::vector<double> latitudes({-45.0, 45.0, 45.0, -45.0, -45.0});
+    const std::vector<double> longitudes({90.0, 90.0, -90.0, -90.0, -90.0});
+    CHECK_EQ(
+        hilbert_order(latitudes, longitudes),
+        std::vector<int>({3, 4, 2, 1, 0}));
+    CHECK_THROWS_AS(
+        hilbert_order(latitudes, {1.0}), std::invalid_argument);
+  }
+}
+
+#endif
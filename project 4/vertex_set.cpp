@@ -0,0 +1,220 @@
+#include "vertex_set.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// The number of 64-bit words in a 64-byte cache line.
+constexpr int kWordsPerLine = 8;
+
+// Returns the number of words needed for a set of the given size, rounded up
+// to a whole number of cache lines.
+int word_count_for(const int size) {
+  const int words = (size + 63) / 64;
+  return (words + kWordsPerLine - 1) / kWordsPerLine * kWordsPerLine;
+}
+
+// The word-wise operations used by the set operations.
+enum class WordOperation { kAnd, kOr, kAndNot };
+
+// Performs lhs[w] = lhs[w] OP rhs[w] for 0 <= w < word_count.
+//
+// ASSUMES: lhs and rhs are 64-byte aligned and word_count is a multiple of
+// kWordsPerLine.
+template <WordOperation Operation>
+void apply(
+    std::uint64_t* lhs, const std::uint64_t* rhs, const int word_count) {
+  int w = 0;
+#if defined(__AVX512F__)
+  for (; w < word_count; w += 8) {
+    const __m512i a = _mm512_load_si512(lhs + w);
+    const __m512i b = _mm512_load_si512(rhs + w);
+    __m512i result;
+    if (Operation == WordOperation::kAnd) {
+      result = _mm512_and_si512(a, b);
+    } else if (Operation == WordOperation::kOr) {
+      result = _mm512_or_si512(a, b);
+    } else {
+      result = _mm512_andnot_si512(b, a);
+    }
+    _mm512_store_si512(lhs + w, result);
+  }
+#elif defined(__AVX2__)
+  for (; w < word_count; w += 4) {
+    __m256i* target = reinterpret_cast<__m256i*>(lhs + w);
+    const __m256i a = _mm256_load_si256(target);
+    const __m256i b =
+        _mm256_load_si256(reinterpret_cast<const __m256i*>(rhs + w));
+    __m256i result;
+    if (Operation == WordOperation::kAnd) {
+      result = _mm256_and_si256(a, b);
+    } else if (Operation == WordOperation::kOr) {
+      result = _mm256_or_si256(a, b);
+    } else {
+      result = _mm256_andnot_si256(b, a);
+    }
+    _mm256_store_si256(target, result);
+  }
+#endif
+  for (; w < word_count; ++w) {
+    if (Operation == WordOperation::kAnd) {
+      lhs[w] &= rhs[w];
+    } else if (Operation == WordOperation::kOr) {
+      lhs[w] |= rhs[w];
+    } else {
+      lhs[w] &= ~rhs[w];
+    }
+  }
+}
+
+}  // namespace
+
+VertexSet::VertexSet(const int size) : size_(size) {
+  if (size < 0) {
+    throw std::invalid_argument("invalid size: " + std::to_string(size));
+  }
+  words_.assign(word_count_for(size), 0);
+}
+
+VertexSet::VertexSet(const std::vector<bool>& members)
+    : VertexSet(members.size()) {
+  for (int v = 0; v < members.size(); ++v) {
+    if (members[v]) {
+      words_[v / 64] |= std::uint64_t(1) << (v % 64);
+    }
+  }
+}
+
+//
+// Accessors
+//
+
+int VertexSet::size() const noexcept {
+  return size_;
+}
+
+int VertexSet::count() const noexcept {
+  int count = 0;
+  for (const std::uint64_t word : words_) {
+    count += __builtin_popcountll(word);
+  }
+  return count;
+}
+
+bool VertexSet::empty() const noexcept {
+  for (const std::uint64_t word : words_) {
+    if (word != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool VertexSet::contains(const int v) const {
+  if (v < 0 || v >= size_) {
+    throw std::range_error("invalid v: " + std::to_string(v));
+  }
+  return (words_[v / 64] >> (v % 64)) & 1;
+}
+
+VertexSet::const_iterator VertexSet::begin() const noexcept {
+  return const_iterator(words_.data(), words_.size(), 0);
+}
+
+VertexSet::const_iterator VertexSet::end() const noexcept {
+  return const_iterator(words_.data(), words_.size(), words_.size());
+}
+
+std::vector<int> VertexSet::members() const {
+  std::vector<int> members;
+  members.reserve(count());
+  for (const int v : *this) {
+    members.push_back(v);
+  }
+  return members;
+}
+
+//
+// Modifiers
+//
+
+void VertexSet::insert(const int v) {
+  if (v < 0 || v >= size_) {
+    throw std::range_error("invalid v: " + std::to_string(v));
+  }
+  words_[v / 64] |= std::uint64_t(1) << (v % 64);
+}
+
+void VertexSet::erase(const int v) {
+  if (v < 0 || v >= size_) {
+    throw std::range_error("invalid v: " + std::to_string(v));
+  }
+  words_[v / 64] &= ~(std::uint64_t(1) << (v % 64));
+}
+
+VertexSet& VertexSet::operator&=(const VertexSet& other) {
+  check_same_size(other);
+  apply<WordOperation::kAnd>(words_.data(), other.words_.data(), words_.size());
+  return *this;
+}
+
+VertexSet& VertexSet::operator|=(const VertexSet& other) {
+  check_same_size(other);
+  apply<WordOperation::kOr>(words_.data(), other.words_.data(), words_.size());
+  return *this;
+}
+
+VertexSet& VertexSet::operator-=(const VertexSet& other) {
+  check_same_size(other);
+  apply<WordOperation::kAndNot>(
+      words_.data(), other.words_.data(), words_.size());
+  return *this;
+}
+
+//
+// Relational Operators
+//
+
+bool VertexSet::operator==(const VertexSet& rhs) const noexcept {
+  return size_ == rhs.size_ && words_ == rhs.words_;
+}
+
+bool VertexSet::operator!=(const VertexSet& rhs) const noexcept {
+  return !(*this == rhs);
+}
+
+void VertexSet::check_same_size(const VertexSet& other) const {
+  if (size_ != other.size_) {
+    throw std::invalid_argument(
+        "sets have different sizes: " + std::to_string(size_) + " and " +
+            std::to_string(other.size_));
+  }
+}
+
+VertexSet operator&(VertexSet lhs, const VertexSet& rhs) {
+  return lhs &= rhs;
+}
+
+VertexSet operator|(VertexSet lhs, const VertexSet& rhs) {
+  return lhs |= rhs;
+}
+
+VertexSet operator-(VertexSet lhs, const VertexSet& rhs) {
+  return lhs -= rhs;
+}
+
+std::ostream& operator<<(std::ostream& stream, const VertexSet& set) {
+  stream << '{';
+  for (int v = 0; v < set.size(); ++v) {
+    stream << (v == 0 ? "" : ", ") << set.contains(v);
+  }
+  return stream << '}';
+}
@@ -0,0 +1,211 @@
+#ifndef _vertex_set_hpp_
+#define _vertex_set_hpp_
+
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+#include "aligned_allocator.hpp"
+
+// The VertexSet class encapsulates a set of the vertices 0, 1, ..., size() - 1
+// of a graph as a dense bitset.
+//
+// The bits are stored in 64-bit words in a 64-byte aligned allocation padded
+// to a whole number of cache lines (the padding bits are always zero), so that
+// count() is a sequence of popcounts, iteration skips 64 absent vertices at a
+// time and finds the next member with a count-trailing-zeros (tzcnt), and the
+// set operations are (AVX-512 or AVX2, when compiled for them) vector
+// operations over whole words.
+class VertexSet {
+ public:
+  // The const_iterator class iterates over the members of a VertexSet in
+  // increasing order.
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = int;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const int*;
+    using reference = int;
+
+    // Returns the current member.
+    int operator*() const noexcept {
+      return 64 * word_ + __builtin_ctzll(bits_);
+    }
+
+    // Advances to the next member.
+    const_iterator& operator++() noexcept {
+      bits_ &= bits_ - 1;
+      advance_to_member();
+      return *this;
+    }
+
+    const_iterator operator++(int) noexcept {
+      const_iterator previous = *this;
+      ++*this;
+      return previous;
+    }
+
+    bool operator==(const const_iterator& rhs) const noexcept {
+      return word_ == rhs.word_ && bits_ == rhs.bits_;
+    }
+
+    bool operator!=(const const_iterator& rhs) const noexcept {
+      return !(*this == rhs);
+    }
+
+   private:
+    friend class VertexSet;
+
+    const_iterator(
+        const std::uint64_t* words, const int word_count, const int word)
+        : words_(words),
+          word_count_(word_count),
+          word_(word),
+          bits_(word < word_count ? words[word] : 0) {
+      advance_to_member();
+    }
+
+    // Moves to the first word at or after word_ with a bit set, or to the end.
+    void advance_to_member() noexcept {
+      while (bits_ == 0 && word_ < word_count_) {
+        word_++;
+        bits_ = word_ < word_count_ ? words_[word_] : 0;
+      }
+    }
+
+    // The words of the set.
+    const std::uint64_t* words_;
+
+    // The number of words of the set.
+    int word_count_;
+
+    // The index of the current word.
+    int word_;
+
+    // The bits of the current word not yet visited.
+    std::uint64_t bits_;
+  };
+
+  //
+  // Constructors and Destructors
+  //
+
+  // The constructor. Creates an empty set of the vertices 0, 1, ..., size - 1.
+  //
+  // Throws a std::invalid_argument exception if size is negative.
+  explicit VertexSet(const int size);
+
+  // Creates the set of the vertices v with members[v] true, of the vertices
+  // 0, 1, ..., members.size() - 1.
+  explicit VertexSet(const std::vector<bool>& members);
+
+  // The copy constructor.
+  VertexSet(const VertexSet& other) = default;
+
+  // The copy assignment constructor.
+  VertexSet& operator=(const VertexSet& other) = default;
+
+  // The move constructor.
+  VertexSet(VertexSet&& other) = default;
+
+  // The move assignment constructor.
+  VertexSet& operator=(VertexSet&& other) = default;
+
+  // The destructor.
+  ~VertexSet() = default;
+
+  //
+  // Accessors
+  //
+
+  // Returns the number of vertices the set is over (not the number of
+  // members; see count).
+  int size() const noexcept;
+
+  // Returns the number of members of the set.
+  int count() const noexcept;
+
+  // Returns whether the set has no members.
+  bool empty() const noexcept;
+
+  // Returns whether vertex v is a member of the set.
+  //
+  // Throws a std::range_error exception if 0 <= v < size() is violated.
+  bool contains(const int v) const;
+
+  // Returns an iterator to the smallest member of the set.
+  const_iterator begin() const noexcept;
+
+  // Returns the past-the-end iterator of the set.
+  const_iterator end() const noexcept;
+
+  // Returns the members of the set, in increasing order.
+  std::vector<int> members() const;
+
+  //
+  // Modifiers
+  //
+
+  // Adds vertex v to the set.
+  //
+  // Throws a std::range_error exception if 0 <= v < size() is violated.
+  void insert(const int v);
+
+  // Removes vertex v from the set.
+  //
+  // Throws a std::range_error exception if 0 <= v < size() is violated.
+  void erase(const int v);
+
+  // Replaces the set with its intersection with `other`.
+  //
+  // Throws a std::invalid_argument exception if the sets have different sizes.
+  VertexSet& operator&=(const VertexSet& other);
+
+  // Replaces the set with its union with `other`.
+  //
+  // Throws a std::invalid_argument exception if the sets have different sizes.
+  VertexSet& operator|=(const VertexSet& other);
+
+  // Removes the members of `other` from the set.
+  //
+  // Throws a std::invalid_argument exception if the sets have different sizes.
+  VertexSet& operator-=(const VertexSet& other);
+
+  //
+  // Relational Operators
+  //
+
+  // Returns whether two sets are over the same vertices and have the same
+  // members.
+  bool operator==(const VertexSet& rhs) const noexcept;
+
+  // Returns whether two sets differ in size or in any member.
+  bool operator!=(const VertexSet& rhs) const noexcept;
+
+ private:
+  // Throws a std::invalid_argument exception if `other` has a different size.
+  void check_same_size(const VertexSet& other) const;
+
+  // The number of vertices the set is over.
+  int size_;
+
+  // The bits of the set. Bit (v % 64) of word (v / 64) is set exactly when
+  // vertex v is a member.
+  std::vector<std::uint64_t, AlignedAllocator<std::uint64_t>> words_;
+};
+
+// Returns the intersection of two sets of the same size.
+VertexSet operator&(VertexSet lhs, const VertexSet& rhs);
+
+// Returns the union of two sets of the same size.
+VertexSet operator|(VertexSet lhs, const VertexSet& rhs);
+
+// Returns the members of lhs that are not members of rhs.
+VertexSet operator-(VertexSet lhs, const VertexSet& rhs);
+
+// Writes the set to `stream` as one 0 or 1 per vertex, e.g., {1, 0, 1}.
+std::ostream& operator<<(std::ostream& stream, const VertexSet& set);
+
+#endif
@@ -0,0 +1,119 @@
+#ifndef _vertex_set_test_hpp_
+#define _vertex_set_test_hpp_
+
+// Unit tests for the VertexSet class.
+#include "vertex_set.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+#include "doctest.hpp"
+#include "test_random.hpp"
+
+TEST_CASE("VertexSet") {
+  SUBCASE("NegativeSizeThrowsException") {
+    CHECK_THROWS_AS(VertexSet(-1), std::invalid_argument);
+  }
+
+  SUBCASE("EmptySet") {
+    const VertexSet set(100);
+    CHECK_EQ(set.size(), 100);
+    CHECK_EQ(set.count(), 0);
+    CHECK(set.empty());
+    CHECK_EQ(set.begin(), set.end());
+    CHECK_FALSE(set.contains(99));
+  }
+
+  SUBCASE("BadVertexThrowsException") {
+    VertexSet set(100);
+    CHECK_THROWS_AS(set.contains(-1), std::range_error);
+    CHECK_THROWS_AS(set.contains(100), std::range_error);
+    CHECK_THROWS_AS(set.insert(100), std::range_error);
+    CHECK_THROWS_AS(set.erase(-1), std::range_error);
+  }
+
+  SUBCASE("InsertAndErase") {
+    VertexSet set(1000);
+    set.insert(0);
+    set.insert(63);
+    set.insert(64);
+    set.insert(999);
+    set.insert(64);
+    CHECK_EQ(set.count(), 4);
+    CHECK(set.contains(63));
+    CHECK_FALSE(set.contains(62));
+    set.erase(63);
+    set.erase(500);
+    CHECK_EQ(set.members(), std::vector<int>({0, 64, 999}));
+  }
+
+  SUBCASE("IterationSkipsEmptyWords") {
+    VertexSet set(5000);
+    std::vector<int> expected;
+    for (int v = 7; v < 5000; v += 611) {
+      set.insert(v);
+      expected.push_back(v);
+    }
+    std::vector<int> members;
+    for (const int v : set) {
+      members.push_back(v);
+    }
+    CHECK_EQ(members, expected);
+  }
+
+  SUBCASE("ConstructsFromVectorOfBool") {
+    const std::vector<bool> members({true, false, false, true, true});
+    const VertexSet set(members);
+    CHECK_EQ(set.size(), 5);
+    CHECK_EQ(set.members(), std::vector<int>({0, 3, 4}));
+    CHECK_EQ(set, VertexSet(members));
+    CHECK_NE(
+        set, VertexSet(std::vector<bool>({true, false, false, true, false})));
+    CHECK_NE(
+        set,
+        VertexSet(std::vector<bool>({true, false, false, true, true, false})));
+  }
+
+  SUBCASE("SetOperationsMatchWordByWord") {
+    // Sets big enough to use every vector width, with pseudo-random members.
+    const int size = 3000;
+    VertexSet a(size);
+    VertexSet b(size);
+    std::vector<bool> in_a(size);
+    std::vector<bool> in_b(size);
+    TestRandom random(7);
+    for (int v = 0; v < size; ++v) {
+      in_a[v] = random.one_in(3);
+      in_b[v] = random.one_in(2);
+      if (in_a[v]) {
+        a.insert(v);
+      }
+      if (in_b[v]) {
+        b.insert(v);
+      }
+    }
+
+    std::vector<bool> both(size);
+    std::vector<bool> either(size);
+    std::vector<bool> only_a(size);
+    for (int v = 0; v < size; ++v) {
+      both[v] = in_a[v] && in_b[v];
+      either[v] = in_a[v] || in_b[v];
+      only_a[v] = in_a[v] && !in_b[v];
+    }
+    CHECK_EQ(a & b, VertexSet(both));
+    CHECK_EQ(a | b, VertexSet(either));
+    CHECK_EQ(a - b, VertexSet(only_a));
+    CHECK_EQ((a & b).count() + (a - b).count(), a.count());
+  }
+
+  SUBCASE("SetOperationsOnDifferentSizesThrowException") {
+    VertexSet a(10);
+    const VertexSet b(11);
+    CHECK_THROWS_AS(a &= b, std::invalid_argument);
+    CHECK_THROWS_AS(a |= b, std::invalid_argument);
+    CHECK_THROWS_AS(a -= b, std::invalid_argument);
+  }
+}
+
+#endif